@@ -20,6 +20,7 @@
 #include "cy_csdidac.h"
 #include "cy_gpio.h"
 #include "cy_csd.h"
+#include "cy_csdidac_route.h"
 
 #if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
 
@@ -32,10 +33,52 @@
 * \addtogroup group_csdidac_internal
 * \{
 */
-static void Cy_CSDIDAC_ConnectChannelA(cy_stc_csdidac_context_t * context);
-static void Cy_CSDIDAC_ConnectChannelB(cy_stc_csdidac_context_t * context);
-static void Cy_CSDIDAC_DisconnectChannelA(cy_stc_csdidac_context_t * context);
-static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_ConnectChannelA(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_ConnectChannelB(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_DisconnectChannelA(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_DisconnectChannelB(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_DisconnectChannels(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_WriteChannel(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_choice_t outputCh,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode,
+                cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_ConvertCurrent(
+                int32_t current,
+                cy_en_csdidac_polarity_t * polarity,
+                cy_en_csdidac_lsb_t * lsbIndex,
+                uint32_t * code);
+static int32_t Cy_CSDIDAC_GetChannelCurrent(
+                cy_en_csdidac_state_t state,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint8_t code);
+#if (0u != CY_CSDIDAC_STATS_EN)
+static void Cy_CSDIDAC_StatsRecord(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_status_t status,
+                cy_stc_csdidac_context_t * context);
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+#if (0u != CY_CSDIDAC_CHARGE_EN)
+static void Cy_CSDIDAC_ChargeAccumulate(cy_stc_csdidac_context_t * context);
+static void Cy_CSDIDAC_ChargeCommit(cy_en_csdidac_api_t api, cy_stc_csdidac_context_t * context);
+#endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+#if (0u != CY_CSDIDAC_PROFILE_EN)
+static void Cy_CSDIDAC_ProfileRecord(cy_en_csdidac_api_t api, uint32_t startTime);
+#endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 /** \}
 * \endcond */
 
@@ -61,14 +104,7 @@ static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context);
  * | 25     | LEG2_EN       | 0x00(The output for LEG2 is disabled)                             |
  * +--------+---------------+-------------------------------------------------------------------+*/
 #define CY_CSDIDAC_DEFAULT_CFG                      (0x01800000uL)
-#define CY_CSDIDAC_POLARITY_POS                     (8uL)
-#define CY_CSDIDAC_POLARITY_MASK                    (3uL << CY_CSDIDAC_POLARITY_POS)
-#define CY_CSDIDAC_LSB_POS                          (22uL)
-#define CY_CSDIDAC_LSB_MASK                         (3uL << CY_CSDIDAC_LSB_POS)
-#define CY_CSDIDAC_LEG1_EN_POS                      (24uL)
-#define CY_CSDIDAC_LEG1_EN_MASK                     (1uL << CY_CSDIDAC_LEG1_EN_POS)
-#define CY_CSDIDAC_LEG2_EN_POS                      (25uL)
-#define CY_CSDIDAC_LEG2_EN_MASK                     (1uL << CY_CSDIDAC_LEG2_EN_POS)
+/* The field positions and masks of the IDAC register word are in cy_csdidac.h */
 #define CY_CSDIDAC_RANGE_MASK                       (CY_CSDIDAC_LSB_MASK | CY_CSDIDAC_LEG1_EN_MASK | CY_CSDIDAC_LEG2_EN_MASK)
 
 /*
@@ -88,8 +124,23 @@ static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context);
 #define CY_CSDIDAC_LSB_2400_MAX_CURRENT           (304800000u)
 #define CY_CSDIDAC_LSB_4800_MAX_CURRENT           (609600000u)
 
+/* The IDAC LSB in pA indexed by cy_en_csdidac_lsb_t */
+static const uint32_t cy_csdidac_lsbPa[] =
+{
+    CY_CSDIDAC_LSB_37,
+    CY_CSDIDAC_LSB_75,
+    CY_CSDIDAC_LSB_300,
+    CY_CSDIDAC_LSB_600,
+    CY_CSDIDAC_LSB_2400,
+    CY_CSDIDAC_LSB_4800,
+};
+
+#if (0u != CY_CSDIDAC_PROFILE_EN)
+    /* The profiling records indexed by cy_en_csdidac_api_t */
+    static cy_stc_csdidac_profile_t cy_csdidac_profile[CY_CSDIDAC_API_NUM];
+#endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
 #define CY_CSDIDAC_CODE_MASK                        (127u)
-#define CY_CSDIDAC_CONST_2                          (2u)
 #define CY_CSDIDAC_CONST_10                         (10u)
 #define CY_CSDIDAC_CONST_1000                       (1000u)
 #define CY_CSDIDAC_CONST_1000000                    (1000000u)
@@ -112,8 +163,6 @@ static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context);
 #define CY_CSDIDAC_CSD_INTR_MASK_CLEAR_MSK          (0x00000000uL)
 
 /* Switch definitions */
-#define CY_CSDIDAC_SW_BYPA_ENABLE                   (0x00001000uL)
-#define CY_CSDIDAC_SW_BYPB_ENABLE                   (0x00010000uL)
 #define CY_CSDIDAC_SW_REFGEN_SEL_IBCB_ON            (0x00000010uL)
 #define CY_CSDIDAC_SW_REFGEN_SEL_IAIB_ON            (0x00000001uL)
 
@@ -215,6 +264,9 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Init(
                 cy_stc_csdidac_context_t * context)
 {
     cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     if ((NULL != config) && (NULL != context))
     {
@@ -222,13 +274,28 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Init(
         {
             /* Copies the configuration structure to the context. */
             context->cfgCopy = *config;
+            context->seq = 0u;
+            #if (0u != CY_CSDIDAC_STATS_EN)
+                /* Clears the statistics. The channels are disconnected below. */
+                context->channelStateA = CY_CSDIDAC_DISABLE;
+                context->channelStateB = CY_CSDIDAC_DISABLE;
+                (void)Cy_CSDIDAC_SnapshotStats(NULL, context);
+            #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+            #if (0u != CY_CSDIDAC_CS_STATS_EN)
+                (void)Cy_CSDIDAC_ResetCsStats(context);
+            #endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+            #if (0u != CY_CSDIDAC_CHARGE_EN)
+                /* The charge accounting is started by Cy_CSDIDAC_ChargeInit(). */
+                context->timestampFunc = NULL;
+                context->chargeA = 0;
+                context->chargeB = 0;
+            #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
             /* Captures the CSD HW block for the IDAC functionality. */
             result = Cy_CSDIDAC_Restore(context);
             if (CY_CSDIDAC_SUCCESS == result)
             {
                 /* Disconnects all CSDIDAC channels. */
-                Cy_CSDIDAC_DisconnectChannelA(context);
-                Cy_CSDIDAC_DisconnectChannelB(context);
+                Cy_CSDIDAC_DisconnectChannels(CY_CSDIDAC_API_INIT, CY_CSDIDAC_AB, context);
                 /* Wakes up the CSD HW block. */
                 (void)Cy_CSDIDAC_Wakeup(context);
             }
@@ -239,6 +306,13 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Init(
         }
     }
 
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_INIT, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_INIT, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
     return (result);
 }
 
@@ -277,7 +351,21 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Init(
 *******************************************************************************/
 cy_en_csdidac_status_t Cy_CSDIDAC_DeInit(cy_stc_csdidac_context_t * context)
 {
-    return (Cy_CSDIDAC_Save(context));
+    cy_en_csdidac_status_t result;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    result = Cy_CSDIDAC_Save(context);
+
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_DEINIT, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_DEINIT, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    return (result);
 }
 
 
@@ -322,6 +410,9 @@ cy_en_csdidac_status_t Cy_CSDIDAC_WriteConfig(
 {
     cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
     uint32_t tmpRegValue = CY_CSDIDAC_SW_REFGEN_SEL_IBCB_ON;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     if ((NULL != config) && (NULL != context))
     {
@@ -361,6 +452,174 @@ cy_en_csdidac_status_t Cy_CSDIDAC_WriteConfig(
         }
     }
 
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_WRITE_CONFIG, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_WRITE_CONFIG, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ReconfigureChannel
+****************************************************************************//**
+*
+* Changes the routing of a single channel while the outputs are enabled.
+*
+* Unlike Cy_CSDIDAC_WriteConfig(), the function does not require both
+* channels to be disabled. The other channel is not touched, and an enabled
+* channel keeps its IDAC output during the migration. The function performs
+* the following:
+* * Verifies the input parameters and the resulting configuration.
+* * Verifies whether the CSD HW block is captured by the CSDIDAC middleware.
+* * Migrates the routing of an enabled channel in the make-before-break order
+*   within one critical section: a routing batch connects the new pin to
+*   the AMUX bus first, then a second batch disconnects the old pin. The
+*   bypass switch stays closed, as it is used by both the GPIO and the AMUX
+*   routing.
+* * Updates the channel configuration in the context. The routing of
+*   a disabled channel is applied by the next output enable.
+*
+* The current of the enabled channel is never interrupted. It is shared
+* between the old and the new pin for the overlap window, which is bounded by
+* the read-modify-write of the HSIOM register of the old pin. The window duration is measured by the critical
+* section statistics of CY_CSDIDAC_API_RECONFIGURE if
+* \ref CY_CSDIDAC_CS_STATS_EN is enabled.
+*
+* The joined channel configuration changes the IAIB switch that is shared by
+* both the channels, so it is not supported by this function. Use
+* Cy_CSDIDAC_WriteConfig() instead.
+*
+* \param ch
+* The channel to reconfigure, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param channelConfig
+* The new channel configuration, CY_CSDIDAC_GPIO, CY_CSDIDAC_AMUX, or
+* CY_CSDIDAC_DISABLED.
+*
+* \param ptrPin
+* The pointer to the new pin structure. Used with CY_CSDIDAC_GPIO only.
+*
+* \param context
+* The pointer to the CSDIDAC context structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS           - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM         - The input pointer is NULL or an invalid
+*                                  parameter is passed.
+* * CY_CSDIDAC_HW_BUSY           - The channel is enabled and the new
+*                                  configuration is CY_CSDIDAC_DISABLED.
+* * CY_CSDIDAC_HW_LOCKED         - The CSD HW block is already in use by other
+*                                  middleware.
+* * CY_CSDIDAC_BAD_CONFIGURATION - The resulting configuration is invalid,
+*                                  uses the joined channels, or routes both
+*                                  the channels to the same pin.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ReconfigureChannel(
+                cy_en_csdidac_choice_t ch,
+                cy_en_csdidac_channel_config_t channelConfig,
+                const cy_stc_csdidac_pin_t * ptrPin,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_config_t newConfig;
+    cy_en_csdidac_channel_config_t oldConfig;
+    const cy_stc_csdidac_pin_t * oldPin;
+    cy_en_csdidac_state_t channelState;
+    en_hsiom_sel_t hsiomSel;
+    cy_stc_csdidac_route_batch_t makeBatch;
+    cy_stc_csdidac_route_batch_t breakBatch;
+    bool samePin;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        newConfig = context->cfgCopy;
+        if (CY_CSDIDAC_A == ch)
+        {
+            oldConfig = newConfig.configA;
+            oldPin = newConfig.ptrPinA;
+            newConfig.configA = channelConfig;
+            newConfig.ptrPinA = ptrPin;
+            channelState = context->channelStateA;
+            hsiomSel = HSIOM_SEL_AMUXA;
+        }
+        else
+        {
+            oldConfig = newConfig.configB;
+            oldPin = newConfig.ptrPinB;
+            newConfig.configB = channelConfig;
+            newConfig.ptrPinB = ptrPin;
+            channelState = context->channelStateB;
+            hsiomSel = HSIOM_SEL_AMUXB;
+        }
+
+        if ((false == Cy_CSDIDAC_IsIdacConfigValid(&newConfig)) ||
+            (CY_CSDIDAC_JOIN == oldConfig) || (CY_CSDIDAC_JOIN == channelConfig) ||
+            (CY_CSDIDAC_JOIN == newConfig.configA) || (CY_CSDIDAC_JOIN == newConfig.configB) ||
+            ((CY_CSDIDAC_GPIO == newConfig.configA) && (CY_CSDIDAC_GPIO == newConfig.configB) &&
+             (newConfig.ptrPinA->ioPcPtr == newConfig.ptrPinB->ioPcPtr) &&
+             (newConfig.ptrPinA->pin == newConfig.ptrPinB->pin)))
+        {
+            result = CY_CSDIDAC_BAD_CONFIGURATION;
+        }
+        else if (CY_CSD_IDAC_KEY != Cy_CSD_GetLockStatus(context->cfgCopy.base, context->cfgCopy.csdCxtPtr))
+        {
+            result = CY_CSDIDAC_HW_LOCKED;
+        }
+        else if ((CY_CSDIDAC_ENABLE == channelState) && (CY_CSDIDAC_DISABLED == channelConfig))
+        {
+            result = CY_CSDIDAC_HW_BUSY;
+        }
+        else
+        {
+            samePin = ((CY_CSDIDAC_GPIO == oldConfig) && (CY_CSDIDAC_GPIO == channelConfig) &&
+                       (oldPin->ioPcPtr == ptrPin->ioPcPtr) && (oldPin->pin == ptrPin->pin));
+
+            (void)Cy_CSDIDAC_RouteBatchInit(&makeBatch);
+            (void)Cy_CSDIDAC_RouteBatchInit(&breakBatch);
+            if ((CY_CSDIDAC_ENABLE == channelState) && (false == samePin))
+            {
+                if (CY_CSDIDAC_GPIO == channelConfig)
+                {
+                    (void)Cy_CSDIDAC_RouteBatchAdd(ptrPin, CY_GPIO_DM_ANALOG, hsiomSel, &makeBatch);
+                }
+                if (CY_CSDIDAC_GPIO == oldConfig)
+                {
+                    (void)Cy_CSDIDAC_RouteBatchAdd(oldPin, CY_CSDIDAC_ROUTE_DM_KEEP, HSIOM_SEL_GPIO, &breakBatch);
+                }
+            }
+
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            if ((CY_CSDIDAC_ENABLE == channelState) && (false == samePin))
+            {
+                /* Make: connects the new pin while the old route still carries the output current. */
+                (void)Cy_CSDIDAC_RouteBatchApply(&makeBatch, context);
+                /* Break: disconnects the old pin from the AMUX bus. */
+                (void)Cy_CSDIDAC_RouteBatchApply(&breakBatch, context);
+            }
+            context->cfgCopy = newConfig;
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_RECONFIGURE, interruptState, csStartTime, context);
+            result = CY_CSDIDAC_SUCCESS;
+        }
+    }
+
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_RECONFIGURE, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_RECONFIGURE, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
     return (result);
 }
 
@@ -500,14 +759,20 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Save(cy_stc_csdidac_context_t * context)
 {
     cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
     cy_en_csd_status_t initStatus = CY_CSD_LOCKED;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     if (NULL != context)
     {
         if (CY_CSD_IDAC_KEY == Cy_CSD_GetLockStatus(context->cfgCopy.base, context->cfgCopy.csdCxtPtr))
         {
+            #if (0u != CY_CSDIDAC_CHARGE_EN)
+                Cy_CSDIDAC_ChargeCommit(CY_CSDIDAC_API_SAVE, context);
+            #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+
             /* Disconnects the output channels pins from analog buses. */
-            Cy_CSDIDAC_DisconnectChannelA(context);
-            Cy_CSDIDAC_DisconnectChannelB(context);
+            Cy_CSDIDAC_DisconnectChannels(CY_CSDIDAC_API_SAVE, CY_CSDIDAC_AB, context);
 
             /* Releases the HW CSD block. */
             initStatus = Cy_CSD_DeInit(context->cfgCopy.base, CY_CSD_IDAC_KEY, context->cfgCopy.csdCxtPtr);
@@ -527,6 +792,13 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Save(cy_stc_csdidac_context_t * context)
         }
     }
 
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_SAVE, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_SAVE, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
     return (result);
 }
 
@@ -571,6 +843,9 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Restore(cy_stc_csdidac_context_t * context)
     cy_en_csd_key_t mvKey;
     cy_en_csd_status_t initStatus = CY_CSD_LOCKED;
     cy_stc_csd_config_t csdCfg = CY_CSDIDAC_CSD_CONFIG_DEFAULT;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     /* The number of cycles of one for() loop. */
     const uint32_t cyclesPerLoop = 5u;
@@ -624,6 +899,14 @@ cy_en_csdidac_status_t Cy_CSDIDAC_Restore(cy_stc_csdidac_context_t * context)
     {
         result = CY_CSDIDAC_BAD_PARAM;
     }
+
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_RESTORE, result, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_RESTORE, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
     return (result);
 }
 
@@ -676,57 +959,150 @@ cy_en_csdidac_status_t Cy_CSDIDAC_OutputEnable(
                 cy_stc_csdidac_context_t * context)
 {
     cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
-    cy_en_csdidac_polarity_t polarity= CY_CSDIDAC_SOURCE;
+    cy_en_csdidac_polarity_t polarity;
     cy_en_csdidac_lsb_t lsbIndex;
-    uint32_t absCurrent = (0 > current) ? (uint32_t)(-current) : (uint32_t)current;
     uint32_t code;
+    uint32_t absCurrent = (0 > current) ? (0u - (uint32_t)current) : (uint32_t)current;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
-    if((NULL != context) && (CY_CSDIDAC_MAX_CURRENT_NA >= absCurrent))
+    if((NULL != context) && (CY_CSDIDAC_MAX_CURRENT_NA >= absCurrent) &&
+       (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, context->cfgCopy.configA, context->cfgCopy.configB)))
     {
-        if(true == Cy_CSDIDAC_IsIdacChoiceValid(ch, context->cfgCopy.configA, context->cfgCopy.configB))
-        {
-            /* Chooses the desired current polarity */
-            if (0 > current)
-            {
-                polarity = CY_CSDIDAC_SINK;
-            }
-            /* Converts absCurrent to pA */
-            absCurrent *= CY_CSDIDAC_CONST_1000;
-            /* Chooses IDAC LSB and calculates the IDAC code */
-            if (absCurrent < CY_CSDIDAC_LSB_37_MAX_CURRENT)
-            {
-                lsbIndex = CY_CSDIDAC_LSB_37_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_37;
-            }
-            else if (absCurrent < CY_CSDIDAC_LSB_75_MAX_CURRENT)
-            {
-                lsbIndex = CY_CSDIDAC_LSB_75_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_75;
-            }
-            else if (absCurrent < CY_CSDIDAC_LSB_300_MAX_CURRENT)
-            {
-                lsbIndex = CY_CSDIDAC_LSB_300_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_300;
-            }
-            else if (absCurrent < CY_CSDIDAC_LSB_600_MAX_CURRENT)
-            {
-                lsbIndex = CY_CSDIDAC_LSB_600_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_600;
-            }
-            else if(absCurrent < CY_CSDIDAC_LSB_2400_MAX_CURRENT)
-            {
-                lsbIndex = CY_CSDIDAC_LSB_2400_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_2400;
-            }
-            else
-            {
-                lsbIndex = CY_CSDIDAC_LSB_4800_IDX;
-                code = absCurrent / CY_CSDIDAC_LSB_4800;
-            }
+        /* Identifies the polarity, LSB and code, the parameters are verified once above */
+        Cy_CSDIDAC_ConvertCurrent(current, &polarity, &lsbIndex, &code);
+        /* Sets the desired IDAC(s) polarity, LSB and code in the CSD block and connects output(s). */
+        retVal = Cy_CSDIDAC_WriteChannel(CY_CSDIDAC_API_OUTPUT_ENABLE, ch, polarity, lsbIndex, code, context);
+    }
+
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_OUTPUT_ENABLE, retVal, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_OUTPUT_ENABLE, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CurrentToCode
+****************************************************************************//**
+*
+* Converts a current value to the polarity, LSB, and IDAC code.
+*
+* The conversion is the same as the Cy_CSDIDAC_OutputEnable() function
+* performs: the minimum possible LSB is chosen to minimize the quantization
+* error. The result can be passed to the Cy_CSDIDAC_OutputEnableExt()
+* function, so the conversion can be done once, out of a time-critical path.
+*
+* \param current
+* A current value in nA with a sign. A positive value is a sourcing current,
+* a negative value is a sinking current. The absolute value is in the range
+* from 0x00u to \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+* \param polarity
+* The pointer to the polarity to be written.
+*
+* \param lsbIndex
+* The pointer to the LSB index to be written.
+*
+* \param code
+* The pointer to the IDAC code to be written.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_CurrentToCode(
+                int32_t current,
+                cy_en_csdidac_polarity_t * polarity,
+                cy_en_csdidac_lsb_t * lsbIndex,
+                uint32_t * code)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t absCurrent = (0 > current) ? (0u - (uint32_t)current) : (uint32_t)current;
+
+    if((NULL != polarity) && (NULL != lsbIndex) && (NULL != code) && (CY_CSDIDAC_MAX_CURRENT_NA >= absCurrent))
+    {
+        Cy_CSDIDAC_ConvertCurrent(current, polarity, lsbIndex, code);
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SyncIdacWord
+****************************************************************************//**
+*
+* Updates the polarity, LSB, and code of the channel in the context structure
+* from the IDAC register.
+*
+* The function is used after the IDAC register is written with the fast path,
+* see Cy_CSDIDAC_GetIdacReg(), so the Cy_CSDIDAC_Save(),
+* Cy_CSDIDAC_Restore(), and Cy_CSDIDAC_GetOutputCurrent() functions use
+* the actual channel configuration. If the charge accounting is enabled,
+* the charge delivered since the previous commit is accounted with
+* the channel configuration stored in the context structure.
+*
+* \param ch
+* The channel to be synchronized, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SyncIdacWord(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t idacRegValue;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
 
-            /* Sets the desired IDAC(s) polarity, LSB and code in the CSD block and connects output(s). */
-            retVal = Cy_CSDIDAC_OutputEnableExt(ch, polarity, lsbIndex, code, context);
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        #if (0u != CY_CSDIDAC_CHARGE_EN)
+            Cy_CSDIDAC_ChargeAccumulate(context);
+        #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+        idacRegValue = *Cy_CSDIDAC_GetIdacReg(ch, context);
+        polarity = (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(idacRegValue);
+        /* The LSB index is the LSB range multiplied by 2 plus the IDAC leg2 enabling bit */
+        lsbIndex = (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(idacRegValue);
+        Cy_CSDIDAC_SeqWriteBegin(context);
+        if (CY_CSDIDAC_A == ch)
+        {
+            context->polarityA = polarity;
+            context->lsbA = lsbIndex;
+            context->codeA = (uint8_t)(idacRegValue & CY_CSDIDAC_CODE_MASK);
         }
+        else
+        {
+            context->polarityB = polarity;
+            context->lsbB = lsbIndex;
+            context->codeB = (uint8_t)(idacRegValue & CY_CSDIDAC_CODE_MASK);
+        }
+        Cy_CSDIDAC_SeqWriteEnd(context);
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_SYNC_IDAC_WORD, interruptState, csStartTime, context);
+        retVal = CY_CSDIDAC_SUCCESS;
     }
 
     return (retVal);
@@ -776,89 +1152,242 @@ cy_en_csdidac_status_t Cy_CSDIDAC_OutputEnableExt(
                 uint32_t idacCode,
                 cy_stc_csdidac_context_t * context)
 {
-    uint32_t idacRegValue;
-    uint32_t  interruptState;
     cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     if((NULL != context) && (CY_CSDIDAC_MAX_CODE >= idacCode))
     {
-        CSD_Type * ptrCsdBaseAdd = context->cfgCopy.base;
-
         if((true == Cy_CSDIDAC_IsIdacChoiceValid(outputCh, context->cfgCopy.configA, context->cfgCopy.configB)) &&
            (true == Cy_CSDIDAC_IsIdacPolarityValid(polarity)) &&
            (true == Cy_CSDIDAC_IsIdacLsbValid(lsbIndex)))
          {
-            idacRegValue = idacCode | (((uint32_t)polarity) << CY_CSDIDAC_POLARITY_POS);
-            /* Sets IDAC LSB. The LSB value equals lsbIndex divided by 2 */
-            idacRegValue |= ((((uint32_t)lsbIndex) >> 1uL) << CY_CSDIDAC_LSB_POS);
-            /* Sets the IDAC leg1 enabling bit */
-            idacRegValue |= ((uint32_t)CY_CSDIDAC_LEG1_EN_MASK);
-            /* Sets the IDAC leg2 enabling bit if the lsbIndex is even. */
-            if (0u != (lsbIndex % CY_CSDIDAC_CONST_2))
-            {
-                idacRegValue |= ((uint32_t)CY_CSDIDAC_LEG2_EN_MASK);
-            }
+            retVal = Cy_CSDIDAC_WriteChannel(CY_CSDIDAC_API_OUTPUT_ENABLE_EXT, outputCh, polarity, lsbIndex, idacCode, context);
+        }
+    }
 
-            interruptState = Cy_SysLib_EnterCriticalSection();
-            if (((CY_CSDIDAC_A == outputCh) || (CY_CSDIDAC_AB == outputCh)) &&
-                (CY_CSDIDAC_DISABLED != context->cfgCopy.configA))
-            {
-                /* Sets the IDAC A polarity, LSB and code in the context structure. */
-                context->polarityA = polarity;
-                context->lsbA = lsbIndex;
-                context->codeA = (uint8_t)idacCode;
-                context->channelStateA = CY_CSDIDAC_ENABLE;
-                /* Connects the IDAC A output. */
-                Cy_CSDIDAC_ConnectChannelA(context);
-                /* A connected IDAC B output must be available if the IDAC A output is joined to it. */
-                if (CY_CSDIDAC_JOIN == context->cfgCopy.configA)
-                {
-                    Cy_CSDIDAC_ConnectChannelB(context);
-                }
-                Cy_CSD_WriteReg(ptrCsdBaseAdd, CY_CSD_REG_OFFSET_IDACA, idacRegValue);
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_OUTPUT_ENABLE_EXT, retVal, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_OUTPUT_ENABLE_EXT, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    return (retVal);
+}
 
-                retVal = CY_CSDIDAC_SUCCESS;
-            }
 
-            if (((CY_CSDIDAC_B == outputCh) || (CY_CSDIDAC_AB == outputCh)) &&
-                (CY_CSDIDAC_DISABLED != context->cfgCopy.configB))
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WriteChannel
+****************************************************************************//**
+*
+* Configures and enables the specified output with the polarity, LSB, and
+* IDAC code. The parameters are not verified, this is done by the callers.
+*
+* \param api
+* The public function the critical section is accounted to.
+*
+* \param outputCh
+* The output(s) to be enabled.
+*
+* \param polarity
+* The polarity to be set.
+*
+* \param lsbIndex
+* The LSB to be set.
+*
+* \param idacCode
+* The code value to be set.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* CY_CSDIDAC_SUCCESS if any output is enabled, CY_CSDIDAC_BAD_PARAM if the
+* chosen output is disabled by the configuration.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_WriteChannel(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_choice_t outputCh,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode,
+                cy_stc_csdidac_context_t * context)
+{
+    CSD_Type * ptrCsdBaseAdd = context->cfgCopy.base;
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_route_batch_t batch;
+    bool writeA = false;
+    bool writeB = false;
+    uint32_t idacRegValue;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+    idacRegValue = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, idacCode);
+
+    interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+    #if (0u != CY_CSDIDAC_CHARGE_EN)
+        Cy_CSDIDAC_ChargeAccumulate(context);
+    #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+    /* The context, routing and IDAC registers are one change for Cy_CSDIDAC_ReadChannelState() */
+    Cy_CSDIDAC_SeqWriteBegin(context);
+    if (((CY_CSDIDAC_A == outputCh) || (CY_CSDIDAC_AB == outputCh)) &&
+        (CY_CSDIDAC_DISABLED != context->cfgCopy.configA))
+    {
+        /* Sets the IDAC A polarity, LSB and code in the context structure. */
+        context->polarityA = polarity;
+        context->lsbA = lsbIndex;
+        context->codeA = (uint8_t)idacCode;
+        #if (0u != CY_CSDIDAC_STATS_EN)
+            if (CY_CSDIDAC_DISABLE == context->channelStateA)
             {
-                /* Sets the IDAC B polarity, LSB and code in the context structure. */
-                context->polarityB = polarity;
-                context->lsbB = lsbIndex;
-                context->codeB = (uint8_t)idacCode;
-                context->channelStateB = CY_CSDIDAC_ENABLE;
-                /* Connects the IDAC B output. */
-                Cy_CSDIDAC_ConnectChannelB(context);
-                /* A connected IDAC A output must be available if the IDAC B output is joined to it */
-                if (CY_CSDIDAC_JOIN == context->cfgCopy.configB)
-                {
-                    Cy_CSDIDAC_ConnectChannelA(context);
-                }
-                Cy_CSD_WriteReg(ptrCsdBaseAdd, CY_CSD_REG_OFFSET_IDACB, idacRegValue);
+                context->stats.enableCntA++;
+            }
+        #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+        context->channelStateA = CY_CSDIDAC_ENABLE;
+        /* Connects the IDAC A output. */
+        Cy_CSDIDAC_ConnectChannelA(&batch, context);
+        /* A connected IDAC B output must be available if the IDAC A output is joined to it. */
+        if (CY_CSDIDAC_JOIN == context->cfgCopy.configA)
+        {
+            Cy_CSDIDAC_ConnectChannelB(&batch, context);
+        }
+        writeA = true;
 
-                retVal = CY_CSDIDAC_SUCCESS;
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    if (((CY_CSDIDAC_B == outputCh) || (CY_CSDIDAC_AB == outputCh)) &&
+        (CY_CSDIDAC_DISABLED != context->cfgCopy.configB))
+    {
+        /* Sets the IDAC B polarity, LSB and code in the context structure. */
+        context->polarityB = polarity;
+        context->lsbB = lsbIndex;
+        context->codeB = (uint8_t)idacCode;
+        #if (0u != CY_CSDIDAC_STATS_EN)
+            if (CY_CSDIDAC_DISABLE == context->channelStateB)
+            {
+                context->stats.enableCntB++;
             }
-            Cy_SysLib_ExitCriticalSection(interruptState);
+        #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+        context->channelStateB = CY_CSDIDAC_ENABLE;
+        /* Connects the IDAC B output. */
+        Cy_CSDIDAC_ConnectChannelB(&batch, context);
+        /* A connected IDAC A output must be available if the IDAC B output is joined to it */
+        if (CY_CSDIDAC_JOIN == context->cfgCopy.configB)
+        {
+            Cy_CSDIDAC_ConnectChannelA(&batch, context);
         }
+        writeB = true;
+
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    /* The pins of both the channels are routed before the IDAC outputs are set */
+    (void)Cy_CSDIDAC_RouteBatchApply(&batch, context);
+    if (true == writeA)
+    {
+        Cy_CSD_WriteReg(ptrCsdBaseAdd, CY_CSD_REG_OFFSET_IDACA, idacRegValue);
+    }
+    if (true == writeB)
+    {
+        Cy_CSD_WriteReg(ptrCsdBaseAdd, CY_CSD_REG_OFFSET_IDACB, idacRegValue);
     }
+    Cy_CSDIDAC_SeqWriteEnd(context);
+    Cy_CSDIDAC_ExitCriticalSection(api, interruptState, csStartTime, context);
+
 
     return (retVal);
 }
 
 
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ConvertCurrent
+****************************************************************************//**
+*
+* Converts a current value to the polarity, LSB, and IDAC code. The current
+* range is not verified, this is done by the callers.
+*
+* \param current
+* A current value in nA with a sign.
+*
+* \param polarity
+* The pointer to the polarity to be written.
+*
+* \param lsbIndex
+* The pointer to the LSB index to be written.
+*
+* \param code
+* The pointer to the IDAC code to be written.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_ConvertCurrent(
+                int32_t current,
+                cy_en_csdidac_polarity_t * polarity,
+                cy_en_csdidac_lsb_t * lsbIndex,
+                uint32_t * code)
+{
+    uint32_t absCurrent = (0 > current) ? (0u - (uint32_t)current) : (uint32_t)current;
+
+    /* Chooses the desired current polarity */
+    *polarity = (0 > current) ? CY_CSDIDAC_SINK : CY_CSDIDAC_SOURCE;
+    /* Converts absCurrent to pA */
+    absCurrent *= CY_CSDIDAC_CONST_1000;
+    /* Chooses IDAC LSB and calculates the IDAC code */
+    if (absCurrent < CY_CSDIDAC_LSB_37_MAX_CURRENT)
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_37_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_37;
+    }
+    else if (absCurrent < CY_CSDIDAC_LSB_75_MAX_CURRENT)
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_75_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_75;
+    }
+    else if (absCurrent < CY_CSDIDAC_LSB_300_MAX_CURRENT)
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_300_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_300;
+    }
+    else if (absCurrent < CY_CSDIDAC_LSB_600_MAX_CURRENT)
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_600_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_600;
+    }
+    else if(absCurrent < CY_CSDIDAC_LSB_2400_MAX_CURRENT)
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_2400_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_2400;
+    }
+    else
+    {
+        *lsbIndex = CY_CSDIDAC_LSB_4800_IDX;
+        *code = absCurrent / CY_CSDIDAC_LSB_4800;
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: Cy_CSDIDAC_ConnectChannelA
 ****************************************************************************//**
 *
 * Connects an IDAC A output as specified by the configuration.
 *
+* \param batch
+* The routing batch the pin changes are added to. The batch is applied
+* by the caller.
+*
 * \param context
 * The pointer to the CSDIDAC middleware context
 * structure \ref cy_stc_csdidac_context_t.
 *
 *******************************************************************************/
 static void Cy_CSDIDAC_ConnectChannelA(
+                cy_stc_csdidac_route_batch_t * batch,
                 cy_stc_csdidac_context_t * context)
 {
     /* Closes the bypass A switch to feed output current to AMuxBusA. */
@@ -869,10 +1398,8 @@ static void Cy_CSDIDAC_ConnectChannelA(
     /* Configures port pin, if it is enabled. */
     if ((CY_CSDIDAC_GPIO == context->cfgCopy.configA) && (NULL != context->cfgCopy.ptrPinA))
     {
-        /* Update port configuration register (drive mode) to High-Z Analog */
-        Cy_GPIO_SetDrivemode(context->cfgCopy.ptrPinA->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinA->pin, CY_GPIO_DM_ANALOG);
-        /* Connect the selected port to AMuxBusA */
-        Cy_GPIO_SetHSIOM(context->cfgCopy.ptrPinA->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinA->pin, HSIOM_SEL_AMUXA);
+        /* Sets the drive mode to High-Z Analog and connects the selected port to AMuxBusA */
+        (void)Cy_CSDIDAC_RouteBatchAdd(context->cfgCopy.ptrPinA, CY_GPIO_DM_ANALOG, HSIOM_SEL_AMUXA, batch);
     }
 }
 
@@ -883,12 +1410,17 @@ static void Cy_CSDIDAC_ConnectChannelA(
 *
 * Connects an IDAC B output as specified by the configuration.
 *
+* \param batch
+* The routing batch the pin changes are added to. The batch is applied
+* by the caller.
+*
 * \param context
 * The pointer to the CSDIDAC middleware context
 * structure \ref cy_stc_csdidac_context_t.
 *
 *******************************************************************************/
 static void Cy_CSDIDAC_ConnectChannelB(
+                cy_stc_csdidac_route_batch_t * batch,
                 cy_stc_csdidac_context_t * context)
 {
     /* Closes the bypass B switch to feed an output current to AMuxBusB. */
@@ -899,10 +1431,8 @@ static void Cy_CSDIDAC_ConnectChannelB(
     /* Configures port pin, if it is enabled. */
     if (CY_CSDIDAC_GPIO == context->cfgCopy.configB)
     {
-        /* Update port configuration register (drive mode) to High-Z Analog */
-        Cy_GPIO_SetDrivemode(context->cfgCopy.ptrPinB->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinB->pin, CY_GPIO_DM_ANALOG);
-        /* Connect the selected port to AMuxBusB */
-        Cy_GPIO_SetHSIOM(context->cfgCopy.ptrPinB->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinB->pin, HSIOM_SEL_AMUXB);
+        /* Sets the drive mode to High-Z Analog and connects the selected port to AMuxBusB */
+        (void)Cy_CSDIDAC_RouteBatchAdd(context->cfgCopy.ptrPinB, CY_GPIO_DM_ANALOG, HSIOM_SEL_AMUXB, batch);
     }
 }
 
@@ -913,13 +1443,29 @@ static void Cy_CSDIDAC_ConnectChannelB(
 *
 * Disconnects the output channel A pin, if it is configured.
 *
+* Called by Cy_CSDIDAC_DisconnectChannels() inside its critical section and
+* sequence counter update.
+*
+* \param batch
+* The routing batch the pin changes are added to. The batch is applied
+* by the caller.
+*
 * \param context
 * The pointer to the CSDIDAC middleware context
 * structure \ref cy_stc_csdidac_context_t.
 *
 *******************************************************************************/
-static void Cy_CSDIDAC_DisconnectChannelA(cy_stc_csdidac_context_t * context)
+static void Cy_CSDIDAC_DisconnectChannelA(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context)
 {
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        if (CY_CSDIDAC_ENABLE == context->channelStateA)
+        {
+            context->stats.disableCntA++;
+        }
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+
     /* Disables the desired IDAC. */
     context->channelStateA = CY_CSDIDAC_DISABLE;
     Cy_CSD_WriteReg(context->cfgCopy.base, CY_CSD_REG_OFFSET_IDACA, 0uL);
@@ -931,7 +1477,7 @@ static void Cy_CSDIDAC_DisconnectChannelA(cy_stc_csdidac_context_t * context)
     /* Disconnects AMuxBusA from the selected pin, if it is configured. */
     if ((CY_CSDIDAC_GPIO == context->cfgCopy.configA) && (NULL != context->cfgCopy.ptrPinA))
     {
-        Cy_GPIO_SetHSIOM(context->cfgCopy.ptrPinA->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinA->pin, HSIOM_SEL_GPIO);
+        (void)Cy_CSDIDAC_RouteBatchAdd(context->cfgCopy.ptrPinA, CY_CSDIDAC_ROUTE_DM_KEEP, HSIOM_SEL_GPIO, batch);
     }
 }
 
@@ -942,13 +1488,29 @@ static void Cy_CSDIDAC_DisconnectChannelA(cy_stc_csdidac_context_t * context)
 *
 * Disconnects the output channel B pin, if it is configured.
 *
+* Called by Cy_CSDIDAC_DisconnectChannels() inside its critical section and
+* sequence counter update.
+*
+* \param batch
+* The routing batch the pin changes are added to. The batch is applied
+* by the caller.
+*
 * \param context
 * The pointer to the CSDIDAC middleware context
 * structure \ref cy_stc_csdidac_context_t.
 *
 *******************************************************************************/
-static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context)
+static void Cy_CSDIDAC_DisconnectChannelB(
+                cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context)
 {
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        if (CY_CSDIDAC_ENABLE == context->channelStateB)
+        {
+            context->stats.disableCntB++;
+        }
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+
     /* Disables the desired IDAC. */
     context->channelStateB = CY_CSDIDAC_DISABLE;
     Cy_CSD_WriteReg(context->cfgCopy.base, CY_CSD_REG_OFFSET_IDACB, 0uL);
@@ -960,8 +1522,56 @@ static void Cy_CSDIDAC_DisconnectChannelB(cy_stc_csdidac_context_t * context)
     /* Disconnects AMuxBusB from the selected pin, if it is configured. */
     if ((CY_CSDIDAC_GPIO == context->cfgCopy.configB) && (NULL != context->cfgCopy.ptrPinB))
     {
-        Cy_GPIO_SetHSIOM(context->cfgCopy.ptrPinB->ioPcPtr, (uint32_t)context->cfgCopy.ptrPinB->pin, HSIOM_SEL_GPIO);
+        (void)Cy_CSDIDAC_RouteBatchAdd(context->cfgCopy.ptrPinB, CY_CSDIDAC_ROUTE_DM_KEEP, HSIOM_SEL_GPIO, batch);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_DisconnectChannels
+****************************************************************************//**
+*
+* Disconnects the specified output channels.
+*
+* The channel states, the IDAC registers, the bypass switches and the pin
+* routing are all changed inside one critical section and one sequence
+* counter update, so Cy_CSDIDAC_ReadChannelState() never returns a disabled
+* channel that still outputs a current.
+*
+* \param api
+* The function the critical section is recorded for.
+*
+* \param ch
+* The channels to disconnect.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_DisconnectChannels(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_stc_csdidac_route_batch_t batch;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+    interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+    Cy_CSDIDAC_SeqWriteBegin(context);
+    if ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_AB == ch))
+    {
+        Cy_CSDIDAC_DisconnectChannelA(&batch, context);
+    }
+    if ((CY_CSDIDAC_B == ch) || (CY_CSDIDAC_AB == ch))
+    {
+        Cy_CSDIDAC_DisconnectChannelB(&batch, context);
     }
+    (void)Cy_CSDIDAC_RouteBatchApply(&batch, context);
+    Cy_CSDIDAC_SeqWriteEnd(context);
+    Cy_CSDIDAC_ExitCriticalSection(api, interruptState, csStartTime, context);
 }
 
 
@@ -994,24 +1604,941 @@ cy_en_csdidac_status_t Cy_CSDIDAC_OutputDisable(
                 cy_stc_csdidac_context_t * context)
 {
     cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
 
     if(NULL != context)
     {
-        if ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_AB == ch))
+        #if (0u != CY_CSDIDAC_CHARGE_EN)
+            Cy_CSDIDAC_ChargeCommit(CY_CSDIDAC_API_OUTPUT_DISABLE, context);
+        #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+
+        if ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch) || (CY_CSDIDAC_AB == ch))
         {
-            Cy_CSDIDAC_DisconnectChannelA(context);
+            Cy_CSDIDAC_DisconnectChannels(CY_CSDIDAC_API_OUTPUT_DISABLE, ch, context);
             retVal = CY_CSDIDAC_SUCCESS;
         }
-        if ((CY_CSDIDAC_B == ch) || (CY_CSDIDAC_AB == ch))
+    }
+
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        Cy_CSDIDAC_StatsRecord(CY_CSDIDAC_API_OUTPUT_DISABLE, retVal, context);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        Cy_CSDIDAC_ProfileRecord(CY_CSDIDAC_API_OUTPUT_DISABLE, profileStart);
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChannelOpen
+****************************************************************************//**
+*
+* Verifies a channel choice once and opens a validated channel handle.
+*
+* The handle is used by the Cy_CSDIDAC_ChannelEnable(),
+* Cy_CSDIDAC_ChannelSetCurrent(), and Cy_CSDIDAC_ChannelDisable() functions,
+* which skip the parameter verification of Cy_CSDIDAC_OutputEnableExt(),
+* Cy_CSDIDAC_OutputEnable(), and Cy_CSDIDAC_OutputDisable(). The other
+* parameters of these functions are verified by asserts only, so they are
+* expected to come from validated tables. The call and error statistics
+* and the function profiling do not cover the unchecked functions.
+* The handle is opened again after Cy_CSDIDAC_WriteConfig().
+*
+* \param ch
+* The channel choice, CY_CSDIDAC_A, CY_CSDIDAC_B, or CY_CSDIDAC_AB.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param channel
+* The pointer to the channel handle to be opened.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or the chosen channel
+*                           is disabled by the configuration.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ChannelOpen(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context,
+                cy_stc_csdidac_channel_t * channel)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != context) && (NULL != channel) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, context->cfgCopy.configA, context->cfgCopy.configB)) &&
+        ((CY_CSDIDAC_B == ch) || (CY_CSDIDAC_DISABLED != context->cfgCopy.configA)) &&
+        ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_DISABLED != context->cfgCopy.configB)))
+    {
+        channel->context = context;
+        channel->ch = ch;
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChannelEnable
+****************************************************************************//**
+*
+* Enables the channel of a validated handle with the specified polarity, LSB,
+* and IDAC code. The unchecked counterpart of Cy_CSDIDAC_OutputEnableExt().
+* The parameters are verified by asserts only.
+*
+* \param channel
+* The pointer to the channel handle opened by Cy_CSDIDAC_ChannelOpen().
+*
+* \param polarity
+* The polarity to be set.
+*
+* \param lsbIndex
+* The LSB to be set.
+*
+* \param idacCode
+* The code value in the range from 0u to \ref CY_CSDIDAC_MAX_CODE.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ChannelEnable(
+                const cy_stc_csdidac_channel_t * channel,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode)
+{
+    CY_ASSERT_L1(NULL != channel);
+    CY_ASSERT_L2(Cy_CSDIDAC_IsIdacPolarityValid(polarity));
+    CY_ASSERT_L2(Cy_CSDIDAC_IsIdacLsbValid(lsbIndex));
+    CY_ASSERT_L2(CY_CSDIDAC_MAX_CODE >= idacCode);
+
+    (void)Cy_CSDIDAC_WriteChannel(CY_CSDIDAC_API_OUTPUT_ENABLE_EXT, channel->ch, polarity, lsbIndex,
+                                  idacCode, channel->context);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChannelSetCurrent
+****************************************************************************//**
+*
+* Enables the channel of a validated handle with the specified current.
+* The unchecked counterpart of Cy_CSDIDAC_OutputEnable(). The current range
+* is verified by an assert only.
+*
+* \param channel
+* The pointer to the channel handle opened by Cy_CSDIDAC_ChannelOpen().
+*
+* \param current
+* A current value in nA with a sign, the absolute value is up to
+* \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ChannelSetCurrent(
+                const cy_stc_csdidac_channel_t * channel,
+                int32_t current)
+{
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+
+    CY_ASSERT_L1(NULL != channel);
+    CY_ASSERT_L2(((int32_t)CY_CSDIDAC_MAX_CURRENT_NA >= current) && (-(int32_t)CY_CSDIDAC_MAX_CURRENT_NA <= current));
+
+    Cy_CSDIDAC_ConvertCurrent(current, &polarity, &lsbIndex, &code);
+    (void)Cy_CSDIDAC_WriteChannel(CY_CSDIDAC_API_OUTPUT_ENABLE, channel->ch, polarity, lsbIndex,
+                                  code, channel->context);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChannelDisable
+****************************************************************************//**
+*
+* Disables the channel of a validated handle. The unchecked counterpart of
+* Cy_CSDIDAC_OutputDisable().
+*
+* \param channel
+* The pointer to the channel handle opened by Cy_CSDIDAC_ChannelOpen().
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ChannelDisable(
+                const cy_stc_csdidac_channel_t * channel)
+{
+    CY_ASSERT_L1(NULL != channel);
+
+    #if (0u != CY_CSDIDAC_CHARGE_EN)
+        Cy_CSDIDAC_ChargeCommit(CY_CSDIDAC_API_OUTPUT_DISABLE, channel->context);
+    #endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+    Cy_CSDIDAC_DisconnectChannels(CY_CSDIDAC_API_OUTPUT_DISABLE, channel->ch, channel->context);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetOutputCurrent
+****************************************************************************//**
+*
+* Returns the effective output current of the specified IDAC channel.
+*
+* The current is decoded from the polarity, LSB and code committed to the
+* context structure by the last Cy_CSDIDAC_OutputEnable() or
+* Cy_CSDIDAC_OutputEnableExt() call, read by Cy_CSDIDAC_ReadChannelState().
+* The decoding uses an LSB table and a single multiplication, no division
+* is performed. A disabled channel returns zero.
+*
+* \param ch
+* The channel to read back, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param currentPa
+* The pointer to the variable to store the output current in pA with a sign.
+* A positive value is a sourcing current, a negative value is a sinking current.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+* * CY_CSDIDAC_HW_BUSY    - The channel fields are being updated, see
+*                           Cy_CSDIDAC_ReadChannelState().
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_GetOutputCurrent(
+                cy_en_csdidac_choice_t ch,
+                int32_t * currentPa,
+                const cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_channel_state_t state;
+
+    if ((NULL != currentPa) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        retVal = Cy_CSDIDAC_ReadChannelState(&state, context);
+        if (CY_CSDIDAC_SUCCESS != retVal)
+        {
+            /* The current is not returned */
+        }
+        else if (CY_CSDIDAC_A == ch)
+        {
+            *currentPa = Cy_CSDIDAC_GetChannelCurrent(state.channelStateA, state.polarityA,
+                                                      state.lsbA, state.codeA);
+        }
+        else
+        {
+            *currentPa = Cy_CSDIDAC_GetChannelCurrent(state.channelStateB, state.polarityB,
+                                                      state.lsbB, state.codeB);
+        }
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ReadChannelState
+****************************************************************************//**
+*
+* Returns a consistent copy of the polarity, LSB, code, and state of both
+* the channels without a critical section.
+*
+* The writers of these fields increment the sequence counter of the context
+* before and after an update, see Cy_CSDIDAC_SeqWriteBegin(). The function
+* copies the fields between two reads of the counter and repeats the copy
+* if the counter is odd or has changed, so the copy never mixes the fields
+* of two updates, for instance the IdacA fields before and the IdacB fields
+* after a Cy_CSDIDAC_OutputEnableExt() call for CY_CSDIDAC_AB.
+* The function is intended for telemetry, logging, and health checks in
+* the thread mode or in interrupts, the interrupts are not masked.
+*
+* \param state
+* The pointer to the structure to store the copy of the channel fields.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+* * CY_CSDIDAC_HW_BUSY    - The fields are updated during each of
+*                           \ref CY_CSDIDAC_READ_RETRY_MAX attempts, the copy
+*                           is not consistent.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ReadChannelState(
+                cy_stc_csdidac_channel_state_t * state,
+                const cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t seq;
+    uint32_t retry;
+
+    if ((NULL != state) && (NULL != context))
+    {
+        retVal = CY_CSDIDAC_HW_BUSY;
+        for (retry = 0u; (retry < CY_CSDIDAC_READ_RETRY_MAX) && (CY_CSDIDAC_SUCCESS != retVal); retry++)
         {
-            Cy_CSDIDAC_DisconnectChannelB(context);
+            seq = context->seq;
+            /* The fields are read after the counter */
+            __DMB();
+            state->polarityA = context->polarityA;
+            state->lsbA = context->lsbA;
+            state->codeA = context->codeA;
+            state->channelStateA = context->channelStateA;
+            state->polarityB = context->polarityB;
+            state->lsbB = context->lsbB;
+            state->codeB = context->codeB;
+            state->channelStateB = context->channelStateB;
+            /* The counter is read again after the fields */
+            __DMB();
+            if ((0u == (seq & 1u)) && (seq == context->seq))
+            {
+                state->seq = seq;
+                retVal = CY_CSDIDAC_SUCCESS;
+            }
+        }
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetChannelCurrent
+****************************************************************************//**
+*
+* Decodes the output current of a channel in pA.
+*
+* \param state
+* The channel state.
+*
+* \param polarity
+* The channel polarity.
+*
+* \param lsbIndex
+* The channel LSB.
+*
+* \param code
+* The channel code.
+*
+* \return
+* The output current in pA with a sign.
+*
+*******************************************************************************/
+static int32_t Cy_CSDIDAC_GetChannelCurrent(
+                cy_en_csdidac_state_t state,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint8_t code)
+{
+    int32_t currentPa = 0;
+
+    if ((CY_CSDIDAC_ENABLE == state) && (true == Cy_CSDIDAC_IsIdacLsbValid(lsbIndex)))
+    {
+        currentPa = (int32_t)(cy_csdidac_lsbPa[lsbIndex] * (uint32_t)code);
+        if (CY_CSDIDAC_SINK == polarity)
+        {
+            currentPa = -currentPa;
+        }
+    }
+
+    return (currentPa);
+}
+
+
+#if (0u != CY_CSDIDAC_CHARGE_EN)
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChargeInit
+****************************************************************************//**
+*
+* Starts the delivered charge accounting.
+*
+* Resets the charge accumulators of both channels and sets the timestamp
+* function. After this call, every IDAC register commit integrates the output
+* current that was active since the previous commit. The function is called
+* after Cy_CSDIDAC_Init().
+*
+* \param timestampFunc
+* The timestamp function. The charge is accumulated in
+* pA * (timestamp ticks), i.e. with a 1 MHz timestamp the unit is 1e-18 C.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ChargeInit(
+                cy_csdidac_timestamp_t timestampFunc,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if ((NULL != context) && (NULL != timestampFunc))
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        context->timestampFunc = timestampFunc;
+        context->commitTime = timestampFunc();
+        context->chargeA = 0;
+        context->chargeB = 0;
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_CHARGE, interruptState, csStartTime, context);
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetCharge
+****************************************************************************//**
+*
+* Returns the charge delivered by the specified IDAC channel since
+* the Cy_CSDIDAC_ChargeInit() call.
+*
+* The charge of the currently active output is integrated up to the moment
+* of the call. A sourced charge is positive, a sunk charge is negative.
+*
+* \param ch
+* The channel to read, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param charge
+* The pointer to the variable to store the charge in pA * (timestamp ticks).
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL, an invalid parameter
+*                           is passed or the charge accounting is not started.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_GetCharge(
+                cy_en_csdidac_choice_t ch,
+                int64_t * charge,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if ((NULL != context) && (NULL != charge) &&
+        ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        if (NULL != context->timestampFunc)
+        {
+            Cy_CSDIDAC_ChargeAccumulate(context);
+            *charge = (CY_CSDIDAC_A == ch) ? context->chargeA : context->chargeB;
             retVal = CY_CSDIDAC_SUCCESS;
         }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_CHARGE, interruptState, csStartTime, context);
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChargeAccumulate
+****************************************************************************//**
+*
+* Integrates the output current of both channels over the time elapsed since
+* the previous commit. The function is called in a critical section before
+* the IDAC registers are changed.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_ChargeAccumulate(cy_stc_csdidac_context_t * context)
+{
+    uint32_t now;
+    uint32_t elapsed;
+
+    if (NULL != context->timestampFunc)
+    {
+        now = context->timestampFunc();
+        elapsed = now - context->commitTime;
+        context->commitTime = now;
+        context->chargeA += (int64_t)Cy_CSDIDAC_GetChannelCurrent(context->channelStateA, context->polarityA,
+                                                                  context->lsbA, context->codeA) * (int64_t)elapsed;
+        context->chargeB += (int64_t)Cy_CSDIDAC_GetChannelCurrent(context->channelStateB, context->polarityB,
+                                                                  context->lsbB, context->codeB) * (int64_t)elapsed;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ChargeCommit
+****************************************************************************//**
+*
+* Integrates the output current of both channels in a critical section.
+* The function is called before the outputs are disconnected.
+*
+* \param api
+* The function that owns the critical section.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_ChargeCommit(cy_en_csdidac_api_t api, cy_stc_csdidac_context_t * context)
+{
+    uint32_t csStartTime;
+    uint32_t interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+
+    Cy_CSDIDAC_ChargeAccumulate(context);
+    Cy_CSDIDAC_ExitCriticalSection(api, interruptState, csStartTime, context);
+}
+#endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+
+
+#if (0u != CY_CSDIDAC_PROFILE_EN)
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetProfile
+****************************************************************************//**
+*
+* Returns the execution time statistics of the specified CSDIDAC function.
+*
+* The statistics are collected since the device reset or since the last
+* Cy_CSDIDAC_ResetProfile() call. The functions from
+* \ref CY_CSDIDAC_API_INIT to \ref CY_CSDIDAC_API_RECONFIGURE are profiled.
+* Cy_CSDIDAC_OutputEnable() and Cy_CSDIDAC_OutputEnableExt() write the
+* channel through the same internal function and are recorded separately,
+* each call for its own identifier only.
+*
+* The unchecked channel handle functions, Cy_CSDIDAC_ChannelEnable(),
+* Cy_CSDIDAC_ChannelSetCurrent(), and Cy_CSDIDAC_ChannelDisable(), are not
+* profiled, so the fast path has no timing overhead. The identifiers from
+* \ref CY_CSDIDAC_API_SYNC_IDAC_WORD on have the critical section statistics
+* only, and their profiling records stay zero.
+*
+* \param api
+* The function identifier.
+*
+* \param profile
+* The pointer to the structure to store the statistics.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_GetProfile(
+                cy_en_csdidac_api_t api,
+                cy_stc_csdidac_profile_t * profile)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+
+    if ((NULL != profile) && (CY_CSDIDAC_API_NUM > api))
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        *profile = cy_csdidac_profile[api];
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ResetProfile
+****************************************************************************//**
+*
+* Clears the execution time statistics of all CSDIDAC functions.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ResetProfile(void)
+{
+    uint32_t interruptState;
+    uint32_t api;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    for (api = 0u; api < (uint32_t)CY_CSDIDAC_API_NUM; api++)
+    {
+        cy_csdidac_profile[api].calls = 0u;
+        cy_csdidac_profile[api].minTime = 0u;
+        cy_csdidac_profile[api].maxTime = 0u;
+        cy_csdidac_profile[api].totalTime = 0u;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ProfileRecord
+****************************************************************************//**
+*
+* Updates the profiling record of the specified function.
+*
+* \param api
+* The function identifier.
+*
+* \param startTime
+* The time counter value captured at the function entry.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_ProfileRecord(cy_en_csdidac_api_t api, uint32_t startTime)
+{
+    uint32_t interruptState;
+    uint32_t elapsed = (Cy_CSDIDAC_GetProfileTime() - startTime) & CY_CSDIDAC_PROFILE_TIME_MASK;
+    cy_stc_csdidac_profile_t * record = &cy_csdidac_profile[api];
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if ((0u == record->calls) || (elapsed < record->minTime))
+    {
+        record->minTime = elapsed;
+    }
+    if (elapsed > record->maxTime)
+    {
+        record->maxTime = elapsed;
+    }
+    record->totalTime += elapsed;
+    record->calls++;
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+#endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+
+#if ((0u != CY_CSDIDAC_PROFILE_EN) || (0u != CY_CSDIDAC_CS_STATS_EN))
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetProfileTime
+****************************************************************************//**
+*
+* Returns the profiling time counter.
+*
+* The default implementation returns the SysTick counter converted to
+* an up-counter, so the application enables SysTick with the maximum reload
+* value and the CPU clock source to get the execution time in CPU cycles.
+* The function is weak and can be redefined by the application to use
+* another time source. In this case, \ref CY_CSDIDAC_PROFILE_TIME_MASK is
+* defined according to the counter width.
+*
+* \return
+* The current value of the time counter.
+*
+*******************************************************************************/
+__WEAK uint32_t Cy_CSDIDAC_GetProfileTime(void)
+{
+    return ((~SysTick->VAL) & CY_CSDIDAC_PROFILE_TIME_MASK);
+}
+#endif /* ((0u != CY_CSDIDAC_PROFILE_EN) || (0u != CY_CSDIDAC_CS_STATS_EN)) */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_EnterCriticalSection
+****************************************************************************//**
+*
+* Enters a middleware critical section.
+*
+* The middleware and its modules enter all the critical sections that
+* change the channels or the CSD HW block through this function and
+* Cy_CSDIDAC_ExitCriticalSection(), so the instrumentation covers them.
+* If \ref CY_CSDIDAC_CS_STATS_EN is enabled, captures the critical section
+* start time.
+*
+* \param startTime
+* The pointer to the variable to store the critical section start time.
+*
+* \return
+* The interrupt state to be passed to Cy_CSDIDAC_ExitCriticalSection().
+*
+*******************************************************************************/
+uint32_t Cy_CSDIDAC_EnterCriticalSection(uint32_t * startTime)
+{
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+
+    #if (0u != CY_CSDIDAC_CS_STATS_EN)
+        *startTime = Cy_CSDIDAC_GetProfileTime();
+    #else
+        *startTime = 0u;
+    #endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+
+    return (interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ExitCriticalSection
+****************************************************************************//**
+*
+* Exits a middleware critical section.
+*
+* If \ref CY_CSDIDAC_CS_STATS_EN is enabled, adds the critical section
+* duration to the statistics of the specified function. The statistics
+* are updated before the interrupts are restored, so they are consistent
+* for any reader.
+*
+* \param api
+* The function that owns the critical section.
+*
+* \param interruptState
+* The interrupt state returned by Cy_CSDIDAC_EnterCriticalSection().
+*
+* \param startTime
+* The critical section start time.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ExitCriticalSection(
+                cy_en_csdidac_api_t api,
+                uint32_t interruptState,
+                uint32_t startTime,
+                cy_stc_csdidac_context_t * context)
+{
+    #if (0u != CY_CSDIDAC_CS_STATS_EN)
+        uint32_t elapsed = (Cy_CSDIDAC_GetProfileTime() - startTime) & CY_CSDIDAC_PROFILE_TIME_MASK;
+        uint32_t bin = elapsed >> CY_CSDIDAC_CS_HIST_SHIFT;
+        cy_stc_csdidac_cs_stats_t * stats = &context->csStats[api];
+
+        if (bin >= CY_CSDIDAC_CS_HIST_BINS)
+        {
+            bin = CY_CSDIDAC_CS_HIST_BINS - 1u;
+        }
+        if (UINT16_MAX > stats->hist[bin])
+        {
+            stats->hist[bin]++;
+        }
+        if (elapsed > stats->maxTime)
+        {
+            stats->maxTime = elapsed;
+        }
+        stats->totalTime += elapsed;
+        stats->count++;
+    #else
+        (void)api;
+        (void)startTime;
+        (void)context;
+    #endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+
+#if (0u != CY_CSDIDAC_CS_STATS_EN)
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetCsStats
+****************************************************************************//**
+*
+* Returns the critical section statistics of the specified CSDIDAC function.
+*
+* The statistics show how long the middleware keeps the interrupts disabled,
+* i.e. the worst-case interrupt latency added by the function. The mean
+* duration is totalTime divided by count.
+*
+* \param api
+* The function identifier.
+*
+* \param stats
+* The pointer to the structure to store the statistics.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_GetCsStats(
+                cy_en_csdidac_api_t api,
+                cy_stc_csdidac_cs_stats_t * stats,
+                const cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+
+    if ((NULL != context) && (NULL != stats) && (CY_CSDIDAC_API_NUM > api))
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        *stats = context->csStats[api];
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        retVal = CY_CSDIDAC_SUCCESS;
     }
 
     return (retVal);
 }
 
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ResetCsStats
+****************************************************************************//**
+*
+* Clears the critical section statistics of all CSDIDAC functions.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ResetCsStats(
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t api;
+    uint32_t bin;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        for (api = 0u; api < (uint32_t)CY_CSDIDAC_API_NUM; api++)
+        {
+            context->csStats[api].count = 0u;
+            context->csStats[api].maxTime = 0u;
+            context->csStats[api].totalTime = 0u;
+            for (bin = 0u; bin < CY_CSDIDAC_CS_HIST_BINS; bin++)
+            {
+                context->csStats[api].hist[bin] = 0u;
+            }
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+#endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+
+
+#if (0u != CY_CSDIDAC_STATS_EN)
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SnapshotStats
+****************************************************************************//**
+*
+* Copies the call and error statistics and clears them.
+*
+* The copy and the clear are performed in one critical section, so no event
+* is lost or counted twice. The function can be called from any execution
+* context, including interrupt handlers.
+*
+* \param stats
+* The pointer to the structure to store the statistics. If NULL is passed,
+* the statistics are only cleared.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The context pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SnapshotStats(
+                cy_stc_csdidac_stats_t * stats,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t retVal = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t api;
+    uint32_t err;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        if (NULL != stats)
+        {
+            *stats = context->stats;
+        }
+        for (api = 0u; api < (uint32_t)CY_CSDIDAC_API_NUM; api++)
+        {
+            context->stats.calls[api] = 0u;
+            for (err = 0u; err < CY_CSDIDAC_STATUS_ERR_NUM; err++)
+            {
+                context->stats.failures[api][err] = 0u;
+            }
+        }
+        context->stats.enableCntA = 0u;
+        context->stats.disableCntA = 0u;
+        context->stats.enableCntB = 0u;
+        context->stats.disableCntB = 0u;
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        retVal = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (retVal);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StatsRecord
+****************************************************************************//**
+*
+* Counts a function call and its failure.
+*
+* \param api
+* The function identifier.
+*
+* \param status
+* The status returned by the function.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_StatsRecord(
+                cy_en_csdidac_api_t api,
+                cy_en_csdidac_status_t status,
+                cy_stc_csdidac_context_t * context)
+{
+    uint32_t interruptState;
+    uint32_t err;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        context->stats.calls[api]++;
+        if (CY_CSDIDAC_SUCCESS != status)
+        {
+            err = CY_CSDIDAC_STATUS_ERR_IDX(status);
+            if ((CY_CSDIDAC_STATUS_ERR_NUM > err) && (UINT16_MAX > context->stats.failures[api][err]))
+            {
+                context->stats.failures[api][err]++;
+            }
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+
 #endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
 
 
@@ -58,6 +58,151 @@ extern "C" {
 */
 #define CY_CSDIDAC_MAX_CURRENT_NA               (609600uL)
 
+/** The position of the polarity field of the IDAC register word. */
+#define CY_CSDIDAC_POLARITY_POS                 (8uL)
+
+/** The polarity field mask of the IDAC register word. */
+#define CY_CSDIDAC_POLARITY_MASK                (3uL << CY_CSDIDAC_POLARITY_POS)
+
+/** The position of the range field of the IDAC register word, the LSB index divided by 2. */
+#define CY_CSDIDAC_LSB_POS                      (22uL)
+
+/** The range field mask of the IDAC register word. */
+#define CY_CSDIDAC_LSB_MASK                     (3uL << CY_CSDIDAC_LSB_POS)
+
+/** The position of the IDAC leg1 enabling bit of the IDAC register word. */
+#define CY_CSDIDAC_LEG1_EN_POS                  (24uL)
+
+/** The IDAC leg1 enabling bit mask of the IDAC register word, always set. */
+#define CY_CSDIDAC_LEG1_EN_MASK                 (1uL << CY_CSDIDAC_LEG1_EN_POS)
+
+/** The position of the IDAC leg2 enabling bit of the IDAC register word, the odd LSB indexes. */
+#define CY_CSDIDAC_LEG2_EN_POS                  (25uL)
+
+/** The IDAC leg2 enabling bit mask of the IDAC register word. */
+#define CY_CSDIDAC_LEG2_EN_MASK                 (1uL << CY_CSDIDAC_LEG2_EN_POS)
+
+/**
+* Builds the IDAC register word from the polarity, LSB index, and code.
+* The word is the value the Cy_CSDIDAC_OutputEnableExt() function writes
+* to the IDAC register, so it can be precomputed, even at compile time,
+* and written with the fast path, see Cy_CSDIDAC_GetIdacReg().
+*/
+#define CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, code)  \
+                                                ((uint32_t)(code) | \
+                                                 ((uint32_t)(polarity) << CY_CSDIDAC_POLARITY_POS) | \
+                                                 (((uint32_t)(lsbIndex) >> 1u) << CY_CSDIDAC_LSB_POS) | \
+                                                 CY_CSDIDAC_LEG1_EN_MASK | \
+                                                 (((uint32_t)(lsbIndex) & 1u) << CY_CSDIDAC_LEG2_EN_POS))
+
+/** The code field mask of the IDAC register word. */
+#define CY_CSDIDAC_IDAC_WORD_CODE_MASK          (0x7Fu)
+
+/** Extracts the \ref cy_en_csdidac_polarity_t value of the IDAC register word. */
+#define CY_CSDIDAC_IDAC_WORD_POLARITY(word)     (((uint32_t)(word) & CY_CSDIDAC_POLARITY_MASK) >> CY_CSDIDAC_POLARITY_POS)
+
+/** Extracts the \ref cy_en_csdidac_lsb_t index of the IDAC register word. */
+#define CY_CSDIDAC_IDAC_WORD_LSB(word)          ((((uint32_t)(word) & CY_CSDIDAC_LSB_MASK) >> (CY_CSDIDAC_LSB_POS - 1u)) | \
+                                                 (((uint32_t)(word) & CY_CSDIDAC_LEG2_EN_MASK) >> CY_CSDIDAC_LEG2_EN_POS))
+
+/** The IdacA bypass switch of the CSD SW_BYP_SEL register, closed while IdacA is connected. */
+#define CY_CSDIDAC_SW_BYPA_ENABLE               (0x00001000uL)
+
+/** The IdacB bypass switch of the CSD SW_BYP_SEL register, closed while IdacB is connected. */
+#define CY_CSDIDAC_SW_BYPB_ENABLE               (0x00010000uL)
+
+/** The LSB size in pA of the \ref cy_en_csdidac_lsb_t index: 37500 pA multiplied by 1, 2, 8, 16, 64, or 128. */
+#define CY_CSDIDAC_LSB_PA(lsbIndex)             (37500uL << ((((uint32_t)(lsbIndex) >> 1u) * 3u) + ((uint32_t)(lsbIndex) & 1u)))
+
+#if !defined(CY_CSDIDAC_CHARGE_EN)
+/**
+* Enables the delivered charge accounting. When set to 1u, every IDAC register
+* commit integrates the previous output current of both channels over the
+* time elapsed since the previous commit.
+* See Cy_CSDIDAC_ChargeInit() and Cy_CSDIDAC_GetCharge().
+*/
+#define CY_CSDIDAC_CHARGE_EN                    (0u)
+#endif
+
+#if !defined(CY_CSDIDAC_PROFILE_EN)
+/**
+* Enables the execution time profiling of the public CSDIDAC functions.
+* When set to 1u, every call is timed with Cy_CSDIDAC_GetProfileTime() and
+* the statistics are available through Cy_CSDIDAC_GetProfile(), which lists
+* the profiled functions.
+*/
+#define CY_CSDIDAC_PROFILE_EN                   (0u)
+#endif
+
+#if !defined(CY_CSDIDAC_STATS_EN)
+/**
+* Enables the call and error statistics. When set to 1u, the middleware
+* counts the calls and failures of every public function and the output
+* enable/disable transitions of every channel in the context structure.
+* See Cy_CSDIDAC_SnapshotStats().
+*/
+#define CY_CSDIDAC_STATS_EN                     (0u)
+#endif
+
+/**
+* The number of the CSDIDAC error statuses. The failures of the functions
+* are counted per error status in the \ref cy_stc_csdidac_stats_t structure.
+*/
+#define CY_CSDIDAC_STATUS_ERR_NUM               (5u)
+
+/**
+* Converts the CSDIDAC error status (CY_CSDIDAC_BAD_PARAM ..
+* CY_CSDIDAC_BAD_CONFIGURATION) to the index of the failures counter.
+*/
+#define CY_CSDIDAC_STATUS_ERR_IDX(status)       ((((uint32_t)(status)) & 0xFFuL) - 1uL)
+
+#if !defined(CY_CSDIDAC_CS_STATS_EN)
+/**
+* Enables the critical section instrumentation. When set to 1u, the duration
+* of every critical section of the middleware and its modules is measured
+* with Cy_CSDIDAC_GetProfileTime() and the per-function statistics are
+* stored in the context structure. See Cy_CSDIDAC_GetCsStats() and
+* Cy_CSDIDAC_EnterCriticalSection().
+*
+* Two kinds of the critical sections are not measured: the short ones that
+* read or clear the profiling and statistics records themselves, as the
+* profiling records are not bound to a context structure, and the sleep
+* entry of Cy_CSDIDAC_PulseSleep(), where the interrupts are masked only to
+* make the check and the sleep atomic and a pending interrupt ends the sleep.
+*/
+#define CY_CSDIDAC_CS_STATS_EN                  (0u)
+#endif
+
+#if !defined(CY_CSDIDAC_CS_HIST_BINS)
+/** The number of the critical section duration histogram bins. */
+#define CY_CSDIDAC_CS_HIST_BINS                 (8u)
+#endif
+
+#if !defined(CY_CSDIDAC_CS_HIST_SHIFT)
+/**
+* The critical section duration histogram bin width is
+* 2^CY_CSDIDAC_CS_HIST_SHIFT time ticks. The last bin counts all
+* the longer critical sections.
+*/
+#define CY_CSDIDAC_CS_HIST_SHIFT                (4u)
+#endif
+
+#if !defined(CY_CSDIDAC_PROFILE_TIME_MASK)
+/**
+* The valid bits of the Cy_CSDIDAC_GetProfileTime() counter. The default
+* value corresponds to the 24-bit SysTick counter.
+*/
+#define CY_CSDIDAC_PROFILE_TIME_MASK            (0x00FFFFFFuL)
+#endif
+
+#if !defined(CY_CSDIDAC_READ_RETRY_MAX)
+/**
+* The maximum number of the read attempts of Cy_CSDIDAC_ReadChannelState().
+* A read is repeated when the channel fields are updated during the read.
+*/
+#define CY_CSDIDAC_READ_RETRY_MAX               (4u)
+#endif
+
 /** \} group_csdidac_macros */
 
 /***************************************
@@ -186,6 +331,38 @@ typedef enum
     CY_CSDIDAC_JOIN       = 3u,             /**< The IDAC channel is enabled and routed to the other IDAC channel. */
 }cy_en_csdidac_channel_config_t;
 
+/**
+* The CSDIDAC public function identifiers. Used to address the per-function
+* profiling records and statistics. The identifiers from
+* \ref CY_CSDIDAC_API_SYNC_IDAC_WORD on address the critical section
+* statistics of the functions and modules that are not profiled.
+*/
+typedef enum
+{
+    CY_CSDIDAC_API_INIT               = 0u, /**< Cy_CSDIDAC_Init() */
+    CY_CSDIDAC_API_DEINIT             = 1u, /**< Cy_CSDIDAC_DeInit() */
+    CY_CSDIDAC_API_WRITE_CONFIG       = 2u, /**< Cy_CSDIDAC_WriteConfig() */
+    CY_CSDIDAC_API_SAVE               = 3u, /**< Cy_CSDIDAC_Save() */
+    CY_CSDIDAC_API_RESTORE            = 4u, /**< Cy_CSDIDAC_Restore() */
+    CY_CSDIDAC_API_OUTPUT_ENABLE      = 5u, /**< Cy_CSDIDAC_OutputEnable() */
+    CY_CSDIDAC_API_OUTPUT_ENABLE_EXT  = 6u, /**< Cy_CSDIDAC_OutputEnableExt() */
+    CY_CSDIDAC_API_OUTPUT_DISABLE     = 7u, /**< Cy_CSDIDAC_OutputDisable() */
+    CY_CSDIDAC_API_RECONFIGURE        = 8u, /**< Cy_CSDIDAC_ReconfigureChannel() */
+    CY_CSDIDAC_API_SYNC_IDAC_WORD     = 9u, /**< Cy_CSDIDAC_SyncIdacWord() */
+    CY_CSDIDAC_API_CHARGE             = 10u, /**< Cy_CSDIDAC_ChargeInit() and Cy_CSDIDAC_GetCharge() */
+    CY_CSDIDAC_API_ROUTE              = 11u, /**< Cy_CSDIDAC_RouteBatchApply() */
+    CY_CSDIDAC_API_MGR                = 12u, /**< The multi-instance manager functions */
+    CY_CSDIDAC_API_SEQ                = 13u, /**< The sequencer functions */
+    CY_CSDIDAC_API_DITHER             = 14u, /**< The dithered output functions */
+    CY_CSDIDAC_API_HEALTH             = 15u, /**< The health checker functions */
+    CY_CSDIDAC_API_IDLE               = 16u, /**< The idle gating functions */
+    CY_CSDIDAC_API_PULSE              = 17u, /**< The pulsed-current functions */
+    CY_CSDIDAC_API_SCAN               = 18u, /**< The pin scanning functions */
+    CY_CSDIDAC_API_TRIG               = 19u, /**< The trigger functions */
+    CY_CSDIDAC_API_BIPOLAR            = 20u, /**< The bipolar output functions */
+    CY_CSDIDAC_API_NUM                = 21u, /**< The number of the public function identifiers */
+}cy_en_csdidac_api_t;
+
 /** \} group_csdidac_enums */
 
 
@@ -197,6 +374,57 @@ typedef enum
 * \{
 */
 
+#if (0u != CY_CSDIDAC_CHARGE_EN)
+/**
+* The timestamp function used by the charge accounting. Returns a free-running
+* 32-bit time counter. The counter wraparound is handled by the middleware.
+*/
+typedef uint32_t (* cy_csdidac_timestamp_t)(void);
+#endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+
+#if (0u != CY_CSDIDAC_PROFILE_EN)
+/** The CSDIDAC function profiling record. The time unit is a Cy_CSDIDAC_GetProfileTime() tick. */
+typedef struct
+{
+    uint32_t calls;                         /**< The number of the function calls. */
+    uint32_t minTime;                       /**< The minimum execution time. */
+    uint32_t maxTime;                       /**< The maximum execution time. */
+    uint32_t totalTime;                     /**< The total execution time of all calls. */
+} cy_stc_csdidac_profile_t;
+#endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+#if (0u != CY_CSDIDAC_STATS_EN)
+/** The CSDIDAC call and error statistics. */
+typedef struct
+{
+    uint32_t calls[CY_CSDIDAC_API_NUM];     /**< The number of calls per function. */
+    uint16_t failures[CY_CSDIDAC_API_NUM][CY_CSDIDAC_STATUS_ERR_NUM];
+                                            /**<
+                                             * The number of failed calls per function and error
+                                             * status, indexed with CY_CSDIDAC_STATUS_ERR_IDX().
+                                             * The counters saturate.
+                                             */
+    uint32_t enableCntA;                    /**< The number of the IdacA disabled to enabled transitions. */
+    uint32_t disableCntA;                   /**< The number of the IdacA enabled to disabled transitions. */
+    uint32_t enableCntB;                    /**< The number of the IdacB disabled to enabled transitions. */
+    uint32_t disableCntB;                   /**< The number of the IdacB enabled to disabled transitions. */
+} cy_stc_csdidac_stats_t;
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+
+#if (0u != CY_CSDIDAC_CS_STATS_EN)
+/**
+* The CSDIDAC critical section statistics of a function. The time unit is
+* a Cy_CSDIDAC_GetProfileTime() tick.
+*/
+typedef struct
+{
+    uint32_t count;                         /**< The number of the critical sections. */
+    uint32_t maxTime;                       /**< The longest critical section. */
+    uint32_t totalTime;                     /**< The total time spent in the critical sections. */
+    uint16_t hist[CY_CSDIDAC_CS_HIST_BINS]; /**< The duration histogram, the counters saturate. */
+} cy_stc_csdidac_cs_stats_t;
+#endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+
 /** The CSDIDAC pin structure. */
 typedef struct {
     GPIO_PRT_Type * ioPcPtr;                /**< The pointer to the channel IO PC register. */
@@ -227,8 +455,49 @@ typedef struct{
     cy_en_csdidac_lsb_t lsbB;               /**< The current IdacB LSB. */
     uint8_t codeB;                          /**< The current IdacB code. */
     cy_en_csdidac_state_t channelStateB;    /**< The IDAC channel B is enabled. */
+    volatile uint32_t seq;                  /**< The update sequence counter of the channel fields, odd during an update. */
+#if (0u != CY_CSDIDAC_CHARGE_EN)
+    cy_csdidac_timestamp_t timestampFunc;   /**< The charge accounting timestamp function. */
+    uint32_t commitTime;                    /**< The timestamp of the last IDAC register commit. */
+    int64_t chargeA;                        /**< The charge delivered by IdacA in pA * timestamp ticks. */
+    int64_t chargeB;                        /**< The charge delivered by IdacB in pA * timestamp ticks. */
+#endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+#if (0u != CY_CSDIDAC_STATS_EN)
+    cy_stc_csdidac_stats_t stats;           /**< The call and error statistics. */
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+#if (0u != CY_CSDIDAC_CS_STATS_EN)
+    cy_stc_csdidac_cs_stats_t csStats[CY_CSDIDAC_API_NUM]; /**< The critical section statistics per function. */
+#endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
 }cy_stc_csdidac_context_t;
 
+/**
+* The consistent copy of the channel fields of the context structure,
+* returned by Cy_CSDIDAC_ReadChannelState().
+*/
+typedef struct
+{
+    cy_en_csdidac_polarity_t polarityA;     /**< The IdacA polarity. */
+    cy_en_csdidac_lsb_t lsbA;               /**< The IdacA LSB. */
+    uint8_t codeA;                          /**< The IdacA code. */
+    cy_en_csdidac_state_t channelStateA;    /**< The IDAC channel A is enabled. */
+    cy_en_csdidac_polarity_t polarityB;     /**< The IdacB polarity. */
+    cy_en_csdidac_lsb_t lsbB;               /**< The IdacB LSB. */
+    uint8_t codeB;                          /**< The IdacB code. */
+    cy_en_csdidac_state_t channelStateB;    /**< The IDAC channel B is enabled. */
+    uint32_t seq;                           /**< The update sequence counter value of the copy. */
+} cy_stc_csdidac_channel_state_t;
+
+/**
+* The CSDIDAC validated channel handle. The handle is opened by
+* Cy_CSDIDAC_ChannelOpen(), which verifies the channel once, and is used
+* by the unchecked Cy_CSDIDAC_Channel functions.
+*/
+typedef struct
+{
+    cy_stc_csdidac_context_t * context;     /**< The pointer to the CSDIDAC middleware context. */
+    cy_en_csdidac_choice_t ch;              /**< The validated channel choice. */
+} cy_stc_csdidac_channel_t;
+
 /** \} group_csdidac_data_structures */
 
 
@@ -248,6 +517,11 @@ cy_en_csdidac_status_t Cy_CSDIDAC_DeInit(
 cy_en_csdidac_status_t Cy_CSDIDAC_WriteConfig(
                 const cy_stc_csdidac_config_t * config,
                 cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ReconfigureChannel(
+                cy_en_csdidac_choice_t ch,
+                cy_en_csdidac_channel_config_t channelConfig,
+                const cy_stc_csdidac_pin_t * ptrPin,
+                cy_stc_csdidac_context_t * context);
 cy_en_csdidac_status_t Cy_CSDIDAC_Wakeup(
                 const cy_stc_csdidac_context_t * context);
 cy_en_syspm_status_t Cy_CSDIDAC_DeepSleepCallback(
@@ -270,10 +544,120 @@ cy_en_csdidac_status_t Cy_CSDIDAC_OutputEnableExt(
 cy_en_csdidac_status_t Cy_CSDIDAC_OutputDisable(
                 cy_en_csdidac_choice_t ch,
                 cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_CurrentToCode(
+                int32_t current,
+                cy_en_csdidac_polarity_t * polarity,
+                cy_en_csdidac_lsb_t * lsbIndex,
+                uint32_t * code);
+cy_en_csdidac_status_t Cy_CSDIDAC_SyncIdacWord(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ChannelOpen(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * context,
+                cy_stc_csdidac_channel_t * channel);
+void Cy_CSDIDAC_ChannelEnable(
+                const cy_stc_csdidac_channel_t * channel,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode);
+void Cy_CSDIDAC_ChannelSetCurrent(
+                const cy_stc_csdidac_channel_t * channel,
+                int32_t current);
+void Cy_CSDIDAC_ChannelDisable(
+                const cy_stc_csdidac_channel_t * channel);
+cy_en_csdidac_status_t Cy_CSDIDAC_GetOutputCurrent(
+                cy_en_csdidac_choice_t ch,
+                int32_t * currentPa,
+                const cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ReadChannelState(
+                cy_stc_csdidac_channel_state_t * state,
+                const cy_stc_csdidac_context_t * context);
+#if (0u != CY_CSDIDAC_CHARGE_EN)
+cy_en_csdidac_status_t Cy_CSDIDAC_ChargeInit(
+                cy_csdidac_timestamp_t timestampFunc,
+                cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_GetCharge(
+                cy_en_csdidac_choice_t ch,
+                int64_t * charge,
+                cy_stc_csdidac_context_t * context);
+#endif /* (0u != CY_CSDIDAC_CHARGE_EN) */
+#if (0u != CY_CSDIDAC_PROFILE_EN)
+cy_en_csdidac_status_t Cy_CSDIDAC_GetProfile(
+                cy_en_csdidac_api_t api,
+                cy_stc_csdidac_profile_t * profile);
+void Cy_CSDIDAC_ResetProfile(void);
+#endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+#if (0u != CY_CSDIDAC_STATS_EN)
+cy_en_csdidac_status_t Cy_CSDIDAC_SnapshotStats(
+                cy_stc_csdidac_stats_t * stats,
+                cy_stc_csdidac_context_t * context);
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+#if (0u != CY_CSDIDAC_CS_STATS_EN)
+cy_en_csdidac_status_t Cy_CSDIDAC_GetCsStats(
+                cy_en_csdidac_api_t api,
+                cy_stc_csdidac_cs_stats_t * stats,
+                const cy_stc_csdidac_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ResetCsStats(
+                cy_stc_csdidac_context_t * context);
+#endif /* (0u != CY_CSDIDAC_CS_STATS_EN) */
+#if ((0u != CY_CSDIDAC_PROFILE_EN) || (0u != CY_CSDIDAC_CS_STATS_EN))
+uint32_t Cy_CSDIDAC_GetProfileTime(void);
+#endif /* ((0u != CY_CSDIDAC_PROFILE_EN) || (0u != CY_CSDIDAC_CS_STATS_EN)) */
+uint32_t Cy_CSDIDAC_EnterCriticalSection(uint32_t * startTime);
+void Cy_CSDIDAC_ExitCriticalSection(
+                cy_en_csdidac_api_t api,
+                uint32_t interruptState,
+                uint32_t startTime,
+                cy_stc_csdidac_context_t * context);
 
 /** \} group_csdidac_functions */
 
 
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqWriteBegin
+****************************************************************************//**
+*
+* Starts an update of the channel fields of the context structure. The
+* sequence counter is odd until Cy_CSDIDAC_SeqWriteEnd(), so
+* Cy_CSDIDAC_ReadChannelState() does not return a partially updated copy.
+*
+* The updates are done in a critical section, so the writers do not nest
+* and a reader in an interrupt never finds an update in progress.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+__STATIC_INLINE void Cy_CSDIDAC_SeqWriteBegin(cy_stc_csdidac_context_t * context)
+{
+    context->seq++;
+    /* The odd counter is stored before the fields */
+    __DMB();
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqWriteEnd
+****************************************************************************//**
+*
+* Completes an update of the channel fields started by
+* Cy_CSDIDAC_SeqWriteBegin().
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+*******************************************************************************/
+__STATIC_INLINE void Cy_CSDIDAC_SeqWriteEnd(cy_stc_csdidac_context_t * context)
+{
+    /* The fields are stored before the even counter */
+    __DMB();
+    context->seq++;
+}
+
+
 /*******************************************************************************
 * Function Name: Cy_CSDIDAC_IsIdacLsbValid
 ****************************************************************************//**
@@ -446,6 +830,33 @@ __STATIC_INLINE bool Cy_CSDIDAC_IsIdacChConfigValid(cy_en_csdidac_channel_config
 }
 
 
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_IsIdacWordValid
+****************************************************************************//**
+*
+* Performs verification if the value passed through the idacWord parameter
+* is an IDAC register word built by \ref CY_CSDIDAC_IDAC_WORD() from a valid
+* polarity, LSB index, and code.
+*
+* \param idacWord
+* The input value for verification.
+*
+* \return status
+* Returns the verification status:
+* - true  - Indicates that the verification succeeded.
+* - false - Indicates that the verification failed.
+*
+*******************************************************************************/
+__STATIC_INLINE bool Cy_CSDIDAC_IsIdacWordValid(uint32_t idacWord)
+{
+    return((CY_CSDIDAC_SINK >= CY_CSDIDAC_IDAC_WORD_POLARITY(idacWord)) &&
+           (CY_CSDIDAC_LSB_4800_IDX >= CY_CSDIDAC_IDAC_WORD_LSB(idacWord)) &&
+           (idacWord == CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_IDAC_WORD_POLARITY(idacWord),
+                                             CY_CSDIDAC_IDAC_WORD_LSB(idacWord),
+                                             idacWord & CY_CSDIDAC_IDAC_WORD_CODE_MASK)));
+}
+
+
 /*******************************************************************************
 * Function Name: Cy_CSDIDAC_IsIdacConfigValid
 ****************************************************************************//**
@@ -489,6 +900,40 @@ __STATIC_INLINE bool Cy_CSDIDAC_IsIdacConfigValid(const cy_stc_csdidac_config_t
 
 
 
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_GetIdacReg
+****************************************************************************//**
+*
+* Returns the address of the IDAC register of the specified channel for
+* the fast write path.
+*
+* The channel is enabled first by the Cy_CSDIDAC_OutputEnable() or
+* Cy_CSDIDAC_OutputEnableExt() functions. Then, the output current is changed
+* by a single store of a precomputed \ref CY_CSDIDAC_IDAC_WORD() value to the
+* returned address. The fast path does not update the context structure,
+* so Cy_CSDIDAC_SyncIdacWord() is called before the functions that use the
+* channel polarity, LSB, and code, for instance, Cy_CSDIDAC_Save() or
+* Cy_CSDIDAC_GetOutputCurrent().
+*
+* \param ch
+* The channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The address of the IDAC register.
+*
+*******************************************************************************/
+__STATIC_INLINE volatile uint32_t * Cy_CSDIDAC_GetIdacReg(cy_en_csdidac_choice_t ch,
+                                                         const cy_stc_csdidac_context_t * context)
+{
+    return ((volatile uint32_t *)((volatile uint8_t *)context->cfgCopy.base +
+                                  ((CY_CSDIDAC_A == ch) ? CY_CSD_REG_OFFSET_IDACA : CY_CSD_REG_OFFSET_IDACB)));
+}
+
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,397 @@
+/***************************************************************************//**
+* \file cy_csdidac_bipolar.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC bipolar output implementation.
+*
+* Both the channels stay enabled and routed while the bipolar output is
+* used, so the output is changed by the IDAC register stores only. The
+* channel with a non-zero code is kept in the context, so a sample stores
+* only the registers that change: the channel of the sample and, on a sign
+* change, the channel of the previous sign before it.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_bipolar.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Static Function Prototypes
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static void Cy_CSDIDAC_BipolarSet(
+                cy_en_csdidac_bipolar_side_t side,
+                uint32_t idacWord,
+                cy_stc_csdidac_bipolar_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarInit
+****************************************************************************//**
+*
+* Initializes the bipolar output and enables IdacA as a source and IdacB as
+* a sink, both with the zero code, through Cy_CSDIDAC_OutputEnableExt().
+*
+* One channel is configured as \ref CY_CSDIDAC_JOIN, so both the channels
+* drive the pin of the other one.
+*
+* \param lsbIndex
+* The LSB of the waveform samples, see Cy_CSDIDAC_BipolarPlay().
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the bipolar output context structure
+* \ref cy_stc_csdidac_bipolar_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+* * CY_CSDIDAC_BAD_CONFIGURATION - No channel is configured as
+*                           \ref CY_CSDIDAC_JOIN.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarInit(
+                cy_en_csdidac_lsb_t lsbIndex,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context) && (true == Cy_CSDIDAC_IsIdacLsbValid(lsbIndex)))
+    {
+        if ((CY_CSDIDAC_JOIN == idacContext->cfgCopy.configA) || (CY_CSDIDAC_JOIN == idacContext->cfgCopy.configB))
+        {
+            result = Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, lsbIndex, 0u, idacContext);
+            if (CY_CSDIDAC_SUCCESS == result)
+            {
+                result = Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_B, CY_CSDIDAC_SINK, lsbIndex, 0u, idacContext);
+            }
+            if (CY_CSDIDAC_SUCCESS == result)
+            {
+                context->idacCxtPtr = idacContext;
+                context->posReg = Cy_CSDIDAC_GetIdacReg(CY_CSDIDAC_A, idacContext);
+                context->negReg = Cy_CSDIDAC_GetIdacReg(CY_CSDIDAC_B, idacContext);
+                context->posBase = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SOURCE, lsbIndex, 0u);
+                context->negBase = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SINK, lsbIndex, 0u);
+                context->side = CY_CSDIDAC_BIPOLAR_ZERO;
+                context->state = CY_CSDIDAC_DISABLE;
+                context->switchCnt = 0u;
+                context->writeCnt = 0u;
+            }
+        }
+        else
+        {
+            result = CY_CSDIDAC_BAD_CONFIGURATION;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarOutput
+****************************************************************************//**
+*
+* Outputs a signed current. The waveform playback is stopped.
+*
+* The current is converted by Cy_CSDIDAC_CurrentToCode(), so the LSB is
+* chosen per call. A positive current is output by IdacA, a negative one by
+* IdacB, and the other channel is set to the zero code. The output takes
+* one IDAC register store, or two on a sign change.
+*
+* \param current
+* The current in nA with a sign, the absolute value is up to
+* \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+* \param context
+* The pointer to the initialized bipolar output context structure
+* \ref cy_stc_csdidac_bipolar_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarOutput(
+                int32_t current,
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_en_csdidac_bipolar_side_t side;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if (NULL != context)
+    {
+        result = Cy_CSDIDAC_CurrentToCode(current, &polarity, &lsbIndex, &code);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            if (0u == code)
+            {
+                side = CY_CSDIDAC_BIPOLAR_ZERO;
+            }
+            else
+            {
+                side = (CY_CSDIDAC_SOURCE == polarity) ? CY_CSDIDAC_BIPOLAR_POS : CY_CSDIDAC_BIPOLAR_NEG;
+            }
+
+            /* The playback interrupt does not store a sample in between */
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            context->state = CY_CSDIDAC_DISABLE;
+            Cy_CSDIDAC_BipolarSet(side, CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, code), context);
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_BIPOLAR, interruptState, csStartTime, context->idacCxtPtr);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarPlay
+****************************************************************************//**
+*
+* Starts the playback of a bipolar waveform.
+*
+* The samples are the signed codes of the LSB passed to
+* Cy_CSDIDAC_BipolarInit(). Each Cy_CSDIDAC_BipolarProcess() call outputs
+* the next sample starting from the first one.
+*
+* \param samples
+* The table of the codes, from -\ref CY_CSDIDAC_IDAC_WORD_CODE_MASK
+* to \ref CY_CSDIDAC_IDAC_WORD_CODE_MASK.
+*
+* \param count
+* The number of the samples in the table.
+*
+* \param loop
+* If true, the playback restarts from the first sample after the last one.
+* Otherwise, the last sample is kept when the playback ends.
+*
+* \param context
+* The pointer to the initialized bipolar output context structure
+* \ref cy_stc_csdidac_bipolar_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarPlay(
+                const int8_t * samples,
+                uint32_t count,
+                bool loop,
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t i;
+
+    if ((NULL != samples) && (NULL != context) && (0u != count))
+    {
+        for (i = 0u; (i < count) && (-(int32_t)CY_CSDIDAC_IDAC_WORD_CODE_MASK <= (int32_t)samples[i]); i++)
+        {
+        }
+        if (i == count)
+        {
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            context->samples = samples;
+            context->count = count;
+            context->index = 0u;
+            context->loop = loop;
+            context->state = CY_CSDIDAC_ENABLE;
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_BIPOLAR, interruptState, csStartTime, context->idacCxtPtr);
+            result = CY_CSDIDAC_SUCCESS;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarProcess
+****************************************************************************//**
+*
+* Outputs the next sample of the bipolar waveform.
+*
+* The function is intended for a timer interrupt, so the parameters are not
+* verified. A sample takes one IDAC register store, or two on a sign change.
+*
+* The IDAC registers are written with the fast path, so
+* Cy_CSDIDAC_BipolarStop() is called before the functions that use
+* the channel configuration in the CSDIDAC context.
+*
+* \param context
+* The pointer to the initialized bipolar output context structure
+* \ref cy_stc_csdidac_bipolar_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_BipolarProcess(
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    int32_t sample;
+
+    if (CY_CSDIDAC_ENABLE == context->state)
+    {
+        sample = context->samples[context->index];
+        if (0 < sample)
+        {
+            Cy_CSDIDAC_BipolarSet(CY_CSDIDAC_BIPOLAR_POS, context->posBase | (uint32_t)sample, context);
+        }
+        else if (0 > sample)
+        {
+            Cy_CSDIDAC_BipolarSet(CY_CSDIDAC_BIPOLAR_NEG, context->negBase | (uint32_t)(-sample), context);
+        }
+        else
+        {
+            Cy_CSDIDAC_BipolarSet(CY_CSDIDAC_BIPOLAR_ZERO, 0u, context);
+        }
+        context->index++;
+        if (context->index == context->count)
+        {
+            context->index = 0u;
+            context->state = (true == context->loop) ? CY_CSDIDAC_ENABLE : CY_CSDIDAC_DISABLE;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarStop
+****************************************************************************//**
+*
+* Stops the waveform playback. The channels are kept enabled with the current
+* output, and their configuration in the CSDIDAC context is updated from
+* the IDAC registers by Cy_CSDIDAC_SyncIdacWord(). Use
+* Cy_CSDIDAC_OutputDisable() to disable the channels.
+*
+* \param context
+* The pointer to the initialized bipolar output context structure
+* \ref cy_stc_csdidac_bipolar_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarStop(
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->state = CY_CSDIDAC_DISABLE;
+        result = Cy_CSDIDAC_SyncIdacWord(CY_CSDIDAC_A, context->idacCxtPtr);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            result = Cy_CSDIDAC_SyncIdacWord(CY_CSDIDAC_B, context->idacCxtPtr);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_BipolarSet
+****************************************************************************//**
+*
+* Stores the IDAC register words of a sample. On a change of the channel
+* with a non-zero code, the previous channel is set to the zero code before
+* the new one is set, so both the channels never output a current at once.
+*
+* \param side
+* The channel of the sample.
+*
+* \param idacWord
+* The IDAC register word of the channel, ignored for
+* \ref CY_CSDIDAC_BIPOLAR_ZERO.
+*
+* \param context
+* The pointer to the bipolar output context structure.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_BipolarSet(
+                cy_en_csdidac_bipolar_side_t side,
+                uint32_t idacWord,
+                cy_stc_csdidac_bipolar_context_t * context)
+{
+    if (side != context->side)
+    {
+        if (CY_CSDIDAC_BIPOLAR_POS == context->side)
+        {
+            *context->posReg = context->posBase;
+            context->writeCnt++;
+        }
+        else if (CY_CSDIDAC_BIPOLAR_NEG == context->side)
+        {
+            *context->negReg = context->negBase;
+            context->writeCnt++;
+        }
+        else
+        {
+            /* Both the channels are at the zero code */
+        }
+        context->side = side;
+        context->switchCnt++;
+    }
+
+    if (CY_CSDIDAC_BIPOLAR_POS == side)
+    {
+        *context->posReg = idacWord;
+        context->writeCnt++;
+    }
+    else if (CY_CSDIDAC_BIPOLAR_NEG == side)
+    {
+        *context->negReg = idacWord;
+        context->writeCnt++;
+    }
+    else
+    {
+        /* The zero sample is output by the release of the previous channel */
+    }
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/***************************************************************************//**
+* \file cy_csdidac_bipolar.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC bipolar output.
+*
+* With one channel configured as \ref CY_CSDIDAC_JOIN, both the IDACs drive
+* the pin of the other channel. The bipolar output enables IdacA as a source
+* and IdacB as a sink once, and then outputs a signed current by the codes
+* only: a positive sample is output by IdacA with IdacB at the zero code,
+* a negative sample by IdacB with IdacA at the zero code. A zero crossing
+* does not disable, re-route, or re-enable a channel.
+*
+* A sample of the same sign as the previous one is one IDAC register store.
+* A sign change is two: the channel of the previous sign is set to the zero
+* code first, then the channel of the new sign is set, so both the channels
+* never output a non-zero current at once.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_BIPOLAR_H)
+#define CY_CSDIDAC_BIPOLAR_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The channel that outputs the bipolar current. */
+typedef enum
+{
+    CY_CSDIDAC_BIPOLAR_ZERO     = 0u,       /**< Both the channels are at the zero code. */
+    CY_CSDIDAC_BIPOLAR_POS      = 1u,       /**< IdacA sources the current, IdacB is at the zero code. */
+    CY_CSDIDAC_BIPOLAR_NEG      = 2u,       /**< IdacB sinks the current, IdacA is at the zero code. */
+} cy_en_csdidac_bipolar_side_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC bipolar output context structure, that contains the output state and the waveform playback data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * posReg;             /**< The IDAC register of IdacA, the positive half. */
+    volatile uint32_t * negReg;             /**< The IDAC register of IdacB, the negative half. */
+    uint32_t posBase;                       /**< The IdacA word of the waveform LSB with the zero code. */
+    uint32_t negBase;                       /**< The IdacB word of the waveform LSB with the zero code. */
+    cy_en_csdidac_bipolar_side_t side;      /**< The channel with a non-zero code. */
+    const int8_t * samples;                 /**< The table of the waveform codes. */
+    uint32_t count;                         /**< The number of the waveform samples. */
+    uint32_t index;                         /**< The next waveform sample. */
+    bool loop;                              /**< The waveform is restarted at the end. */
+    volatile cy_en_csdidac_state_t state;   /**< The waveform playback is running. */
+    uint32_t switchCnt;                     /**< The number of the changes of the channel with a non-zero code. */
+    uint32_t writeCnt;                      /**< The number of the IDAC register stores. */
+} cy_stc_csdidac_bipolar_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarInit(
+                cy_en_csdidac_lsb_t lsbIndex,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_bipolar_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarOutput(
+                int32_t current,
+                cy_stc_csdidac_bipolar_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarPlay(
+                const int8_t * samples,
+                uint32_t count,
+                bool loop,
+                cy_stc_csdidac_bipolar_context_t * context);
+void Cy_CSDIDAC_BipolarProcess(
+                cy_stc_csdidac_bipolar_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_BipolarStop(
+                cy_stc_csdidac_bipolar_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_BIPOLAR_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,453 @@
+/***************************************************************************//**
+* \file cy_csdidac_cmd.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC binary setpoint command interface
+* implementation. The frames are parsed byte by byte in the receive interrupt
+* directly into the setpoint queue slots and are applied by
+* Cy_CSDIDAC_CmdProcess() from the main loop or a periodic tick.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_cmd.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_CMD_QUEUE_MASK               (CY_CSDIDAC_CMD_QUEUE_SIZE - 1u)
+
+/* The parser states */
+#define CY_CSDIDAC_CMD_STATE_SOF                (0u)
+#define CY_CSDIDAC_CMD_STATE_FLAGS              (1u)
+#define CY_CSDIDAC_CMD_STATE_SEQ                (2u)
+#define CY_CSDIDAC_CMD_STATE_VALUE              (3u)
+#define CY_CSDIDAC_CMD_STATE_TIMESTAMP          (4u)
+#define CY_CSDIDAC_CMD_STATE_CRC                (5u)
+
+#define CY_CSDIDAC_CMD_FLAGS_MASK               (CY_CSDIDAC_CMD_FLAG_CH_MASK | CY_CSDIDAC_CMD_FLAG_WORD | \
+                                                 CY_CSDIDAC_CMD_FLAG_TIMESTAMP | CY_CSDIDAC_CMD_FLAG_SYNC)
+#define CY_CSDIDAC_CMD_SEQ_MASK                 (0xFFu)
+#define CY_CSDIDAC_CMD_FIELD_SIZE               (4u)
+#define CY_CSDIDAC_CMD_CRC_SIZE                 (2u)
+#define CY_CSDIDAC_CMD_CRC_INIT                 (0xFFFFu)
+#define CY_CSDIDAC_CMD_CRC_POLY                 (0x1021u)
+
+#if (0u != (CY_CSDIDAC_CMD_QUEUE_SIZE & CY_CSDIDAC_CMD_QUEUE_MASK))
+    #error "CY_CSDIDAC_CMD_QUEUE_SIZE must be a power of two"
+#endif
+
+
+/*******************************************************************************
+* Function Prototypes - internal functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_CmdCrc(uint32_t crc, uint8_t data);
+static void Cy_CSDIDAC_CmdRespond(
+                uint32_t status,
+                uint32_t seq,
+                const cy_stc_csdidac_cmd_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_CmdApply(
+                const cy_stc_csdidac_cmd_setpoint_t * setpoint,
+                cy_stc_csdidac_context_t * idacContext);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdInit
+****************************************************************************//**
+*
+* Initializes the binary setpoint command interface.
+*
+* \param txFunc
+* The response transmit function. The responses are not sent if NULL.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the command interface context structure
+* \ref cy_stc_csdidac_cmd_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_CmdInit(
+                cy_csdidac_cmd_tx_t txFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_cmd_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context))
+    {
+        context->idacCxtPtr = idacContext;
+        context->txFunc = txFunc;
+        context->frame = &context->discard;
+        context->head = 0u;
+        context->tail = 0u;
+        context->state = CY_CSDIDAC_CMD_STATE_SOF;
+        context->byteIdx = 0u;
+        context->crc = CY_CSDIDAC_CMD_CRC_INIT;
+        context->rxCrc = 0u;
+        context->nextSeq = 0u;
+        context->synced = false;
+        context->frameCnt = 0u;
+        context->crcErrCnt = 0u;
+        context->busyCnt = 0u;
+        context->seqErrCnt = 0u;
+        context->applyErrCnt = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdReceive
+****************************************************************************//**
+*
+* Parses a received byte of the setpoint frame.
+*
+* The function is called from the UART receive interrupt for every byte read
+* from the RX FIFO. The frame fields are assembled directly in the next free
+* queue slot, so no frame buffer is copied. The slot is committed to the
+* queue when the frame CRC is correct and the frame is the next one of the
+* sequence, and a response is sent. A byte that is not a valid frame start
+* or flags value resynchronizes the parser to the next start of a frame.
+* An invalid flags byte equal to the frame start is taken as the start of
+* the next frame. The parameters are not verified.
+*
+* \param rxByte
+* The received byte.
+*
+* \param context
+* The pointer to the initialized command interface context structure
+* \ref cy_stc_csdidac_cmd_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_CmdReceive(
+                uint8_t rxByte,
+                cy_stc_csdidac_cmd_context_t * context)
+{
+    cy_stc_csdidac_cmd_setpoint_t * frame = context->frame;
+
+    switch (context->state)
+    {
+        case CY_CSDIDAC_CMD_STATE_FLAGS:
+            if ((0u != (rxByte & (uint8_t)~CY_CSDIDAC_CMD_FLAGS_MASK)) ||
+                ((uint32_t)CY_CSDIDAC_AB < (rxByte & CY_CSDIDAC_CMD_FLAG_CH_MASK)))
+            {
+                /* An invalid flags byte may be the start of the next frame */
+                context->state = (CY_CSDIDAC_CMD_SOF == rxByte) ?
+                                 CY_CSDIDAC_CMD_STATE_FLAGS : CY_CSDIDAC_CMD_STATE_SOF;
+            }
+            else
+            {
+                /* The frame goes to the next free slot, or is received to be dropped */
+                if (CY_CSDIDAC_CMD_QUEUE_SIZE > (context->head - context->tail))
+                {
+                    frame = &context->queue[context->head & CY_CSDIDAC_CMD_QUEUE_MASK];
+                }
+                else
+                {
+                    frame = &context->discard;
+                }
+                context->frame = frame;
+                frame->flags = rxByte;
+                frame->value = 0u;
+                frame->timestamp = 0u;
+                context->crc = Cy_CSDIDAC_CmdCrc(CY_CSDIDAC_CMD_CRC_INIT, rxByte);
+                context->state = CY_CSDIDAC_CMD_STATE_SEQ;
+            }
+            break;
+
+        case CY_CSDIDAC_CMD_STATE_SEQ:
+            frame->seq = rxByte;
+            context->crc = Cy_CSDIDAC_CmdCrc(context->crc, rxByte);
+            context->byteIdx = 0u;
+            context->state = CY_CSDIDAC_CMD_STATE_VALUE;
+            break;
+
+        case CY_CSDIDAC_CMD_STATE_VALUE:
+            frame->value |= ((uint32_t)rxByte << (8u * context->byteIdx));
+            context->crc = Cy_CSDIDAC_CmdCrc(context->crc, rxByte);
+            context->byteIdx++;
+            if (CY_CSDIDAC_CMD_FIELD_SIZE == context->byteIdx)
+            {
+                context->byteIdx = 0u;
+                context->rxCrc = 0u;
+                context->state = (0u != (frame->flags & CY_CSDIDAC_CMD_FLAG_TIMESTAMP)) ?
+                                 CY_CSDIDAC_CMD_STATE_TIMESTAMP : CY_CSDIDAC_CMD_STATE_CRC;
+            }
+            break;
+
+        case CY_CSDIDAC_CMD_STATE_TIMESTAMP:
+            frame->timestamp |= ((uint32_t)rxByte << (8u * context->byteIdx));
+            context->crc = Cy_CSDIDAC_CmdCrc(context->crc, rxByte);
+            context->byteIdx++;
+            if (CY_CSDIDAC_CMD_FIELD_SIZE == context->byteIdx)
+            {
+                context->byteIdx = 0u;
+                context->state = CY_CSDIDAC_CMD_STATE_CRC;
+            }
+            break;
+
+        case CY_CSDIDAC_CMD_STATE_CRC:
+            context->rxCrc |= ((uint32_t)rxByte << (8u * context->byteIdx));
+            context->byteIdx++;
+            if (CY_CSDIDAC_CMD_CRC_SIZE == context->byteIdx)
+            {
+                context->state = CY_CSDIDAC_CMD_STATE_SOF;
+                if (context->rxCrc != context->crc)
+                {
+                    context->crcErrCnt++;
+                    Cy_CSDIDAC_CmdRespond(CY_CSDIDAC_CMD_NAK_CRC, context->nextSeq, context);
+                }
+                else if ((0u == (frame->flags & CY_CSDIDAC_CMD_FLAG_SYNC)) &&
+                         ((false == context->synced) || (context->nextSeq != frame->seq)))
+                {
+                    context->seqErrCnt++;
+                    Cy_CSDIDAC_CmdRespond(CY_CSDIDAC_CMD_NAK_SEQ, context->nextSeq, context);
+                }
+                else if (&context->discard == frame)
+                {
+                    context->busyCnt++;
+                    Cy_CSDIDAC_CmdRespond(CY_CSDIDAC_CMD_BUSY, frame->seq, context);
+                }
+                else
+                {
+                    /* Commits the slot, the slot fields are stored before the index */
+                    __DMB();
+                    context->head++;
+                    context->frameCnt++;
+                    context->nextSeq = (frame->seq + 1u) & CY_CSDIDAC_CMD_SEQ_MASK;
+                    context->synced = true;
+                    Cy_CSDIDAC_CmdRespond(CY_CSDIDAC_CMD_ACK, frame->seq, context);
+                }
+            }
+            break;
+
+        default:
+            if (CY_CSDIDAC_CMD_SOF == rxByte)
+            {
+                context->state = CY_CSDIDAC_CMD_STATE_FLAGS;
+            }
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdProcess
+****************************************************************************//**
+*
+* Applies the queued setpoints.
+*
+* The setpoints are applied in the received order. A setpoint without
+* a timestamp is applied immediately, a setpoint with a timestamp waits
+* until the now parameter reaches it, and holds the following setpoints.
+* A current in nA is applied by Cy_CSDIDAC_OutputEnable(), an IDAC register
+* word by Cy_CSDIDAC_OutputEnableExt(), and a zero register word by
+* Cy_CSDIDAC_OutputDisable().
+*
+* \param now
+* The current time in the units of the frame timestamps, for instance
+* the tick counter. The counter wraparound is handled.
+*
+* \param context
+* The pointer to the initialized command interface context structure
+* \ref cy_stc_csdidac_cmd_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or a setpoint is
+*                           rejected by the CSDIDAC middleware.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_CmdProcess(
+                uint32_t now,
+                cy_stc_csdidac_cmd_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    const cy_stc_csdidac_cmd_setpoint_t * setpoint;
+    uint32_t tail;
+
+    if (NULL != context)
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        tail = context->tail;
+        while (tail != context->head)
+        {
+            setpoint = &context->queue[tail & CY_CSDIDAC_CMD_QUEUE_MASK];
+            if ((0u != (setpoint->flags & CY_CSDIDAC_CMD_FLAG_TIMESTAMP)) &&
+                (0 > (int32_t)(now - setpoint->timestamp)))
+            {
+                break;
+            }
+            if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_CmdApply(setpoint, context->idacCxtPtr))
+            {
+                context->applyErrCnt++;
+                result = CY_CSDIDAC_BAD_PARAM;
+            }
+            /* Releases the slot after it is applied, as the parser writes the released slots */
+            tail++;
+            context->tail = tail;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdCrc
+****************************************************************************//**
+*
+* Updates the CRC-16/CCITT-FALSE with a byte.
+*
+* \param crc
+* The CRC of the previous bytes.
+*
+* \param data
+* The byte.
+*
+* \return
+* The updated CRC.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_CmdCrc(uint32_t crc, uint8_t data)
+{
+    uint32_t i;
+
+    crc ^= ((uint32_t)data << 8u);
+    for (i = 0u; i < 8u; i++)
+    {
+        crc = (0u != (crc & 0x8000u)) ? ((crc << 1u) ^ CY_CSDIDAC_CMD_CRC_POLY) : (crc << 1u);
+    }
+
+    return (crc & 0xFFFFu);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdRespond
+****************************************************************************//**
+*
+* Sends the response to the current frame.
+*
+* \param status
+* The response status.
+*
+* \param seq
+* The sequence number of the accepted frame for an ACK, or the expected
+* sequence number otherwise.
+*
+* \param context
+* The pointer to the command interface context structure
+* \ref cy_stc_csdidac_cmd_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_CmdRespond(
+                uint32_t status,
+                uint32_t seq,
+                const cy_stc_csdidac_cmd_context_t * context)
+{
+    uint8_t response[CY_CSDIDAC_CMD_RSP_SIZE];
+
+    if (NULL != context->txFunc)
+    {
+        response[0u] = CY_CSDIDAC_CMD_RSP_SOF;
+        response[1u] = (uint8_t)seq;
+        response[2u] = (uint8_t)status;
+        response[3u] = (uint8_t)(CY_CSDIDAC_CMD_QUEUE_SIZE - (context->head - context->tail));
+        context->txFunc(response, CY_CSDIDAC_CMD_RSP_SIZE);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_CmdApply
+****************************************************************************//**
+*
+* Applies a setpoint to the CSDIDAC middleware. A current outside
+* +/-\ref CY_CSDIDAC_MAX_CURRENT_NA is rejected before the conversion to
+* int32_t, as the value comes from the untrusted frame.
+*
+* \param setpoint
+* The pointer to the setpoint.
+*
+* \param idacContext
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The status of the CSDIDAC function.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_CmdApply(
+                const cy_stc_csdidac_cmd_setpoint_t * setpoint,
+                cy_stc_csdidac_context_t * idacContext)
+{
+    cy_en_csdidac_status_t result;
+    cy_en_csdidac_choice_t ch = (cy_en_csdidac_choice_t)((uint32_t)setpoint->flags & CY_CSDIDAC_CMD_FLAG_CH_MASK);
+    uint32_t word = setpoint->value;
+
+    if (0u == (setpoint->flags & CY_CSDIDAC_CMD_FLAG_WORD))
+    {
+        if ((CY_CSDIDAC_MAX_CURRENT_NA >= word) || (CY_CSDIDAC_MAX_CURRENT_NA >= (0u - word)))
+        {
+            result = Cy_CSDIDAC_OutputEnable(ch, (int32_t)word, idacContext);
+        }
+        else
+        {
+            result = CY_CSDIDAC_BAD_PARAM;
+        }
+    }
+    else if (0u == word)
+    {
+        result = Cy_CSDIDAC_OutputDisable(ch, idacContext);
+    }
+    else if (true == Cy_CSDIDAC_IsIdacWordValid(word))
+    {
+        result = Cy_CSDIDAC_OutputEnableExt(ch, (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(word),
+                                            (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(word),
+                                            word & CY_CSDIDAC_IDAC_WORD_CODE_MASK, idacContext);
+    }
+    else
+    {
+        result = CY_CSDIDAC_BAD_PARAM;
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
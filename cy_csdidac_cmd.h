@@ -0,0 +1,170 @@
+/***************************************************************************//**
+* \file cy_csdidac_cmd.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC binary setpoint command interface.
+*
+* The host sends the setpoint frames, all the multi-byte fields are
+* little-endian:
+*
+*   | SOF 0xA5 | flags | seq | value[4] | timestamp[4], optional | CRC[2] |
+*
+* The flags hold the channel (\ref cy_en_csdidac_choice_t) in bits 1:0,
+* \ref CY_CSDIDAC_CMD_FLAG_WORD, \ref CY_CSDIDAC_CMD_FLAG_TIMESTAMP and
+* \ref CY_CSDIDAC_CMD_FLAG_SYNC. The CRC is CRC-16/CCITT-FALSE of the bytes
+* from the flags to the end of the payload. Each frame is answered with
+* a response:
+*
+*   | SOF 0x5A | seq | status | free queue slots |
+*
+* The frames are accepted in the sequence number order only. The first frame
+* of the host has \ref CY_CSDIDAC_CMD_FLAG_SYNC and is accepted with any
+* sequence number, each next frame has the next sequence number. An ACK
+* carries the sequence number of the accepted frame. A non-ACK status
+* carries the sequence number the device expects, as the sequence number of
+* a frame with a wrong CRC cannot be trusted. The host keeps no more frames
+* in flight than the last reported number of the free slots. On a non-ACK
+* status, the host goes back to the expected frame and sends it and the
+* following frames again, the frames in flight after it are answered with
+* \ref CY_CSDIDAC_CMD_NAK_SEQ and dropped.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_CMD_H)
+#define CY_CSDIDAC_CMD_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_CMD_QUEUE_SIZE)
+/** The number of the setpoint queue slots, a power of two. */
+#define CY_CSDIDAC_CMD_QUEUE_SIZE               (8u)
+#endif
+
+/** The start of a setpoint frame. */
+#define CY_CSDIDAC_CMD_SOF                      (0xA5u)
+/** The start of a response. */
+#define CY_CSDIDAC_CMD_RSP_SOF                  (0x5Au)
+/** The response size in bytes. */
+#define CY_CSDIDAC_CMD_RSP_SIZE                 (4u)
+
+/** The channel field of the frame flags. */
+#define CY_CSDIDAC_CMD_FLAG_CH_MASK             (0x03u)
+/** The value is an IDAC register word, zero disables the channel. Otherwise, the value is a current in nA with a sign. */
+#define CY_CSDIDAC_CMD_FLAG_WORD                (0x04u)
+/** The frame has a timestamp, the setpoint is applied when the caller time reaches it. */
+#define CY_CSDIDAC_CMD_FLAG_TIMESTAMP           (0x08u)
+
+/** The frame starts the sequence, it is accepted with any sequence number. */
+#define CY_CSDIDAC_CMD_FLAG_SYNC                (0x10u)
+
+/** The response status: the frame is queued. */
+#define CY_CSDIDAC_CMD_ACK                      (0x00u)
+/** The response status: the frame CRC is wrong. */
+#define CY_CSDIDAC_CMD_NAK_CRC                  (0x01u)
+/** The response status: the queue is full, the frame is dropped. */
+#define CY_CSDIDAC_CMD_BUSY                     (0x02u)
+
+/** The response status: the frame is not the expected one of the sequence, the frame is dropped. */
+#define CY_CSDIDAC_CMD_NAK_SEQ                  (0x03u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/**
+* The response transmit function. Called from the receive context, so it
+* does not block, for instance it puts the bytes to the SCB TX FIFO.
+*/
+typedef void (* cy_csdidac_cmd_tx_t)(const uint8_t * data, uint32_t size);
+
+/** The CSDIDAC setpoint queue slot. */
+typedef struct
+{
+    uint32_t value;                         /**< The current in nA with a sign or the IDAC register word. */
+    uint32_t timestamp;                     /**< The time to apply the setpoint. */
+    uint8_t flags;                          /**< The frame flags. */
+    uint8_t seq;                            /**< The frame sequence number. */
+} cy_stc_csdidac_cmd_setpoint_t;
+
+/** The CSDIDAC command interface context structure, that contains the internal parser and queue data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    cy_csdidac_cmd_tx_t txFunc;             /**< The response transmit function. */
+    cy_stc_csdidac_cmd_setpoint_t queue[CY_CSDIDAC_CMD_QUEUE_SIZE]; /**< The setpoint queue. */
+    cy_stc_csdidac_cmd_setpoint_t discard;  /**< The slot that receives a frame when the queue is full. */
+    cy_stc_csdidac_cmd_setpoint_t * frame;  /**< The slot that receives the current frame. */
+    volatile uint32_t head;                 /**< The queue write index, updated by the receive context. */
+    volatile uint32_t tail;                 /**< The queue read index, updated by Cy_CSDIDAC_CmdProcess(). */
+    uint32_t state;                         /**< The parser state. */
+    uint32_t byteIdx;                       /**< The byte index in the current field. */
+    uint32_t crc;                           /**< The calculated frame CRC. */
+    uint32_t rxCrc;                         /**< The received frame CRC. */
+    uint32_t nextSeq;                       /**< The sequence number of the next accepted frame. */
+    bool synced;                            /**< A frame with CY_CSDIDAC_CMD_FLAG_SYNC is accepted. */
+    uint32_t frameCnt;                      /**< The number of the queued frames. */
+    uint32_t crcErrCnt;                     /**< The number of the frames with a wrong CRC. */
+    uint32_t busyCnt;                       /**< The number of the frames dropped on a full queue. */
+    uint32_t seqErrCnt;                     /**< The number of the frames dropped out of the sequence. */
+    uint32_t applyErrCnt;                   /**< The number of the setpoints rejected by the CSDIDAC middleware. */
+} cy_stc_csdidac_cmd_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_CmdInit(
+                cy_csdidac_cmd_tx_t txFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_cmd_context_t * context);
+void Cy_CSDIDAC_CmdReceive(
+                uint8_t rxByte,
+                cy_stc_csdidac_cmd_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_CmdProcess(
+                uint32_t now,
+                cy_stc_csdidac_cmd_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_CMD_H */
+
+
+/* [] END OF FILE */
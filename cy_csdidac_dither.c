@@ -0,0 +1,245 @@
+/***************************************************************************//**
+* \file cy_csdidac_dither.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC sigma-delta dithered output implementation.
+* A first-order sigma-delta modulator toggles the IDAC code between two
+* adjacent values from a periodic tick, so the average output current
+* has a resolution beyond the 7-bit IDAC code.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_dither.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_DITHER_MAX_CURRENT_PA        (CY_CSDIDAC_MAX_CURRENT_NA * 1000u)
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_DitherInit
+****************************************************************************//**
+*
+* Initializes the dithered output of a channel. The channel is enabled by
+* the first Cy_CSDIDAC_DitherSetCurrent() call.
+*
+* \param ch
+* The dithered channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param extraBits
+* The number of the extra resolution bits, from 1u to
+* \ref CY_CSDIDAC_DITHER_MAX_BITS. More bits give a finer average current
+* and a longer settling time and a lower frequency of the dither pattern.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the dither context structure
+* \ref cy_stc_csdidac_dither_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t extraBits,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_dither_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)) &&
+        (0u != extraBits) && (CY_CSDIDAC_DITHER_MAX_BITS >= extraBits) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)))
+    {
+        context->idacCxtPtr = idacContext;
+        context->idacReg = Cy_CSDIDAC_GetIdacReg(ch, idacContext);
+        context->channel = ch;
+        context->extraBits = extraBits;
+        context->fraction = 0u;
+        context->accumulator = 0u;
+        context->state = CY_CSDIDAC_DISABLE;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_DitherSetCurrent
+****************************************************************************//**
+*
+* Sets the average output current of the dithered channel and starts
+* the dithering.
+*
+* The function chooses the minimum LSB that covers the current, enables the
+* channel with the integer part of the code through
+* Cy_CSDIDAC_OutputEnableExt(), and stores the fractional part for
+* Cy_CSDIDAC_DitherProcess(). The 64-bit scaling is done here, so the tick
+* path is free of the divisions. The sigma-delta accumulator is kept, so
+* the slow current changes do not restart the dither pattern.
+*
+* \param currentPa
+* The average current in pA with a sign. A positive value is a sourcing
+* current, a negative value is a sinking current. The absolute value is
+* up to \ref CY_CSDIDAC_MAX_CURRENT_NA multiplied by 1000.
+*
+* \param context
+* The pointer to the initialized dither context structure
+* \ref cy_stc_csdidac_dither_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherSetCurrent(
+                int32_t currentPa,
+                cy_stc_csdidac_dither_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t absCurrent = (0 > currentPa) ? (0u - (uint32_t)currentPa) : (uint32_t)currentPa;
+    cy_en_csdidac_polarity_t polarity = (0 > currentPa) ? CY_CSDIDAC_SINK : CY_CSDIDAC_SOURCE;
+    uint32_t lsbIndex = (uint32_t)CY_CSDIDAC_LSB_37_IDX;
+    uint32_t scaledCode;
+    uint32_t code;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if ((NULL != context) && (CY_CSDIDAC_DITHER_MAX_CURRENT_PA >= absCurrent))
+    {
+        /* Chooses the minimum LSB, so both the adjacent codes are in the code range */
+        while ((absCurrent > (CY_CSDIDAC_MAX_CODE * CY_CSDIDAC_LSB_PA(lsbIndex))) &&
+               ((uint32_t)CY_CSDIDAC_LSB_4800_IDX > lsbIndex))
+        {
+            lsbIndex++;
+        }
+
+        /* The code in 2^-extraBits units, rounded to the nearest */
+        scaledCode = (uint32_t)((((uint64_t)absCurrent << context->extraBits) + (CY_CSDIDAC_LSB_PA(lsbIndex) >> 1u)) /
+                                CY_CSDIDAC_LSB_PA(lsbIndex));
+        if ((CY_CSDIDAC_MAX_CODE << context->extraBits) < scaledCode)
+        {
+            scaledCode = CY_CSDIDAC_MAX_CODE << context->extraBits;
+        }
+        code = scaledCode >> context->extraBits;
+
+        /* A tick between the register and the dither state update would restore the previous range */
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        result = Cy_CSDIDAC_OutputEnableExt(context->channel, polarity, (cy_en_csdidac_lsb_t)lsbIndex,
+                                            code, context->idacCxtPtr);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            context->baseWord = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, code);
+            context->fraction = scaledCode & ((1uL << context->extraBits) - 1u);
+            context->state = CY_CSDIDAC_ENABLE;
+        }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_DITHER, interruptState, csStartTime, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_DitherProcess
+****************************************************************************//**
+*
+* Executes one tick of the first-order sigma-delta modulator.
+*
+* The fractional code is added to the accumulator, the carry selects the
+* integer code or the next code, which is written with a single IDAC register
+* store. The function is intended for a timer interrupt, so the parameters
+* are not verified. The context structure is initialized by
+* Cy_CSDIDAC_DitherInit().
+*
+* The CSDIDAC context keeps the integer code, so Cy_CSDIDAC_GetOutputCurrent()
+* and the charge accounting do not include the fractional part.
+*
+* \param context
+* The pointer to the initialized dither context structure
+* \ref cy_stc_csdidac_dither_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_DitherProcess(
+                cy_stc_csdidac_dither_context_t * context)
+{
+    uint32_t accumulator;
+
+    if (CY_CSDIDAC_ENABLE == context->state)
+    {
+        accumulator = context->accumulator + context->fraction;
+        context->accumulator = accumulator & ((1uL << context->extraBits) - 1u);
+        *context->idacReg = context->baseWord + (accumulator >> context->extraBits);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_DitherStop
+****************************************************************************//**
+*
+* Stops the dithering. The channel is kept enabled with the integer part
+* of the code, use Cy_CSDIDAC_OutputDisable() to disable it.
+*
+* \param context
+* The pointer to the initialized dither context structure
+* \ref cy_stc_csdidac_dither_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherStop(
+                cy_stc_csdidac_dither_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        if (CY_CSDIDAC_ENABLE == context->state)
+        {
+            context->state = CY_CSDIDAC_DISABLE;
+            *context->idacReg = context->baseWord;
+        }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_DITHER, interruptState, csStartTime, context->idacCxtPtr);
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/***************************************************************************//**
+* \file cy_csdidac_dither.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC sigma-delta dithered output.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_DITHER_H)
+#define CY_CSDIDAC_DITHER_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/**
+* The maximum number of the extra resolution bits of the dithered output.
+* The average current settles within 2^extraBits ticks.
+*/
+#define CY_CSDIDAC_DITHER_MAX_BITS              (16u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC dithered output context structure, that contains the internal dither data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * idacReg;            /**< The IDAC register of the dithered channel. */
+    cy_en_csdidac_choice_t channel;         /**< The dithered channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    uint32_t extraBits;                     /**< The number of the extra resolution bits. */
+    uint32_t baseWord;                      /**< The IDAC register word with the integer code. */
+    uint32_t fraction;                      /**< The fractional code in 2^-extraBits units. */
+    uint32_t accumulator;                   /**< The sigma-delta accumulator. */
+    cy_en_csdidac_state_t state;            /**< The dithering is running. */
+} cy_stc_csdidac_dither_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t extraBits,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_dither_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherSetCurrent(
+                int32_t currentPa,
+                cy_stc_csdidac_dither_context_t * context);
+void Cy_CSDIDAC_DitherProcess(
+                cy_stc_csdidac_dither_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_DitherStop(
+                cy_stc_csdidac_dither_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_DITHER_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,326 @@
+/***************************************************************************//**
+* \file cy_csdidac_health.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC health checker implementation. The checker
+* periodically compares the CSD HW block ownership, the IDAC registers, the
+* bypass switches and the pin routing with the CSDIDAC context, and executes
+* a recovery policy on a mismatch.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_gpio.h"
+#include "cy_csdidac_health.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+
+#define CY_CSDIDAC_HEALTH_FAULT_CH_A            (CY_CSDIDAC_HEALTH_FAULT_IDACA | \
+                                                 CY_CSDIDAC_HEALTH_FAULT_BYPA | \
+                                                 CY_CSDIDAC_HEALTH_FAULT_PINA)
+#define CY_CSDIDAC_HEALTH_FAULT_CH_B            (CY_CSDIDAC_HEALTH_FAULT_IDACB | \
+                                                 CY_CSDIDAC_HEALTH_FAULT_BYPB | \
+                                                 CY_CSDIDAC_HEALTH_FAULT_PINB)
+
+
+/*******************************************************************************
+* Function Prototypes - internal functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_HealthCompare(
+                uint32_t idacMask,
+                const cy_stc_csdidac_context_t * idacContext);
+static void Cy_CSDIDAC_HealthRecover(
+                uint32_t faults,
+                const cy_stc_csdidac_health_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_HealthInit
+****************************************************************************//**
+*
+* Initializes the health checker of the CSDIDAC middleware.
+*
+* All the IDAC register bits are compared by default. The idacMask field of
+* the checker context is updated after this function when the application
+* changes the IDAC codes through the register fast path, see
+* Cy_CSDIDAC_GetIdacReg().
+*
+* \param policy
+* The recovery policy executed when a fault is detected.
+*
+* \param callback
+* The fault callback executed after the recovery policy. May be NULL, except
+* for the CY_CSDIDAC_HEALTH_CALLBACK policy.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the health checker context structure
+* \ref cy_stc_csdidac_health_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_HealthInit(
+                cy_en_csdidac_health_policy_t policy,
+                cy_csdidac_health_callback_t callback,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_health_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context) &&
+        ((CY_CSDIDAC_HEALTH_REAPPLY == policy) || (CY_CSDIDAC_HEALTH_DISABLE == policy) ||
+         ((CY_CSDIDAC_HEALTH_CALLBACK == policy) && (NULL != callback))))
+    {
+        context->idacCxtPtr = idacContext;
+        context->policy = policy;
+        context->callback = callback;
+        context->idacMask = 0xFFFFFFFFuL;
+        context->lastFaults = 0u;
+        context->checkCnt = 0u;
+        context->faultCnt = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_HealthCheck
+****************************************************************************//**
+*
+* Verifies the CSDIDAC hardware state and executes the recovery policy
+* on a mismatch.
+*
+* The check verifies that the CSD HW block is still captured by the CSDIDAC
+* middleware, then compares the IDACA, IDACB and SW_BYP_SEL registers and
+* the HSIOM routing of the connected pins with the values expected from
+* the context. It costs a few register reads in a short critical section,
+* so it can be executed from a periodic interrupt up to about 1 kHz. The
+* parameters are not verified, the context structure is initialized by
+* Cy_CSDIDAC_HealthInit().
+*
+* When the CSD HW block is lost, the registers belong to another owner, so
+* the REAPPLY and DISABLE policies only mark both the channels as disabled
+* in the context. Otherwise, the REAPPLY policy disables the faulty disabled
+* channels and enables the enabled channels again with the context polarity,
+* LSB, and code, and the DISABLE policy disables both the channels.
+*
+* \param context
+* The pointer to the initialized health checker context structure
+* \ref cy_stc_csdidac_health_context_t.
+*
+* \return
+* The detected fault mask, a combination of the CY_CSDIDAC_HEALTH_FAULT_
+* macros. Zero means that no fault is detected.
+*
+*******************************************************************************/
+uint32_t Cy_CSDIDAC_HealthCheck(
+                cy_stc_csdidac_health_context_t * context)
+{
+    uint32_t faults;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    /* The compared context and registers are not changed by an interrupt in between */
+    interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+    faults = Cy_CSDIDAC_HealthCompare(context->idacMask, context->idacCxtPtr);
+    Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_HEALTH, interruptState, csStartTime, context->idacCxtPtr);
+
+    context->checkCnt++;
+    context->lastFaults = faults;
+    if (0u != faults)
+    {
+        context->faultCnt++;
+        Cy_CSDIDAC_HealthRecover(faults, context);
+        if (NULL != context->callback)
+        {
+            context->callback(faults, context->idacCxtPtr);
+        }
+    }
+
+    return (faults);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_HealthCompare
+****************************************************************************//**
+*
+* Compares the CSDIDAC hardware state with the values expected from
+* the context.
+*
+* \param idacMask
+* The compared bits of the IDAC registers.
+*
+* \param idacContext
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \return
+* The detected fault mask.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_HealthCompare(
+                uint32_t idacMask,
+                const cy_stc_csdidac_context_t * idacContext)
+{
+    const cy_stc_csdidac_config_t * config = &idacContext->cfgCopy;
+    uint32_t faults = 0u;
+    uint32_t expected;
+    uint32_t swBypSel;
+    bool routeA;
+    bool routeB;
+
+    if (CY_CSD_IDAC_KEY != Cy_CSD_GetLockStatus(config->base, config->csdCxtPtr))
+    {
+        faults = CY_CSDIDAC_HEALTH_FAULT_LOCK;
+    }
+    else
+    {
+        expected = (CY_CSDIDAC_ENABLE == idacContext->channelStateA) ?
+                   CY_CSDIDAC_IDAC_WORD(idacContext->polarityA, idacContext->lsbA, idacContext->codeA) : 0u;
+        if (0u != ((Cy_CSD_ReadReg(config->base, CY_CSD_REG_OFFSET_IDACA) ^ expected) & idacMask))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_IDACA;
+        }
+        expected = (CY_CSDIDAC_ENABLE == idacContext->channelStateB) ?
+                   CY_CSDIDAC_IDAC_WORD(idacContext->polarityB, idacContext->lsbB, idacContext->codeB) : 0u;
+        if (0u != ((Cy_CSD_ReadReg(config->base, CY_CSD_REG_OFFSET_IDACB) ^ expected) & idacMask))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_IDACB;
+        }
+
+        /* An output is routed while its channel or the channel joined to it is enabled */
+        routeA = (((CY_CSDIDAC_ENABLE == idacContext->channelStateA) ||
+                   ((CY_CSDIDAC_ENABLE == idacContext->channelStateB) && (CY_CSDIDAC_JOIN == config->configB))) &&
+                  ((CY_CSDIDAC_GPIO == config->configA) || (CY_CSDIDAC_AMUX == config->configA)));
+        routeB = (((CY_CSDIDAC_ENABLE == idacContext->channelStateB) ||
+                   ((CY_CSDIDAC_ENABLE == idacContext->channelStateA) && (CY_CSDIDAC_JOIN == config->configA))) &&
+                  ((CY_CSDIDAC_GPIO == config->configB) || (CY_CSDIDAC_AMUX == config->configB)));
+
+        swBypSel = Cy_CSD_ReadReg(config->base, CY_CSD_REG_OFFSET_SW_BYP_SEL);
+        if (routeA != (0u != (swBypSel & CY_CSDIDAC_SW_BYPA_ENABLE)))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_BYPA;
+        }
+        if (routeB != (0u != (swBypSel & CY_CSDIDAC_SW_BYPB_ENABLE)))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_BYPB;
+        }
+
+        if ((true == routeA) && (CY_CSDIDAC_GPIO == config->configA) && (NULL != config->ptrPinA) &&
+            (HSIOM_SEL_AMUXA != Cy_GPIO_GetHSIOM(config->ptrPinA->ioPcPtr, (uint32_t)config->ptrPinA->pin)))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_PINA;
+        }
+        if ((true == routeB) && (CY_CSDIDAC_GPIO == config->configB) && (NULL != config->ptrPinB) &&
+            (HSIOM_SEL_AMUXB != Cy_GPIO_GetHSIOM(config->ptrPinB->ioPcPtr, (uint32_t)config->ptrPinB->pin)))
+        {
+            faults |= CY_CSDIDAC_HEALTH_FAULT_PINB;
+        }
+    }
+
+    return (faults);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_HealthRecover
+****************************************************************************//**
+*
+* Executes the recovery policy of the health checker.
+*
+* \param faults
+* The detected fault mask.
+*
+* \param context
+* The pointer to the health checker context structure
+* \ref cy_stc_csdidac_health_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_HealthRecover(
+                uint32_t faults,
+                const cy_stc_csdidac_health_context_t * context)
+{
+    cy_stc_csdidac_context_t * idacContext = context->idacCxtPtr;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if (CY_CSDIDAC_HEALTH_CALLBACK == context->policy)
+    {
+        /* The recovery is done by the callback */
+    }
+    else if (0u != (faults & CY_CSDIDAC_HEALTH_FAULT_LOCK))
+    {
+        /* The hardware is not accessible, so only the context follows the lost outputs */
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        Cy_CSDIDAC_SeqWriteBegin(idacContext);
+        idacContext->channelStateA = CY_CSDIDAC_DISABLE;
+        idacContext->channelStateB = CY_CSDIDAC_DISABLE;
+        Cy_CSDIDAC_SeqWriteEnd(idacContext);
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_HEALTH, interruptState, csStartTime, idacContext);
+    }
+    else if (CY_CSDIDAC_HEALTH_REAPPLY == context->policy)
+    {
+        /* The disabled channels go first, as disabling opens the bypass switch used by a joined channel */
+        if ((CY_CSDIDAC_DISABLE == idacContext->channelStateA) && (0u != (faults & CY_CSDIDAC_HEALTH_FAULT_CH_A)))
+        {
+            (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_A, idacContext);
+        }
+        if ((CY_CSDIDAC_DISABLE == idacContext->channelStateB) && (0u != (faults & CY_CSDIDAC_HEALTH_FAULT_CH_B)))
+        {
+            (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_B, idacContext);
+        }
+        if (CY_CSDIDAC_ENABLE == idacContext->channelStateA)
+        {
+            (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, idacContext->polarityA, idacContext->lsbA,
+                                             (uint32_t)idacContext->codeA, idacContext);
+        }
+        if (CY_CSDIDAC_ENABLE == idacContext->channelStateB)
+        {
+            (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_B, idacContext->polarityB, idacContext->lsbB,
+                                             (uint32_t)idacContext->codeB, idacContext);
+        }
+    }
+    else
+    {
+        (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, idacContext);
+    }
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
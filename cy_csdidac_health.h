@@ -0,0 +1,130 @@
+/***************************************************************************//**
+* \file cy_csdidac_health.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC health checker.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_HEALTH_H)
+#define CY_CSDIDAC_HEALTH_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/** The CSD HW block is not captured by the CSDIDAC middleware anymore. */
+#define CY_CSDIDAC_HEALTH_FAULT_LOCK            (0x01u)
+/** The IDACA register differs from the context. */
+#define CY_CSDIDAC_HEALTH_FAULT_IDACA           (0x02u)
+/** The IDACB register differs from the context. */
+#define CY_CSDIDAC_HEALTH_FAULT_IDACB           (0x04u)
+/** The bypass A switch differs from the channel routing. */
+#define CY_CSDIDAC_HEALTH_FAULT_BYPA            (0x08u)
+/** The bypass B switch differs from the channel routing. */
+#define CY_CSDIDAC_HEALTH_FAULT_BYPB            (0x10u)
+/** The channel A pin is not connected to AMuxBusA. */
+#define CY_CSDIDAC_HEALTH_FAULT_PINA            (0x20u)
+/** The channel B pin is not connected to AMuxBusB. */
+#define CY_CSDIDAC_HEALTH_FAULT_PINB            (0x40u)
+
+/** \} group_csdidac_macros */
+
+
+/***************************************
+* Enumerated Types and Parameters
+***************************************/
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The CSDIDAC health checker recovery policy. */
+typedef enum
+{
+    CY_CSDIDAC_HEALTH_REAPPLY  = 0u,        /**< The context state is written to the hardware again. */
+    CY_CSDIDAC_HEALTH_DISABLE  = 1u,        /**< Both the channels are disabled. */
+    CY_CSDIDAC_HEALTH_CALLBACK = 2u,        /**< Only the callback is executed. */
+} cy_en_csdidac_health_policy_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/**
+* The health checker fault callback. Receives the detected fault mask, a
+* combination of the CY_CSDIDAC_HEALTH_FAULT_ macros, after the recovery
+* policy is executed.
+*/
+typedef void (* cy_csdidac_health_callback_t)(uint32_t faults, cy_stc_csdidac_context_t * idacContext);
+
+/** The CSDIDAC health checker context structure, that contains the internal checker data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    cy_en_csdidac_health_policy_t policy;   /**< The recovery policy. */
+    cy_csdidac_health_callback_t callback;  /**< The fault callback, may be NULL. */
+    uint32_t idacMask;                      /**<
+                                             * The compared bits of the IDAC registers. The code bits
+                                             * are excluded with ~CY_CSDIDAC_IDAC_WORD_CODE_MASK when
+                                             * the channel is updated through the register fast path.
+                                             */
+    uint32_t lastFaults;                    /**< The faults detected by the last check. */
+    uint32_t checkCnt;                      /**< The number of the checks. */
+    uint32_t faultCnt;                      /**< The number of the checks that detected a fault. */
+} cy_stc_csdidac_health_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_HealthInit(
+                cy_en_csdidac_health_policy_t policy,
+                cy_csdidac_health_callback_t callback,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_health_context_t * context);
+uint32_t Cy_CSDIDAC_HealthCheck(
+                cy_stc_csdidac_health_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_HEALTH_H */
+
+
+/* [] END OF FILE */
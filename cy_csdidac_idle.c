@@ -0,0 +1,295 @@
+/***************************************************************************//**
+* \file cy_csdidac_idle.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC zero-current idle gating implementation.
+*
+* The channel fields are read by Cy_CSDIDAC_ReadChannelState(), so the
+* gating does not mask the interrupts while it checks the channels. The
+* parking is done only if the sequence counter of the CSDIDAC context is
+* not changed since the read, so a new setpoint written in between is not
+* disabled.
+*
+* The re-arming is the usual enable of a disabled channel: one bypass
+* switch write, one write of the PC, PC2, and HSIOM registers of the pin
+* port through a routing batch, and the IDAC register write, so its latency
+* does not depend on how long the channel was parked.
+*
+* The residency statistics are kept in the idle gating context, so the
+* CSDIDAC context of an application without the gating does not grow.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_idle.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Static Function Prototypes
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static void Cy_CSDIDAC_IdleUpdate(
+                uint32_t idx,
+                cy_en_csdidac_state_t channelState,
+                uint8_t code,
+                uint32_t seq,
+                cy_stc_csdidac_idle_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_IdleInit
+****************************************************************************//**
+*
+* Initializes the idle gating of the specified channels. The residency
+* statistics are cleared.
+*
+* Only the channels set through Cy_CSDIDAC_OutputEnable() or
+* Cy_CSDIDAC_OutputEnableExt() are gated. A channel written by the fast
+* path, for instance by the LED driver or the waveform playback, is not
+* passed to the idle gating, as its code in the CSDIDAC context is not
+* updated by the register stores.
+*
+* \param ch
+* The gated channels, CY_CSDIDAC_A, CY_CSDIDAC_B, or CY_CSDIDAC_AB.
+*
+* \param holdTicks
+* The number of Cy_CSDIDAC_IdleProcess() calls a channel is kept at the
+* zero code before it is parked. With zero, the channel is parked by
+* the first call that finds the zero code.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the idle gating context structure
+* \ref cy_stc_csdidac_idle_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t holdTicks,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_idle_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+
+    if ((NULL != idacContext) && (NULL != context) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)))
+    {
+        context->idacCxtPtr = idacContext;
+        context->channels = ch;
+        context->holdTicks = holdTicks;
+        for (i = 0u; i < CY_CSDIDAC_IDLE_CH_NUM; i++)
+        {
+            context->zeroTicks[i] = 0u;
+            context->state[i] = CY_CSDIDAC_IDLE_OFF;
+        }
+        result = Cy_CSDIDAC_IdleResetStats(context);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_IdleProcess
+****************************************************************************//**
+*
+* Updates the power state of the gated channels and parks the channels that
+* are at the zero code for longer than the hold time.
+*
+* The function is called periodically, for instance from the main loop, and
+* its period is the unit of the hold time and of the residency statistics.
+* A parked channel is disabled in the CSDIDAC context, so the deep sleep is
+* allowed by Cy_CSDIDAC_DeepSleepCallback() when no other channel is
+* enabled. A parked channel that is enabled again with a non-zero code
+* counts as re-armed.
+*
+* \param context
+* The pointer to the initialized idle gating context structure
+* \ref cy_stc_csdidac_idle_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+* * CY_CSDIDAC_HW_BUSY    - The channel fields are being updated, the states
+*                           are updated by the next call.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleProcess(
+                cy_stc_csdidac_idle_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_channel_state_t state;
+
+    if (NULL != context)
+    {
+        result = Cy_CSDIDAC_ReadChannelState(&state, context->idacCxtPtr);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            if ((CY_CSDIDAC_A == context->channels) || (CY_CSDIDAC_AB == context->channels))
+            {
+                Cy_CSDIDAC_IdleUpdate(0u, state.channelStateA, state.codeA, state.seq, context);
+            }
+            if ((CY_CSDIDAC_B == context->channels) || (CY_CSDIDAC_AB == context->channels))
+            {
+                Cy_CSDIDAC_IdleUpdate(1u, state.channelStateB, state.codeB, state.seq, context);
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_IdleResetStats
+****************************************************************************//**
+*
+* Clears the residency statistics and the parking and re-arming counters.
+*
+* \param context
+* The pointer to the idle gating context structure
+* \ref cy_stc_csdidac_idle_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleResetStats(
+                cy_stc_csdidac_idle_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+    uint32_t st;
+
+    if (NULL != context)
+    {
+        for (i = 0u; i < CY_CSDIDAC_IDLE_CH_NUM; i++)
+        {
+            for (st = 0u; st < (uint32_t)CY_CSDIDAC_IDLE_STATE_NUM; st++)
+            {
+                context->residency[i][st] = 0u;
+            }
+            context->parkCnt[i] = 0u;
+            context->rearmCnt[i] = 0u;
+        }
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_IdleUpdate
+****************************************************************************//**
+*
+* Updates the power state of a channel, parks it if the hold time is over,
+* and accounts the call in the residency statistics.
+*
+* \param idx
+* The channel index, 0u for IdacA, 1u for IdacB.
+*
+* \param channelState
+* The channel state read from the CSDIDAC context.
+*
+* \param code
+* The channel code read from the CSDIDAC context.
+*
+* \param seq
+* The sequence counter value of the read.
+*
+* \param context
+* The pointer to the idle gating context structure
+* \ref cy_stc_csdidac_idle_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_IdleUpdate(
+                uint32_t idx,
+                cy_en_csdidac_state_t channelState,
+                uint8_t code,
+                uint32_t seq,
+                cy_stc_csdidac_idle_context_t * context)
+{
+    cy_en_csdidac_idle_state_t nextState;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if (CY_CSDIDAC_DISABLE == channelState)
+    {
+        /* A parked channel stays parked until it is enabled again */
+        nextState = (CY_CSDIDAC_IDLE_PARKED == context->state[idx]) ? CY_CSDIDAC_IDLE_PARKED : CY_CSDIDAC_IDLE_OFF;
+        context->zeroTicks[idx] = 0u;
+    }
+    else
+    {
+        if (0u == code)
+        {
+            nextState = CY_CSDIDAC_IDLE_ZERO;
+            context->zeroTicks[idx]++;
+        }
+        else
+        {
+            /* An enable at the zero code is parked again and is not a re-arm */
+            if (CY_CSDIDAC_IDLE_PARKED == context->state[idx])
+            {
+                context->rearmCnt[idx]++;
+            }
+            nextState = CY_CSDIDAC_IDLE_ACTIVE;
+            context->zeroTicks[idx] = 0u;
+        }
+        if ((CY_CSDIDAC_IDLE_ZERO == nextState) && (context->zeroTicks[idx] > context->holdTicks))
+        {
+            /* A setpoint written after the read is not disabled */
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            if ((seq == context->idacCxtPtr->seq) &&
+                (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_OutputDisable((0u == idx) ? CY_CSDIDAC_A : CY_CSDIDAC_B,
+                                                                context->idacCxtPtr)))
+            {
+                nextState = CY_CSDIDAC_IDLE_PARKED;
+                context->parkCnt[idx]++;
+                context->zeroTicks[idx] = 0u;
+            }
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_IDLE, interruptState, csStartTime, context->idacCxtPtr);
+        }
+    }
+
+    context->state[idx] = nextState;
+    context->residency[idx][nextState]++;
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
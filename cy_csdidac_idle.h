@@ -0,0 +1,122 @@
+/***************************************************************************//**
+* \file cy_csdidac_idle.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC zero-current idle gating.
+*
+* An enabled channel with the zero code still has the IDAC leg enabled, the
+* bypass switch closed, and the pin routed to the analog bus, and it blocks
+* the device deep sleep in Cy_CSDIDAC_DeepSleepCallback(). The idle gating
+* parks such a channel after a hold time: Cy_CSDIDAC_IdleProcess(), called
+* periodically, disables it with Cy_CSDIDAC_OutputDisable(). The next
+* Cy_CSDIDAC_OutputEnable() or Cy_CSDIDAC_OutputEnableExt() call re-arms
+* the channel as a usual enable, so the application does not track
+* the parking.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_IDLE_H)
+#define CY_CSDIDAC_IDLE_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/** The number of the channels with the idle gating. */
+#define CY_CSDIDAC_IDLE_CH_NUM                  (2u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The power state of a gated channel, as seen by Cy_CSDIDAC_IdleProcess(). */
+typedef enum
+{
+    CY_CSDIDAC_IDLE_OFF           = 0u,     /**< The channel is disabled by the application. */
+    CY_CSDIDAC_IDLE_ACTIVE        = 1u,     /**< The channel is enabled with a non-zero code. */
+    CY_CSDIDAC_IDLE_ZERO          = 2u,     /**< The channel is enabled with the zero code, the hold time runs. */
+    CY_CSDIDAC_IDLE_PARKED        = 3u,     /**< The channel is parked by the idle gating. */
+    CY_CSDIDAC_IDLE_STATE_NUM     = 4u,     /**< The number of the power states. */
+}cy_en_csdidac_idle_state_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC idle gating context structure, that contains the gating state and residency statistics. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    cy_en_csdidac_choice_t channels;        /**< The gated channels. */
+    uint32_t holdTicks;                     /**< The Cy_CSDIDAC_IdleProcess() calls a zero code is kept before the parking. */
+    uint32_t zeroTicks[CY_CSDIDAC_IDLE_CH_NUM]; /**< The calls the channel is at the zero code. */
+    cy_en_csdidac_idle_state_t state[CY_CSDIDAC_IDLE_CH_NUM]; /**< The power state of the channel. */
+    uint32_t residency[CY_CSDIDAC_IDLE_CH_NUM][CY_CSDIDAC_IDLE_STATE_NUM];
+                                            /**<
+                                             * The number of the Cy_CSDIDAC_IdleProcess() calls
+                                             * per channel and power state.
+                                             */
+    uint32_t parkCnt[CY_CSDIDAC_IDLE_CH_NUM];  /**< The number of the parkings of the channel. */
+    uint32_t rearmCnt[CY_CSDIDAC_IDLE_CH_NUM]; /**< The number of the non-zero enables of the parked channel. */
+} cy_stc_csdidac_idle_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t holdTicks,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_idle_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleProcess(
+                cy_stc_csdidac_idle_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_IdleResetStats(
+                cy_stc_csdidac_idle_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_IDLE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,320 @@
+/***************************************************************************//**
+* \file cy_csdidac_led.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC gamma-corrected LED intensity driver
+* implementation. The LED is driven by an IDAC channel in the sink mode,
+* the brightness is mapped to the IDAC register words through a gamma
+* table generated at compile time.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_led.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+#if ((8u != CY_CSDIDAC_LED_BITS) && (10u != CY_CSDIDAC_LED_BITS))
+    #error "CY_CSDIDAC_LED_BITS must be 8u or 10u"
+#endif
+
+#if (CY_CSDIDAC_LED_MAX_CURRENT_NA > CY_CSDIDAC_MAX_CURRENT_NA)
+    #error "CY_CSDIDAC_LED_MAX_CURRENT_NA exceeds CY_CSDIDAC_MAX_CURRENT_NA"
+#endif
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+
+/*
+* The gamma curve. The LED current for the brightness b of the maximum N is
+*   I(b) = Imax * b^2 * (b + N) / (2 * N^3)
+* that is the mean of the gamma 2 and gamma 3 curves, close to the CIE
+* lightness response over the most of the range. The current is in pA,
+* the 64-bit math is evaluated by the compiler only.
+*/
+#define CY_CSDIDAC_LED_N                        ((uint64_t)CY_CSDIDAC_LED_MAX_BRIGHTNESS)
+#define CY_CSDIDAC_LED_PA(b)                    ((uint32_t)(((uint64_t)CY_CSDIDAC_LED_MAX_CURRENT_NA * 1000uLL * \
+                                                             (uint64_t)(b) * (uint64_t)(b) * \
+                                                             ((uint64_t)(b) + CY_CSDIDAC_LED_N)) / \
+                                                            (2uLL * CY_CSDIDAC_LED_N * CY_CSDIDAC_LED_N * CY_CSDIDAC_LED_N)))
+
+/*
+* The minimum LSB that covers the current, as chosen by
+* Cy_CSDIDAC_OutputEnable(), and the LSB size in pA
+*/
+#define CY_CSDIDAC_LED_LSB(pa)                  (((pa) <   4762500u) ? CY_CSDIDAC_LSB_37_IDX  : \
+                                                 ((pa) <   9525000u) ? CY_CSDIDAC_LSB_75_IDX  : \
+                                                 ((pa) <  38100000u) ? CY_CSDIDAC_LSB_300_IDX : \
+                                                 ((pa) <  76200000u) ? CY_CSDIDAC_LSB_600_IDX : \
+                                                 ((pa) < 304800000u) ? CY_CSDIDAC_LSB_2400_IDX : CY_CSDIDAC_LSB_4800_IDX)
+#define CY_CSDIDAC_LED_LSB_PA(pa)               (((pa) <   4762500u) ?   37500u : \
+                                                 ((pa) <   9525000u) ?   75000u : \
+                                                 ((pa) <  38100000u) ?  300000u : \
+                                                 ((pa) <  76200000u) ?  600000u : \
+                                                 ((pa) < 304800000u) ? 2400000u : 4800000u)
+
+/* The code is rounded to the nearest, so the low brightness levels are not lost */
+#define CY_CSDIDAC_LED_CODE(pa)                 ((((pa) + (CY_CSDIDAC_LED_LSB_PA(pa) / 2u)) / CY_CSDIDAC_LED_LSB_PA(pa)) > CY_CSDIDAC_MAX_CODE ? \
+                                                 CY_CSDIDAC_MAX_CODE : \
+                                                 (((pa) + (CY_CSDIDAC_LED_LSB_PA(pa) / 2u)) / CY_CSDIDAC_LED_LSB_PA(pa)))
+
+#define CY_CSDIDAC_LED_WORD(b)                  CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SINK, \
+                                                                     CY_CSDIDAC_LED_LSB(CY_CSDIDAC_LED_PA(b)), \
+                                                                     CY_CSDIDAC_LED_CODE(CY_CSDIDAC_LED_PA(b)))
+
+/* The table generators */
+#define CY_CSDIDAC_LED_W4(b)                    CY_CSDIDAC_LED_WORD((b)),        CY_CSDIDAC_LED_WORD((b) + 1u), \
+                                                CY_CSDIDAC_LED_WORD((b) + 2u),   CY_CSDIDAC_LED_WORD((b) + 3u)
+#define CY_CSDIDAC_LED_W16(b)                   CY_CSDIDAC_LED_W4((b)),          CY_CSDIDAC_LED_W4((b) + 4u), \
+                                                CY_CSDIDAC_LED_W4((b) + 8u),     CY_CSDIDAC_LED_W4((b) + 12u)
+#define CY_CSDIDAC_LED_W64(b)                   CY_CSDIDAC_LED_W16((b)),         CY_CSDIDAC_LED_W16((b) + 16u), \
+                                                CY_CSDIDAC_LED_W16((b) + 32u),   CY_CSDIDAC_LED_W16((b) + 48u)
+#define CY_CSDIDAC_LED_W256(b)                  CY_CSDIDAC_LED_W64((b)),         CY_CSDIDAC_LED_W64((b) + 64u), \
+                                                CY_CSDIDAC_LED_W64((b) + 128u),  CY_CSDIDAC_LED_W64((b) + 192u)
+#define CY_CSDIDAC_LED_W1024(b)                 CY_CSDIDAC_LED_W256((b)),        CY_CSDIDAC_LED_W256((b) + 256u), \
+                                                CY_CSDIDAC_LED_W256((b) + 512u), CY_CSDIDAC_LED_W256((b) + 768u)
+
+const uint32_t cy_csdidac_ledGamma[CY_CSDIDAC_LED_MAX_BRIGHTNESS + 1u] =
+{
+#if (8u == CY_CSDIDAC_LED_BITS)
+    CY_CSDIDAC_LED_W256(0u)
+#else
+    CY_CSDIDAC_LED_W1024(0u)
+#endif
+};
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedInit
+****************************************************************************//**
+*
+* Initializes the LED driver and enables the LED channel in the sink mode
+* with the zero brightness.
+*
+* \param ch
+* The LED channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the LED driver context structure
+* \ref cy_stc_csdidac_led_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_LedInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_led_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        /* Connects the channel, the brightness is then changed with the fast path */
+        result = Cy_CSDIDAC_OutputEnableExt(ch, CY_CSDIDAC_SINK, CY_CSDIDAC_LSB_37_IDX, 0u, idacContext);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            context->idacCxtPtr = idacContext;
+            context->idacReg = Cy_CSDIDAC_GetIdacReg(ch, idacContext);
+            context->channel = ch;
+            context->brightness = 0u;
+            context->target = 0u;
+            context->fadeTicks = 0u;
+            Cy_CSDIDAC_LedSetBrightness(0u, context);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedFade
+****************************************************************************//**
+*
+* Starts a fade from the brightness of the last fade step to the specified
+* brightness. The fade is linear in the gamma-corrected brightness, so it
+* looks perceptually uniform. The steps are applied by Cy_CSDIDAC_LedProcess().
+*
+* \param brightness
+* The target brightness from 0u to \ref CY_CSDIDAC_LED_MAX_BRIGHTNESS.
+*
+* \param ticks
+* The fade duration in Cy_CSDIDAC_LedProcess() calls. If 0u, the target
+* brightness is applied immediately.
+*
+* \param context
+* The pointer to the initialized LED driver context
+* structure \ref cy_stc_csdidac_led_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_LedFade(
+                uint32_t brightness,
+                uint32_t ticks,
+                cy_stc_csdidac_led_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    int32_t diff;
+
+    if ((NULL != context) && (CY_CSDIDAC_LED_MAX_BRIGHTNESS >= brightness))
+    {
+        context->target = brightness;
+        if (0u == ticks)
+        {
+            context->fadeTicks = 0u;
+            context->brightness = brightness;
+            Cy_CSDIDAC_LedSetBrightness(brightness, context);
+        }
+        else
+        {
+            diff = (int32_t)brightness - (int32_t)context->brightness;
+            context->fadeStep = diff / (int32_t)ticks;
+            context->fadeRem = (uint32_t)((0 > diff) ? -(diff % (int32_t)ticks) : (diff % (int32_t)ticks));
+            context->fadeDiv = ticks;
+            context->fadeErr = 0u;
+            context->fadeTicks = ticks;
+        }
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedProcess
+****************************************************************************//**
+*
+* Applies the next step of an active fade. The function is called from
+* the periodic waveform tick, for instance, together with
+* Cy_CSDIDAC_SeqProcess().
+*
+* \param context
+* The pointer to the initialized LED driver context
+* structure \ref cy_stc_csdidac_led_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_LedProcess(
+                cy_stc_csdidac_led_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    int32_t brightness;
+
+    if (NULL != context)
+    {
+        if (0u != context->fadeTicks)
+        {
+            context->fadeTicks--;
+            if (0u == context->fadeTicks)
+            {
+                brightness = (int32_t)context->target;
+            }
+            else
+            {
+                brightness = (int32_t)context->brightness + context->fadeStep;
+                context->fadeErr += context->fadeRem;
+                if (context->fadeErr >= context->fadeDiv)
+                {
+                    context->fadeErr -= context->fadeDiv;
+                    brightness += ((int32_t)context->target < brightness) ? -1 : 1;
+                }
+            }
+            context->brightness = (uint32_t)brightness;
+            Cy_CSDIDAC_LedSetBrightness(context->brightness, context);
+        }
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedIsFading
+****************************************************************************//**
+*
+* Checks if a fade is active.
+*
+* \param context
+* The pointer to the LED driver context structure
+* \ref cy_stc_csdidac_led_context_t.
+*
+* \return
+* true if a fade is active, false otherwise or if the input pointer is NULL.
+*
+*******************************************************************************/
+bool Cy_CSDIDAC_LedIsFading(
+                const cy_stc_csdidac_led_context_t * context)
+{
+    return ((NULL != context) && (0u != context->fadeTicks));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedStop
+****************************************************************************//**
+*
+* Stops an active fade and disables the LED channel.
+*
+* \param context
+* The pointer to the initialized LED driver context
+* structure \ref cy_stc_csdidac_led_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_LedStop(
+                cy_stc_csdidac_led_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->fadeTicks = 0u;
+        context->brightness = 0u;
+        context->target = 0u;
+        result = Cy_CSDIDAC_OutputDisable(context->channel, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
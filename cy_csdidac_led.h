@@ -0,0 +1,143 @@
+/***************************************************************************//**
+* \file cy_csdidac_led.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC gamma-corrected LED intensity driver.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_LED_H)
+#define CY_CSDIDAC_LED_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_LED_BITS)
+/** The LED brightness resolution in bits, 8u or 10u. */
+#define CY_CSDIDAC_LED_BITS                     (8u)
+#endif
+
+#if !defined(CY_CSDIDAC_LED_MAX_CURRENT_NA)
+/** The LED sink current at the maximum brightness in nA. */
+#define CY_CSDIDAC_LED_MAX_CURRENT_NA           (CY_CSDIDAC_MAX_CURRENT_NA)
+#endif
+
+/** The maximum LED brightness. */
+#define CY_CSDIDAC_LED_MAX_BRIGHTNESS           ((1uL << CY_CSDIDAC_LED_BITS) - 1u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC LED driver context structure, that contains the internal driver data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * idacReg;            /**< The IDAC register of the LED channel. */
+    cy_en_csdidac_choice_t channel;         /**< The LED channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    uint32_t brightness;                    /**< The brightness applied by the last fade step. */
+    uint32_t target;                        /**< The fade target brightness. */
+    uint32_t fadeTicks;                     /**< The remaining fade steps. */
+    int32_t fadeStep;                       /**< The integer part of the fade step. */
+    uint32_t fadeRem;                       /**< The absolute remainder of the fade step. */
+    uint32_t fadeDiv;                       /**< The fade step divider, the fade ticks. */
+    uint32_t fadeErr;                       /**< The fade remainder accumulator. */
+} cy_stc_csdidac_led_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+*/
+/* The gamma-corrected IDAC register words indexed by the brightness */
+extern const uint32_t cy_csdidac_ledGamma[CY_CSDIDAC_LED_MAX_BRIGHTNESS + 1u];
+/** \endcond */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_LedInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_led_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_LedFade(
+                uint32_t brightness,
+                uint32_t ticks,
+                cy_stc_csdidac_led_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_LedProcess(
+                cy_stc_csdidac_led_context_t * context);
+bool Cy_CSDIDAC_LedIsFading(
+                const cy_stc_csdidac_led_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_LedStop(
+                cy_stc_csdidac_led_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_LedSetBrightness
+****************************************************************************//**
+*
+* Sets the LED brightness immediately.
+*
+* The gamma-corrected IDAC register word is precomputed at compile time,
+* so the update is one table load and one IDAC register store. The function
+* does not stop an active fade and does not update the CSDIDAC context, see
+* Cy_CSDIDAC_GetIdacReg().
+*
+* \param brightness
+* The brightness from 0u to \ref CY_CSDIDAC_LED_MAX_BRIGHTNESS. The upper
+* bits are ignored.
+*
+* \param context
+* The pointer to the initialized LED driver context
+* structure \ref cy_stc_csdidac_led_context_t.
+*
+*******************************************************************************/
+__STATIC_INLINE void Cy_CSDIDAC_LedSetBrightness(uint32_t brightness,
+                                                 const cy_stc_csdidac_led_context_t * context)
+{
+    *context->idacReg = cy_csdidac_ledGamma[brightness & CY_CSDIDAC_LED_MAX_BRIGHTNESS];
+}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_LED_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,402 @@
+/***************************************************************************//**
+* \file cy_csdidac_mgr.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC multi-instance manager implementation.
+* The manager addresses the IDAC channels of several CSD HW blocks as
+* one flat channel space: channel 2*N is IDAC A and channel 2*N+1 is
+* IDAC B of the CSD HW block N.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_mgr.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Function Prototypes - Internal Functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static cy_en_csdidac_status_t Cy_CSDIDAC_MgrApply(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_mgr_update_t * update,
+                cy_stc_csdidac_context_t * idacContext);
+static cy_en_csdidac_channel_config_t Cy_CSDIDAC_MgrGetChannelConfig(
+                uint32_t channel,
+                const cy_stc_csdidac_mgr_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_MGR_NO_UPDATE                (0xFFFFFFFFuL)
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrInit
+****************************************************************************//**
+*
+* Initializes the CSDIDAC multi-instance manager.
+*
+* Each CSD HW block is initialized by Cy_CSDIDAC_Init() with its own
+* configuration and context structure before the manager is used.
+* The manager keeps the pointers to these contexts and addresses
+* the channels as a flat channel space, see CY_CSDIDAC_MGR_CHANNEL().
+*
+* \param idacContexts
+* The array of the pointers to the initialized CSDIDAC context structures,
+* one per CSD HW block.
+*
+* \param numBlocks
+* The number of the CSD HW blocks, from 1 to \ref CY_CSDIDAC_MGR_MAX_BLOCKS.
+*
+* \param context
+* The pointer to the manager context structure
+* \ref cy_stc_csdidac_mgr_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrInit(
+                cy_stc_csdidac_context_t * const idacContexts[],
+                uint32_t numBlocks,
+                cy_stc_csdidac_mgr_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t block;
+
+    if ((NULL != idacContexts) && (NULL != context) &&
+        (0u != numBlocks) && (CY_CSDIDAC_MGR_MAX_BLOCKS >= numBlocks))
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        for (block = 0u; block < numBlocks; block++)
+        {
+            if (NULL == idacContexts[block])
+            {
+                result = CY_CSDIDAC_BAD_PARAM;
+            }
+        }
+
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            for (block = 0u; block < numBlocks; block++)
+            {
+                context->idacCxtPtr[block] = idacContexts[block];
+            }
+            context->numBlocks = numBlocks;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrOutputEnable
+****************************************************************************//**
+*
+* Enables a channel of the flat channel space with the specified current.
+*
+* \param channel
+* The flat channel number, see CY_CSDIDAC_MGR_CHANNEL().
+*
+* \param current
+* The current in nA with a sign, see Cy_CSDIDAC_OutputEnable().
+*
+* \param context
+* The pointer to the manager context structure
+* \ref cy_stc_csdidac_mgr_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrOutputEnable(
+                uint32_t channel,
+                int32_t current,
+                const cy_stc_csdidac_mgr_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != context) && ((context->numBlocks * CY_CSDIDAC_MGR_CH_PER_BLOCK) > channel))
+    {
+        result = Cy_CSDIDAC_OutputEnable((cy_en_csdidac_choice_t)(channel % CY_CSDIDAC_MGR_CH_PER_BLOCK), current,
+                                         context->idacCxtPtr[channel / CY_CSDIDAC_MGR_CH_PER_BLOCK]);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrOutputDisable
+****************************************************************************//**
+*
+* Disables a channel of the flat channel space.
+*
+* \param channel
+* The flat channel number, see CY_CSDIDAC_MGR_CHANNEL().
+*
+* \param context
+* The pointer to the manager context structure
+* \ref cy_stc_csdidac_mgr_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrOutputDisable(
+                uint32_t channel,
+                const cy_stc_csdidac_mgr_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != context) && ((context->numBlocks * CY_CSDIDAC_MGR_CH_PER_BLOCK) > channel))
+    {
+        result = Cy_CSDIDAC_OutputDisable((cy_en_csdidac_choice_t)(channel % CY_CSDIDAC_MGR_CH_PER_BLOCK),
+                                          context->idacCxtPtr[channel / CY_CSDIDAC_MGR_CH_PER_BLOCK]);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrUpdateGroup
+****************************************************************************//**
+*
+* Updates a group of channels of the flat channel space at once.
+*
+* The function performs the following:
+* * Verifies all the updates. If any update is invalid, no channel is changed.
+*   An update of a channel configured as CY_CSDIDAC_DISABLED is invalid,
+*   as is enabling a CY_CSDIDAC_JOIN channel while the same group disables
+*   the channel it is joined to.
+* * Coalesces the updates per channel. If a channel is updated several times,
+*   the last update is applied.
+* * Applies the updates block by block. Both channels of a CSD HW block are
+*   updated in one critical section, so their registers are written
+*   together. If both channels of a block get the same enabled current,
+*   a single Cy_CSDIDAC_OutputEnable() call with CY_CSDIDAC_AB is used.
+*
+* \param updates
+* The array of the channel updates.
+*
+* \param numUpdates
+* The number of the channel updates.
+*
+* \param context
+* The pointer to the manager context structure
+* \ref cy_stc_csdidac_mgr_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrUpdateGroup(
+                const cy_stc_csdidac_mgr_update_t * updates,
+                uint32_t numUpdates,
+                const cy_stc_csdidac_mgr_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_en_csdidac_status_t chResult;
+    uint32_t pending[CY_CSDIDAC_MGR_MAX_BLOCKS * CY_CSDIDAC_MGR_CH_PER_BLOCK];
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t idx;
+    uint32_t block;
+    const cy_stc_csdidac_mgr_update_t * updA;
+    const cy_stc_csdidac_mgr_update_t * updB;
+    cy_stc_csdidac_context_t * idacCxt;
+
+    if ((NULL != updates) && (NULL != context) && (0u != numUpdates))
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        for (idx = 0u; idx < (CY_CSDIDAC_MGR_MAX_BLOCKS * CY_CSDIDAC_MGR_CH_PER_BLOCK); idx++)
+        {
+            pending[idx] = CY_CSDIDAC_MGR_NO_UPDATE;
+        }
+
+        /* Verifies and coalesces the updates */
+        for (idx = 0u; idx < numUpdates; idx++)
+        {
+            if (((context->numBlocks * CY_CSDIDAC_MGR_CH_PER_BLOCK) > updates[idx].channel) &&
+                (CY_CSDIDAC_DISABLED != Cy_CSDIDAC_MgrGetChannelConfig(updates[idx].channel, context)) &&
+                ((CY_CSDIDAC_DISABLE == updates[idx].state) ||
+                 ((CY_CSDIDAC_ENABLE == updates[idx].state) &&
+                  ((int32_t)CY_CSDIDAC_MAX_CURRENT_NA >= updates[idx].current) &&
+                  (-(int32_t)CY_CSDIDAC_MAX_CURRENT_NA <= updates[idx].current))))
+            {
+                pending[updates[idx].channel] = idx;
+            }
+            else
+            {
+                result = CY_CSDIDAC_BAD_PARAM;
+            }
+        }
+
+        /*
+        * Verifies the coalesced updates of each block. A joined channel
+        * outputs through the pin of the other channel, so it is not enabled
+        * while the other channel is disabled by the same group.
+        */
+        for (block = 0u; (block < context->numBlocks) && (CY_CSDIDAC_SUCCESS == result); block++)
+        {
+            idx = CY_CSDIDAC_MGR_CHANNEL(block, CY_CSDIDAC_A);
+            if ((CY_CSDIDAC_MGR_NO_UPDATE != pending[idx]) && (CY_CSDIDAC_MGR_NO_UPDATE != pending[idx + 1u]))
+            {
+                updA = &updates[pending[idx]];
+                updB = &updates[pending[idx + 1u]];
+                if (((CY_CSDIDAC_JOIN == Cy_CSDIDAC_MgrGetChannelConfig(idx, context)) &&
+                     (CY_CSDIDAC_ENABLE == updA->state) && (CY_CSDIDAC_DISABLE == updB->state)) ||
+                    ((CY_CSDIDAC_JOIN == Cy_CSDIDAC_MgrGetChannelConfig(idx + 1u, context)) &&
+                     (CY_CSDIDAC_ENABLE == updB->state) && (CY_CSDIDAC_DISABLE == updA->state)))
+                {
+                    result = CY_CSDIDAC_BAD_PARAM;
+                }
+            }
+        }
+
+        /* Applies the updates block by block */
+        for (block = 0u; (block < context->numBlocks) && (CY_CSDIDAC_SUCCESS == result); block++)
+        {
+            idx = CY_CSDIDAC_MGR_CHANNEL(block, CY_CSDIDAC_A);
+            updA = (CY_CSDIDAC_MGR_NO_UPDATE != pending[idx]) ? &updates[pending[idx]] : NULL;
+            updB = (CY_CSDIDAC_MGR_NO_UPDATE != pending[idx + 1u]) ? &updates[pending[idx + 1u]] : NULL;
+            idacCxt = context->idacCxtPtr[block];
+
+            if ((NULL != updA) || (NULL != updB))
+            {
+                interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+                if ((NULL != updA) && (NULL != updB) &&
+                    (CY_CSDIDAC_ENABLE == updA->state) && (CY_CSDIDAC_ENABLE == updB->state) &&
+                    (updA->current == updB->current))
+                {
+                    result = Cy_CSDIDAC_MgrApply(CY_CSDIDAC_AB, updA, idacCxt);
+                }
+                else
+                {
+                    if (NULL != updA)
+                    {
+                        result = Cy_CSDIDAC_MgrApply(CY_CSDIDAC_A, updA, idacCxt);
+                    }
+                    if (NULL != updB)
+                    {
+                        chResult = Cy_CSDIDAC_MgrApply(CY_CSDIDAC_B, updB, idacCxt);
+                        if (CY_CSDIDAC_SUCCESS == result)
+                        {
+                            result = chResult;
+                        }
+                    }
+                }
+                Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_MGR, interruptState, csStartTime, idacCxt);
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrApply
+****************************************************************************//**
+*
+* Applies a single update to a channel of a CSD HW block.
+*
+* \param ch
+* The channel choice in the CSD HW block.
+*
+* \param update
+* The pointer to the update.
+*
+* \param idacContext
+* The pointer to the CSDIDAC context of the CSD HW block.
+*
+* \return
+* The status of the CSDIDAC function call.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_MgrApply(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_mgr_update_t * update,
+                cy_stc_csdidac_context_t * idacContext)
+{
+    cy_en_csdidac_status_t result;
+
+    if (CY_CSDIDAC_ENABLE == update->state)
+    {
+        result = Cy_CSDIDAC_OutputEnable(ch, update->current, idacContext);
+    }
+    else
+    {
+        result = Cy_CSDIDAC_OutputDisable(ch, idacContext);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_MgrGetChannelConfig
+****************************************************************************//**
+*
+* Returns the configuration of a channel of the flat channel space.
+*
+* \param channel
+* The flat channel number, less than the number of the managed channels.
+*
+* \param context
+* The pointer to the manager context structure
+* \ref cy_stc_csdidac_mgr_context_t.
+*
+* \return
+* The channel configuration in its CSD HW block.
+*
+*******************************************************************************/
+static cy_en_csdidac_channel_config_t Cy_CSDIDAC_MgrGetChannelConfig(
+                uint32_t channel,
+                const cy_stc_csdidac_mgr_context_t * context)
+{
+    const cy_stc_csdidac_config_t * config = &context->idacCxtPtr[channel / CY_CSDIDAC_MGR_CH_PER_BLOCK]->cfgCopy;
+
+    return ((CY_CSDIDAC_A == (cy_en_csdidac_choice_t)(channel % CY_CSDIDAC_MGR_CH_PER_BLOCK)) ?
+            config->configA : config->configB);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
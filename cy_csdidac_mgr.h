@@ -0,0 +1,108 @@
+/***************************************************************************//**
+* \file cy_csdidac_mgr.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC multi-instance manager.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_MGR_H)
+#define CY_CSDIDAC_MGR_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_MGR_MAX_BLOCKS)
+/** The maximum number of CSD HW blocks handled by one manager. */
+#define CY_CSDIDAC_MGR_MAX_BLOCKS               (4u)
+#endif
+
+/** The number of IDAC channels per CSD HW block. */
+#define CY_CSDIDAC_MGR_CH_PER_BLOCK             (2u)
+
+/** Converts a CSD HW block index and a channel choice to a flat channel number. */
+#define CY_CSDIDAC_MGR_CHANNEL(block, ch)       (((uint32_t)(block) * CY_CSDIDAC_MGR_CH_PER_BLOCK) + (uint32_t)(ch))
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC manager channel update. */
+typedef struct
+{
+    uint16_t channel;                       /**< The flat channel number, see CY_CSDIDAC_MGR_CHANNEL(). */
+    cy_en_csdidac_state_t state;            /**< CY_CSDIDAC_ENABLE to set the current, CY_CSDIDAC_DISABLE to disable the channel. */
+    int32_t current;                        /**< The current in nA with a sign, see Cy_CSDIDAC_OutputEnable(). */
+} cy_stc_csdidac_mgr_update_t;
+
+/** The CSDIDAC manager context structure. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr[CY_CSDIDAC_MGR_MAX_BLOCKS];
+                                            /**< The CSDIDAC contexts, one per CSD HW block. */
+    uint32_t numBlocks;                     /**< The number of the managed CSD HW blocks. */
+} cy_stc_csdidac_mgr_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrInit(
+                cy_stc_csdidac_context_t * const idacContexts[],
+                uint32_t numBlocks,
+                cy_stc_csdidac_mgr_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrOutputEnable(
+                uint32_t channel,
+                int32_t current,
+                const cy_stc_csdidac_mgr_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrOutputDisable(
+                uint32_t channel,
+                const cy_stc_csdidac_mgr_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_MgrUpdateGroup(
+                const cy_stc_csdidac_mgr_update_t * updates,
+                uint32_t numUpdates,
+                const cy_stc_csdidac_mgr_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_MGR_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,449 @@
+/***************************************************************************//**
+* \file cy_csdidac_persist.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC operating point persistence implementation.
+* The enabled channel setpoints are stored as IDAC register words in a ring
+* of flash rows, so every row is written in turn, and are restored after
+* a reset.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_persist.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+/* The record layout, in 32-bit words at the start of a storage row */
+#define CY_CSDIDAC_PERSIST_MAGIC_IDX            (0u)
+#define CY_CSDIDAC_PERSIST_SEQUENCE_IDX         (1u)
+#define CY_CSDIDAC_PERSIST_WORD_IDX             (2u)
+#define CY_CSDIDAC_PERSIST_CHECK_IDX            (CY_CSDIDAC_PERSIST_WORD_IDX + CY_CSDIDAC_PERSIST_CH_NUM)
+
+#define CY_CSDIDAC_PERSIST_MAGIC                (0x49444143uL)
+#define CY_CSDIDAC_PERSIST_ROW_WORDS            (CY_CSDIDAC_PERSIST_ROW_SIZE / 4u)
+
+
+/*******************************************************************************
+* Function Prototypes - internal functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_PersistChecksum(const uint32_t * record);
+static void Cy_CSDIDAC_PersistGetWords(
+                uint32_t * words,
+                const cy_stc_csdidac_persist_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_PersistWrite(
+                cy_stc_csdidac_persist_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistInit
+****************************************************************************//**
+*
+* Initializes the operating point persistence and finds the latest valid
+* record in the storage area.
+*
+* The storage area is a number of flash rows reserved by the application,
+* for instance a row-aligned constant array. The records are written to the
+* rows in turn, so each row is erased once per rowCount records. A record
+* with a wrong checksum, for instance a row write interrupted by a reset,
+* is skipped and the previous record is used.
+*
+* \param ch
+* The persisted channels, CY_CSDIDAC_A, CY_CSDIDAC_B, or CY_CSDIDAC_AB.
+* A channel updated through the register fast path, for instance by the LED
+* driver, is not persisted, as the context does not follow its setpoint.
+*
+* \param area
+* The pointer to the storage area aligned to
+* \ref CY_CSDIDAC_PERSIST_ROW_SIZE.
+*
+* \param rowCount
+* The number of the storage rows in the area, one or more.
+*
+* \param writeFunc
+* The flash row write function. Cy_Flash_WriteRow() is used if NULL.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistInit(
+                cy_en_csdidac_choice_t ch,
+                const uint8_t * area,
+                uint32_t rowCount,
+                cy_csdidac_persist_write_t writeFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_persist_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    const uint32_t * record;
+    bool found = false;
+    uint32_t row;
+    uint32_t i;
+
+    if ((NULL != idacContext) && (NULL != context) && (NULL != area) && (0u != rowCount) &&
+        (0u == ((uintptr_t)area % CY_CSDIDAC_PERSIST_ROW_SIZE)) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)))
+    {
+        context->idacCxtPtr = idacContext;
+        context->writeFunc = (NULL != writeFunc) ? writeFunc : &Cy_Flash_WriteRow;
+        context->area = area;
+        context->rowCount = rowCount;
+        context->channels = ch;
+        context->sequence = 0u;
+        context->nextRow = 0u;
+        context->holdoff = 0u;
+        context->writeCnt = 0u;
+        for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+        {
+            context->storedWord[i] = 0u;
+        }
+
+        for (row = 0u; row < rowCount; row++)
+        {
+            record = (const uint32_t *)(const void *)&area[row * CY_CSDIDAC_PERSIST_ROW_SIZE];
+            if ((CY_CSDIDAC_PERSIST_MAGIC == record[CY_CSDIDAC_PERSIST_MAGIC_IDX]) &&
+                (Cy_CSDIDAC_PersistChecksum(record) == record[CY_CSDIDAC_PERSIST_CHECK_IDX]) &&
+                ((false == found) ||
+                 (0 <= (int32_t)(record[CY_CSDIDAC_PERSIST_SEQUENCE_IDX] - context->sequence))))
+            {
+                /* The latest record wins, the sequence number wraparound is handled by the signed difference */
+                found = true;
+                context->sequence = record[CY_CSDIDAC_PERSIST_SEQUENCE_IDX] + 1u;
+                context->nextRow = (row + 1u) % rowCount;
+                for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+                {
+                    context->storedWord[i] = record[CY_CSDIDAC_PERSIST_WORD_IDX + i];
+                }
+            }
+        }
+
+        for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+        {
+            context->pendingWord[i] = context->storedWord[i];
+        }
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistRestore
+****************************************************************************//**
+*
+* Restores the stored operating point of the persisted channels.
+*
+* The function is called after Cy_CSDIDAC_Init() and
+* Cy_CSDIDAC_PersistInit(). Each stored enabled channel is enabled by
+* Cy_CSDIDAC_OutputEnableExt() with the stored polarity, LSB, and code, which
+* is a single IDAC register write per channel. The channels without a stored
+* setpoint are kept disabled.
+*
+* \param context
+* The pointer to the initialized persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS           - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM         - The input pointer is NULL.
+* * CY_CSDIDAC_BAD_CONFIGURATION - The stored register word is invalid.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistRestore(
+                cy_stc_csdidac_persist_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t word;
+    uint32_t i;
+
+    if (NULL != context)
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        for (i = 0u; (i < CY_CSDIDAC_PERSIST_CH_NUM) && (CY_CSDIDAC_SUCCESS == result); i++)
+        {
+            word = context->storedWord[i];
+            if ((0u == word) || ((CY_CSDIDAC_AB != context->channels) && ((uint32_t)context->channels != i)))
+            {
+                /* The channel was disabled or is not persisted */
+            }
+            else if (false == Cy_CSDIDAC_IsIdacWordValid(word))
+            {
+                result = CY_CSDIDAC_BAD_CONFIGURATION;
+            }
+            else
+            {
+                result = Cy_CSDIDAC_OutputEnableExt((cy_en_csdidac_choice_t)i,
+                                                    (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(word),
+                                                    (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(word),
+                                                    word & CY_CSDIDAC_IDAC_WORD_CODE_MASK,
+                                                    context->idacCxtPtr);
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistProcess
+****************************************************************************//**
+*
+* Tracks the operating point of the persisted channels and writes it to
+* the flash after it is stable for \ref CY_CSDIDAC_PERSIST_HOLDOFF calls.
+*
+* The function is called periodically from the main loop, as the flash row
+* write stalls the CPU. Every change restarts the hold-off, so a burst of
+* changes is coalesced into one record, and an operating point equal to the
+* stored one is not written again. A failed write is retried after the next
+* hold-off.
+*
+* \param context
+* The pointer to the initialized persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+* * CY_CSDIDAC_HW_FAILURE - The flash row write failed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistProcess(
+                cy_stc_csdidac_persist_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t words[CY_CSDIDAC_PERSIST_CH_NUM];
+    uint32_t i;
+
+    if (NULL != context)
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        Cy_CSDIDAC_PersistGetWords(words, context);
+
+        if ((words[0u] != context->pendingWord[0u]) || (words[1u] != context->pendingWord[1u]))
+        {
+            for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+            {
+                context->pendingWord[i] = words[i];
+            }
+            context->holdoff = CY_CSDIDAC_PERSIST_HOLDOFF;
+        }
+        else if (0u != context->holdoff)
+        {
+            context->holdoff--;
+            if (0u == context->holdoff)
+            {
+                result = Cy_CSDIDAC_PersistWrite(context);
+                if (CY_CSDIDAC_SUCCESS != result)
+                {
+                    context->holdoff = CY_CSDIDAC_PERSIST_HOLDOFF;
+                }
+            }
+        }
+        else
+        {
+            /* The operating point is stored */
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistFlush
+****************************************************************************//**
+*
+* Writes the current operating point of the persisted channels to the flash
+* immediately, if it differs from the stored one. Used before an expected
+* power-down or reset.
+*
+* \param context
+* The pointer to the initialized persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+* * CY_CSDIDAC_HW_FAILURE - The flash row write failed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistFlush(
+                cy_stc_csdidac_persist_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        Cy_CSDIDAC_PersistGetWords(context->pendingWord, context);
+        context->holdoff = 0u;
+        result = Cy_CSDIDAC_PersistWrite(context);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistChecksum
+****************************************************************************//**
+*
+* Calculates the checksum of a record.
+*
+* \param record
+* The pointer to the record words.
+*
+* \return
+* The inverted sum of the record words before the checksum.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_PersistChecksum(const uint32_t * record)
+{
+    uint32_t sum = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < CY_CSDIDAC_PERSIST_CHECK_IDX; i++)
+    {
+        sum += record[i];
+    }
+
+    return (~sum);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistGetWords
+****************************************************************************//**
+*
+* Gets the IDAC register words of the persisted channels from the CSDIDAC
+* context. The word of a disabled or not persisted channel is zero.
+*
+* \param words
+* The pointer to the array of \ref CY_CSDIDAC_PERSIST_CH_NUM words.
+*
+* \param context
+* The pointer to the persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_PersistGetWords(
+                uint32_t * words,
+                const cy_stc_csdidac_persist_context_t * context)
+{
+    cy_stc_csdidac_channel_state_t state;
+
+    words[0u] = 0u;
+    words[1u] = 0u;
+    if (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_ReadChannelState(&state, context->idacCxtPtr))
+    {
+        if (((CY_CSDIDAC_A == context->channels) || (CY_CSDIDAC_AB == context->channels)) &&
+            (CY_CSDIDAC_ENABLE == state.channelStateA))
+        {
+            words[0u] = CY_CSDIDAC_IDAC_WORD(state.polarityA, state.lsbA, state.codeA);
+        }
+        if (((CY_CSDIDAC_B == context->channels) || (CY_CSDIDAC_AB == context->channels)) &&
+            (CY_CSDIDAC_ENABLE == state.channelStateB))
+        {
+            words[1u] = CY_CSDIDAC_IDAC_WORD(state.polarityB, state.lsbB, state.codeB);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PersistWrite
+****************************************************************************//**
+*
+* Writes the pending operating point to the next storage row, if it differs
+* from the stored one.
+*
+* \param context
+* The pointer to the persistence context structure
+* \ref cy_stc_csdidac_persist_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_HW_FAILURE - The flash row write failed.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_PersistWrite(
+                cy_stc_csdidac_persist_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_SUCCESS;
+    uint32_t rowData[CY_CSDIDAC_PERSIST_ROW_WORDS] = {0u};
+    uint32_t i;
+
+    if ((context->pendingWord[0u] != context->storedWord[0u]) ||
+        (context->pendingWord[1u] != context->storedWord[1u]))
+    {
+        rowData[CY_CSDIDAC_PERSIST_MAGIC_IDX] = CY_CSDIDAC_PERSIST_MAGIC;
+        rowData[CY_CSDIDAC_PERSIST_SEQUENCE_IDX] = context->sequence;
+        for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+        {
+            rowData[CY_CSDIDAC_PERSIST_WORD_IDX + i] = context->pendingWord[i];
+        }
+        rowData[CY_CSDIDAC_PERSIST_CHECK_IDX] = Cy_CSDIDAC_PersistChecksum(rowData);
+
+        if (CY_FLASH_DRV_SUCCESS == context->writeFunc(
+                (uint32_t)(uintptr_t)&context->area[context->nextRow * CY_CSDIDAC_PERSIST_ROW_SIZE], rowData))
+        {
+            for (i = 0u; i < CY_CSDIDAC_PERSIST_CH_NUM; i++)
+            {
+                context->storedWord[i] = context->pendingWord[i];
+            }
+            context->sequence++;
+            context->nextRow = (context->nextRow + 1u) % context->rowCount;
+            context->writeCnt++;
+        }
+        else
+        {
+            result = CY_CSDIDAC_HW_FAILURE;
+        }
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+* \file cy_csdidac_persist.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC operating point persistence.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_PERSIST_H)
+#define CY_CSDIDAC_PERSIST_H
+
+#include "cy_csdidac.h"
+#include "cy_flash.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_PERSIST_HOLDOFF)
+/**
+* The number of Cy_CSDIDAC_PersistProcess() calls a new operating point must
+* be stable before it is written to the flash. A burst of changes within
+* this time results in a single flash row write.
+*/
+#define CY_CSDIDAC_PERSIST_HOLDOFF              (1000u)
+#endif
+
+/** The number of the persisted channels in a record. */
+#define CY_CSDIDAC_PERSIST_CH_NUM               (2u)
+
+/** The size in bytes of a persistence storage row. */
+#define CY_CSDIDAC_PERSIST_ROW_SIZE             (CY_FLASH_SIZEOF_ROW)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/**
+* The flash row write function. Cy_Flash_WriteRow() is used on the target,
+* a RAM stand-in is used on the host.
+*/
+typedef cy_en_flashdrv_status_t (* cy_csdidac_persist_write_t)(uint32_t rowAddr, const uint32_t * data);
+
+/** The CSDIDAC persistence context structure, that contains the internal persistence data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    cy_csdidac_persist_write_t writeFunc;   /**< The flash row write function. */
+    const uint8_t * area;                   /**< The row-aligned storage area. */
+    uint32_t rowCount;                      /**< The number of the storage rows used in turn. */
+    cy_en_csdidac_choice_t channels;        /**< The persisted channels. */
+    uint32_t sequence;                      /**< The sequence number of the next record. */
+    uint32_t nextRow;                       /**< The storage row of the next record. */
+    uint32_t storedWord[CY_CSDIDAC_PERSIST_CH_NUM];  /**< The IDAC register words of the last record, zero if disabled. */
+    uint32_t pendingWord[CY_CSDIDAC_PERSIST_CH_NUM]; /**< The IDAC register words waiting for the hold-off. */
+    uint32_t holdoff;                       /**< The remaining hold-off calls. */
+    uint32_t writeCnt;                      /**< The number of the flash row writes. */
+} cy_stc_csdidac_persist_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistInit(
+                cy_en_csdidac_choice_t ch,
+                const uint8_t * area,
+                uint32_t rowCount,
+                cy_csdidac_persist_write_t writeFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_persist_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistRestore(
+                cy_stc_csdidac_persist_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistProcess(
+                cy_stc_csdidac_persist_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_PersistFlush(
+                cy_stc_csdidac_persist_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_PERSIST_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,430 @@
+/***************************************************************************//**
+* \file cy_csdidac_pulse.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC pulsed-current mode implementation.
+*
+* The timer compare is shared by both the trains: each train keeps the timer
+* counter value of its next edge, and Cy_CSDIDAC_PulseProcess() handles
+* the trains whose edge is the scheduled one and schedules the nearest of
+* the next edges. The edge times are computed from the previous edge times,
+* not from the interrupt time, so the interrupt latency does not accumulate
+* in the pulse timing.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_pulse.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_PULSE_PERIOD_MAX             (CY_CSDIDAC_PULSE_TIME_MASK >> 1u)
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseInit
+****************************************************************************//**
+*
+* Initializes the pulsed-current mode. No train is running.
+*
+* \param scheduleFunc
+* The function that programs the timer compare. The timer is a free-running
+* counter with \ref CY_CSDIDAC_PULSE_TIME_MASK valid bits, and its compare
+* interrupt calls Cy_CSDIDAC_PulseProcess(). For instance, a TCPWM counter
+* with Cy_TCPWM_Counter_SetCompare0().
+*
+* \param timeFunc
+* The function that returns the timer counter value, for instance
+* Cy_TCPWM_Counter_GetCounter() of the same counter.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseInit(
+                cy_csdidac_pulse_schedule_t scheduleFunc,
+                cy_csdidac_pulse_time_t timeFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_pulse_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+
+    if ((NULL != scheduleFunc) && (NULL != timeFunc) && (NULL != idacContext) && (NULL != context))
+    {
+        context->idacCxtPtr = idacContext;
+        context->scheduleFunc = scheduleFunc;
+        context->timeFunc = timeFunc;
+        for (i = 0u; i < CY_CSDIDAC_PULSE_CH_NUM; i++)
+        {
+            context->train[i].on = false;
+            context->train[i].running = false;
+            context->train[i].pulseCnt = 0u;
+            context->train[i].onTicks = 0u;
+        }
+        context->edgeTime = 0u;
+        context->scheduled = false;
+        context->runStart = 0u;
+        context->runTicks = 0u;
+        context->sleepTicks = 0u;
+        context->sleepCnt = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseStart
+****************************************************************************//**
+*
+* Starts a pulse train on a channel.
+*
+* The current is converted by Cy_CSDIDAC_CurrentToCode(), and the channel is
+* enabled through Cy_CSDIDAC_OutputEnableExt() with the zero code, so it is
+* routed once and each edge is a single IDAC register store. The train
+* starts with a pulse at the next scheduled edge of the other train, or
+* \ref CY_CSDIDAC_PULSE_MIN_TICKS after the call if no train is running.
+* The pulse and train counters of the channel are cleared.
+*
+* \param ch
+* The channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param current
+* The pulse current in nA with a sign, the absolute value is up to
+* \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+* \param width
+* The pulse width in the timer ticks, at least
+* \ref CY_CSDIDAC_PULSE_MIN_TICKS.
+*
+* \param period
+* The pulse period in the timer ticks. The off time, period minus width,
+* is at least \ref CY_CSDIDAC_PULSE_MIN_TICKS, and the period is up to half
+* of the \ref CY_CSDIDAC_PULSE_TIME_MASK range.
+*
+* \param count
+* The number of the pulses, or zero for an endless train.
+*
+* \param context
+* The pointer to the initialized pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL, an invalid parameter
+*                           is passed, or the train of the channel is running.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseStart(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                uint32_t width,
+                uint32_t period,
+                uint32_t count,
+                cy_stc_csdidac_pulse_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_pulse_train_t * train;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)) &&
+        (CY_CSDIDAC_PULSE_MIN_TICKS <= width) && (period > width) &&
+        (CY_CSDIDAC_PULSE_MIN_TICKS <= (period - width)) && (CY_CSDIDAC_PULSE_PERIOD_MAX >= period) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, context->idacCxtPtr->cfgCopy.configA,
+                                                 context->idacCxtPtr->cfgCopy.configB)))
+    {
+        train = &context->train[(CY_CSDIDAC_A == ch) ? 0u : 1u];
+        if (false == train->running)
+        {
+            result = Cy_CSDIDAC_CurrentToCode(current, &polarity, &lsbIndex, &code);
+        }
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            result = Cy_CSDIDAC_OutputEnableExt(ch, polarity, lsbIndex, 0u, context->idacCxtPtr);
+        }
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            train->idacReg = Cy_CSDIDAC_GetIdacReg(ch, context->idacCxtPtr);
+            train->onWord = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, code);
+            train->offWord = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, 0u);
+            train->width = width;
+            train->period = period;
+            train->remaining = count;
+            train->on = false;
+            train->pulseCnt = 0u;
+            train->onTicks = 0u;
+
+            /* The edge interrupt does not run between the check and the update of the schedule */
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            if (false == context->scheduled)
+            {
+                context->runStart = context->timeFunc();
+                context->edgeTime = (context->runStart + CY_CSDIDAC_PULSE_MIN_TICKS) & CY_CSDIDAC_PULSE_TIME_MASK;
+                context->scheduled = true;
+                context->scheduleFunc(context->edgeTime);
+            }
+            train->nextEdge = context->edgeTime;
+            train->running = true;
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_PULSE, interruptState, csStartTime, context->idacCxtPtr);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseStop
+****************************************************************************//**
+*
+* Stops the pulse train of a channel. A pulse in progress is cut, and
+* the channel is kept enabled with the zero code, which is the channel
+* configuration in the CSDIDAC context. Use Cy_CSDIDAC_OutputDisable() to
+* disable the channel.
+*
+* \param ch
+* The channel, CY_CSDIDAC_A, CY_CSDIDAC_B, or CY_CSDIDAC_AB.
+*
+* \param context
+* The pointer to the initialized pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseStop(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_pulse_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_pulse_train_t * train;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t i;
+
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch) || (CY_CSDIDAC_AB == ch)))
+    {
+        for (i = 0u; i < CY_CSDIDAC_PULSE_CH_NUM; i++)
+        {
+            train = &context->train[i];
+            if ((CY_CSDIDAC_AB == ch) || ((uint32_t)ch == i))
+            {
+                interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+                if (true == train->running)
+                {
+                    train->running = false;
+                    train->on = false;
+                    *train->idacReg = train->offWord;
+                }
+                Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_PULSE, interruptState, csStartTime, context->idacCxtPtr);
+            }
+        }
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseProcess
+****************************************************************************//**
+*
+* Outputs the scheduled edge and schedules the next one.
+*
+* The trains whose next edge is the scheduled one store the pulse or zero
+* code word. A train with a pulse count stops after its last pulse. The
+* nearest next edge of the running trains is programmed through
+* the schedule function. When no train is running, nothing is scheduled.
+*
+* The timer counter is read on each call, and the time since the previous
+* read is added to the running time. The running time so covers the time
+* from the start of a train to the edge interrupt after the trains end,
+* which contains every sleep of Cy_CSDIDAC_PulseSleep().
+*
+* The function is intended for the timer compare interrupt, so the
+* parameters are not verified.
+*
+* \param context
+* The pointer to the initialized pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_PulseProcess(
+                cy_stc_csdidac_pulse_context_t * context)
+{
+    cy_stc_csdidac_pulse_train_t * train;
+    uint32_t delay;
+    uint32_t minDelay = CY_CSDIDAC_PULSE_TIME_MASK;
+    bool running = false;
+    uint32_t now;
+    uint32_t i;
+
+    now = context->timeFunc();
+    context->runTicks += (now - context->runStart) & CY_CSDIDAC_PULSE_TIME_MASK;
+    context->runStart = now;
+
+    for (i = 0u; i < CY_CSDIDAC_PULSE_CH_NUM; i++)
+    {
+        train = &context->train[i];
+        if ((true == train->running) && (train->nextEdge == context->edgeTime))
+        {
+            if (true == train->on)
+            {
+                *train->idacReg = train->offWord;
+                train->on = false;
+                train->pulseCnt++;
+                train->onTicks += train->width;
+                train->nextEdge = (train->nextEdge + (train->period - train->width)) & CY_CSDIDAC_PULSE_TIME_MASK;
+                if (0u != train->remaining)
+                {
+                    train->remaining--;
+                    train->running = (0u != train->remaining);
+                }
+            }
+            else
+            {
+                *train->idacReg = train->onWord;
+                train->on = true;
+                train->nextEdge = (train->nextEdge + train->width) & CY_CSDIDAC_PULSE_TIME_MASK;
+            }
+        }
+        if (true == train->running)
+        {
+            delay = (train->nextEdge - context->edgeTime) & CY_CSDIDAC_PULSE_TIME_MASK;
+            if (delay < minDelay)
+            {
+                minDelay = delay;
+            }
+            running = true;
+        }
+    }
+
+    if (true == running)
+    {
+        context->edgeTime = (context->edgeTime + minDelay) & CY_CSDIDAC_PULSE_TIME_MASK;
+        context->scheduleFunc(context->edgeTime);
+    }
+    else
+    {
+        context->scheduled = false;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseSleep
+****************************************************************************//**
+*
+* Puts the CPU to the Sleep mode until the next interrupt, if a train is
+* running, and adds the sleep time to the sleep statistics.
+*
+* The function is called from the main loop instead of a delay. The sleep
+* is entered with the interrupts masked, so an edge between the check and
+* the sleep wakes the CPU at once, and the edge interrupt runs after
+* the wake-up time is read, so its execution is accounted as the active
+* time. A sleep lasts until the scheduled edge interrupt at most, so it is
+* within the running time, and the active time is runTicks minus
+* sleepTicks.
+*
+* \param context
+* The pointer to the initialized pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_PulseSleep(
+                cy_stc_csdidac_pulse_context_t * context)
+{
+    uint32_t interruptState;
+    uint32_t sleepStart;
+
+    if (NULL != context)
+    {
+        /* Not instrumented, the sleep is not an interrupt latency, see CY_CSDIDAC_CS_STATS_EN */
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        if (true == context->scheduled)
+        {
+            sleepStart = context->timeFunc();
+            (void)Cy_SysPm_CpuEnterSleep();
+            context->sleepTicks += (context->timeFunc() - sleepStart) & CY_CSDIDAC_PULSE_TIME_MASK;
+            context->sleepCnt++;
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_PulseIsRunning
+****************************************************************************//**
+*
+* Checks whether the pulse train of a channel is running.
+*
+* \param ch
+* The channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param context
+* The pointer to the initialized pulsed-current context structure
+* \ref cy_stc_csdidac_pulse_context_t.
+*
+* \return
+* True if the train is running, false if it is stopped, completed, or
+* the parameters are invalid.
+*
+*******************************************************************************/
+bool Cy_CSDIDAC_PulseIsRunning(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_pulse_context_t * context)
+{
+    bool running = false;
+
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        running = context->train[(CY_CSDIDAC_A == ch) ? 0u : 1u].running;
+    }
+
+    return (running);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
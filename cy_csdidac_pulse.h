@@ -0,0 +1,159 @@
+/***************************************************************************//**
+* \file cy_csdidac_pulse.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC pulsed-current mode.
+*
+* Each channel outputs a train of current pulses with the specified width
+* and period. The edges of both the channels are timed by one compare of
+* a free-running timer owned by the application: Cy_CSDIDAC_PulseProcess(),
+* called from the timer interrupt, writes the IDAC register word of the
+* edge and programs the compare of the next edge through a callback. In
+* between, the main loop calls Cy_CSDIDAC_PulseSleep(), so the CPU sleeps
+* and is woken by the next edge.
+*
+* The CPU Sleep mode is used, as the CSD HW block and the timer are not
+* clocked in the Deep Sleep mode, and Cy_CSDIDAC_DeepSleepCallback() does
+* not allow the Deep Sleep mode while a channel is enabled.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_PULSE_H)
+#define CY_CSDIDAC_PULSE_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_PULSE_TIME_MASK)
+/**
+* The valid bits of the pulse timer counter. The default value corresponds
+* to a 16-bit TCPWM counter. The pulse period is up to half of the counter
+* range.
+*/
+#define CY_CSDIDAC_PULSE_TIME_MASK              (0x0000FFFFuL)
+#endif
+
+#if !defined(CY_CSDIDAC_PULSE_MIN_TICKS)
+/**
+* The minimum pulse width and off time in the timer ticks. The timer compare
+* of an edge is programmed by the interrupt of the previous edge, so the time
+* between the edges covers the interrupt latency and the
+* Cy_CSDIDAC_PulseProcess() execution time.
+*/
+#define CY_CSDIDAC_PULSE_MIN_TICKS              (16u)
+#endif
+
+/** The number of the pulse trains, one per channel. */
+#define CY_CSDIDAC_PULSE_CH_NUM                 (2u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** Programs the timer compare to interrupt at the timer counter value edgeTime. */
+typedef void (* cy_csdidac_pulse_schedule_t)(uint32_t edgeTime);
+
+/** Returns the timer counter value. */
+typedef uint32_t (* cy_csdidac_pulse_time_t)(void);
+
+/** The pulse train of a channel. */
+typedef struct
+{
+    volatile uint32_t * idacReg;            /**< The IDAC register of the channel. */
+    uint32_t onWord;                        /**< The IDAC register word of the pulse. */
+    uint32_t offWord;                       /**< The IDAC register word between the pulses, with the zero code. */
+    uint32_t width;                         /**< The pulse width in the timer ticks. */
+    uint32_t period;                        /**< The pulse period in the timer ticks. */
+    uint32_t remaining;                     /**< The remaining pulses, zero for an endless train. */
+    uint32_t nextEdge;                      /**< The timer counter value of the next edge. */
+    bool on;                                /**< The pulse is output. */
+    volatile bool running;                  /**< The train is running. */
+    uint32_t pulseCnt;                      /**< The number of the output pulses. */
+    uint32_t onTicks;                       /**< The total pulse time in the timer ticks. */
+} cy_stc_csdidac_pulse_train_t;
+
+/** The CSDIDAC pulsed-current context structure, that contains the pulse trains and residency statistics. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    cy_csdidac_pulse_schedule_t scheduleFunc; /**< The timer compare programming function. */
+    cy_csdidac_pulse_time_t timeFunc;       /**< The timer counter read function. */
+    cy_stc_csdidac_pulse_train_t train[CY_CSDIDAC_PULSE_CH_NUM]; /**< The pulse trains of IdacA and IdacB. */
+    uint32_t edgeTime;                      /**< The timer counter value of the scheduled edge. */
+    volatile bool scheduled;                /**< An edge is scheduled. */
+    uint32_t runStart;                      /**< The timer counter value runTicks is accumulated to. */
+    uint32_t runTicks;                      /**< The time in the timer ticks from a train start to the edge after the trains end. */
+    uint32_t sleepTicks;                    /**< The time in the timer ticks the CPU slept with a running train. */
+    uint32_t sleepCnt;                      /**< The number of the CPU sleeps. */
+} cy_stc_csdidac_pulse_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseInit(
+                cy_csdidac_pulse_schedule_t scheduleFunc,
+                cy_csdidac_pulse_time_t timeFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_pulse_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseStart(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                uint32_t width,
+                uint32_t period,
+                uint32_t count,
+                cy_stc_csdidac_pulse_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_PulseStop(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_pulse_context_t * context);
+void Cy_CSDIDAC_PulseProcess(
+                cy_stc_csdidac_pulse_context_t * context);
+void Cy_CSDIDAC_PulseSleep(
+                cy_stc_csdidac_pulse_context_t * context);
+bool Cy_CSDIDAC_PulseIsRunning(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_pulse_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_PULSE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,308 @@
+/***************************************************************************//**
+* \file cy_csdidac_reg.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC closed-loop current regulator implementation.
+* An integer PI controller adjusts the IDAC output current to hold the sense
+* voltage (typically measured across the load resistor) at the target value.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_reg.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_REG_MAX_OUTPUT_Q             ((int32_t)(CY_CSDIDAC_MAX_CURRENT_NA << CY_CSDIDAC_REG_GAIN_SHIFT))
+
+
+/*******************************************************************************
+* Function Prototypes - Internal Functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static int32_t Cy_CSDIDAC_RegClampError(uint32_t errorMv);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RegInit
+****************************************************************************//**
+*
+* Initializes the closed-loop current regulator.
+*
+* The regulator uses the already initialized CSDIDAC middleware to drive
+* the specified channel. The output is not enabled by this function: the first
+* Cy_CSDIDAC_RegProcess() call that performs a control update enables it.
+*
+* The sense voltage is provided by the senseFunc function of the configuration.
+* It can read the CSD HW block ADC, an external ADC or a stand-in model.
+* Note that the CSD HW block cannot perform ADC conversions while it is
+* captured by the CSDIDAC middleware, so the CSD ADC is used in
+* Time-multiplexed mode with the Cy_CSDIDAC_Save() / Cy_CSDIDAC_Restore()
+* functions or another ADC is used.
+*
+* \param config
+* The pointer to the regulator configuration structure
+* \ref cy_stc_csdidac_reg_config_t.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC context structure
+* \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the regulator context structure
+* \ref cy_stc_csdidac_reg_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RegInit(
+                const cy_stc_csdidac_reg_config_t * config,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_reg_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != config) && (NULL != idacContext) && (NULL != context))
+    {
+        if ((NULL != config->senseFunc) &&
+            ((CY_CSDIDAC_A == config->channel) || (CY_CSDIDAC_B == config->channel)) &&
+            (true == Cy_CSDIDAC_IsIdacPolarityValid(config->polarity)) &&
+            (CY_CSDIDAC_REG_MAX_GAIN >= config->kp) &&
+            (CY_CSDIDAC_REG_MAX_GAIN >= config->ki) &&
+            (0u != config->loopDivider))
+        {
+            context->cfgCopy = *config;
+            context->idacCxtPtr = idacContext;
+            context->integral = 0;
+            context->outputNa = 0u;
+            context->errorMv = 0;
+            context->tickCnt = 0u;
+            context->state = CY_CSDIDAC_ENABLE;
+            result = CY_CSDIDAC_SUCCESS;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RegSetTarget
+****************************************************************************//**
+*
+* Changes the target sense voltage of the regulator.
+*
+* The integrator state is kept, so the output moves smoothly to the new
+* operating point.
+*
+* \param targetMv
+* The target sense voltage in mV.
+*
+* \param context
+* The pointer to the regulator context structure
+* \ref cy_stc_csdidac_reg_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RegSetTarget(
+                uint32_t targetMv,
+                cy_stc_csdidac_reg_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->cfgCopy.targetMv = targetMv;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RegProcess
+****************************************************************************//**
+*
+* Runs the regulator. The function is called periodically, for example from
+* a timer interrupt.
+*
+* Every loopDivider calls, the function reads the sense voltage, runs the
+* PI controller and updates the IDAC output if the computed current changed.
+* The control update uses only 32-bit integer multiplications and shifts.
+* The error is computed and clamped to +/-(CY_CSDIDAC_REG_MAX_ERROR_MV) in
+* unsigned math, so any target and sense voltage is safe. With the gains
+* limited to CY_CSDIDAC_REG_MAX_GAIN, the gain products and the sum with
+* the integrator stay below 2^29 in magnitude.
+* The integrator is clamped to the IDAC output range to prevent windup.
+*
+* \param context
+* The pointer to the regulator context structure
+* \ref cy_stc_csdidac_reg_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or the regulator
+*                           is stopped.
+* * The status of the sense function or of Cy_CSDIDAC_OutputEnable()
+*   if it failed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RegProcess(
+                cy_stc_csdidac_reg_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t senseMv = 0u;
+    int32_t errorMv;
+    int32_t outputQ;
+    uint32_t outputNa;
+
+    if ((NULL != context) && (CY_CSDIDAC_ENABLE == context->state))
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        context->tickCnt++;
+        if (context->tickCnt >= context->cfgCopy.loopDivider)
+        {
+            context->tickCnt = 0u;
+            result = context->cfgCopy.senseFunc(context->cfgCopy.senseData, &senseMv);
+            if (CY_CSDIDAC_SUCCESS == result)
+            {
+                /* Clamps the error in unsigned math, so any target and sense voltage is safe */
+                if (context->cfgCopy.targetMv >= senseMv)
+                {
+                    errorMv = Cy_CSDIDAC_RegClampError(context->cfgCopy.targetMv - senseMv);
+                }
+                else
+                {
+                    errorMv = -Cy_CSDIDAC_RegClampError(senseMv - context->cfgCopy.targetMv);
+                }
+                context->errorMv = errorMv;
+
+                /* Integrates the error with anti-windup clamping */
+                context->integral += (int32_t)context->cfgCopy.ki * errorMv;
+                if (context->integral > CY_CSDIDAC_REG_MAX_OUTPUT_Q)
+                {
+                    context->integral = CY_CSDIDAC_REG_MAX_OUTPUT_Q;
+                }
+                else if (context->integral < 0)
+                {
+                    context->integral = 0;
+                }
+                else
+                {
+                    /* The integrator is in range */
+                }
+
+                outputQ = context->integral + ((int32_t)context->cfgCopy.kp * errorMv);
+                if (outputQ > CY_CSDIDAC_REG_MAX_OUTPUT_Q)
+                {
+                    outputQ = CY_CSDIDAC_REG_MAX_OUTPUT_Q;
+                }
+                else if (outputQ < 0)
+                {
+                    outputQ = 0;
+                }
+                else
+                {
+                    /* The output is in range */
+                }
+                outputNa = (uint32_t)outputQ >> CY_CSDIDAC_REG_GAIN_SHIFT;
+
+                /* Skips the register path if the output current is unchanged */
+                if ((outputNa != context->outputNa) ||
+                    ((CY_CSDIDAC_A == context->cfgCopy.channel) && (CY_CSDIDAC_DISABLE == context->idacCxtPtr->channelStateA)) ||
+                    ((CY_CSDIDAC_B == context->cfgCopy.channel) && (CY_CSDIDAC_DISABLE == context->idacCxtPtr->channelStateB)))
+                {
+                    context->outputNa = outputNa;
+                    result = Cy_CSDIDAC_OutputEnable(context->cfgCopy.channel,
+                                    (CY_CSDIDAC_SINK == context->cfgCopy.polarity) ? -(int32_t)outputNa : (int32_t)outputNa,
+                                    context->idacCxtPtr);
+                }
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RegStop
+****************************************************************************//**
+*
+* Stops the regulator and disables the regulated IDAC output.
+*
+* \param context
+* The pointer to the regulator context structure
+* \ref cy_stc_csdidac_reg_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RegStop(
+                cy_stc_csdidac_reg_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->state = CY_CSDIDAC_DISABLE;
+        context->integral = 0;
+        context->outputNa = 0u;
+        result = Cy_CSDIDAC_OutputDisable(context->cfgCopy.channel, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RegClampError
+****************************************************************************//**
+*
+* Clamps the magnitude of the regulation error to CY_CSDIDAC_REG_MAX_ERROR_MV.
+*
+*******************************************************************************/
+static int32_t Cy_CSDIDAC_RegClampError(uint32_t errorMv)
+{
+    return (((uint32_t)CY_CSDIDAC_REG_MAX_ERROR_MV < errorMv) ? CY_CSDIDAC_REG_MAX_ERROR_MV : (int32_t)errorMv);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
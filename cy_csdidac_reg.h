@@ -0,0 +1,125 @@
+/***************************************************************************//**
+* \file cy_csdidac_reg.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC closed-loop current regulator.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_REG_H)
+#define CY_CSDIDAC_REG_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/**
+* The number of fractional bits of the regulator gains. The kp and ki
+* fields of \ref cy_stc_csdidac_reg_config_t are in nA per mV scaled
+* by 2^CY_CSDIDAC_REG_GAIN_SHIFT.
+*/
+#define CY_CSDIDAC_REG_GAIN_SHIFT               (8u)
+
+/** The maximum value of the kp and ki regulator gains. */
+#define CY_CSDIDAC_REG_MAX_GAIN                 (0xFFFFu)
+
+/**
+* The regulation error is clamped to +/-(CY_CSDIDAC_REG_MAX_ERROR_MV) before
+* it is multiplied by the gains, so the controller math fits into 32 bits.
+*/
+#define CY_CSDIDAC_REG_MAX_ERROR_MV             (4095)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/**
+* The sense voltage read function. Returns the latest sense voltage in mV
+* through the senseMv parameter and CY_CSDIDAC_SUCCESS if a new sample
+* is available. Any other return value skips the control update.
+*/
+typedef cy_en_csdidac_status_t (* cy_csdidac_reg_sense_t)(void * userData, uint32_t * senseMv);
+
+/** The CSDIDAC regulator configuration structure */
+typedef struct
+{
+    cy_en_csdidac_choice_t channel;         /**< The regulated IDAC channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    cy_en_csdidac_polarity_t polarity;      /**< The polarity of the regulated output current. */
+    uint32_t targetMv;                      /**< The initial target sense voltage in mV. */
+    uint32_t kp;                            /**< The proportional gain, nA/mV in Q8 format. */
+    uint32_t ki;                            /**< The integral gain per loop update, nA/mV in Q8 format. */
+    uint16_t loopDivider;                   /**< The number of Cy_CSDIDAC_RegProcess() calls per control update. */
+    cy_csdidac_reg_sense_t senseFunc;       /**< The sense voltage read function. */
+    void * senseData;                       /**< The user data passed to senseFunc. */
+} cy_stc_csdidac_reg_config_t;
+
+/** The CSDIDAC regulator context structure, that contains the internal regulator data. */
+typedef struct
+{
+    cy_stc_csdidac_reg_config_t cfgCopy;    /**< A configuration structure copy. */
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    int32_t integral;                       /**< The integrator state in nA, Q8 format. */
+    uint32_t outputNa;                      /**< The last output current applied, in nA. */
+    int32_t errorMv;                        /**< The last regulation error in mV. */
+    uint16_t tickCnt;                       /**< The tick counter of the loop divider. */
+    cy_en_csdidac_state_t state;            /**< The regulator is running. */
+} cy_stc_csdidac_reg_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_RegInit(
+                const cy_stc_csdidac_reg_config_t * config,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_reg_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_RegSetTarget(
+                uint32_t targetMv,
+                cy_stc_csdidac_reg_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_RegProcess(
+                cy_stc_csdidac_reg_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_RegStop(
+                cy_stc_csdidac_reg_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_REG_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,228 @@
+/***************************************************************************//**
+* \file cy_csdidac_route.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC port-batched pin routing implementation.
+* The drive mode and HSIOM fields of the added pins are merged into the
+* register masks and values of their ports, so applying a batch takes one
+* read-modify-write of the PC, PC2, and HSIOM PORT_SEL registers per port,
+* whatever the number of the pins.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_gpio.h"
+#include "cy_csdidac_route.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_ROUTE_DM_MAX                 (CY_GPIO_PC_DM_MASK | CY_GPIO_DM_VAL_IBUF_DISABLE_MASK)
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RouteBatchInit
+****************************************************************************//**
+*
+* Initializes an empty routing batch.
+*
+* \param batch
+* The pointer to the routing batch structure
+* \ref cy_stc_csdidac_route_batch_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchInit(
+                cy_stc_csdidac_route_batch_t * batch)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != batch)
+    {
+        batch->portNum = 0u;
+        batch->pinNum = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RouteBatchAdd
+****************************************************************************//**
+*
+* Adds the drive mode and HSIOM change of a pin to a routing batch.
+*
+* The change is merged into the port entry of the pin, a new entry is taken
+* for the first pin of a port. A later change of the same pin overrides
+* the earlier one. The registers are not accessed until
+* Cy_CSDIDAC_RouteBatchApply().
+*
+* \param ptrPin
+* The pin to be routed.
+*
+* \param driveMode
+* The drive mode of the pin, for instance CY_GPIO_DM_ANALOG, or
+* \ref CY_CSDIDAC_ROUTE_DM_KEEP to keep the drive mode.
+*
+* \param hsiomSel
+* The HSIOM selection of the pin, for instance HSIOM_SEL_AMUXA.
+*
+* \param batch
+* The pointer to the initialized routing batch structure
+* \ref cy_stc_csdidac_route_batch_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL, an invalid parameter
+*                           is passed, or the pin is in a new port and
+*                           the batch has \ref CY_CSDIDAC_ROUTE_PORT_MAX
+*                           ports already.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchAdd(
+                const cy_stc_csdidac_pin_t * ptrPin,
+                uint32_t driveMode,
+                en_hsiom_sel_t hsiomSel,
+                cy_stc_csdidac_route_batch_t * batch)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_route_port_t * ptrPort = NULL;
+    uint32_t pinPos;
+    uint32_t i;
+
+    if ((NULL != ptrPin) && (NULL != batch) && (CY_GPIO_PINS_MAX > (uint32_t)ptrPin->pin) &&
+        ((CY_CSDIDAC_ROUTE_DM_KEEP == driveMode) || (CY_CSDIDAC_ROUTE_DM_MAX >= driveMode)) &&
+        (CY_GPIO_HSIOM_MASK >= (uint32_t)hsiomSel))
+    {
+        for (i = 0u; (i < batch->portNum) && (NULL == ptrPort); i++)
+        {
+            if (ptrPin->ioPcPtr == batch->port[i].port)
+            {
+                ptrPort = &batch->port[i];
+            }
+        }
+        if ((NULL == ptrPort) && (CY_CSDIDAC_ROUTE_PORT_MAX > batch->portNum))
+        {
+            ptrPort = &batch->port[batch->portNum];
+            ptrPort->port = ptrPin->ioPcPtr;
+            ptrPort->pcMask = 0u;
+            ptrPort->pcValue = 0u;
+            ptrPort->pc2Mask = 0u;
+            ptrPort->pc2Value = 0u;
+            ptrPort->hsiomMask = 0u;
+            ptrPort->hsiomValue = 0u;
+            batch->portNum++;
+        }
+
+        if (NULL != ptrPort)
+        {
+            pinPos = (uint32_t)ptrPin->pin;
+            if (CY_CSDIDAC_ROUTE_DM_KEEP != driveMode)
+            {
+                /* The same fields as Cy_GPIO_SetDrivemode() */
+                ptrPort->pcMask |= CY_GPIO_PC_DM_MASK << (pinPos * CY_GPIO_DRIVE_MODE_OFFSET);
+                ptrPort->pcValue = (ptrPort->pcValue & ~(CY_GPIO_PC_DM_MASK << (pinPos * CY_GPIO_DRIVE_MODE_OFFSET))) |
+                                   ((driveMode & CY_GPIO_PC_DM_MASK) << (pinPos * CY_GPIO_DRIVE_MODE_OFFSET));
+                ptrPort->pc2Mask |= CY_GPIO_PC_DM_IBUF_MASK << pinPos;
+                ptrPort->pc2Value = (ptrPort->pc2Value & ~(CY_GPIO_PC_DM_IBUF_MASK << pinPos)) |
+                                    (((driveMode & CY_GPIO_DM_VAL_IBUF_DISABLE_MASK) >> CY_GPIO_DRIVE_MODE_OFFSET) << pinPos);
+            }
+            /* The same field as Cy_GPIO_SetHSIOM() */
+            ptrPort->hsiomMask |= CY_GPIO_HSIOM_MASK << (pinPos << CY_GPIO_HSIOM_OFFSET);
+            ptrPort->hsiomValue = (ptrPort->hsiomValue & ~(CY_GPIO_HSIOM_MASK << (pinPos << CY_GPIO_HSIOM_OFFSET))) |
+                                  ((uint32_t)hsiomSel << (pinPos << CY_GPIO_HSIOM_OFFSET));
+            batch->pinNum++;
+            result = CY_CSDIDAC_SUCCESS;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_RouteBatchApply
+****************************************************************************//**
+*
+* Writes the changes of a routing batch to the port registers.
+*
+* Each port of the batch takes one read-modify-write of the PC register,
+* one of the PC2 register, if a drive mode is changed, and one of the HSIOM
+* PORT_SEL register. The drive modes of a port are written before its HSIOM
+* selections, as with Cy_GPIO_SetDrivemode() and Cy_GPIO_SetHSIOM() called
+* in this order. The writes are done in a critical section, because the
+* port registers are shared with the other pins of the ports. The batch is
+* kept, so it can be applied again.
+*
+* \param batch
+* The pointer to the routing batch structure
+* \ref cy_stc_csdidac_route_batch_t.
+*
+* \param context
+* The pointer to the CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t, the owner of the critical
+* section statistics.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchApply(
+                const cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    const cy_stc_csdidac_route_port_t * ptrPort;
+    volatile uint32_t * hsiomReg;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t i;
+
+    if ((NULL != batch) && (NULL != context))
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        for (i = 0u; i < batch->portNum; i++)
+        {
+            ptrPort = &batch->port[i];
+            if (0u != ptrPort->pcMask)
+            {
+                GPIO_PRT_PC(ptrPort->port) = (GPIO_PRT_PC(ptrPort->port) & ~ptrPort->pcMask) | ptrPort->pcValue;
+                GPIO_PRT_PC2(ptrPort->port) = (GPIO_PRT_PC2(ptrPort->port) & ~ptrPort->pc2Mask) | ptrPort->pc2Value;
+            }
+            hsiomReg = &HSIOM_PRT_PORT_SEL(Cy_GPIO_PortToHSIOM(ptrPort->port));
+            *hsiomReg = (*hsiomReg & ~ptrPort->hsiomMask) | ptrPort->hsiomValue;
+        }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_ROUTE, interruptState, csStartTime, context);
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
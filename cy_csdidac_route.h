@@ -0,0 +1,112 @@
+/***************************************************************************//**
+* \file cy_csdidac_route.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC port-batched pin routing.
+*
+* Cy_GPIO_SetDrivemode() and Cy_GPIO_SetHSIOM() do a read-modify-write of
+* the port registers for every pin. A routing batch collects the drive mode
+* and HSIOM changes of several pins, merges the changes of the pins of one
+* port, and Cy_CSDIDAC_RouteBatchApply() writes each register of a port
+* once. The middleware connects and disconnects the IDAC pins through
+* a batch, so the pins of both channels in one port are routed together.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_ROUTE_H)
+#define CY_CSDIDAC_ROUTE_H
+
+#include "cy_csdidac.h"
+#include "cy_gpio.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_ROUTE_PORT_MAX)
+/** The maximum number of the ports in a routing batch. */
+#define CY_CSDIDAC_ROUTE_PORT_MAX               (2u)
+#endif
+
+/** The drive mode value of Cy_CSDIDAC_RouteBatchAdd() that keeps the drive mode of the pin. */
+#define CY_CSDIDAC_ROUTE_DM_KEEP                (0xFFFFFFFFuL)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The merged changes of the port registers. A zero mask means the register is not written. */
+typedef struct
+{
+    GPIO_PRT_Type * port;                   /**< The port. */
+    uint32_t pcMask;                        /**< The changed bits of the PC register. */
+    uint32_t pcValue;                       /**< The new value of the changed PC bits. */
+    uint32_t pc2Mask;                       /**< The changed bits of the PC2 register. */
+    uint32_t pc2Value;                      /**< The new value of the changed PC2 bits. */
+    uint32_t hsiomMask;                     /**< The changed bits of the HSIOM PORT_SEL register. */
+    uint32_t hsiomValue;                    /**< The new value of the changed HSIOM bits. */
+} cy_stc_csdidac_route_port_t;
+
+/** The CSDIDAC routing batch structure, that contains the pin changes merged per port. */
+typedef struct
+{
+    cy_stc_csdidac_route_port_t port[CY_CSDIDAC_ROUTE_PORT_MAX]; /**< The changed ports. */
+    uint32_t portNum;                       /**< The number of the changed ports. */
+    uint32_t pinNum;                        /**< The number of the pin changes added to the batch. */
+} cy_stc_csdidac_route_batch_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchInit(
+                cy_stc_csdidac_route_batch_t * batch);
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchAdd(
+                const cy_stc_csdidac_pin_t * ptrPin,
+                uint32_t driveMode,
+                en_hsiom_sel_t hsiomSel,
+                cy_stc_csdidac_route_batch_t * batch);
+cy_en_csdidac_status_t Cy_CSDIDAC_RouteBatchApply(
+                const cy_stc_csdidac_route_batch_t * batch,
+                cy_stc_csdidac_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_ROUTE_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,452 @@
+/***************************************************************************//**
+* \file cy_csdidac_scan.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC time-multiplexed pin scanning
+* implementation.
+*
+* A pin switch is done in three steps: the IDAC code is set to zero, the
+* HSIOM selection of the current pin is set to GPIO and of the next pin to
+* the analog bus, and the word of the next pin is written. When both the
+* pins are in the same port, the HSIOM port register is updated by a single
+* read-modify-write. The scanned pins are kept in the analog drive mode, so
+* a disconnected pin is in high impedance.
+*
+* The HSIOM port registers are shared with the other pins of the port. The
+* tick switches the pins in a critical section, as the middleware routing
+* does, so the application changes the HSIOM of the other pins of the
+* scanned ports in a critical section too, or from a context that is not
+* interrupted by Cy_CSDIDAC_ScanProcess().
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_gpio.h"
+#include "cy_csdidac_route.h"
+#include "cy_csdidac_scan.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_SCAN_HSIOM_REG(ptrPin)       (&HSIOM_PRT_PORT_SEL(Cy_GPIO_PortToHSIOM((ptrPin)->ioPcPtr)))
+#define CY_CSDIDAC_SCAN_HSIOM_SHIFT(ptrPin)     ((uint32_t)(ptrPin)->pin << CY_GPIO_HSIOM_OFFSET)
+
+
+/*******************************************************************************
+* Static Function Prototypes
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_ScanSwitch(
+                const cy_stc_csdidac_pin_t * prevPin,
+                const cy_stc_csdidac_pin_t * nextPin,
+                uint32_t hsiomSel);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanInit
+****************************************************************************//**
+*
+* Initializes the pin scanning of a channel.
+*
+* The channel is configured as CY_CSDIDAC_AMUX, and its pins are not used
+* by another channel. The pins are connected by the scanning only.
+*
+* \param ch
+* The scanning channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param pins
+* The list of the scanned pins with their IDAC register words. The words
+* are verified by Cy_CSDIDAC_ScanStart() and can be changed by
+* Cy_CSDIDAC_ScanSetCurrent() while the scanning runs.
+*
+* \param pinNum
+* The number of the pins in the list.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the pin scanning context structure
+* \ref cy_stc_csdidac_scan_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS            - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM          - The input pointer is NULL or an invalid
+*                                   parameter is passed.
+* * CY_CSDIDAC_BAD_CONFIGURATION  - The channel is not configured as
+*                                   CY_CSDIDAC_AMUX.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_scan_pin_t * pins,
+                uint32_t pinNum,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_scan_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+
+    if ((NULL != idacContext) && (NULL != context) && (NULL != pins) && (0u != pinNum) &&
+        ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)))
+    {
+        for (i = 0u; (i < pinNum) && (NULL != pins[i].ptrPin) && (NULL != pins[i].ptrPin->ioPcPtr); i++)
+        {
+        }
+        if (i == pinNum)
+        {
+            result = CY_CSDIDAC_BAD_CONFIGURATION;
+            if (CY_CSDIDAC_AMUX == ((CY_CSDIDAC_A == ch) ? idacContext->cfgCopy.configA : idacContext->cfgCopy.configB))
+            {
+                context->idacCxtPtr = idacContext;
+                context->idacReg = Cy_CSDIDAC_GetIdacReg(ch, idacContext);
+                context->channel = ch;
+                context->hsiomSel = (CY_CSDIDAC_A == ch) ? (uint32_t)HSIOM_SEL_AMUXA : (uint32_t)HSIOM_SEL_AMUXB;
+                context->pins = pins;
+                context->pinNum = pinNum;
+                context->pinIdx = 0u;
+                context->state = CY_CSDIDAC_DISABLE;
+                context->switchCnt = 0u;
+                context->batchedCnt = 0u;
+                #if (0u != CY_CSDIDAC_PROFILE_EN)
+                    context->profile.calls = 0u;
+                    context->profile.minTime = 0u;
+                    context->profile.maxTime = 0u;
+                    context->profile.totalTime = 0u;
+                    context->deadTimeMax = 0u;
+                #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+                result = CY_CSDIDAC_SUCCESS;
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanSetCurrent
+****************************************************************************//**
+*
+* Sets the current of a scanned pin. The current is converted by
+* Cy_CSDIDAC_CurrentToCode() and applied from the next time the pin is
+* connected.
+*
+* \param pinIdx
+* The index of the pin in the list.
+*
+* \param current
+* A current value in nA with a sign, the absolute value is up to
+* \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+* \param context
+* The pointer to the initialized pin scanning context structure
+* \ref cy_stc_csdidac_scan_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanSetCurrent(
+                uint32_t pinIdx,
+                int32_t current,
+                cy_stc_csdidac_scan_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+
+    if ((NULL != context) && (pinIdx < context->pinNum))
+    {
+        result = Cy_CSDIDAC_CurrentToCode(current, &polarity, &lsbIndex, &code);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            /* A single store, so the tick reads either the previous or the new word */
+            context->pins[pinIdx].idacWord = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, code);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanStart
+****************************************************************************//**
+*
+* Starts the pin scanning.
+*
+* The words of the pins are verified. The pins are set to the analog drive
+* mode and disconnected from the analog bus through routing batches, so the
+* registers of a port are written once for all its scanned pins. The
+* channel is enabled through Cy_CSDIDAC_OutputEnableExt() with the zero
+* code, the first pin is connected through a batch, and its word is
+* written.
+*
+* \param context
+* The pointer to the initialized pin scanning context structure
+* \ref cy_stc_csdidac_scan_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or a pin has an invalid
+*                           IDAC register word.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanStart(
+                cy_stc_csdidac_scan_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_route_batch_t batch;
+    const cy_stc_csdidac_pin_t * ptrPin;
+    uint32_t idacWord;
+    uint32_t i;
+
+    if ((NULL != context) && (CY_CSDIDAC_DISABLE == context->state))
+    {
+        for (i = 0u; (i < context->pinNum) && (true == Cy_CSDIDAC_IsIdacWordValid(context->pins[i].idacWord)); i++)
+        {
+        }
+        if (i == context->pinNum)
+        {
+            (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+            for (i = 0u; i < context->pinNum; i++)
+            {
+                ptrPin = context->pins[i].ptrPin;
+                if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_RouteBatchAdd(ptrPin, CY_GPIO_DM_ANALOG, HSIOM_SEL_GPIO, &batch))
+                {
+                    /* The batch is full, the collected ports are written and a new batch is started */
+                    (void)Cy_CSDIDAC_RouteBatchApply(&batch, context->idacCxtPtr);
+                    (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+                    (void)Cy_CSDIDAC_RouteBatchAdd(ptrPin, CY_GPIO_DM_ANALOG, HSIOM_SEL_GPIO, &batch);
+                }
+            }
+            (void)Cy_CSDIDAC_RouteBatchApply(&batch, context->idacCxtPtr);
+
+            idacWord = context->pins[0u].idacWord;
+            result = Cy_CSDIDAC_OutputEnableExt(context->channel,
+                                                (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(idacWord),
+                                                (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(idacWord),
+                                                0u, context->idacCxtPtr);
+            if (CY_CSDIDAC_SUCCESS == result)
+            {
+                (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+                (void)Cy_CSDIDAC_RouteBatchAdd(context->pins[0u].ptrPin, CY_CSDIDAC_ROUTE_DM_KEEP,
+                                               (en_hsiom_sel_t)context->hsiomSel, &batch);
+                (void)Cy_CSDIDAC_RouteBatchApply(&batch, context->idacCxtPtr);
+                *context->idacReg = idacWord;
+                context->pinIdx = 0u;
+                context->state = CY_CSDIDAC_ENABLE;
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanProcess
+****************************************************************************//**
+*
+* Switches the analog bus to the next pin of the list and writes its word.
+*
+* The function is intended for a timer interrupt, so the parameters are not
+* verified. The HSIOM read-modify-writes are done in a critical section,
+* as the port registers are shared with the routing of the other pins.
+* The dead time, when the channel outputs the zero code, lasts one or two
+* HSIOM read-modify-writes. If \ref CY_CSDIDAC_PROFILE_EN is
+* enabled, the execution time and the maximum dead time are stored in the
+* context structure, so the achievable scan rate can be measured.
+*
+* \param context
+* The pointer to the initialized pin scanning context structure
+* \ref cy_stc_csdidac_scan_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_ScanProcess(
+                cy_stc_csdidac_scan_context_t * context)
+{
+    uint32_t prevIdx = context->pinIdx;
+    uint32_t nextIdx = prevIdx + 1u;
+    uint32_t idacWord;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+        uint32_t deadStart;
+        uint32_t elapsed;
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    if ((CY_CSDIDAC_ENABLE == context->state) && (1u < context->pinNum))
+    {
+        if (nextIdx == context->pinNum)
+        {
+            nextIdx = 0u;
+        }
+        idacWord = context->pins[nextIdx].idacWord;
+
+        /* The previous pin does not get the current of the next pin and vice versa */
+        *context->idacReg &= ~CY_CSDIDAC_IDAC_WORD_CODE_MASK;
+        #if (0u != CY_CSDIDAC_PROFILE_EN)
+            deadStart = Cy_CSDIDAC_GetProfileTime();
+        #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        context->batchedCnt += Cy_CSDIDAC_ScanSwitch(context->pins[prevIdx].ptrPin, context->pins[nextIdx].ptrPin,
+                                                     context->hsiomSel);
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_SCAN, interruptState, csStartTime, context->idacCxtPtr);
+        *context->idacReg = idacWord;
+        #if (0u != CY_CSDIDAC_PROFILE_EN)
+            elapsed = (Cy_CSDIDAC_GetProfileTime() - deadStart) & CY_CSDIDAC_PROFILE_TIME_MASK;
+            if (elapsed > context->deadTimeMax)
+            {
+                context->deadTimeMax = elapsed;
+            }
+        #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+        context->pinIdx = nextIdx;
+        context->switchCnt++;
+    }
+
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        elapsed = (Cy_CSDIDAC_GetProfileTime() - profileStart) & CY_CSDIDAC_PROFILE_TIME_MASK;
+        if ((0u == context->profile.calls) || (elapsed < context->profile.minTime))
+        {
+            context->profile.minTime = elapsed;
+        }
+        if (elapsed > context->profile.maxTime)
+        {
+            context->profile.maxTime = elapsed;
+        }
+        context->profile.totalTime += elapsed;
+        context->profile.calls++;
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanStop
+****************************************************************************//**
+*
+* Stops the pin scanning. The code is set to zero and the connected pin is
+* disconnected from the analog bus through a routing batch. The channel configuration in the CSDIDAC
+* context is updated from the IDAC register by Cy_CSDIDAC_SyncIdacWord().
+* Use Cy_CSDIDAC_OutputDisable() to disable the channel.
+*
+* \param context
+* The pointer to the initialized pin scanning context structure
+* \ref cy_stc_csdidac_scan_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanStop(
+                cy_stc_csdidac_scan_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_stc_csdidac_route_batch_t batch;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        if (CY_CSDIDAC_ENABLE == context->state)
+        {
+            context->state = CY_CSDIDAC_DISABLE;
+            *context->idacReg &= ~CY_CSDIDAC_IDAC_WORD_CODE_MASK;
+            (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+            (void)Cy_CSDIDAC_RouteBatchAdd(context->pins[context->pinIdx].ptrPin, CY_CSDIDAC_ROUTE_DM_KEEP,
+                                           HSIOM_SEL_GPIO, &batch);
+            (void)Cy_CSDIDAC_RouteBatchApply(&batch, context->idacCxtPtr);
+        }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_SCAN, interruptState, csStartTime, context->idacCxtPtr);
+        result = Cy_CSDIDAC_SyncIdacWord(context->channel, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_ScanSwitch
+****************************************************************************//**
+*
+* Disconnects the previous pin and connects the next pin to the analog bus.
+* The pins of one port are switched by a single HSIOM register write.
+*
+* \param prevPin
+* The pin connected to the analog bus.
+*
+* \param nextPin
+* The pin to be connected.
+*
+* \param hsiomSel
+* The HSIOM selection of the analog bus.
+*
+* \return
+* 1u if the pins are switched by a single write, 0u otherwise.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_ScanSwitch(
+                const cy_stc_csdidac_pin_t * prevPin,
+                const cy_stc_csdidac_pin_t * nextPin,
+                uint32_t hsiomSel)
+{
+    volatile uint32_t * prevReg = CY_CSDIDAC_SCAN_HSIOM_REG(prevPin);
+    volatile uint32_t * nextReg = CY_CSDIDAC_SCAN_HSIOM_REG(nextPin);
+    uint32_t prevMask = (uint32_t)CY_GPIO_HSIOM_MASK << CY_CSDIDAC_SCAN_HSIOM_SHIFT(prevPin);
+    uint32_t nextShift = CY_CSDIDAC_SCAN_HSIOM_SHIFT(nextPin);
+    uint32_t batched = 0u;
+
+    /* HSIOM_SEL_GPIO is zero, so clearing the field disconnects a pin */
+    if (prevReg == nextReg)
+    {
+        *nextReg = (*nextReg & ~(prevMask | ((uint32_t)CY_GPIO_HSIOM_MASK << nextShift))) | (hsiomSel << nextShift);
+        batched = 1u;
+    }
+    else
+    {
+        *prevReg &= ~prevMask;
+        *nextReg = (*nextReg & ~((uint32_t)CY_GPIO_HSIOM_MASK << nextShift)) | (hsiomSel << nextShift);
+    }
+
+    return (batched);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
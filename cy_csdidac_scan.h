@@ -0,0 +1,107 @@
+/***************************************************************************//**
+* \file cy_csdidac_scan.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC time-multiplexed pin scanning.
+*
+* One IDAC channel drives a list of pins in turn, for instance a bank of
+* LEDs or sensors. The channel is configured as CY_CSDIDAC_AMUX, so the
+* middleware routes the IDAC to the analog bus only, and each
+* Cy_CSDIDAC_ScanProcess() call moves the bus from the current pin to the
+* next one and writes the IDAC register word of the next pin.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_SCAN_H)
+#define CY_CSDIDAC_SCAN_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The scanned pin with its current. */
+typedef struct
+{
+    const cy_stc_csdidac_pin_t * ptrPin;    /**< The pin. */
+    uint32_t idacWord;                      /**< The \ref CY_CSDIDAC_IDAC_WORD() value of the pin. */
+} cy_stc_csdidac_scan_pin_t;
+
+/** The CSDIDAC pin scanning context structure, that contains the internal scanning data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * idacReg;            /**< The IDAC register of the scanning channel. */
+    cy_en_csdidac_choice_t channel;         /**< The scanning channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    uint32_t hsiomSel;                      /**< The HSIOM selection of the channel analog bus. */
+    cy_stc_csdidac_scan_pin_t * pins;       /**< The scanned pins. */
+    uint32_t pinNum;                        /**< The number of the scanned pins. */
+    uint32_t pinIdx;                        /**< The pin connected to the analog bus. */
+    volatile cy_en_csdidac_state_t state;   /**< The scanning is running. */
+    uint32_t switchCnt;                     /**< The number of the pin switches. */
+    uint32_t batchedCnt;                    /**< The number of the pin switches within a port, with a single HSIOM write. */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        cy_stc_csdidac_profile_t profile;   /**< The execution time of Cy_CSDIDAC_ScanProcess(). */
+        uint32_t deadTimeMax;               /**< The maximum time between the zero code and the next pin word. */
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+} cy_stc_csdidac_scan_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_scan_pin_t * pins,
+                uint32_t pinNum,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_scan_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanSetCurrent(
+                uint32_t pinIdx,
+                int32_t current,
+                cy_stc_csdidac_scan_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanStart(
+                cy_stc_csdidac_scan_context_t * context);
+void Cy_CSDIDAC_ScanProcess(
+                cy_stc_csdidac_scan_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_ScanStop(
+                cy_stc_csdidac_scan_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_SCAN_H */
+
+
+/* [] END OF FILE */
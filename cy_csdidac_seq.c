@@ -0,0 +1,691 @@
+/***************************************************************************//**
+* \file cy_csdidac_seq.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC current-profile sequencer implementation.
+* The sequencer executes a compact bytecode profile from flash or RAM and
+* drives the IDAC outputs from a periodic tick.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_seq.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Function Prototypes - Internal Functions
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_SeqReadU16(const uint8_t * ptr);
+static int32_t Cy_CSDIDAC_SeqReadI32(const uint8_t * ptr);
+static bool Cy_CSDIDAC_SeqIsCurrentValid(int32_t current);
+static bool Cy_CSDIDAC_SeqIsChannelValid(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_context_t * idacContext);
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqVerify(
+                const uint8_t * program,
+                uint32_t length,
+                const cy_stc_csdidac_context_t * idacContext);
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqSet(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                cy_stc_csdidac_seq_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqSync(
+                int32_t currentA,
+                int32_t currentB,
+                cy_stc_csdidac_seq_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqRampStep(
+                cy_stc_csdidac_seq_context_t * context);
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqExecute(
+                cy_stc_csdidac_seq_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqInit
+****************************************************************************//**
+*
+* Loads a current profile into the sequencer.
+*
+* The whole profile is verified once by this function: the instruction
+* lengths, channels, current ranges, and loop nesting. A channel disabled
+* by the IDAC configuration is rejected. So, the
+* Cy_CSDIDAC_SeqProcess() function executes the profile without
+* per-instruction checks. The profile is not copied and must stay
+* available until the sequence is stopped.
+*
+* \param program
+* The pointer to the profile bytecode, see \ref group_csdidac_macros.
+*
+* \param length
+* The profile length in bytes.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the sequencer context structure
+* \ref cy_stc_csdidac_seq_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL, an invalid parameter
+*                           is passed, or the profile is invalid.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqInit(
+                const uint8_t * program,
+                uint32_t length,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != program) && (NULL != idacContext) && (NULL != context))
+    {
+        result = Cy_CSDIDAC_SeqVerify(program, length, idacContext);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            context->program = program;
+            context->length = length;
+            context->idacCxtPtr = idacContext;
+            context->pc = 0u;
+            context->state = CY_CSDIDAC_SEQ_IDLE;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqStart
+****************************************************************************//**
+*
+* Starts the loaded profile from the first instruction.
+*
+* The first instruction is executed by the next Cy_CSDIDAC_SeqProcess() call.
+* The RAMP instructions start from the current setpoint of the channel,
+* which is 0 nA at the sequence start.
+*
+* \param context
+* The pointer to the sequencer context structure
+* \ref cy_stc_csdidac_seq_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or no profile is loaded.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqStart(
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != context) && (NULL != context->program))
+    {
+        context->pc = 0u;
+        context->current[CY_CSDIDAC_A] = 0;
+        context->current[CY_CSDIDAC_B] = 0;
+        context->waitTicks = 0u;
+        context->rampTicks = 0u;
+        context->loopDepth = 0u;
+        context->state = CY_CSDIDAC_SEQ_RUNNING;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqStop
+****************************************************************************//**
+*
+* Stops the sequence. The IDAC outputs are kept in their current state,
+* use Cy_CSDIDAC_OutputDisable() to disable them.
+*
+* \param context
+* The pointer to the sequencer context structure
+* \ref cy_stc_csdidac_seq_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqStop(
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->state = CY_CSDIDAC_SEQ_IDLE;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqProcess
+****************************************************************************//**
+*
+* Executes one tick of the running sequence.
+*
+* The function is called periodically, for instance, from a timer interrupt
+* or from the main loop with a fixed period. The tick period is the time
+* unit of the WAIT and RAMP instructions. Each call performs one of:
+* * Applies the next step of an active RAMP instruction.
+* * Counts down an active WAIT instruction.
+* * Executes the instructions up to the next WAIT, RAMP, or END instruction,
+*   at most \ref CY_CSDIDAC_SEQ_MAX_OPS_PER_TICK instructions.
+*
+* If a CSDIDAC function returns an error, the sequence is aborted and
+* the state is set to CY_CSDIDAC_SEQ_ERROR.
+*
+* \param context
+* The pointer to the sequencer context structure
+* \ref cy_stc_csdidac_seq_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+* * Any other status      - The status of the failed CSDIDAC function.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqProcess(
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        if (CY_CSDIDAC_SEQ_RUNNING == context->state)
+        {
+            if (0u != context->rampTicks)
+            {
+                result = Cy_CSDIDAC_SeqRampStep(context);
+            }
+            else if (0u != context->waitTicks)
+            {
+                context->waitTicks--;
+            }
+            else
+            {
+                result = Cy_CSDIDAC_SeqExecute(context);
+            }
+
+            if (CY_CSDIDAC_SUCCESS != result)
+            {
+                context->state = CY_CSDIDAC_SEQ_ERROR;
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqGetState
+****************************************************************************//**
+*
+* Returns the sequencer state.
+*
+* \param context
+* The pointer to the sequencer context structure
+* \ref cy_stc_csdidac_seq_context_t.
+*
+* \return
+* The sequencer state. CY_CSDIDAC_SEQ_IDLE is returned if the input
+* pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_seq_state_t Cy_CSDIDAC_SeqGetState(
+                const cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_seq_state_t state = CY_CSDIDAC_SEQ_IDLE;
+
+    if (NULL != context)
+    {
+        state = context->state;
+    }
+
+    return (state);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqReadU16
+****************************************************************************//**
+*
+* Reads a little-endian 16-bit operand.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_SeqReadU16(const uint8_t * ptr)
+{
+    return ((uint32_t)ptr[0u] | ((uint32_t)ptr[1u] << 8u));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqReadI32
+****************************************************************************//**
+*
+* Reads a little-endian 32-bit signed operand.
+*
+*******************************************************************************/
+static int32_t Cy_CSDIDAC_SeqReadI32(const uint8_t * ptr)
+{
+    return ((int32_t)((uint32_t)ptr[0u] | ((uint32_t)ptr[1u] << 8u) |
+                      ((uint32_t)ptr[2u] << 16u) | ((uint32_t)ptr[3u] << 24u)));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqIsCurrentValid
+****************************************************************************//**
+*
+* Checks if the current operand is in the IDAC output range.
+*
+*******************************************************************************/
+static bool Cy_CSDIDAC_SeqIsCurrentValid(int32_t current)
+{
+    return (((int32_t)CY_CSDIDAC_MAX_CURRENT_NA >= current) &&
+            (-(int32_t)CY_CSDIDAC_MAX_CURRENT_NA <= current));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqIsChannelValid
+****************************************************************************//**
+*
+* Checks if the channel operand is a valid choice and none of its channels
+* is disabled by the IDAC configuration.
+*
+*******************************************************************************/
+static bool Cy_CSDIDAC_SeqIsChannelValid(
+                cy_en_csdidac_choice_t ch,
+                const cy_stc_csdidac_context_t * idacContext)
+{
+    return ((true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)) &&
+            ((CY_CSDIDAC_B == ch) || (CY_CSDIDAC_DISABLED != idacContext->cfgCopy.configA)) &&
+            ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_DISABLED != idacContext->cfgCopy.configB)));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqVerify
+****************************************************************************//**
+*
+* Verifies the profile bytecode up to the first END instruction.
+*
+* \param program
+* The pointer to the profile bytecode.
+*
+* \param length
+* The profile length in bytes.
+*
+* \param idacContext
+* The pointer to the CSDIDAC middleware context, used to verify
+* the channels against the IDAC configuration.
+*
+* \return
+* CY_CSDIDAC_SUCCESS if the profile is valid, CY_CSDIDAC_BAD_PARAM otherwise.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqVerify(
+                const uint8_t * program,
+                uint32_t length,
+                const cy_stc_csdidac_context_t * idacContext)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_en_csdidac_choice_t ch;
+    uint32_t pc = 0u;
+    uint32_t depth = 0u;
+    uint32_t opLen;
+    bool valid = true;
+    bool endFound = false;
+
+    while ((true == valid) && (false == endFound) && (pc < length))
+    {
+        opLen = 0u;
+        switch (program[pc])
+        {
+            case CY_CSDIDAC_SEQ_OP_END:     opLen = CY_CSDIDAC_SEQ_LEN_END;     break;
+            case CY_CSDIDAC_SEQ_OP_SET:     opLen = CY_CSDIDAC_SEQ_LEN_SET;     break;
+            case CY_CSDIDAC_SEQ_OP_OFF:     opLen = CY_CSDIDAC_SEQ_LEN_OFF;     break;
+            case CY_CSDIDAC_SEQ_OP_RAMP:    opLen = CY_CSDIDAC_SEQ_LEN_RAMP;    break;
+            case CY_CSDIDAC_SEQ_OP_WAIT:    opLen = CY_CSDIDAC_SEQ_LEN_WAIT;    break;
+            case CY_CSDIDAC_SEQ_OP_LOOP:    opLen = CY_CSDIDAC_SEQ_LEN_LOOP;    break;
+            case CY_CSDIDAC_SEQ_OP_ENDLOOP: opLen = CY_CSDIDAC_SEQ_LEN_ENDLOOP; break;
+            case CY_CSDIDAC_SEQ_OP_SYNC:    opLen = CY_CSDIDAC_SEQ_LEN_SYNC;    break;
+            default:                        valid = false;                      break;
+        }
+
+        if ((true == valid) && ((length - pc) < opLen))
+        {
+            valid = false;
+        }
+
+        if (true == valid)
+        {
+            ch = (1u < opLen) ? (cy_en_csdidac_choice_t)program[pc + 1u] : CY_CSDIDAC_A;
+            switch (program[pc])
+            {
+                case CY_CSDIDAC_SEQ_OP_END:
+                    endFound = true;
+                    valid = (0u == depth);
+                    break;
+                case CY_CSDIDAC_SEQ_OP_SET:
+                    valid = Cy_CSDIDAC_SeqIsChannelValid(ch, idacContext) &&
+                            Cy_CSDIDAC_SeqIsCurrentValid(Cy_CSDIDAC_SeqReadI32(&program[pc + 2u]));
+                    break;
+                case CY_CSDIDAC_SEQ_OP_OFF:
+                    valid = Cy_CSDIDAC_SeqIsChannelValid(ch, idacContext);
+                    break;
+                case CY_CSDIDAC_SEQ_OP_RAMP:
+                    valid = (CY_CSDIDAC_AB != ch) &&
+                            Cy_CSDIDAC_SeqIsChannelValid(ch, idacContext) &&
+                            Cy_CSDIDAC_SeqIsCurrentValid(Cy_CSDIDAC_SeqReadI32(&program[pc + 2u]));
+                    break;
+                case CY_CSDIDAC_SEQ_OP_LOOP:
+                    depth++;
+                    valid = (CY_CSDIDAC_SEQ_LOOP_DEPTH >= depth);
+                    break;
+                case CY_CSDIDAC_SEQ_OP_ENDLOOP:
+                    valid = (0u != depth);
+                    if (true == valid)
+                    {
+                        depth--;
+                    }
+                    break;
+                case CY_CSDIDAC_SEQ_OP_SYNC:
+                    valid = Cy_CSDIDAC_IsIdacChoiceValid(CY_CSDIDAC_AB, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB) &&
+                            Cy_CSDIDAC_SeqIsCurrentValid(Cy_CSDIDAC_SeqReadI32(&program[pc + 1u])) &&
+                            Cy_CSDIDAC_SeqIsCurrentValid(Cy_CSDIDAC_SeqReadI32(&program[pc + 5u]));
+                    break;
+                default:
+                    /* WAIT has no operands to verify */
+                    break;
+            }
+            pc += opLen;
+        }
+    }
+
+    if ((true == valid) && (true == endFound))
+    {
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqSet
+****************************************************************************//**
+*
+* Sets the current of one or both channels and updates the setpoints.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqSet(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+
+    result = Cy_CSDIDAC_CurrentToCode(current, &polarity, &lsbIndex, &code);
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        result = Cy_CSDIDAC_OutputEnableExt(ch, polarity, lsbIndex, code, context->idacCxtPtr);
+    }
+    if (CY_CSDIDAC_B != ch)
+    {
+        context->current[CY_CSDIDAC_A] = current;
+    }
+    if (CY_CSDIDAC_A != ch)
+    {
+        context->current[CY_CSDIDAC_B] = current;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqSync
+****************************************************************************//**
+*
+* Sets the currents of both channels in one critical section, so no tick
+* or interrupt observes only one of the channels updated.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqSync(
+                int32_t currentA,
+                int32_t currentB,
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result;
+    cy_en_csdidac_polarity_t polarityA;
+    cy_en_csdidac_polarity_t polarityB;
+    cy_en_csdidac_lsb_t lsbIndexA;
+    cy_en_csdidac_lsb_t lsbIndexB;
+    uint32_t codeA;
+    uint32_t codeB;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    result = Cy_CSDIDAC_CurrentToCode(currentA, &polarityA, &lsbIndexA, &codeA);
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        result = Cy_CSDIDAC_CurrentToCode(currentB, &polarityB, &lsbIndexB, &codeB);
+    }
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        result = Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, polarityA, lsbIndexA, codeA, context->idacCxtPtr);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            result = Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_B, polarityB, lsbIndexB, codeB, context->idacCxtPtr);
+        }
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_SEQ, interruptState, csStartTime, context->idacCxtPtr);
+    }
+    context->current[CY_CSDIDAC_A] = currentA;
+    context->current[CY_CSDIDAC_B] = currentB;
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqRampStep
+****************************************************************************//**
+*
+* Applies the next step of the active RAMP instruction. The step remainder
+* is distributed over the ramp with an error accumulator, so the ramp ends
+* exactly at the target current without a division per step.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqRampStep(
+                cy_stc_csdidac_seq_context_t * context)
+{
+    int32_t current = context->current[context->rampCh];
+
+    context->rampTicks--;
+    if (0u == context->rampTicks)
+    {
+        current = context->rampTarget;
+    }
+    else
+    {
+        current += context->rampStep;
+        context->rampErr += context->rampRem;
+        if (context->rampErr >= context->rampDiv)
+        {
+            context->rampErr -= context->rampDiv;
+            current += (context->rampTarget < current) ? -1 : 1;
+        }
+    }
+
+    return (Cy_CSDIDAC_SeqSet(context->rampCh, current, context));
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_SeqExecute
+****************************************************************************//**
+*
+* Executes the instructions up to the next time-consuming instruction.
+* The profile is verified by Cy_CSDIDAC_SeqInit(), so the operands are
+* not checked here.
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_SeqExecute(
+                cy_stc_csdidac_seq_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_SUCCESS;
+    const uint8_t * op;
+    cy_stc_csdidac_seq_loop_t * loop;
+    cy_en_csdidac_choice_t ch;
+    uint32_t ticks;
+    uint32_t opCnt = 0u;
+    int32_t diff;
+    bool yield = false;
+
+    while ((false == yield) && (CY_CSDIDAC_SUCCESS == result) && (CY_CSDIDAC_SEQ_MAX_OPS_PER_TICK > opCnt))
+    {
+        op = &context->program[context->pc];
+        opCnt++;
+
+        switch (op[0u])
+        {
+            case CY_CSDIDAC_SEQ_OP_SET:
+                result = Cy_CSDIDAC_SeqSet((cy_en_csdidac_choice_t)op[1u], Cy_CSDIDAC_SeqReadI32(&op[2u]), context);
+                context->pc += CY_CSDIDAC_SEQ_LEN_SET;
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_OFF:
+                ch = (cy_en_csdidac_choice_t)op[1u];
+                result = Cy_CSDIDAC_OutputDisable(ch, context->idacCxtPtr);
+                if (CY_CSDIDAC_B != ch)
+                {
+                    context->current[CY_CSDIDAC_A] = 0;
+                }
+                if (CY_CSDIDAC_A != ch)
+                {
+                    context->current[CY_CSDIDAC_B] = 0;
+                }
+                context->pc += CY_CSDIDAC_SEQ_LEN_OFF;
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_RAMP:
+                ch = (cy_en_csdidac_choice_t)op[1u];
+                ticks = Cy_CSDIDAC_SeqReadU16(&op[6u]);
+                context->rampCh = ch;
+                context->rampTarget = Cy_CSDIDAC_SeqReadI32(&op[2u]);
+                context->pc += CY_CSDIDAC_SEQ_LEN_RAMP;
+                if (0u == ticks)
+                {
+                    result = Cy_CSDIDAC_SeqSet(ch, context->rampTarget, context);
+                }
+                else
+                {
+                    diff = context->rampTarget - context->current[ch];
+                    context->rampStep = diff / (int32_t)ticks;
+                    context->rampRem = (uint32_t)((0 > diff) ? -(diff % (int32_t)ticks) : (diff % (int32_t)ticks));
+                    context->rampDiv = ticks;
+                    context->rampErr = 0u;
+                    context->rampTicks = (uint16_t)ticks;
+                    result = Cy_CSDIDAC_SeqRampStep(context);
+                    yield = true;
+                }
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_WAIT:
+                ticks = Cy_CSDIDAC_SeqReadU16(&op[1u]);
+                context->pc += CY_CSDIDAC_SEQ_LEN_WAIT;
+                if (0u != ticks)
+                {
+                    context->waitTicks = (uint16_t)(ticks - 1u);
+                    yield = true;
+                }
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_LOOP:
+                context->pc += CY_CSDIDAC_SEQ_LEN_LOOP;
+                loop = &context->loop[context->loopDepth];
+                loop->start = context->pc;
+                loop->remaining = (uint16_t)Cy_CSDIDAC_SeqReadU16(&op[1u]);
+                context->loopDepth++;
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_ENDLOOP:
+                loop = &context->loop[context->loopDepth - 1u];
+                if (1u == loop->remaining)
+                {
+                    context->loopDepth--;
+                    context->pc += CY_CSDIDAC_SEQ_LEN_ENDLOOP;
+                }
+                else
+                {
+                    /* The loop with the zero count repeats forever */
+                    if (0u != loop->remaining)
+                    {
+                        loop->remaining--;
+                    }
+                    context->pc = loop->start;
+                }
+                break;
+
+            case CY_CSDIDAC_SEQ_OP_SYNC:
+                result = Cy_CSDIDAC_SeqSync(Cy_CSDIDAC_SeqReadI32(&op[1u]), Cy_CSDIDAC_SeqReadI32(&op[5u]), context);
+                context->pc += CY_CSDIDAC_SEQ_LEN_SYNC;
+                break;
+
+            default:
+                /* END */
+                context->state = CY_CSDIDAC_SEQ_DONE;
+                yield = true;
+                break;
+        }
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,167 @@
+/***************************************************************************//**
+* \file cy_csdidac_seq.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC current-profile sequencer.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_SEQ_H)
+#define CY_CSDIDAC_SEQ_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+#if !defined(CY_CSDIDAC_SEQ_LOOP_DEPTH)
+/** The maximum nesting depth of the sequencer loops. */
+#define CY_CSDIDAC_SEQ_LOOP_DEPTH               (4u)
+#endif
+
+#if !defined(CY_CSDIDAC_SEQ_MAX_OPS_PER_TICK)
+/**
+* The maximum number of instructions executed by one Cy_CSDIDAC_SeqProcess()
+* call. Limits the tick execution time of the profiles with loops that
+* contain no time-consuming instructions.
+*/
+#define CY_CSDIDAC_SEQ_MAX_OPS_PER_TICK         (16u)
+#endif
+
+/**
+* \name Sequencer Bytecode
+* The profile is a byte array of instructions. Each instruction starts with
+* an opcode byte followed by its operands. The multi-byte operands are
+* little-endian. The channel operand is a \ref cy_en_csdidac_choice_t value,
+* the current operand is an int32_t in nA with a sign, as for
+* Cy_CSDIDAC_OutputEnable(), the ticks and count operands are uint16_t.
+* \{
+*/
+#define CY_CSDIDAC_SEQ_OP_END                   (0x00u) /**< END. Stops the sequence, the outputs are kept. */
+#define CY_CSDIDAC_SEQ_OP_SET                   (0x01u) /**< SET channel, current. Sets the channel current. */
+#define CY_CSDIDAC_SEQ_OP_OFF                   (0x02u) /**< OFF channel. Disables the channel. */
+#define CY_CSDIDAC_SEQ_OP_RAMP                  (0x03u) /**< RAMP channel, current, ticks. Linear ramp, one step per tick. */
+#define CY_CSDIDAC_SEQ_OP_WAIT                  (0x04u) /**< WAIT ticks. Keeps the outputs for the number of ticks. */
+#define CY_CSDIDAC_SEQ_OP_LOOP                  (0x05u) /**< LOOP count. Repeats up to ENDLOOP, 0 - forever. */
+#define CY_CSDIDAC_SEQ_OP_ENDLOOP               (0x06u) /**< ENDLOOP. Closes the innermost LOOP. */
+#define CY_CSDIDAC_SEQ_OP_SYNC                  (0x07u) /**< SYNC currentA, currentB. Sets both channels at once. */
+
+#define CY_CSDIDAC_SEQ_LEN_END                  (1u)    /**< The END instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_SET                  (6u)    /**< The SET instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_OFF                  (2u)    /**< The OFF instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_RAMP                 (8u)    /**< The RAMP instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_WAIT                 (3u)    /**< The WAIT instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_LOOP                 (3u)    /**< The LOOP instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_ENDLOOP              (1u)    /**< The ENDLOOP instruction length in bytes. */
+#define CY_CSDIDAC_SEQ_LEN_SYNC                 (9u)    /**< The SYNC instruction length in bytes. */
+/** \} */
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The CSDIDAC sequencer state enumeration type. */
+typedef enum
+{
+    CY_CSDIDAC_SEQ_IDLE     = 0u,           /**< The sequence is loaded and not started or is stopped. */
+    CY_CSDIDAC_SEQ_RUNNING  = 1u,           /**< The sequence is running. */
+    CY_CSDIDAC_SEQ_DONE     = 2u,           /**< The sequence reached the END instruction. */
+    CY_CSDIDAC_SEQ_ERROR    = 3u,           /**< The sequence is aborted by a CSDIDAC error. */
+} cy_en_csdidac_seq_state_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC sequencer loop record. */
+typedef struct
+{
+    uint32_t start;                         /**< The offset of the first instruction of the loop body. */
+    uint16_t remaining;                     /**< The number of the remaining iterations, 0 - forever. */
+} cy_stc_csdidac_seq_loop_t;
+
+/** The CSDIDAC sequencer context structure, that contains the internal sequencer data. */
+typedef struct
+{
+    const uint8_t * program;                /**< The pointer to the profile bytecode. */
+    uint32_t length;                        /**< The profile length in bytes. */
+    uint32_t pc;                            /**< The offset of the next instruction. */
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    int32_t current[CY_CSDIDAC_AB];         /**< The current setpoint of IdacA and IdacB in nA. */
+    uint16_t waitTicks;                     /**< The remaining ticks of the WAIT instruction. */
+    uint16_t rampTicks;                     /**< The remaining steps of the RAMP instruction. */
+    cy_en_csdidac_choice_t rampCh;          /**< The ramped channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    int32_t rampTarget;                     /**< The ramp target current in nA. */
+    int32_t rampStep;                       /**< The integer part of the ramp step in nA. */
+    uint32_t rampRem;                       /**< The absolute remainder of the ramp step. */
+    uint32_t rampDiv;                       /**< The ramp step divider, the RAMP ticks. */
+    uint32_t rampErr;                       /**< The ramp remainder accumulator. */
+    cy_stc_csdidac_seq_loop_t loop[CY_CSDIDAC_SEQ_LOOP_DEPTH];
+                                            /**< The loop stack. */
+    uint32_t loopDepth;                     /**< The number of the active loops. */
+    cy_en_csdidac_seq_state_t state;        /**< The sequencer state. */
+} cy_stc_csdidac_seq_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqInit(
+                const uint8_t * program,
+                uint32_t length,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_seq_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqStart(
+                cy_stc_csdidac_seq_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqStop(
+                cy_stc_csdidac_seq_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_SeqProcess(
+                cy_stc_csdidac_seq_context_t * context);
+cy_en_csdidac_seq_state_t Cy_CSDIDAC_SeqGetState(
+                const cy_stc_csdidac_seq_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_SEQ_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,398 @@
+/***************************************************************************//**
+* \file cy_csdidac_stream.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC double-buffered streaming playback
+* implementation. The producer fills one half of a ping-pong buffer of IDAC
+* register words while Cy_CSDIDAC_StreamProcess() plays the other half
+* from a periodic tick.
+*
+* Each half has a ready flag. The producer sets the flag of the half it
+* filled, and the tick clears the flag of the half it played, so a flag
+* has one writer in each state and the halves are handed over without
+* critical sections.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_stream.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Static Function Prototypes
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static void Cy_CSDIDAC_StreamNext(
+                uint32_t * half,
+                cy_stc_csdidac_stream_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamInit
+****************************************************************************//**
+*
+* Initializes the streaming playback of a channel. Both the halves of the
+* buffer are free.
+*
+* \param ch
+* The streaming channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param buffer
+* The streaming buffer of 2 * halfSize IDAC register words.
+*
+* \param halfSize
+* The number of the words in a half of the buffer.
+*
+* \param policy
+* The output when the next half is not ready at the buffer swap.
+*
+* \param notifyFunc
+* The buffer-swap notification called from the tick, or NULL to poll
+* the producer with Cy_CSDIDAC_StreamGetFree().
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t * buffer,
+                uint32_t halfSize,
+                cy_en_csdidac_stream_policy_t policy,
+                cy_csdidac_stream_notify_t notifyFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_stream_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t half;
+
+    if ((NULL != idacContext) && (NULL != context) && (NULL != buffer) && (0u != halfSize) &&
+        ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)) &&
+        ((CY_CSDIDAC_STREAM_HOLD_LAST == policy) || (CY_CSDIDAC_STREAM_ZERO == policy)) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)))
+    {
+        context->idacCxtPtr = idacContext;
+        context->idacReg = Cy_CSDIDAC_GetIdacReg(ch, idacContext);
+        context->channel = ch;
+        context->policy = policy;
+        context->notifyFunc = notifyFunc;
+        context->buffer = buffer;
+        context->halfSize = halfSize;
+        for (half = 0u; half < CY_CSDIDAC_STREAM_HALF_NUM; half++)
+        {
+            context->ready[half] = false;
+        }
+        context->playHalf = 0u;
+        context->playIdx = 0u;
+        context->fillHalf = 0u;
+        context->lastWord = 0u;
+        context->state = CY_CSDIDAC_DISABLE;
+        context->sampleCnt = 0u;
+        context->swapCnt = 0u;
+        context->underrunCnt = 0u;
+        context->overrunCnt = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamGetFree
+****************************************************************************//**
+*
+* Returns the half of the buffer the producer fills next.
+*
+* The halves are filled in turn. If the half is not played yet, the producer
+* is ahead of the playback and NULL is returned, so the producer retries
+* later, for instance after the buffer-swap notification. The poll is not
+* counted as an overrun, only a rejected Cy_CSDIDAC_StreamCommit() is.
+*
+* \param context
+* The pointer to the initialized streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+* \return
+* The pointer to the halfSize words to fill, or NULL if no half is free or
+* the context pointer is NULL.
+*
+*******************************************************************************/
+uint32_t * Cy_CSDIDAC_StreamGetFree(
+                cy_stc_csdidac_stream_context_t * context)
+{
+    uint32_t * half = NULL;
+
+    if ((NULL != context) && (false == context->ready[context->fillHalf]))
+    {
+        half = &context->buffer[context->fillHalf * context->halfSize];
+    }
+
+    return (half);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamCommit
+****************************************************************************//**
+*
+* Hands the half returned by Cy_CSDIDAC_StreamGetFree() over to the playback.
+*
+* The words are verified by Cy_CSDIDAC_IsIdacWordValid(), so the tick writes
+* them without the checks. An invalid half is kept free. A commit while the
+* half is not played yet is rejected and increments the overrun counter.
+*
+* \param context
+* The pointer to the initialized streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL, the half holds
+*                           an invalid word, or no half is free.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamCommit(
+                cy_stc_csdidac_stream_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    const uint32_t * half;
+    uint32_t i;
+
+    if (NULL != context)
+    {
+        if (true == context->ready[context->fillHalf])
+        {
+            /* The producer is ahead of the playback */
+            context->overrunCnt++;
+        }
+        else
+        {
+            half = &context->buffer[context->fillHalf * context->halfSize];
+            for (i = 0u; (i < context->halfSize) && (true == Cy_CSDIDAC_IsIdacWordValid(half[i])); i++)
+            {
+            }
+            if (i == context->halfSize)
+            {
+                /* The words are stored before the tick sees the flag */
+                __DMB();
+                context->ready[context->fillHalf] = true;
+                context->fillHalf ^= 1u;
+                result = CY_CSDIDAC_SUCCESS;
+            }
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamStart
+****************************************************************************//**
+*
+* Starts the streaming playback. The first half is committed before the
+* start, and the channel is enabled with its first word through
+* Cy_CSDIDAC_OutputEnableExt(). The first word is counted as played, so the
+* next Cy_CSDIDAC_StreamProcess() outputs the second word.
+*
+* \param context
+* The pointer to the initialized streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or the first half
+*                           is not committed.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamStart(
+                cy_stc_csdidac_stream_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t * half;
+    uint32_t idacWord;
+
+    if ((NULL != context) && (CY_CSDIDAC_DISABLE == context->state) && (true == context->ready[context->playHalf]))
+    {
+        half = &context->buffer[context->playHalf * context->halfSize];
+        idacWord = half[context->playIdx];
+        result = Cy_CSDIDAC_OutputEnableExt(context->channel,
+                                            (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(idacWord),
+                                            (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(idacWord),
+                                            idacWord & CY_CSDIDAC_IDAC_WORD_CODE_MASK, context->idacCxtPtr);
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            context->lastWord = idacWord;
+            Cy_CSDIDAC_StreamNext(half, context);
+            context->state = CY_CSDIDAC_ENABLE;
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamProcess
+****************************************************************************//**
+*
+* Outputs the next word of the played half.
+*
+* After the last word of a half, the half is freed, the buffer-swap
+* notification is called, and the playback switches to the other half.
+* If the other half is not committed yet, each tick increments the underrun
+* counter and outputs the last word or a zero code according to the policy,
+* and the playback resumes as soon as the half is committed.
+*
+* The function is intended for a timer interrupt, so the parameters are not
+* verified. The IDAC register is written with the fast path, so
+* Cy_CSDIDAC_StreamStop() is called before the functions that use
+* the channel configuration in the CSDIDAC context.
+*
+* \param context
+* The pointer to the initialized streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_StreamProcess(
+                cy_stc_csdidac_stream_context_t * context)
+{
+    uint32_t * half;
+
+    if (CY_CSDIDAC_ENABLE == context->state)
+    {
+        if (true == context->ready[context->playHalf])
+        {
+            half = &context->buffer[context->playHalf * context->halfSize];
+            context->lastWord = half[context->playIdx];
+            *context->idacReg = context->lastWord;
+            Cy_CSDIDAC_StreamNext(half, context);
+        }
+        else
+        {
+            context->underrunCnt++;
+            *context->idacReg = (CY_CSDIDAC_STREAM_ZERO == context->policy) ?
+                                (context->lastWord & ~CY_CSDIDAC_IDAC_WORD_CODE_MASK) : context->lastWord;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamStop
+****************************************************************************//**
+*
+* Stops the streaming playback and frees both the halves. The channel is
+* kept enabled with the current output, and its configuration in the
+* CSDIDAC context is updated from the IDAC register by
+* Cy_CSDIDAC_SyncIdacWord(). Use Cy_CSDIDAC_OutputDisable() to disable
+* the channel.
+*
+* \param context
+* The pointer to the initialized streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamStop(
+                cy_stc_csdidac_stream_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t half;
+
+    if (NULL != context)
+    {
+        context->state = CY_CSDIDAC_DISABLE;
+        for (half = 0u; half < CY_CSDIDAC_STREAM_HALF_NUM; half++)
+        {
+            context->ready[half] = false;
+        }
+        context->playHalf = 0u;
+        context->playIdx = 0u;
+        context->fillHalf = 0u;
+        result = Cy_CSDIDAC_SyncIdacWord(context->channel, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_StreamNext
+****************************************************************************//**
+*
+* Counts the played word and moves to the next one. After the last word of
+* the half, the half is freed, the buffer-swap notification is called, and
+* the playback switches to the other half.
+*
+* \param half
+* The played half.
+*
+* \param context
+* The pointer to the streaming context structure
+* \ref cy_stc_csdidac_stream_context_t.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_StreamNext(
+                uint32_t * half,
+                cy_stc_csdidac_stream_context_t * context)
+{
+    context->sampleCnt++;
+    context->playIdx++;
+    if (context->playIdx == context->halfSize)
+    {
+        context->playIdx = 0u;
+        context->ready[context->playHalf] = false;
+        context->playHalf ^= 1u;
+        context->swapCnt++;
+        if (NULL != context->notifyFunc)
+        {
+            context->notifyFunc(half, context->halfSize);
+        }
+    }
+}
+
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,132 @@
+/***************************************************************************//**
+* \file cy_csdidac_stream.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC double-buffered streaming playback.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_STREAM_H)
+#define CY_CSDIDAC_STREAM_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/** The number of the halves of the streaming buffer. */
+#define CY_CSDIDAC_STREAM_HALF_NUM              (2u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The output of the streaming playback when the next half of the buffer is not ready. */
+typedef enum
+{
+    CY_CSDIDAC_STREAM_HOLD_LAST = 0u,       /**< The last sample is kept. */
+    CY_CSDIDAC_STREAM_ZERO      = 1u,       /**< The code is set to zero with the last polarity and LSB. */
+} cy_en_csdidac_stream_policy_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/**
+* The buffer-swap notification. Called from Cy_CSDIDAC_StreamProcess() when
+* the playback of a half is finished, so the producer can refill the half.
+* The function does not block, for instance it sets a flag or starts a DMA
+* transfer.
+*/
+typedef void (* cy_csdidac_stream_notify_t)(uint32_t * half, uint32_t size);
+
+/** The CSDIDAC streaming playback context structure, that contains the internal streaming data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * idacReg;            /**< The IDAC register of the streaming channel. */
+    cy_en_csdidac_choice_t channel;         /**< The streaming channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    cy_en_csdidac_stream_policy_t policy;   /**< The underrun policy. */
+    cy_csdidac_stream_notify_t notifyFunc;  /**< The buffer-swap notification, or NULL. */
+    uint32_t * buffer;                      /**< The streaming buffer of two halves of IDAC register words. */
+    uint32_t halfSize;                      /**< The number of the words in a half. */
+    volatile bool ready[CY_CSDIDAC_STREAM_HALF_NUM]; /**< The half is filled and not played yet. */
+    uint32_t playHalf;                      /**< The half played by Cy_CSDIDAC_StreamProcess(). */
+    uint32_t playIdx;                       /**< The next word of the played half. */
+    uint32_t fillHalf;                      /**< The half filled by the producer. */
+    uint32_t lastWord;                      /**< The last played IDAC register word. */
+    volatile cy_en_csdidac_state_t state;   /**< The streaming is running. */
+    volatile uint32_t sampleCnt;            /**< The number of the played samples. */
+    volatile uint32_t swapCnt;              /**< The number of the buffer swaps. */
+    volatile uint32_t underrunCnt;          /**< The number of the ticks without a ready sample. */
+    volatile uint32_t overrunCnt;           /**< The number of the commits rejected because the half is not played yet. */
+} cy_stc_csdidac_stream_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamInit(
+                cy_en_csdidac_choice_t ch,
+                uint32_t * buffer,
+                uint32_t halfSize,
+                cy_en_csdidac_stream_policy_t policy,
+                cy_csdidac_stream_notify_t notifyFunc,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_stream_context_t * context);
+uint32_t * Cy_CSDIDAC_StreamGetFree(
+                cy_stc_csdidac_stream_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamCommit(
+                cy_stc_csdidac_stream_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamStart(
+                cy_stc_csdidac_stream_context_t * context);
+void Cy_CSDIDAC_StreamProcess(
+                cy_stc_csdidac_stream_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_StreamStop(
+                cy_stc_csdidac_stream_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_STREAM_H */
+
+
+/* [] END OF FILE */
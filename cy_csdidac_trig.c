@@ -0,0 +1,276 @@
+/***************************************************************************//**
+* \file cy_csdidac_trig.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC pre-armed trigger implementation. The
+* conversion, validation, and routing of an output change are done when
+* the trigger is armed, so Cy_CSDIDAC_TrigFire() is a fixed sequence of
+* register stores.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_gpio.h"
+#include "cy_csdidac_trig.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_TRIG_MARKER_PIN_MAX          (8u)
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_TrigInit
+****************************************************************************//**
+*
+* Initializes the pre-armed trigger. No channel is armed.
+*
+* \param markerPort
+* The port of the marker pin toggled by Cy_CSDIDAC_TrigFire() for the
+* oscilloscope synchronization, or NULL if no marker is used. The pin is
+* configured as a digital output by the application.
+*
+* \param markerPin
+* The marker pin number in the port.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the trigger context structure
+* \ref cy_stc_csdidac_trig_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigInit(
+                GPIO_PRT_Type * markerPort,
+                uint32_t markerPin,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_trig_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+
+    if ((NULL != idacContext) && (NULL != context) && (CY_CSDIDAC_TRIG_MARKER_PIN_MAX > markerPin))
+    {
+        context->idacCxtPtr = idacContext;
+        for (i = 0u; i < CY_CSDIDAC_TRIG_CH_NUM; i++)
+        {
+            context->reg[i] = &context->dummy;
+            context->word[i] = 0u;
+        }
+        if (NULL != markerPort)
+        {
+            context->markerReg = &GPIO_PRT_DR_INV(markerPort);
+            context->markerMask = CY_GPIO_DR_MASK << markerPin;
+        }
+        else
+        {
+            context->markerReg = &context->dummy;
+            context->markerMask = 0u;
+        }
+        context->armed = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_TrigArm
+****************************************************************************//**
+*
+* Arms a channel with the specified current. The current is converted
+* by Cy_CSDIDAC_CurrentToCode() and the channel is armed by
+* Cy_CSDIDAC_TrigArmExt().
+*
+* \param ch
+* The channel to be armed, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param current
+* A current value in nA with a sign, the absolute value is up to
+* \ref CY_CSDIDAC_MAX_CURRENT_NA.
+*
+* \param context
+* The pointer to the initialized trigger context structure
+* \ref cy_stc_csdidac_trig_context_t.
+*
+* \return
+* The function returns the status of Cy_CSDIDAC_TrigArmExt().
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigArm(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                cy_stc_csdidac_trig_context_t * context)
+{
+    cy_en_csdidac_status_t result;
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsbIndex;
+    uint32_t code;
+
+    result = Cy_CSDIDAC_CurrentToCode(current, &polarity, &lsbIndex, &code);
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        result = Cy_CSDIDAC_TrigArmExt(ch, polarity, lsbIndex, code, context);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_TrigArmExt
+****************************************************************************//**
+*
+* Arms a channel with the specified polarity, LSB, and IDAC code.
+*
+* A disabled channel is enabled with the zero code, the specified polarity,
+* and LSB through Cy_CSDIDAC_OutputEnableExt(), so its pin is routed
+* before the trigger and Cy_CSDIDAC_TrigFire() only writes the IDAC
+* register. An enabled channel keeps its output until the trigger.
+* The channels are armed independently, an armed channel is armed again
+* with the new value.
+*
+* \param ch
+* The channel to be armed, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param polarity
+* The polarity to be set on the trigger.
+*
+* \param lsbIndex
+* The LSB to be set on the trigger.
+*
+* \param idacCode
+* The code value in the range from 0u to \ref CY_CSDIDAC_MAX_CODE.
+*
+* \param context
+* The pointer to the initialized trigger context structure
+* \ref cy_stc_csdidac_trig_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigArmExt(
+                cy_en_csdidac_choice_t ch,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode,
+                cy_stc_csdidac_trig_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    cy_en_csdidac_state_t channelState;
+    uint32_t idx = (CY_CSDIDAC_A == ch) ? 0u : 1u;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+
+    if ((NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)) &&
+        (true == Cy_CSDIDAC_IsIdacPolarityValid(polarity)) && (true == Cy_CSDIDAC_IsIdacLsbValid(lsbIndex)) &&
+        (CY_CSDIDAC_MAX_CODE >= idacCode) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, context->idacCxtPtr->cfgCopy.configA,
+                                                 context->idacCxtPtr->cfgCopy.configB)))
+    {
+        result = CY_CSDIDAC_SUCCESS;
+        channelState = (CY_CSDIDAC_A == ch) ? context->idacCxtPtr->channelStateA : context->idacCxtPtr->channelStateB;
+        if (CY_CSDIDAC_DISABLE == channelState)
+        {
+            result = Cy_CSDIDAC_OutputEnableExt(ch, polarity, lsbIndex, 0u, context->idacCxtPtr);
+        }
+        if (CY_CSDIDAC_SUCCESS == result)
+        {
+            /* A trigger between the stores would write a half-armed channel */
+            interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+            context->word[idx] = CY_CSDIDAC_IDAC_WORD(polarity, lsbIndex, idacCode);
+            context->reg[idx] = Cy_CSDIDAC_GetIdacReg(ch, context->idacCxtPtr);
+            context->armed |= (1uL << idx);
+            Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_TRIG, interruptState, csStartTime, context->idacCxtPtr);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_TrigDisarm
+****************************************************************************//**
+*
+* Disarms both the channels. The configuration of the armed channels in the
+* CSDIDAC context is updated from the IDAC registers by
+* Cy_CSDIDAC_SyncIdacWord(), so it is correct whether the trigger was fired
+* or not.
+*
+* \param context
+* The pointer to the initialized trigger context structure
+* \ref cy_stc_csdidac_trig_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigDisarm(
+                cy_stc_csdidac_trig_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t interruptState;
+    uint32_t csStartTime;
+    uint32_t armed;
+    uint32_t i;
+
+    if (NULL != context)
+    {
+        interruptState = Cy_CSDIDAC_EnterCriticalSection(&csStartTime);
+        armed = context->armed;
+        for (i = 0u; i < CY_CSDIDAC_TRIG_CH_NUM; i++)
+        {
+            context->reg[i] = &context->dummy;
+        }
+        context->armed = 0u;
+        Cy_CSDIDAC_ExitCriticalSection(CY_CSDIDAC_API_TRIG, interruptState, csStartTime, context->idacCxtPtr);
+
+        result = CY_CSDIDAC_SUCCESS;
+        for (i = 0u; (i < CY_CSDIDAC_TRIG_CH_NUM) && (CY_CSDIDAC_SUCCESS == result); i++)
+        {
+            if (0u != (armed & (1uL << i)))
+            {
+                result = Cy_CSDIDAC_SyncIdacWord((0u == i) ? CY_CSDIDAC_A : CY_CSDIDAC_B, context->idacCxtPtr);
+            }
+        }
+    }
+
+    return (result);
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/***************************************************************************//**
+* \file cy_csdidac_trig.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC pre-armed trigger.
+*
+* The output change is prepared by Cy_CSDIDAC_TrigArm() or
+* Cy_CSDIDAC_TrigArmExt() in the thread mode: the current is converted,
+* the channel is routed, and the IDAC register words and addresses are
+* stored. Cy_CSDIDAC_TrigFire(), called from any interrupt, only stores
+* the prepared words, so the latency does not depend on the current or
+* the configuration.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_TRIG_H)
+#define CY_CSDIDAC_TRIG_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/** The number of the IDAC registers written by Cy_CSDIDAC_TrigFire(). */
+#define CY_CSDIDAC_TRIG_CH_NUM                  (2u)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC pre-armed trigger context structure, that contains the prepared register stores. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * reg[CY_CSDIDAC_TRIG_CH_NUM]; /**< The IDAC registers of the armed channels, the dummy register otherwise. */
+    uint32_t word[CY_CSDIDAC_TRIG_CH_NUM];  /**< The armed IDAC register words. */
+    volatile uint32_t * markerReg;          /**< The DR_INV register of the marker port, the dummy register otherwise. */
+    uint32_t markerMask;                    /**< The marker pin mask. */
+    uint32_t dummy;                         /**< The target of the stores of the not armed channels and marker. */
+    uint32_t armed;                         /**< The armed channels, bit 0 is IdacA, bit 1 is IdacB. */
+} cy_stc_csdidac_trig_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigInit(
+                GPIO_PRT_Type * markerPort,
+                uint32_t markerPin,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_trig_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigArm(
+                cy_en_csdidac_choice_t ch,
+                int32_t current,
+                cy_stc_csdidac_trig_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigArmExt(
+                cy_en_csdidac_choice_t ch,
+                cy_en_csdidac_polarity_t polarity,
+                cy_en_csdidac_lsb_t lsbIndex,
+                uint32_t idacCode,
+                cy_stc_csdidac_trig_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_TrigDisarm(
+                cy_stc_csdidac_trig_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_TrigFire
+****************************************************************************//**
+*
+* Applies the armed output change.
+*
+* The function stores the armed words to the IDAC registers and toggles
+* the marker pin, the channels that are not armed and the missing marker
+* are stored to a dummy variable, so the function has no branches and
+* the same execution time in any configuration: six loads and three
+* stores, with the IdacA store right after its two loads.
+*
+* The function is intended for an interrupt, so the parameters are not
+* verified. The arming is kept, so the next call stores the same words.
+* The IDAC registers are written with the fast path, so
+* Cy_CSDIDAC_TrigDisarm() is called before the functions that use
+* the channel configuration in the CSDIDAC context.
+*
+* \param context
+* The pointer to the initialized trigger context structure
+* \ref cy_stc_csdidac_trig_context_t.
+*
+*******************************************************************************/
+__STATIC_INLINE void Cy_CSDIDAC_TrigFire(const cy_stc_csdidac_trig_context_t * context)
+{
+    *context->reg[0u] = context->word[0u];
+    *context->reg[1u] = context->word[1u];
+    *context->markerReg = context->markerMask;
+}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_TRIG_H */
+
+
+/* [] END OF FILE */
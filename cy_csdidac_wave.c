@@ -0,0 +1,491 @@
+/***************************************************************************//**
+* \file cy_csdidac_wave.c
+* \version 2.10
+*
+* \brief
+* This file provides the CSDIDAC waveform playback implementation. The
+* samples of a raw or compressed waveform are written to the IDAC register
+* from a periodic tick. A compressed sample is decoded in constant time:
+* a tick reads at most one token and one code byte, without loops or
+* divisions.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_csdidac.h"
+#include "cy_csdidac_wave.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+
+/*******************************************************************************
+* Local Definition
+*******************************************************************************/
+#define CY_CSDIDAC_WAVE_HOLD_MASK               (CY_CSDIDAC_WAVE_HOLD_MAX - 1u)
+#define CY_CSDIDAC_WAVE_RANGE_LAST              (CY_CSDIDAC_WAVE_RANGE_TOKEN(CY_CSDIDAC_SINK, CY_CSDIDAC_LSB_4800_IDX))
+#define CY_CSDIDAC_WAVE_RANGE_POLARITY(token)   (((uint32_t)(token) >> 3u) & 1u)
+#define CY_CSDIDAC_WAVE_RANGE_LSB(token)        ((uint32_t)(token) & 7u)
+
+
+/*******************************************************************************
+* Static Function Prototypes
+*******************************************************************************/
+/**
+* \cond SECTION_CSDIDAC_INTERNAL
+* \addtogroup group_csdidac_internal
+* \{
+*/
+static uint32_t Cy_CSDIDAC_WaveCheckStream(
+                const uint8_t * stream,
+                uint32_t size);
+static cy_en_csdidac_status_t Cy_CSDIDAC_WaveStart(
+                uint32_t idacWord,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context);
+static void Cy_CSDIDAC_WaveDecode(
+                cy_stc_csdidac_wave_context_t * context);
+/** \}
+* \endcond */
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveInit
+****************************************************************************//**
+*
+* Initializes the waveform playback of a channel.
+*
+* \param ch
+* The playback channel, CY_CSDIDAC_A or CY_CSDIDAC_B.
+*
+* \param idacContext
+* The pointer to the initialized CSDIDAC middleware context
+* structure \ref cy_stc_csdidac_context_t.
+*
+* \param context
+* The pointer to the waveform playback context structure
+* \ref cy_stc_csdidac_wave_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_WaveInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_wave_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != context) && ((CY_CSDIDAC_A == ch) || (CY_CSDIDAC_B == ch)) &&
+        (true == Cy_CSDIDAC_IsIdacChoiceValid(ch, idacContext->cfgCopy.configA, idacContext->cfgCopy.configB)))
+    {
+        context->idacCxtPtr = idacContext;
+        context->idacReg = Cy_CSDIDAC_GetIdacReg(ch, idacContext);
+        context->channel = ch;
+        context->state = CY_CSDIDAC_DISABLE;
+        #if (0u != CY_CSDIDAC_PROFILE_EN)
+            context->profile.calls = 0u;
+            context->profile.minTime = 0u;
+            context->profile.maxTime = 0u;
+            context->profile.totalTime = 0u;
+        #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WavePlayRaw
+****************************************************************************//**
+*
+* Starts the playback of a table of IDAC register words.
+*
+* The words are verified, then the channel is enabled with the first word
+* through Cy_CSDIDAC_OutputEnableExt(). Each Cy_CSDIDAC_WaveProcess() call
+* outputs the next word starting from the first one.
+*
+* \param words
+* The table of the \ref CY_CSDIDAC_IDAC_WORD() values.
+*
+* \param count
+* The number of the words in the table.
+*
+* \param loop
+* If true, the playback restarts from the first word after the last one.
+* Otherwise, the last word is kept when the playback ends.
+*
+* \param context
+* The pointer to the initialized waveform playback context structure
+* \ref cy_stc_csdidac_wave_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_WavePlayRaw(
+                const uint32_t * words,
+                uint32_t count,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+    uint32_t i;
+
+    if ((NULL != words) && (NULL != context) && (0u != count))
+    {
+        for (i = 0u; (i < count) && (true == Cy_CSDIDAC_IsIdacWordValid(words[i])); i++)
+        {
+        }
+        if (i == count)
+        {
+            context->state = CY_CSDIDAC_DISABLE;
+            context->format = CY_CSDIDAC_WAVE_RAW;
+            context->words = words;
+            context->count = count;
+            context->index = 0u;
+            result = Cy_CSDIDAC_WaveStart(words[0u], loop, context);
+        }
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WavePlay
+****************************************************************************//**
+*
+* Starts the playback of a compressed waveform.
+*
+* The stream is verified, so Cy_CSDIDAC_WaveProcess() decodes it without
+* the checks. Then, the channel is enabled with the first sample through
+* Cy_CSDIDAC_OutputEnableExt(). Each Cy_CSDIDAC_WaveProcess() call outputs
+* the next sample starting from the first one.
+*
+* \param stream
+* The compressed stream, the format is described in cy_csdidac_wave.h.
+*
+* \param size
+* The size of the stream in bytes, including the end token.
+*
+* \param loop
+* If true, the playback restarts from the first sample after the last one.
+* Otherwise, the last sample is kept when the playback ends.
+*
+* \param context
+* The pointer to the initialized waveform playback context structure
+* \ref cy_stc_csdidac_wave_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL or an invalid parameter
+*                           is passed, for instance, the stream is malformed.
+* * CY_CSDIDAC_HW_LOCKED  - The CSD HW block is acquired and locked by other
+*                           middleware or application.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_WavePlay(
+                const uint8_t * stream,
+                uint32_t size,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != stream) && (NULL != context) && (0u != Cy_CSDIDAC_WaveCheckStream(stream, size)))
+    {
+        context->state = CY_CSDIDAC_DISABLE;
+        context->format = CY_CSDIDAC_WAVE_COMPRESSED;
+        context->stream = stream;
+        context->token = stream;
+        context->holdCnt = 0u;
+        context->word = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_WAVE_RANGE_POLARITY(stream[0u]),
+                                             CY_CSDIDAC_WAVE_RANGE_LSB(stream[0u]), stream[1u]);
+        result = Cy_CSDIDAC_WaveStart(context->word, loop, context);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveProcess
+****************************************************************************//**
+*
+* Outputs the next sample of the waveform.
+*
+* The function is intended for a timer interrupt, so the parameters are not
+* verified. The execution time does not depend on the waveform: a raw sample
+* is a table read, a compressed sample reads at most two stream bytes.
+* If \ref CY_CSDIDAC_PROFILE_EN is enabled, the execution time is stored
+* in the profile field of the context structure, so the raw and compressed
+* playback can be compared.
+*
+* The IDAC register is written with the fast path, so Cy_CSDIDAC_WaveStop()
+* is called before the functions that use the channel configuration
+* in the CSDIDAC context, see Cy_CSDIDAC_SyncIdacWord().
+*
+* \param context
+* The pointer to the initialized waveform playback context structure
+* \ref cy_stc_csdidac_wave_context_t.
+*
+*******************************************************************************/
+void Cy_CSDIDAC_WaveProcess(
+                cy_stc_csdidac_wave_context_t * context)
+{
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        uint32_t profileStart = Cy_CSDIDAC_GetProfileTime();
+        uint32_t elapsed;
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+
+    if (CY_CSDIDAC_ENABLE == context->state)
+    {
+        if (CY_CSDIDAC_WAVE_RAW == context->format)
+        {
+            *context->idacReg = context->words[context->index];
+            context->index++;
+            if (context->index == context->count)
+            {
+                context->index = 0u;
+                context->state = (true == context->loop) ? CY_CSDIDAC_ENABLE : CY_CSDIDAC_DISABLE;
+            }
+        }
+        else
+        {
+            if (0u != context->holdCnt)
+            {
+                context->holdCnt--;
+            }
+            else
+            {
+                Cy_CSDIDAC_WaveDecode(context);
+            }
+            *context->idacReg = context->word;
+        }
+    }
+
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        elapsed = (Cy_CSDIDAC_GetProfileTime() - profileStart) & CY_CSDIDAC_PROFILE_TIME_MASK;
+        if ((0u == context->profile.calls) || (elapsed < context->profile.minTime))
+        {
+            context->profile.minTime = elapsed;
+        }
+        if (elapsed > context->profile.maxTime)
+        {
+            context->profile.maxTime = elapsed;
+        }
+        context->profile.totalTime += elapsed;
+        context->profile.calls++;
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveStop
+****************************************************************************//**
+*
+* Stops the playback. The channel is kept enabled with the current sample,
+* and its configuration in the CSDIDAC context is updated from the IDAC
+* register by Cy_CSDIDAC_SyncIdacWord(). Use Cy_CSDIDAC_OutputDisable()
+* to disable the channel.
+*
+* \param context
+* The pointer to the initialized waveform playback context structure
+* \ref cy_stc_csdidac_wave_context_t.
+*
+* \return
+* The function returns the status of its operation.
+* * CY_CSDIDAC_SUCCESS    - The operation is performed successfully.
+* * CY_CSDIDAC_BAD_PARAM  - The input pointer is NULL.
+*
+*******************************************************************************/
+cy_en_csdidac_status_t Cy_CSDIDAC_WaveStop(
+                cy_stc_csdidac_wave_context_t * context)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if (NULL != context)
+    {
+        context->state = CY_CSDIDAC_DISABLE;
+        result = Cy_CSDIDAC_SyncIdacWord(context->channel, context->idacCxtPtr);
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveCheckStream
+****************************************************************************//**
+*
+* Verifies a compressed stream: it starts with a range token, the tokens
+* are valid, the codes stay in the code range, and the only end token is
+* the last byte.
+*
+* \param stream
+* The compressed stream.
+*
+* \param size
+* The size of the stream in bytes.
+*
+* \return
+* The number of the samples in the stream, or 0u if the stream is invalid.
+*
+*******************************************************************************/
+static uint32_t Cy_CSDIDAC_WaveCheckStream(
+                const uint8_t * stream,
+                uint32_t size)
+{
+    uint32_t samples = 0u;
+    uint32_t code = 0u;
+    uint32_t token;
+    uint32_t i = 0u;
+    bool valid = ((3u <= size) && (CY_CSDIDAC_WAVE_RANGE <= stream[0u]) &&
+                  (CY_CSDIDAC_WAVE_RANGE_LAST >= stream[0u]));
+
+    while ((true == valid) && (i < (size - 1u)))
+    {
+        token = stream[i];
+        i++;
+        if (CY_CSDIDAC_WAVE_HOLD > token)
+        {
+            /* The delta is a 7-bit two's complement value */
+            code += token - ((token & 0x40u) << 1u);
+            valid = (CY_CSDIDAC_MAX_CODE >= code);
+            samples++;
+        }
+        else if (CY_CSDIDAC_WAVE_RANGE > token)
+        {
+            samples += (token & CY_CSDIDAC_WAVE_HOLD_MASK) + 1u;
+        }
+        else if ((CY_CSDIDAC_WAVE_RANGE_LAST >= token) && (CY_CSDIDAC_WAVE_RANGE_LSB(token) <= CY_CSDIDAC_LSB_4800_IDX) &&
+                 (i < (size - 1u)) && (CY_CSDIDAC_MAX_CODE >= stream[i]))
+        {
+            code = stream[i];
+            i++;
+            samples++;
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    return (((true == valid) && (CY_CSDIDAC_WAVE_END == stream[size - 1u])) ? samples : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveStart
+****************************************************************************//**
+*
+* Enables the playback channel with the first sample and starts the playback.
+*
+* \param idacWord
+* The IDAC register word of the first sample.
+*
+* \param loop
+* The waveform is restarted at the end.
+*
+* \param context
+* The pointer to the waveform playback context structure.
+*
+* \return
+* The status of Cy_CSDIDAC_OutputEnableExt().
+*
+*******************************************************************************/
+static cy_en_csdidac_status_t Cy_CSDIDAC_WaveStart(
+                uint32_t idacWord,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context)
+{
+    cy_en_csdidac_status_t result;
+
+    result = Cy_CSDIDAC_OutputEnableExt(context->channel,
+                                        (cy_en_csdidac_polarity_t)CY_CSDIDAC_IDAC_WORD_POLARITY(idacWord),
+                                        (cy_en_csdidac_lsb_t)CY_CSDIDAC_IDAC_WORD_LSB(idacWord),
+                                        idacWord & CY_CSDIDAC_IDAC_WORD_CODE_MASK, context->idacCxtPtr);
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        context->loop = loop;
+        context->state = CY_CSDIDAC_ENABLE;
+    }
+
+    return (result);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_CSDIDAC_WaveDecode
+****************************************************************************//**
+*
+* Decodes the next token of the compressed stream into the current IDAC
+* register word. The stream is verified by Cy_CSDIDAC_WavePlay(), so the
+* delta never carries out of the code field. In the loop mode, the end token
+* is skipped right after the last sample, so a token is read on every call.
+*
+* \param context
+* The pointer to the waveform playback context structure.
+*
+*******************************************************************************/
+static void Cy_CSDIDAC_WaveDecode(
+                cy_stc_csdidac_wave_context_t * context)
+{
+    const uint8_t * token = context->token;
+    uint32_t value = *token;
+
+    token++;
+    if (CY_CSDIDAC_WAVE_HOLD > value)
+    {
+        /* The code field is incremented modulo 128 by the 7-bit delta */
+        context->word = (context->word & ~CY_CSDIDAC_IDAC_WORD_CODE_MASK) |
+                        ((context->word + value) & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+    }
+    else if (CY_CSDIDAC_WAVE_RANGE > value)
+    {
+        context->holdCnt = value & CY_CSDIDAC_WAVE_HOLD_MASK;
+    }
+    else if (CY_CSDIDAC_WAVE_END != value)
+    {
+        context->word = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_WAVE_RANGE_POLARITY(value),
+                                             CY_CSDIDAC_WAVE_RANGE_LSB(value), *token);
+        token++;
+    }
+    else
+    {
+        /* The end of the stream, the last sample is kept */
+        token--;
+        context->state = CY_CSDIDAC_DISABLE;
+    }
+
+    if ((CY_CSDIDAC_WAVE_END == *token) && (true == context->loop))
+    {
+        token = context->stream;
+    }
+    context->token = token;
+}
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+
+/* [] END OF FILE */
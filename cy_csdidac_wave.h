@@ -0,0 +1,146 @@
+/***************************************************************************//**
+* \file cy_csdidac_wave.h
+* \version 2.10
+*
+* \brief
+* This file provides the function prototypes and constants specific
+* to the CSDIDAC waveform playback.
+*
+* A waveform is played from a table of IDAC register words, one word per
+* sample, or from a compressed byte stream of tokens:
+*
+*   | 0x00..0x7F | The code delta, a 7-bit two's complement value. Outputs
+*   |            | the next sample with the same polarity and LSB.
+*   | 0x80..0xBF | Hold. Outputs the current sample (token & 0x3F) + 1 times.
+*   | 0xC0..0xCF | Range. (token >> 3) & 1 is the polarity, token & 7 is the
+*   |            | LSB index, followed by a byte with the code. Outputs the
+*   |            | next sample.
+*   | 0xFF       | The end of the stream.
+*
+* The stream starts with a range token. A stream is produced from a sampled
+* waveform by the tools/csdidac_wavec.c host tool.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_CSDIDAC_WAVE_H)
+#define CY_CSDIDAC_WAVE_H
+
+#include "cy_csdidac.h"
+
+#if (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2))
+
+/* The C binding of definitions to build with the C++ compiler. */
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+
+/**
+* \addtogroup group_csdidac_macros
+* \{
+*/
+/** The first hold token of the compressed stream. */
+#define CY_CSDIDAC_WAVE_HOLD                    (0x80u)
+/** The maximum number of the samples of a hold token. */
+#define CY_CSDIDAC_WAVE_HOLD_MAX                (64u)
+/** The first range token of the compressed stream. */
+#define CY_CSDIDAC_WAVE_RANGE                   (0xC0u)
+/** Builds the range token of the polarity and LSB index. */
+#define CY_CSDIDAC_WAVE_RANGE_TOKEN(polarity, lsbIndex) \
+                                                (CY_CSDIDAC_WAVE_RANGE | ((uint32_t)(polarity) << 3u) | (uint32_t)(lsbIndex))
+/** The end token of the compressed stream. */
+#define CY_CSDIDAC_WAVE_END                     (0xFFu)
+
+/** \} group_csdidac_macros */
+
+
+/**
+* \addtogroup group_csdidac_enums
+* \{
+*/
+
+/** The waveform format. */
+typedef enum
+{
+    CY_CSDIDAC_WAVE_RAW         = 0u,       /**< A table of IDAC register words. */
+    CY_CSDIDAC_WAVE_COMPRESSED  = 1u,       /**< A compressed token stream. */
+} cy_en_csdidac_wave_format_t;
+
+/** \} group_csdidac_enums */
+
+
+/**
+* \addtogroup group_csdidac_data_structures
+* \{
+*/
+
+/** The CSDIDAC waveform playback context structure, that contains the internal playback data. */
+typedef struct
+{
+    cy_stc_csdidac_context_t * idacCxtPtr;  /**< The pointer to the CSDIDAC middleware context. */
+    volatile uint32_t * idacReg;            /**< The IDAC register of the playback channel. */
+    cy_en_csdidac_choice_t channel;         /**< The playback channel, CY_CSDIDAC_A or CY_CSDIDAC_B. */
+    cy_en_csdidac_wave_format_t format;     /**< The format of the played waveform. */
+    const uint32_t * words;                 /**< The table of the raw waveform. */
+    uint32_t count;                         /**< The number of the samples of the raw waveform. */
+    uint32_t index;                         /**< The next sample of the raw waveform. */
+    const uint8_t * stream;                 /**< The compressed stream. */
+    const uint8_t * token;                  /**< The next token of the compressed stream. */
+    uint32_t word;                          /**< The current IDAC register word of the compressed stream. */
+    uint32_t holdCnt;                       /**< The remaining samples of the hold token. */
+    bool loop;                              /**< The waveform is restarted at the end. */
+    volatile cy_en_csdidac_state_t state;   /**< The playback is running. */
+    #if (0u != CY_CSDIDAC_PROFILE_EN)
+        cy_stc_csdidac_profile_t profile;   /**< The execution time of Cy_CSDIDAC_WaveProcess(). */
+    #endif /* (0u != CY_CSDIDAC_PROFILE_EN) */
+} cy_stc_csdidac_wave_context_t;
+
+/** \} group_csdidac_data_structures */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+
+/**
+* \addtogroup group_csdidac_functions
+* \{
+*/
+cy_en_csdidac_status_t Cy_CSDIDAC_WaveInit(
+                cy_en_csdidac_choice_t ch,
+                cy_stc_csdidac_context_t * idacContext,
+                cy_stc_csdidac_wave_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_WavePlayRaw(
+                const uint32_t * words,
+                uint32_t count,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_WavePlay(
+                const uint8_t * stream,
+                uint32_t size,
+                bool loop,
+                cy_stc_csdidac_wave_context_t * context);
+void Cy_CSDIDAC_WaveProcess(
+                cy_stc_csdidac_wave_context_t * context);
+cy_en_csdidac_status_t Cy_CSDIDAC_WaveStop(
+                cy_stc_csdidac_wave_context_t * context);
+
+/** \} group_csdidac_functions */
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (defined(CY_IP_MXCSDV2) || defined(CY_IP_M0S8CSDV2)) */
+
+#endif /* CY_CSDIDAC_WAVE_H */
+
+
+/* [] END OF FILE */
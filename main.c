@@ -46,6 +46,9 @@
 #include "cybsp.h"
 #include "cy_pdl.h"
 #include "cy_csdidac.h"
+#include "cy_csdidac_led.h"
+#include "cy_csdidac_persist.h"
+#include "cy_csdidac_idle.h"
 #include <stdio.h>
 #include <inttypes.h>
 
@@ -67,19 +70,69 @@
 /* Current Increment while pressing switch (in nA) */
 #define CURRENT_INCREMENT_VALUE (4800u)
 
-/* LED Current (in nA) */
-#define LED_CURRENT_MAX_VALUE   (-609600)
-
 /* LED Toggle (in milliseconds) */
 #define LED_TOGGLE_DELAY_MS     (1000u)
 
+/* LED fade-in time from the minimum to the maximum brightness (in milliseconds) */
+#define LED_FADE_TIME_MS        (3200u)
+
+/* Number of flash rows used in turn to store the channel A operating point */
+#define PERSIST_ROWS            (4u)
+
+/* Main loop tick (in milliseconds) */
+#define MAIN_LOOP_TICK_MS       (1u)
+
+/* Time channel A is kept at 0 nA before it is parked (in milliseconds) */
+#define IDLE_HOLD_MS            (1000u)
+
+/* User button pin level when pressed (active low) */
+#define USER_BTN_PRESSED        (0u)
+
+/* Time the button level must be stable to accept a press or release (in milliseconds) */
+#define BUTTON_DEBOUNCE_MS      (20u)
+
+/* Press-and-hold time before the auto-repeat starts (in milliseconds) */
+#define BUTTON_REPEAT_DELAY_MS  (500u)
+
+/* First auto-repeat interval (in milliseconds) */
+#define BUTTON_REPEAT_START_MS  (200u)
+
+/* Shortest auto-repeat interval (in milliseconds) */
+#define BUTTON_REPEAT_MIN_MS    (10u)
+
+/* Auto-repeat acceleration: every repeat shortens the interval by 1/2^N */
+#define BUTTON_REPEAT_ACCEL_SHIFT (2u)
+
+/* Button debouncer states */
+typedef enum
+{
+    BUTTON_IDLE,                        /* Released, waiting for an edge */
+    BUTTON_DEBOUNCE,                    /* Edge detected, waiting for a stable press */
+    BUTTON_HELD                         /* Press accepted, auto-repeat running */
+} button_state_t;
+
 /*******************************************************************************
 * Global Variables
 *******************************************************************************/
 cy_stc_csdidac_context_t csdidac_context;
 
+/* Gamma-corrected LED driver on IDAC channel B */
+cy_stc_csdidac_led_context_t led_context;
+
+/* Channel A operating point persistence across resets */
+cy_stc_csdidac_persist_context_t persist_context;
+
+/* Zero-current idle gating of channel A */
+cy_stc_csdidac_idle_context_t idle_context;
+
+/* Flash rows reserved for the persistence records */
+CY_ALIGN(CY_CSDIDAC_PERSIST_ROW_SIZE) const uint8_t persist_storage[PERSIST_ROWS * CY_CSDIDAC_PERSIST_ROW_SIZE] = {0u};
+
 long current_value = CURRENT_MIN_VALUE;
 
+/* Set by the User Switch Interrupt Handler, consumed by the debouncer */
+volatile bool button_edge = false;
+
 /* User Switch Interrupt Configuration */
 const cy_stc_sysint_t User_Switch_intr_config =
 {
@@ -133,33 +186,220 @@ void check_status(char *message, cy_rslt_t status)
 }
 #endif /* DEBUG_PRINT */
 
+#if (DEBUG_PRINT && CY_CSDIDAC_PROFILE_EN)
+/*******************************************************************************
+* Function Name: print_profile
+********************************************************************************
+* Summary:
+*  Prints the CSDIDAC function profiling records in CSV format:
+*  api,calls,min,max,total. The time unit is the CPU clock cycle.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void print_profile(void)
+{
+    static const char * const api_name[CY_CSDIDAC_API_NUM] =
+    {
+        "Init", "DeInit", "WriteConfig", "Save", "Restore",
+        "OutputEnable", "OutputEnableExt", "OutputDisable", "ReconfigureChannel",
+        "SyncIdacWord", "Charge", "Route", "Mgr", "Seq", "Dither", "Health", "Idle",
+        "Pulse", "Scan", "Trig", "Bipolar"
+    };
+    cy_stc_csdidac_profile_t profile;
+    char str[80];
+    uint32_t api;
+
+    Cy_SCB_UART_PutString(CYBSP_UART_HW, "api,calls,min,max,total\r\n");
+    for (api = 0u; api < (uint32_t)CY_CSDIDAC_API_NUM; api++)
+    {
+        (void)Cy_CSDIDAC_GetProfile((cy_en_csdidac_api_t)api, &profile);
+        sprintf(str, "%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\r\n", api_name[api],
+                profile.calls, profile.minTime, profile.maxTime, profile.totalTime);
+        Cy_SCB_UART_PutString(CYBSP_UART_HW, str);
+    }
+}
+#endif /* (DEBUG_PRINT && CY_CSDIDAC_PROFILE_EN) */
+
 /*******************************************************************************
 * Function Name: User_Switch_Interrupt_Handler
 ********************************************************************************
 *
 * Summary:
 *  This function is executed when interrupt is triggered through the user switch press.
+*  It only records the edge; debouncing and the IDAC update are done by the
+*  main loop, so contact bounce does not reach the IDAC register path.
 *
 *******************************************************************************/
 void User_Switch_Interrupt_Handler(void)
 {
-    Cy_CSDIDAC_OutputEnable (CY_CSDIDAC_A, current_value, &csdidac_context);
+    button_edge = true;
 
-    /* Incrementing the current value */
-    current_value += CURRENT_INCREMENT_VALUE;
+    /* Clear the Interrupt */
+    Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN_PORT, CYBSP_USER_BTN_NUM);
+}
 
-    if (current_value > CURRENT_MAX_VALUE)
+/*******************************************************************************
+* Function Name: button_process
+********************************************************************************
+* Summary:
+*  Debounces the user button and generates the setpoint steps. Called every
+*  MAIN_LOOP_TICK_MS. A press is accepted when the button level is stable for
+*  BUTTON_DEBOUNCE_MS. When the button is held for BUTTON_REPEAT_DELAY_MS,
+*  steps are repeated with an interval that shrinks on every repeat down to
+*  BUTTON_REPEAT_MIN_MS, so the full current range can be crossed quickly.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool - true if a setpoint step is generated.
+*
+*******************************************************************************/
+bool button_process(void)
+{
+    static button_state_t state = BUTTON_IDLE;
+    static uint32_t stable_time = 0u;
+    static uint32_t hold_time = 0u;
+    static uint32_t repeat_interval = BUTTON_REPEAT_DELAY_MS;
+    bool pressed = (USER_BTN_PRESSED == Cy_GPIO_Read(CYBSP_USER_BTN_PORT, CYBSP_USER_BTN_NUM));
+    bool step = false;
+
+    switch (state)
     {
-        current_value = CURRENT_MIN_VALUE;
+        case BUTTON_IDLE:
+            if (button_edge)
+            {
+                button_edge = false;
+                stable_time = 0u;
+                state = BUTTON_DEBOUNCE;
+            }
+            break;
+
+        case BUTTON_DEBOUNCE:
+            if (pressed)
+            {
+                stable_time += MAIN_LOOP_TICK_MS;
+                if (stable_time >= BUTTON_DEBOUNCE_MS)
+                {
+                    step = true;
+                    stable_time = 0u;
+                    hold_time = 0u;
+                    repeat_interval = BUTTON_REPEAT_DELAY_MS;
+                    state = BUTTON_HELD;
+                }
+            }
+            else
+            {
+                /* Bounce or glitch: wait for the next edge */
+                state = BUTTON_IDLE;
+            }
+            break;
+
+        case BUTTON_HELD:
+            if (pressed)
+            {
+                stable_time = 0u;
+                hold_time += MAIN_LOOP_TICK_MS;
+                if (hold_time >= repeat_interval)
+                {
+                    step = true;
+                    hold_time = 0u;
+                    if (BUTTON_REPEAT_DELAY_MS == repeat_interval)
+                    {
+                        repeat_interval = BUTTON_REPEAT_START_MS;
+                    }
+                    else
+                    {
+                        repeat_interval -= repeat_interval >> BUTTON_REPEAT_ACCEL_SHIFT;
+                        if (repeat_interval < BUTTON_REPEAT_MIN_MS)
+                        {
+                            repeat_interval = BUTTON_REPEAT_MIN_MS;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                /* Release is accepted after a stable debounce time */
+                stable_time += MAIN_LOOP_TICK_MS;
+                if (stable_time >= BUTTON_DEBOUNCE_MS)
+                {
+                    button_edge = false;
+                    state = BUTTON_IDLE;
+                }
+            }
+            break;
+
+        default:
+            state = BUTTON_IDLE;
+            break;
     }
 
-#if DEBUG_PRINT
-    /* Set Switch press debug flag to 1 */
-    SwitchPressDebugFlag = 1;
-#endif /* DEBUG_PRINT */
+    return step;
+}
 
-    /* Clear the Interrupt */
-    Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN_PORT, CYBSP_USER_BTN_NUM);
+/*******************************************************************************
+* Function Name: led_process
+********************************************************************************
+* Summary:
+*  Runs the LED sequence on IDAC channel B without blocking: fades the LED in
+*  over LED_FADE_TIME_MS through the gamma-corrected LED driver, keeps it on
+*  for LED_TOGGLE_DELAY_MS, then switches it off for LED_TOGGLE_DELAY_MS.
+*  Called every MAIN_LOOP_TICK_MS.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void led_process(void)
+{
+    static bool led_control = false;
+    static uint32_t led_time = LED_TOGGLE_DELAY_MS;
+
+    led_time += MAIN_LOOP_TICK_MS;
+
+    /* Apply the next fade step */
+    Cy_CSDIDAC_LedProcess(&led_context);
+
+    if (led_control)
+    {
+        if (Cy_CSDIDAC_LedIsFading(&led_context))
+        {
+            /* Fade in */
+        }
+        else if (led_time >= (LED_FADE_TIME_MS + LED_TOGGLE_DELAY_MS))
+        {
+            Cy_CSDIDAC_LedFade(0u, 0u, &led_context);
+            led_control = false;
+            led_time = 0u;
+
+#if (DEBUG_PRINT && CY_CSDIDAC_PROFILE_EN)
+            print_profile();
+#endif /* (DEBUG_PRINT && CY_CSDIDAC_PROFILE_EN) */
+        }
+        else
+        {
+            /* Keep the LED on */
+        }
+    }
+    else if (led_time >= LED_TOGGLE_DELAY_MS)
+    {
+        Cy_CSDIDAC_LedFade(CY_CSDIDAC_LED_MAX_BRIGHTNESS, LED_FADE_TIME_MS / MAIN_LOOP_TICK_MS, &led_context);
+        led_control = true;
+        led_time = 0u;
+    }
+    else
+    {
+        /* Keep the LED off */
+    }
 }
 
 /*******************************************************************************
@@ -169,8 +409,10 @@ void User_Switch_Interrupt_Handler(void)
 * System entrance point. This function performs
 *    1. Intial setup of device
 *    2. Enables Switch Interrupt and UART
-*    3. Enables CSDIDAC
-*    4. Increases current while pressing Switch (Source mode)
+*    3. Enables CSDIDAC and restores the channel A current saved before
+*       the last reset
+*    4. Increases current while pressing Switch (Source mode), with
+*       debouncing and press-and-hold auto-repeat
 *    5. Toggles LED (sink mode)
 *
 * Parameters:
@@ -185,9 +427,7 @@ int main(void)
     cy_rslt_t result;
     cy_en_sysint_status_t intr_result;
     cy_en_csdidac_status_t csdidac_status;
-    long led_current_value = LED_CURRENT_MAX_VALUE;
-    bool led_control = true;
-    uint32_t toggle_delay = 0u;
+    int32_t current_pa;
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -225,6 +465,13 @@ int main(void)
     Cy_SCB_UART_PutString(CYBSP_UART_HW, "Sourcing current:\r\n");
 #endif /* DEBUG_PRINT */
 
+#if (CY_CSDIDAC_PROFILE_EN || CY_CSDIDAC_CS_STATS_EN)
+    /* Run SysTick from the CPU clock as the CSDIDAC profiling time source */
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif /* (CY_CSDIDAC_PROFILE_EN || CY_CSDIDAC_CS_STATS_EN) */
+
     /* Enable global interrupts */
     __enable_irq();
 
@@ -239,9 +486,78 @@ int main(void)
         CY_ASSERT (CY_ASSERT_FAILED);
     }
 
+    /* Initialize the LED driver on IDAC channel B (sink mode) */
+    csdidac_status = Cy_CSDIDAC_LedInit(CY_CSDIDAC_B, &csdidac_context, &led_context);
+
+    if (csdidac_status != CY_CSDIDAC_SUCCESS)
+    {
+#if DEBUG_PRINT
+        check_status ("API Cy_CSDIDAC_LedInit failed with error code", csdidac_status);
+#endif /* DEBUG_PRINT */
+        CY_ASSERT (CY_ASSERT_FAILED);
+    }
+
+    /* Restore the channel A current saved before the last reset */
+    csdidac_status = Cy_CSDIDAC_PersistInit(CY_CSDIDAC_A, persist_storage, PERSIST_ROWS, NULL,
+                                            &csdidac_context, &persist_context);
+    if (csdidac_status == CY_CSDIDAC_SUCCESS)
+    {
+        csdidac_status = Cy_CSDIDAC_PersistRestore(&persist_context);
+    }
+
+    if (csdidac_status != CY_CSDIDAC_SUCCESS)
+    {
+#if DEBUG_PRINT
+        check_status ("API Cy_CSDIDAC_PersistRestore failed with error code", csdidac_status);
+#endif /* DEBUG_PRINT */
+        CY_ASSERT (CY_ASSERT_FAILED);
+    }
+
+    /* Park channel A when the current wraps around to CURRENT_MIN_VALUE */
+    csdidac_status = Cy_CSDIDAC_IdleInit(CY_CSDIDAC_A, IDLE_HOLD_MS / MAIN_LOOP_TICK_MS,
+                                         &csdidac_context, &idle_context);
+
+    if (csdidac_status != CY_CSDIDAC_SUCCESS)
+    {
+#if DEBUG_PRINT
+        check_status ("API Cy_CSDIDAC_IdleInit failed with error code", csdidac_status);
+#endif /* DEBUG_PRINT */
+        CY_ASSERT (CY_ASSERT_FAILED);
+    }
+
+    /* The next press continues from the restored channel A current */
+    if ((Cy_CSDIDAC_GetOutputCurrent(CY_CSDIDAC_A, &current_pa, &csdidac_context) == CY_CSDIDAC_SUCCESS) &&
+        (0 != current_pa))
+    {
+        current_value = (current_pa / 1000) + CURRENT_INCREMENT_VALUE;
+
+        if (current_value > CURRENT_MAX_VALUE)
+        {
+            current_value = CURRENT_MIN_VALUE;
+        }
+    }
+
     for (;;)
     {
         /* CSDIDAC - Source mode */
+        if (button_process())
+        {
+            Cy_CSDIDAC_OutputEnable (CY_CSDIDAC_A, current_value, &csdidac_context);
+
+            /* Incrementing the current value */
+            current_value += CURRENT_INCREMENT_VALUE;
+
+            if (current_value > CURRENT_MAX_VALUE)
+            {
+                current_value = CURRENT_MIN_VALUE;
+            }
+
+#if DEBUG_PRINT
+            /* Set Switch press debug flag to 1 */
+            SwitchPressDebugFlag = 1;
+#endif /* DEBUG_PRINT */
+        }
+
 #if DEBUG_PRINT
         if (SwitchPressDebugFlag)
         {
@@ -256,28 +572,15 @@ int main(void)
 #endif /* DEBUG_PRINT */
 
         /* CSDIDAC - Sink mode */
-        if (LED_TOGGLE_DELAY_MS == toggle_delay)
-        {
-            if (led_control)
-            {
-                for (;led_current_value <= 0; led_current_value += CURRENT_INCREMENT_VALUE)
-                {
-                    Cy_CSDIDAC_OutputEnable (CY_CSDIDAC_B, led_current_value, &csdidac_context);
-                    Cy_SysLib_Delay(25);
-                }
-            }
-            else
-            {
-                Cy_CSDIDAC_OutputDisable (CY_CSDIDAC_B, &csdidac_context);
-                led_current_value = LED_CURRENT_MAX_VALUE;
-            }
+        led_process();
 
-            led_control = !led_control;
-            toggle_delay = 0;
-        }
+        /* Save the channel A current once it is stable */
+        (void)Cy_CSDIDAC_PersistProcess(&persist_context);
+
+        /* Park channel A after IDLE_HOLD_MS at 0 nA */
+        (void)Cy_CSDIDAC_IdleProcess(&idle_context);
 
-        Cy_SysLib_Delay (LED_TOGGLE_DELAY_MS);
-        toggle_delay += LED_TOGGLE_DELAY_MS;
+        Cy_SysLib_Delay (MAIN_LOOP_TICK_MS);
 
 #if DEBUG_PRINT
         if (ENTER_LOOP)
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+* \file csdidac_cmdsend.c
+* \version 2.10
+*
+* \brief
+* Host-side sender of the CSDIDAC binary setpoint frames. Streams a ramp of
+* setpoints to the device through a serial port, a pty, or a pipe, follows
+* the ACK/free-slot flow control of cy_csdidac_cmd.h, and reports the
+* sustained update rate.
+*
+* A non-ACK response or a response timeout makes the sender go back to the
+* frame the device expects and send it and the following frames again, so
+* the setpoints are applied once and in order.
+*
+* Build:  cc -std=c99 -D_DEFAULT_SOURCE -o csdidac_cmdsend csdidac_cmdsend.c
+* Usage:  csdidac_cmdsend <device> <a|b|ab> <count> [<start_nA> <step_nA>]
+*
+* A terminal device is switched to the raw mode at 115200 baud. The ramp
+* wraps from +609600 nA to -609600 nA.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+
+/* The protocol definitions must match cy_csdidac_cmd.h */
+#define CMD_SOF                     (0xA5u)
+#define CMD_RSP_SOF                 (0x5Au)
+#define CMD_RSP_SIZE                (4u)
+#define CMD_ACK                     (0x00u)
+#define CMD_FLAG_SYNC               (0x10u)
+#define CMD_QUEUE_SIZE              (8u)
+#define CMD_FRAME_SIZE              (9u)
+
+#define CMD_TIMEOUT_MS              (200)
+
+#define CMD_MAX_CURRENT_NA          (609600L)
+#define CMD_SEQ_NUM                 (256u)
+
+
+static uint16_t crc16(const uint8_t * data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFu;
+    uint32_t i;
+    uint32_t bit;
+
+    for (i = 0u; i < size; i++)
+    {
+        crc ^= ((uint32_t)data[i] << 8u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? ((crc << 1u) ^ 0x1021u) : (crc << 1u);
+        }
+    }
+
+    return ((uint16_t)crc);
+}
+
+
+static int send_frame(int fd, uint32_t flags, uint32_t seq, int32_t current)
+{
+    uint8_t frame[CMD_FRAME_SIZE];
+    uint32_t value = (uint32_t)current;
+    uint16_t crc;
+
+    frame[0] = CMD_SOF;
+    frame[1] = (uint8_t)flags;
+    frame[2] = (uint8_t)seq;
+    frame[3] = (uint8_t)value;
+    frame[4] = (uint8_t)(value >> 8u);
+    frame[5] = (uint8_t)(value >> 16u);
+    frame[6] = (uint8_t)(value >> 24u);
+    crc = crc16(&frame[1], 6u);
+    frame[7] = (uint8_t)crc;
+    frame[8] = (uint8_t)(crc >> 8u);
+
+    return ((CMD_FRAME_SIZE == write(fd, frame, CMD_FRAME_SIZE)) ? 0 : -1);
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+int main(int argc, char * argv[])
+{
+    int fd;
+    uint32_t ch;
+    unsigned long count;
+    long start = 0L;
+    long step = 4800L;
+    int32_t value[CMD_SEQ_NUM];
+    uint8_t rsp[CMD_RSP_SIZE];
+    uint32_t rspLen = 0u;
+    unsigned long base = 0u;
+    unsigned long next = 0u;
+    unsigned long generated = 0u;
+    unsigned long stale = 0u;
+    unsigned long offset;
+    unsigned long retries = 0u;
+    unsigned long timeouts = 0u;
+    uint32_t window = CMD_QUEUE_SIZE;
+    long current;
+    double startTime;
+    double elapsed;
+    struct termios tio;
+    struct pollfd pfd;
+    uint8_t rxByte;
+
+    if ((4 != argc) && (6 != argc))
+    {
+        fprintf(stderr, "Usage: %s <device> <a|b|ab> <count> [<start_nA> <step_nA>]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    ch = (0 == strcmp(argv[2], "a")) ? 0u : (0 == strcmp(argv[2], "b")) ? 1u : (0 == strcmp(argv[2], "ab")) ? 2u : 3u;
+    count = strtoul(argv[3], NULL, 0);
+    if (6 == argc)
+    {
+        start = strtol(argv[4], NULL, 0);
+        step = strtol(argv[5], NULL, 0);
+    }
+    if ((3u == ch) || (0u == count) || (CMD_MAX_CURRENT_NA < labs(start)) || (CMD_MAX_CURRENT_NA < labs(step)))
+    {
+        fprintf(stderr, "%s: invalid argument\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    fd = open(argv[1], O_RDWR | O_NOCTTY);
+    if (0 > fd)
+    {
+        fprintf(stderr, "%s: cannot open\n", argv[1]);
+        return (EXIT_FAILURE);
+    }
+    if (0 == tcgetattr(fd, &tio))
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    current = start;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    startTime = now_s();
+    while (base < count)
+    {
+        /* Sends while the device has free queue slots, the first frame starts the sequence */
+        while ((next < count) && ((next - base) < window))
+        {
+            if (next == generated)
+            {
+                value[generated % CMD_SEQ_NUM] = (int32_t)current;
+                generated++;
+                current += step;
+                if (CMD_MAX_CURRENT_NA < current)
+                {
+                    current = -CMD_MAX_CURRENT_NA;
+                }
+                else if (-CMD_MAX_CURRENT_NA > current)
+                {
+                    current = CMD_MAX_CURRENT_NA;
+                }
+            }
+            if (0 != send_frame(fd, ch | ((0u == next) ? CMD_FLAG_SYNC : 0u), (uint32_t)(next % CMD_SEQ_NUM),
+                                value[next % CMD_SEQ_NUM]))
+            {
+                fprintf(stderr, "%s: write failed\n", argv[1]);
+                close(fd);
+                return (EXIT_FAILURE);
+            }
+            next++;
+        }
+
+        if (0 == poll(&pfd, 1u, CMD_TIMEOUT_MS))
+        {
+            /* A frame or a response is lost, goes back to the oldest frame in flight */
+            timeouts++;
+            next = base;
+            stale = 0u;
+            rspLen = 0u;
+            continue;
+        }
+        if (1 != read(fd, &rxByte, 1u))
+        {
+            fprintf(stderr, "%s: read failed\n", argv[1]);
+            close(fd);
+            return (EXIT_FAILURE);
+        }
+        if ((0u == rspLen) && (CMD_RSP_SOF != rxByte))
+        {
+            /* Resynchronizes to the response start */
+            continue;
+        }
+        rsp[rspLen++] = rxByte;
+        if (CMD_RSP_SIZE == rspLen)
+        {
+            rspLen = 0u;
+            window = rsp[3];
+            /* The sequence number of the response relative to the oldest frame in flight */
+            offset = ((unsigned long)rsp[1] - base) % CMD_SEQ_NUM;
+            if (CMD_ACK == rsp[2])
+            {
+                /* The frames up to the acknowledged one are accepted */
+                if (offset < (next - base))
+                {
+                    base += offset + 1u;
+                }
+            }
+            else
+            {
+                /* The frames before the expected one are accepted */
+                if (offset <= (next - base))
+                {
+                    base += offset;
+                }
+                if (0u != stale)
+                {
+                    /* A frame sent before the last go-back, dropped by the device */
+                    stale--;
+                }
+                else
+                {
+                    /* Goes back to the expected frame, the device drops the frames in flight after it */
+                    retries++;
+                    stale = (next > base) ? (next - base - 1u) : 0u;
+                    next = base;
+                }
+            }
+            /* With no free slot reported, one frame is kept in flight to poll the device */
+            if (0u == window)
+            {
+                window = 1u;
+            }
+        }
+    }
+    elapsed = now_s() - startTime;
+    close(fd);
+
+    printf("%lu setpoints, %lu go-backs, %lu timeouts, %.3f s, %.1f setpoints/s\n",
+           base, retries, timeouts, elapsed, (elapsed > 0.0) ? ((double)base / elapsed) : 0.0);
+
+    return (EXIT_SUCCESS);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,294 @@
+/***************************************************************************//**
+* \file csdidac_seqasm.c
+* \version 2.10
+*
+* \brief
+* Host-side assembler of the CSDIDAC sequencer profiles. Translates the text
+* profile format into the bytecode executed by Cy_CSDIDAC_SeqProcess() and
+* writes it as a C array, ready to be compiled into the application. The
+* bytecode definitions are taken from cy_csdidac_seq.h, built with the host
+* stand-ins of the PDL headers in tools/host.
+*
+* Build:  cc -std=c99 -Itools/host -I. -o csdidac_seqasm tools/csdidac_seqasm.c
+* Usage:  csdidac_seqasm <profile.txt> <array_name> [<output.c>]
+*
+* The text format is one instruction per line, '#' starts a comment.
+* The channel is a, b, or ab, currents are in nA with a sign, ticks and
+* counts are in the range 0..65535:
+*
+*   set  <channel> <current>
+*   off  <channel>
+*   ramp <a|b> <current> <ticks>
+*   wait <ticks>
+*   loop <count>            # 0 - forever
+*   endloop
+*   sync <currentA> <currentB>
+*   end
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "cy_csdidac_seq.h"
+
+#define SEQ_MAX_CURRENT_NA          ((long)CY_CSDIDAC_MAX_CURRENT_NA)
+#define SEQ_MAX_TICKS               (65535L)
+#define SEQ_MAX_LENGTH              (65536u)
+#define SEQ_LINE_LEN                (256u)
+
+static uint8_t program[SEQ_MAX_LENGTH];
+static uint32_t length = 0u;
+
+
+static int emit(uint32_t value, uint32_t size)
+{
+    int result = 0;
+    uint32_t i;
+
+    if ((length + size) > SEQ_MAX_LENGTH)
+    {
+        result = -1;
+    }
+    else
+    {
+        for (i = 0u; i < size; i++)
+        {
+            program[length++] = (uint8_t)(value >> (8u * i));
+        }
+    }
+
+    return (result);
+}
+
+
+static int parse_number(const char * token, long min, long max, long * value)
+{
+    int result = -1;
+    char * end;
+
+    if (NULL != token)
+    {
+        *value = strtol(token, &end, 0);
+        if (('\0' == *end) && (min <= *value) && (max >= *value))
+        {
+            result = 0;
+        }
+    }
+
+    return (result);
+}
+
+
+static int parse_channel(const char * token, int allowBoth, long * value)
+{
+    int result = 0;
+
+    if (NULL == token)
+    {
+        result = -1;
+    }
+    else if (0 == strcmp(token, "a"))
+    {
+        *value = (long)CY_CSDIDAC_A;
+    }
+    else if (0 == strcmp(token, "b"))
+    {
+        *value = (long)CY_CSDIDAC_B;
+    }
+    else if ((0 != allowBoth) && (0 == strcmp(token, "ab")))
+    {
+        *value = (long)CY_CSDIDAC_AB;
+    }
+    else
+    {
+        result = -1;
+    }
+
+    return (result);
+}
+
+
+static int assemble_line(char * line, int * depth, int * endFound)
+{
+    int result = 0;
+    long ch = 0;
+    long arg1 = 0;
+    long arg2 = 0;
+    uint32_t start = length;
+    uint32_t size = 0u;
+    char * op;
+    char * comment = strchr(line, '#');
+
+    if (NULL != comment)
+    {
+        *comment = '\0';
+    }
+
+    op = strtok(line, " \t\r\n");
+    if (NULL == op)
+    {
+        /* An empty line */
+    }
+    else if (0 == strcmp(op, "set"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_SET;
+        result |= parse_channel(strtok(NULL, " \t\r\n"), 1, &ch);
+        result |= parse_number(strtok(NULL, " \t\r\n"), -SEQ_MAX_CURRENT_NA, SEQ_MAX_CURRENT_NA, &arg1);
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_SET, 1u) | emit((uint32_t)ch, 1u) |
+                                   emit((uint32_t)arg1, 4u)) : 0;
+    }
+    else if (0 == strcmp(op, "off"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_OFF;
+        result |= parse_channel(strtok(NULL, " \t\r\n"), 1, &ch);
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_OFF, 1u) | emit((uint32_t)ch, 1u)) : 0;
+    }
+    else if (0 == strcmp(op, "ramp"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_RAMP;
+        result |= parse_channel(strtok(NULL, " \t\r\n"), 0, &ch);
+        result |= parse_number(strtok(NULL, " \t\r\n"), -SEQ_MAX_CURRENT_NA, SEQ_MAX_CURRENT_NA, &arg1);
+        result |= parse_number(strtok(NULL, " \t\r\n"), 0, SEQ_MAX_TICKS, &arg2);
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_RAMP, 1u) | emit((uint32_t)ch, 1u) |
+                                   emit((uint32_t)arg1, 4u) | emit((uint32_t)arg2, 2u)) : 0;
+    }
+    else if (0 == strcmp(op, "wait"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_WAIT;
+        result |= parse_number(strtok(NULL, " \t\r\n"), 0, SEQ_MAX_TICKS, &arg1);
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_WAIT, 1u) | emit((uint32_t)arg1, 2u)) : 0;
+    }
+    else if (0 == strcmp(op, "loop"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_LOOP;
+        result |= parse_number(strtok(NULL, " \t\r\n"), 0, SEQ_MAX_TICKS, &arg1);
+        result |= ((int)CY_CSDIDAC_SEQ_LOOP_DEPTH <= *depth) ? -1 : 0;
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_LOOP, 1u) | emit((uint32_t)arg1, 2u)) : 0;
+        (*depth)++;
+    }
+    else if (0 == strcmp(op, "endloop"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_ENDLOOP;
+        result |= (0 == *depth) ? -1 : 0;
+        result |= (0 == result) ? emit(CY_CSDIDAC_SEQ_OP_ENDLOOP, 1u) : 0;
+        (*depth)--;
+    }
+    else if (0 == strcmp(op, "sync"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_SYNC;
+        result |= parse_number(strtok(NULL, " \t\r\n"), -SEQ_MAX_CURRENT_NA, SEQ_MAX_CURRENT_NA, &arg1);
+        result |= parse_number(strtok(NULL, " \t\r\n"), -SEQ_MAX_CURRENT_NA, SEQ_MAX_CURRENT_NA, &arg2);
+        result |= (0 == result) ? (emit(CY_CSDIDAC_SEQ_OP_SYNC, 1u) | emit((uint32_t)arg1, 4u) |
+                                   emit((uint32_t)arg2, 4u)) : 0;
+    }
+    else if (0 == strcmp(op, "end"))
+    {
+        size = CY_CSDIDAC_SEQ_LEN_END;
+        result |= (0 != *depth) ? -1 : 0;
+        result |= (0 == result) ? emit(CY_CSDIDAC_SEQ_OP_END, 1u) : 0;
+        *endFound = 1;
+    }
+    else
+    {
+        result = -1;
+    }
+
+    if ((0 == result) && (NULL != op) && (NULL != strtok(NULL, " \t\r\n")))
+    {
+        /* Extra operands */
+        result = -1;
+    }
+    else if ((0 == result) && (NULL != op) && ((length - start) != size))
+    {
+        /* The operands do not match the instruction length of cy_csdidac_seq.h */
+        result = -1;
+    }
+    else
+    {
+        /* The instruction is assembled */
+    }
+
+    return (result);
+}
+
+
+int main(int argc, char * argv[])
+{
+    int result = EXIT_SUCCESS;
+    char line[SEQ_LINE_LEN];
+    unsigned lineNum = 0u;
+    int depth = 0;
+    int endFound = 0;
+    uint32_t i;
+    FILE * in;
+    FILE * out = stdout;
+
+    if ((3 > argc) || (4 < argc))
+    {
+        fprintf(stderr, "Usage: %s <profile.txt> <array_name> [<output.c>]\n", argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    in = fopen(argv[1], "r");
+    if (NULL == in)
+    {
+        fprintf(stderr, "%s: cannot open\n", argv[1]);
+        return (EXIT_FAILURE);
+    }
+
+    while ((EXIT_SUCCESS == result) && (0 == endFound) && (NULL != fgets(line, sizeof(line), in)))
+    {
+        lineNum++;
+        if (0 != assemble_line(line, &depth, &endFound))
+        {
+            fprintf(stderr, "%s:%u: invalid instruction\n", argv[1], lineNum);
+            result = EXIT_FAILURE;
+        }
+    }
+    fclose(in);
+
+    if ((EXIT_SUCCESS == result) && (0 == endFound))
+    {
+        fprintf(stderr, "%s: missing end\n", argv[1]);
+        result = EXIT_FAILURE;
+    }
+
+    if ((EXIT_SUCCESS == result) && (4 == argc))
+    {
+        out = fopen(argv[3], "w");
+        if (NULL == out)
+        {
+            fprintf(stderr, "%s: cannot open\n", argv[3]);
+            result = EXIT_FAILURE;
+        }
+    }
+
+    if (EXIT_SUCCESS == result)
+    {
+        fprintf(out, "/* Generated by csdidac_seqasm from %s, %u bytes */\n", argv[1], (unsigned)length);
+        fprintf(out, "const uint8_t %s[] =\n{", argv[2]);
+        for (i = 0u; i < length; i++)
+        {
+            fprintf(out, "%s0x%02Xu%s", (0u == (i % 12u)) ? "\n    " : " ", program[i],
+                    ((i + 1u) < length) ? "," : "\n");
+        }
+        fprintf(out, "};\n");
+        if (stdout != out)
+        {
+            fclose(out);
+        }
+    }
+
+    return (result);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,920 @@
+/***************************************************************************//**
+* \file csdidac_wavec.c
+* \version 2.10
+*
+* \brief
+* Host-side waveform compiler of the CSDIDAC register-word tables. Converts
+* a sampled current waveform into IDAC register words, choosing the LSB and
+* code of every sample so the number of the LSB range switches is minimal
+* while the error of every sample exceeds the error of its most accurate
+* LSB by no more than the bound, 50 nA by default. The total error is
+* minimized among the solutions with the same number of switches.
+*
+* Build:  cc -std=c99 -D_DEFAULT_SOURCE -O2 -pthread -o csdidac_wavec csdidac_wavec.c -lm
+* Usage:  csdidac_wavec [-z] [-e <max_error_nA>] [-j <threads>] [-s <segment>]
+*                       <waveform.txt> <array_name> [<output.c>]
+*         csdidac_wavec -b <samples> [-z] [-e <max_error_nA>] [-j <threads>] [-s <segment>]
+*
+* The waveform file has one sample per line with one column per channel,
+* up to two, the currents are in nA with a sign, '#' starts a comment.
+* The output is a C array of register words per channel, ready for the
+* Cy_CSDIDAC_GetIdacReg() fast path or Cy_CSDIDAC_WavePlayRaw(). With the
+* -z option, the output is a compressed stream per channel for
+* Cy_CSDIDAC_WavePlay(), and the compression ratio and the decode time
+* compared to the raw table are reported. The -b option compiles a synthetic
+* two-channel waveform and reports the time and the switches compared to
+* the Cy_CSDIDAC_OutputEnable() rule.
+*
+* The waveform is split into segments that are compiled in parallel. For
+* every segment, the dynamic-programming pass is done once per entry LSB,
+* the segment results are chained in a short sequential pass, and then
+* every segment is compiled again in parallel from its chosen entry LSB to
+* emit the words, so the result is as good as a single pass over the waveform.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+
+/* The IDAC definitions must match cy_csdidac.h */
+#define WAV_LSB_NUM                 (6u)
+#define WAV_MAX_CODE                (127u)
+#define WAV_MAX_CURRENT_NA          (609600L)
+#define WAV_WORD(pol, lsb, code)    ((uint32_t)(code) | ((uint32_t)(pol) << 8u) | (((uint32_t)(lsb) >> 1u) << 22u) | \
+                                     (1uL << 24u) | (((uint32_t)(lsb) & 1u) << 25u))
+#define WAV_WORD_LSB(word)          (((((word) >> 22u) & 3u) << 1u) | (((word) >> 25u) & 1u))
+#define WAV_WORD_POL_MASK           ((uint32_t)3u << 8u)
+#define WAV_WORD_CODE_MASK          (0x7Fu)
+
+/* The compressed stream definitions must match cy_csdidac_wave.h */
+#define WAV_Z_HOLD                  (0x80u)
+#define WAV_Z_HOLD_MAX              (64u)
+#define WAV_Z_RANGE                 (0xC0u)
+#define WAV_Z_END                   (0xFFu)
+#define WAV_Z_DELTA_MIN             (-64)
+#define WAV_Z_DELTA_MAX             (63)
+#define WAV_Z_DECODE_RUNS           (20u)
+
+#define WAV_CH_MAX                  (2u)
+#define WAV_FREE_ENTRY              (WAV_LSB_NUM)
+#define WAV_ENTRY_NUM               (WAV_LSB_NUM + 1u)
+#define WAV_DEFAULT_SEGMENT         (65536u)
+#define WAV_DEFAULT_ERROR_PA        (50000u)
+#define WAV_DEFAULT_THREADS         (4u)
+#define WAV_MAX_THREADS             (64u)
+#define WAV_LINE_LEN                (256u)
+#define WAV_INF                     (UINT32_MAX)
+
+static const uint32_t lsbPa[WAV_LSB_NUM] = {37500u, 75000u, 300000u, 600000u, 2400000u, 4800000u};
+
+/* The lexicographic cost: the switches first, then the total error */
+typedef struct
+{
+    uint32_t switches;
+    uint64_t error;
+} cost_t;
+
+/* The per-sample table of a segment */
+typedef struct
+{
+    uint32_t err[WAV_LSB_NUM];
+    uint8_t code[WAV_LSB_NUM];
+    uint8_t feasible;
+} sample_t;
+
+typedef struct
+{
+    uint32_t ch;
+    size_t first;
+    size_t count;
+    cost_t exitCost[WAV_ENTRY_NUM][WAV_LSB_NUM];   /* The segment cost per entry and exit LSB */
+    uint32_t entry;                                 /* The chosen entry LSB */
+    uint32_t exit;                                  /* The chosen exit LSB */
+} segment_t;
+
+typedef struct
+{
+    const int32_t * samples[WAV_CH_MAX];
+    uint32_t * words[WAV_CH_MAX];
+    segment_t * segments;
+    size_t segmentNum;
+    size_t nextTask;
+    int emitPass;
+    uint64_t maxErrPa;
+    pthread_mutex_t lock;
+} job_t;
+
+
+static int cost_less(const cost_t * a, const cost_t * b)
+{
+    return ((a->switches < b->switches) || ((a->switches == b->switches) && (a->error < b->error)));
+}
+
+
+/* The per-sample error and code of every LSB, and the LSBs within the bound */
+static void sample_table(const int32_t * samples, size_t count, uint64_t maxErrPa, sample_t * table)
+{
+    uint64_t absPa;
+    uint64_t minErr;
+    uint64_t code;
+    uint64_t err;
+    uint32_t lsb;
+    size_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        absPa = (uint64_t)((0 > samples[i]) ? -(int64_t)samples[i] : (int64_t)samples[i]) * 1000u;
+        minErr = UINT64_MAX;
+        for (lsb = 0u; lsb < WAV_LSB_NUM; lsb++)
+        {
+            code = (absPa + (lsbPa[lsb] / 2u)) / lsbPa[lsb];
+            if (WAV_MAX_CODE < code)
+            {
+                code = WAV_MAX_CODE;
+            }
+            err = (code * lsbPa[lsb] > absPa) ? ((code * lsbPa[lsb]) - absPa) : (absPa - (code * lsbPa[lsb]));
+            table[i].err[lsb] = (uint32_t)err;
+            table[i].code[lsb] = (uint8_t)code;
+            minErr = (err < minErr) ? err : minErr;
+        }
+        /* The bound is relative to the most accurate LSB, so every sample has an LSB within it */
+        table[i].feasible = 0u;
+        for (lsb = 0u; lsb < WAV_LSB_NUM; lsb++)
+        {
+            table[i].feasible |= (table[i].err[lsb] <= (minErr + maxErrPa)) ? (uint8_t)(1u << lsb) : 0u;
+        }
+    }
+}
+
+
+/*
+* The dynamic-programming pass over a segment from an entry LSB. The final
+* costs per exit LSB are returned, the predecessor LSBs are stored if from
+* is not NULL.
+*/
+static void segment_pass(const sample_t * table, size_t count, uint32_t entry, cost_t * cost, uint8_t * from)
+{
+    cost_t next[WAV_LSB_NUM];
+    uint32_t best;
+    uint32_t lsb;
+    size_t i;
+
+    for (lsb = 0u; lsb < WAV_LSB_NUM; lsb++)
+    {
+        cost[lsb].switches = ((WAV_FREE_ENTRY == entry) || (lsb == entry)) ? 0u : 1u;
+        cost[lsb].error = 0u;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        best = 0u;
+        for (lsb = 1u; lsb < WAV_LSB_NUM; lsb++)
+        {
+            if (cost_less(&cost[lsb], &cost[best]))
+            {
+                best = lsb;
+            }
+        }
+
+        for (lsb = 0u; lsb < WAV_LSB_NUM; lsb++)
+        {
+            if (0u == (table[i].feasible & (1u << lsb)))
+            {
+                next[lsb].switches = WAV_INF;
+                next[lsb].error = UINT64_MAX;
+                continue;
+            }
+            next[lsb] = cost[lsb];
+            if (NULL != from)
+            {
+                from[(i * WAV_LSB_NUM) + lsb] = (uint8_t)lsb;
+            }
+            /* A switch from the best LSB, the stay wins a tie */
+            if ((WAV_INF != cost[best].switches) &&
+                ((WAV_INF == next[lsb].switches) || ((cost[best].switches + 1u) < next[lsb].switches) ||
+                 (((cost[best].switches + 1u) == next[lsb].switches) && (cost[best].error < next[lsb].error))))
+            {
+                next[lsb].switches = cost[best].switches + 1u;
+                next[lsb].error = cost[best].error;
+                if (NULL != from)
+                {
+                    from[(i * WAV_LSB_NUM) + lsb] = (uint8_t)best;
+                }
+            }
+            next[lsb].error += table[i].err[lsb];
+        }
+        memcpy(cost, next, sizeof(next));
+    }
+}
+
+
+/* Compiles a segment from the chosen entry LSB and emits the register words */
+static int segment_emit(const int32_t * samples, uint32_t * words, const segment_t * seg, uint64_t maxErrPa)
+{
+    cost_t cost[WAV_LSB_NUM];
+    uint32_t lsb = seg->exit;
+    sample_t * table = malloc(seg->count * sizeof(sample_t));
+    uint8_t * from = malloc(seg->count * WAV_LSB_NUM);
+    size_t i;
+
+    if ((NULL == table) || (NULL == from))
+    {
+        free(table);
+        free(from);
+        return (-1);
+    }
+
+    samples += seg->first;
+    words += seg->first;
+    sample_table(samples, seg->count, maxErrPa, table);
+    segment_pass(table, seg->count, seg->entry, cost, from);
+    for (i = seg->count; i > 0u; i--)
+    {
+        words[i - 1u] = WAV_WORD((0 > samples[i - 1u]) ? 1u : 0u, lsb, table[i - 1u].code[lsb]);
+        lsb = from[((i - 1u) * WAV_LSB_NUM) + lsb];
+    }
+    free(table);
+    free(from);
+
+    return (0);
+}
+
+
+/* Compiles a segment from every entry LSB and keeps the costs per exit LSB */
+static int segment_cost(const int32_t * samples, segment_t * seg, uint64_t maxErrPa)
+{
+    sample_t * table = malloc(seg->count * sizeof(sample_t));
+    uint32_t entry;
+
+    if (NULL == table)
+    {
+        return (-1);
+    }
+
+    sample_table(&samples[seg->first], seg->count, maxErrPa, table);
+    for (entry = 0u; entry < WAV_ENTRY_NUM; entry++)
+    {
+        /* Only the first segment of a channel has the free entry */
+        if ((WAV_FREE_ENTRY == entry) == (0u == seg->first))
+        {
+            segment_pass(table, seg->count, entry, seg->exitCost[entry], NULL);
+        }
+    }
+    free(table);
+
+    return (0);
+}
+
+
+static void * worker(void * arg)
+{
+    job_t * job = (job_t *)arg;
+    segment_t * seg;
+    size_t task;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&job->lock);
+        task = job->nextTask++;
+        pthread_mutex_unlock(&job->lock);
+        if (task >= job->segmentNum)
+        {
+            break;
+        }
+
+        seg = &job->segments[task];
+        if (0 != ((0 == job->emitPass) ? segment_cost(job->samples[seg->ch], seg, job->maxErrPa) :
+                  segment_emit(job->samples[seg->ch], job->words[seg->ch], seg, job->maxErrPa)))
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return (NULL);
+}
+
+
+static void run_pass(job_t * job, uint32_t threads, int emitPass)
+{
+    pthread_t tid[WAV_MAX_THREADS];
+    uint32_t i;
+
+    job->nextTask = 0u;
+    job->emitPass = emitPass;
+    for (i = 0u; i < threads; i++)
+    {
+        if (0 != pthread_create(&tid[i], NULL, worker, job))
+        {
+            fprintf(stderr, "cannot create a thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (i = 0u; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    }
+}
+
+
+/* Chains the segment costs of a channel and chooses the entry and exit LSB of every segment */
+static void chain_segments(segment_t * segs, size_t num)
+{
+    cost_t total[WAV_LSB_NUM];
+    cost_t next[WAV_LSB_NUM];
+    cost_t sum;
+    uint8_t * arg = malloc(num * WAV_LSB_NUM);
+    uint32_t entry;
+    uint32_t lsb;
+    size_t k;
+
+    if (NULL == arg)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(total, segs[0].exitCost[WAV_FREE_ENTRY], sizeof(total));
+    for (k = 1u; k < num; k++)
+    {
+        for (lsb = 0u; lsb < WAV_LSB_NUM; lsb++)
+        {
+            next[lsb].switches = WAV_INF;
+            next[lsb].error = UINT64_MAX;
+            arg[(k * WAV_LSB_NUM) + lsb] = 0u;
+            for (entry = 0u; entry < WAV_LSB_NUM; entry++)
+            {
+                if ((WAV_INF == total[entry].switches) || (WAV_INF == segs[k].exitCost[entry][lsb].switches))
+                {
+                    continue;
+                }
+                sum.switches = total[entry].switches + segs[k].exitCost[entry][lsb].switches;
+                sum.error = total[entry].error + segs[k].exitCost[entry][lsb].error;
+                if (cost_less(&sum, &next[lsb]))
+                {
+                    next[lsb] = sum;
+                    arg[(k * WAV_LSB_NUM) + lsb] = (uint8_t)entry;
+                }
+            }
+        }
+        memcpy(total, next, sizeof(total));
+    }
+
+    lsb = 0u;
+    for (entry = 1u; entry < WAV_LSB_NUM; entry++)
+    {
+        if (cost_less(&total[entry], &total[lsb]))
+        {
+            lsb = entry;
+        }
+    }
+    for (k = num; k > 0u; k--)
+    {
+        segs[k - 1u].exit = lsb;
+        segs[k - 1u].entry = (1u == k) ? WAV_FREE_ENTRY : arg[((k - 1u) * WAV_LSB_NUM) + lsb];
+        lsb = segs[k - 1u].entry;
+    }
+    free(arg);
+}
+
+
+/* Compiles the channels and sets the polarity of the zero samples to the previous one */
+static int compile(int32_t * const * samples, uint32_t ** words, uint32_t channels, size_t count,
+                   uint64_t maxErrPa, uint32_t threads, size_t segment)
+{
+    job_t job;
+    size_t perCh = (count + segment - 1u) / segment;
+    size_t k;
+    size_t i;
+    uint32_t ch;
+
+    memset(&job, 0, sizeof(job));
+    job.segmentNum = perCh * channels;
+    job.segments = calloc(job.segmentNum, sizeof(segment_t));
+    job.maxErrPa = maxErrPa;
+    if (NULL == job.segments)
+    {
+        return (-1);
+    }
+    for (ch = 0u; ch < channels; ch++)
+    {
+        job.samples[ch] = samples[ch];
+        job.words[ch] = words[ch];
+        for (k = 0u; k < perCh; k++)
+        {
+            job.segments[(ch * perCh) + k].ch = ch;
+            job.segments[(ch * perCh) + k].first = k * segment;
+            job.segments[(ch * perCh) + k].count = ((k + 1u) < perCh) ? segment : (count - (k * segment));
+        }
+    }
+    pthread_mutex_init(&job.lock, NULL);
+
+    run_pass(&job, threads, 0);
+    for (ch = 0u; ch < channels; ch++)
+    {
+        chain_segments(&job.segments[ch * perCh], perCh);
+    }
+    run_pass(&job, threads, 1);
+
+    for (ch = 0u; ch < channels; ch++)
+    {
+        for (i = 1u; i < count; i++)
+        {
+            if (0u == (words[ch][i] & WAV_WORD_CODE_MASK))
+            {
+                words[ch][i] = (words[ch][i] & ~WAV_WORD_POL_MASK) | (words[ch][i - 1u] & WAV_WORD_POL_MASK);
+            }
+        }
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    free(job.segments);
+
+    return (0);
+}
+
+
+/* The Cy_CSDIDAC_OutputEnable() rule: the smallest LSB that fits, the code is truncated */
+static uint32_t greedy_word(int32_t current)
+{
+    uint64_t absPa = (uint64_t)((0 > current) ? -(int64_t)current : (int64_t)current) * 1000u;
+    uint32_t lsb = 0u;
+
+    while (((lsb + 1u) < WAV_LSB_NUM) && (absPa >= ((uint64_t)WAV_MAX_CODE * lsbPa[lsb])))
+    {
+        lsb++;
+    }
+
+    return (WAV_WORD((0 > current) ? 1u : 0u, lsb, (uint32_t)(absPa / lsbPa[lsb])));
+}
+
+
+static uint64_t word_error(int32_t current, uint32_t word)
+{
+    uint64_t absPa = (uint64_t)((0 > current) ? -(int64_t)current : (int64_t)current) * 1000u;
+    uint64_t outPa = (uint64_t)(word & WAV_WORD_CODE_MASK) * lsbPa[WAV_WORD_LSB(word)];
+
+    return ((outPa > absPa) ? (outPa - absPa) : (absPa - outPa));
+}
+
+
+static void report(const int32_t * samples, const uint32_t * words, size_t count, uint32_t ch)
+{
+    size_t switches = 0u;
+    size_t greedySwitches = 0u;
+    uint64_t maxErr = 0u;
+    uint64_t greedyMaxErr = 0u;
+    uint64_t err;
+    uint32_t greedy;
+    uint32_t greedyPrev = 0u;
+    size_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        greedy = greedy_word(samples[i]);
+        err = word_error(samples[i], words[i]);
+        maxErr = (err > maxErr) ? err : maxErr;
+        err = word_error(samples[i], greedy);
+        greedyMaxErr = (err > greedyMaxErr) ? err : greedyMaxErr;
+        if (0u < i)
+        {
+            switches += (WAV_WORD_LSB(words[i]) != WAV_WORD_LSB(words[i - 1u])) ? 1u : 0u;
+            greedySwitches += (WAV_WORD_LSB(greedy) != WAV_WORD_LSB(greedyPrev)) ? 1u : 0u;
+        }
+        greedyPrev = greedy;
+    }
+
+    fprintf(stderr, "channel %c: %zu samples, %zu range switches, max error %.3f nA "
+                    "(OutputEnable rule: %zu range switches, max error %.3f nA)\n",
+            (char)('a' + ch), count, switches, (double)maxErr / 1000.0, greedySwitches, (double)greedyMaxErr / 1000.0);
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+/* Encodes the words into a compressed stream of up to 2 * count + 1 bytes, returns the size */
+static size_t encode(const uint32_t * words, size_t count, uint8_t * out)
+{
+    size_t size = 0u;
+    size_t run;
+    size_t i = 0u;
+    int32_t delta;
+
+    while (i < count)
+    {
+        if ((0u < i) && (words[i] == words[i - 1u]))
+        {
+            for (run = 1u; ((i + run) < count) && (words[i + run] == words[i]) && (WAV_Z_HOLD_MAX > run); run++)
+            {
+            }
+            out[size++] = (uint8_t)(WAV_Z_HOLD | (run - 1u));
+            i += run;
+            continue;
+        }
+
+        delta = (0u < i) ? ((int32_t)(words[i] & WAV_WORD_CODE_MASK) - (int32_t)(words[i - 1u] & WAV_WORD_CODE_MASK)) : 0;
+        if ((0u < i) && ((words[i] & ~WAV_WORD_CODE_MASK) == (words[i - 1u] & ~WAV_WORD_CODE_MASK)) &&
+            (WAV_Z_DELTA_MIN <= delta) && (WAV_Z_DELTA_MAX >= delta))
+        {
+            out[size++] = (uint8_t)((uint32_t)delta & WAV_WORD_CODE_MASK);
+        }
+        else
+        {
+            out[size++] = (uint8_t)(WAV_Z_RANGE | (((words[i] & WAV_WORD_POL_MASK) >> 8u) << 3u) | WAV_WORD_LSB(words[i]));
+            out[size++] = (uint8_t)(words[i] & WAV_WORD_CODE_MASK);
+        }
+        i++;
+    }
+    out[size++] = WAV_Z_END;
+
+    return (size);
+}
+
+
+/* The decoder of Cy_CSDIDAC_WaveProcess(), one sample per call, returns the sample count */
+static size_t decode(const uint8_t * stream, uint32_t * words, size_t count)
+{
+    const uint8_t * token = stream;
+    uint32_t word = 0u;
+    uint32_t hold = 0u;
+    uint32_t value;
+    size_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        if (0u != hold)
+        {
+            hold--;
+        }
+        else
+        {
+            value = *token++;
+            if (WAV_Z_HOLD > value)
+            {
+                word = (word & ~WAV_WORD_CODE_MASK) | ((word + value) & WAV_WORD_CODE_MASK);
+            }
+            else if (WAV_Z_RANGE > value)
+            {
+                hold = value & (WAV_Z_HOLD_MAX - 1u);
+            }
+            else if (WAV_Z_END != value)
+            {
+                word = WAV_WORD((value >> 3u) & 1u, value & 7u, *token);
+                token++;
+            }
+            else
+            {
+                break;
+            }
+        }
+        words[i] = word;
+    }
+
+    return (i);
+}
+
+
+/* Compresses a channel, verifies the stream and compares the decode time with the raw table reads */
+static uint8_t * compress(const uint32_t * words, size_t count, uint32_t ch, size_t * size)
+{
+    uint8_t * stream = malloc((2u * count) + 1u);
+    uint32_t * decoded = malloc(count * sizeof(uint32_t));
+    volatile uint32_t sink = 0u;
+    double rawTime;
+    double decodeTime;
+    double startTime;
+    uint32_t run;
+    size_t i;
+
+    if ((NULL == stream) || (NULL == decoded))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    *size = encode(words, count, stream);
+    if ((count != decode(stream, decoded, count)) || (0 != memcmp(words, decoded, count * sizeof(uint32_t))))
+    {
+        fprintf(stderr, "channel %c: the stream does not decode to the words\n", (char)('a' + ch));
+        exit(EXIT_FAILURE);
+    }
+
+    startTime = now_s();
+    for (run = 0u; run < WAV_Z_DECODE_RUNS; run++)
+    {
+        for (i = 0u; i < count; i++)
+        {
+            sink = words[i];
+        }
+    }
+    rawTime = now_s() - startTime;
+    startTime = now_s();
+    for (run = 0u; run < WAV_Z_DECODE_RUNS; run++)
+    {
+        (void)decode(stream, decoded, count);
+        sink = decoded[count - 1u];
+    }
+    decodeTime = now_s() - startTime;
+    (void)sink;
+    free(decoded);
+
+    fprintf(stderr, "channel %c: %zu bytes compressed, %zu bytes raw, ratio %.2f, "
+                    "decode %.2f ns/sample, raw %.2f ns/sample\n",
+            (char)('a' + ch), *size, count * sizeof(uint32_t), (double)(count * sizeof(uint32_t)) / (double)*size,
+            decodeTime * 1e9 / ((double)count * WAV_Z_DECODE_RUNS), rawTime * 1e9 / ((double)count * WAV_Z_DECODE_RUNS));
+
+    return (stream);
+}
+
+
+static int read_waveform(const char * path, int32_t ** samples, uint32_t * channels, size_t * count)
+{
+    char line[WAV_LINE_LEN];
+    size_t capacity = 0u;
+    uint32_t cols;
+    long value;
+    char * token;
+    char * end;
+    char * comment;
+    int32_t * grown;
+    FILE * in = fopen(path, "r");
+    uint32_t ch;
+
+    if (NULL == in)
+    {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return (-1);
+    }
+
+    *channels = 0u;
+    *count = 0u;
+    while (NULL != fgets(line, sizeof(line), in))
+    {
+        comment = strchr(line, '#');
+        if (NULL != comment)
+        {
+            *comment = '\0';
+        }
+        cols = 0u;
+        for (token = strtok(line, " \t\r\n,"); NULL != token; token = strtok(NULL, " \t\r\n,"))
+        {
+            value = strtol(token, &end, 0);
+            if (('\0' != *end) || (WAV_CH_MAX <= cols) || (WAV_MAX_CURRENT_NA < labs(value)))
+            {
+                fprintf(stderr, "%s:%zu: invalid sample\n", path, *count + 1u);
+                fclose(in);
+                return (-1);
+            }
+            if (*count == capacity)
+            {
+                capacity = (0u == capacity) ? 4096u : (capacity * 2u);
+                for (ch = 0u; ch < WAV_CH_MAX; ch++)
+                {
+                    grown = realloc(samples[ch], capacity * sizeof(int32_t));
+                    if (NULL == grown)
+                    {
+                        fclose(in);
+                        return (-1);
+                    }
+                    samples[ch] = grown;
+                }
+            }
+            samples[cols++][*count] = (int32_t)value;
+        }
+        if (0u == cols)
+        {
+            continue;
+        }
+        if ((0u != *channels) && (cols != *channels))
+        {
+            fprintf(stderr, "%s:%zu: wrong number of channels\n", path, *count + 1u);
+            fclose(in);
+            return (-1);
+        }
+        *channels = cols;
+        (*count)++;
+    }
+    fclose(in);
+
+    if (0u == *count)
+    {
+        fprintf(stderr, "%s: no samples\n", path);
+        return (-1);
+    }
+
+    return (0);
+}
+
+
+static void synthesize(int32_t ** samples, size_t count)
+{
+    uint32_t seed = 1u;
+    double t;
+    size_t i;
+
+    for (i = 0u; i < count; i++)
+    {
+        t = (double)i / 1000.0;
+        seed = (seed * 1664525u) + 1013904223u;
+        /* A sweep through all the ranges with noise, and a sink/source sine with a slow envelope */
+        samples[0][i] = (int32_t)(300000.0 * (1.0 + sin(t * 0.37)) * (0.5 + (0.5 * sin(t * 0.011)))) +
+                        (int32_t)(seed >> 28u) - 8;
+        samples[1][i] = (int32_t)(200000.0 * sin(t) * (0.5 + (0.5 * cos(t * 0.05))));
+        if (WAV_MAX_CURRENT_NA < samples[0][i])
+        {
+            samples[0][i] = WAV_MAX_CURRENT_NA;
+        }
+        if (0 > samples[0][i])
+        {
+            samples[0][i] = 0;
+        }
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    int32_t * samples[WAV_CH_MAX] = {NULL, NULL};
+    uint32_t * words[WAV_CH_MAX] = {NULL, NULL};
+    uint64_t maxErrPa = WAV_DEFAULT_ERROR_PA;
+    uint32_t threads = WAV_DEFAULT_THREADS;
+    size_t segment = WAV_DEFAULT_SEGMENT;
+    size_t bench = 0u;
+    int compressed = 0;
+    uint8_t * streams[WAV_CH_MAX] = {NULL, NULL};
+    size_t sizes[WAV_CH_MAX] = {0u, 0u};
+    size_t count = 0u;
+    uint32_t channels = 0u;
+    const char * pos[3] = {NULL, NULL, NULL};
+    int posNum = 0;
+    FILE * out = stdout;
+    double startTime;
+    double elapsed;
+    uint32_t ch;
+    size_t i;
+    int a;
+
+    for (a = 1; a < argc; a++)
+    {
+        if (0 == strcmp(argv[a], "-z"))
+        {
+            compressed = 1;
+        }
+        else if ((0 == strcmp(argv[a], "-e")) && ((a + 1) < argc))
+        {
+            maxErrPa = (uint64_t)(strtod(argv[++a], NULL) * 1000.0);
+        }
+        else if ((0 == strcmp(argv[a], "-j")) && ((a + 1) < argc))
+        {
+            threads = (uint32_t)strtoul(argv[++a], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[a], "-s")) && ((a + 1) < argc))
+        {
+            segment = (size_t)strtoul(argv[++a], NULL, 0);
+        }
+        else if ((0 == strcmp(argv[a], "-b")) && ((a + 1) < argc))
+        {
+            bench = (size_t)strtoul(argv[++a], NULL, 0);
+        }
+        else if (3 > posNum)
+        {
+            pos[posNum++] = argv[a];
+        }
+        else
+        {
+            posNum = 4;
+        }
+    }
+    if ((0u == threads) || (WAV_MAX_THREADS < threads) || (0u == segment) ||
+        ((0u == bench) && ((2 > posNum) || (3 < posNum))) || ((0u != bench) && (0 != posNum)))
+    {
+        fprintf(stderr, "Usage: %s [-z] [-e <max_error_nA>] [-j <threads>] [-s <segment>] "
+                        "<waveform.txt> <array_name> [<output.c>]\n"
+                        "       %s -b <samples> [-z] [-e <max_error_nA>] [-j <threads>] [-s <segment>]\n",
+                argv[0], argv[0]);
+        return (EXIT_FAILURE);
+    }
+
+    if (0u != bench)
+    {
+        count = bench;
+        channels = WAV_CH_MAX;
+        for (ch = 0u; ch < WAV_CH_MAX; ch++)
+        {
+            samples[ch] = malloc(count * sizeof(int32_t));
+            if (NULL == samples[ch])
+            {
+                fprintf(stderr, "out of memory\n");
+                return (EXIT_FAILURE);
+            }
+        }
+        synthesize(samples, count);
+    }
+    else if (0 != read_waveform(pos[0], samples, &channels, &count))
+    {
+        return (EXIT_FAILURE);
+    }
+
+    for (ch = 0u; ch < channels; ch++)
+    {
+        words[ch] = malloc(count * sizeof(uint32_t));
+        if (NULL == words[ch])
+        {
+            fprintf(stderr, "out of memory\n");
+            return (EXIT_FAILURE);
+        }
+    }
+
+    startTime = now_s();
+    if (0 != compile(samples, words, channels, count, maxErrPa, threads, segment))
+    {
+        fprintf(stderr, "out of memory\n");
+        return (EXIT_FAILURE);
+    }
+    elapsed = now_s() - startTime;
+
+    for (ch = 0u; ch < channels; ch++)
+    {
+        report(samples[ch], words[ch], count, ch);
+    }
+    fprintf(stderr, "%u threads, %.3f s, %.2f Msamples/s\n", (unsigned)threads, elapsed,
+            (elapsed > 0.0) ? (((double)count * channels) / elapsed / 1e6) : 0.0);
+
+    if (0 != compressed)
+    {
+        for (ch = 0u; ch < channels; ch++)
+        {
+            streams[ch] = compress(words[ch], count, ch, &sizes[ch]);
+        }
+    }
+
+    if (0u == bench)
+    {
+        if (3 == posNum)
+        {
+            out = fopen(pos[2], "w");
+            if (NULL == out)
+            {
+                fprintf(stderr, "%s: cannot open\n", pos[2]);
+                return (EXIT_FAILURE);
+            }
+        }
+        fprintf(out, "/* Generated by csdidac_wavec from %s, error bound %.3f nA */\n", pos[0], (double)maxErrPa / 1000.0);
+        for (ch = 0u; ch < channels; ch++)
+        {
+            if (0 != compressed)
+            {
+                fprintf(out, "const uint8_t %s_%c[%zu] =\n{", pos[1], (char)('a' + ch), sizes[ch]);
+                for (i = 0u; i < sizes[ch]; i++)
+                {
+                    fprintf(out, "%s0x%02Xu%s", (0u == (i % 12u)) ? "\n    " : " ", (unsigned)streams[ch][i],
+                            ((i + 1u) < sizes[ch]) ? "," : "\n");
+                }
+            }
+            else
+            {
+                fprintf(out, "const uint32_t %s_%c[%zu] =\n{", pos[1], (char)('a' + ch), count);
+                for (i = 0u; i < count; i++)
+                {
+                    fprintf(out, "%s0x%08Xu%s", (0u == (i % 6u)) ? "\n    " : " ", (unsigned)words[ch][i],
+                            ((i + 1u) < count) ? "," : "\n");
+                }
+            }
+            fprintf(out, "};\n");
+        }
+        if (stdout != out)
+        {
+            fclose(out);
+        }
+    }
+
+    for (ch = 0u; ch < WAV_CH_MAX; ch++)
+    {
+        free(samples[ch]);
+        free(words[ch]);
+        free(streams[ch]);
+    }
+
+    return (EXIT_SUCCESS);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,375 @@
+/***************************************************************************//**
+* \file csdidac_host.c
+* \version 2.10
+*
+* \brief
+* Host model of the PDL functions used by the CSDIDAC middleware, see
+* csdidac_host.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include <pthread.h>
+#include "csdidac_host.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "cy_flash.h"
+#include "cy_sysint.h"
+
+uint32_t host_csd_regs[HOST_CSD_NUM][HOST_CSD_REG_NUM] __attribute__((aligned(4096)));
+GPIO_PRT_Type host_gpio_ports[HOST_PORT_NUM];
+HSIOM_PRT_Type host_hsiom_ports[HOST_PORT_NUM];
+SysTick_Type host_systick;
+host_access_t host_access;
+cy_en_csd_key_t host_csd_lock[HOST_CSD_NUM];
+int host_csd_busy = 0;
+void (* host_sleep_hook)(void) = NULL;
+void (* host_csd_write_hook)(uint32_t block, uint32_t offset, uint32_t value) = NULL;
+void (* host_gpio_hook)(volatile uint32_t * reg) = NULL;
+
+static pthread_mutex_t csMutex;
+static pthread_once_t csOnce = PTHREAD_ONCE_INIT;
+static uint32_t csDepth;
+static uint32_t csStartAccess;
+static uintptr_t stackTop;
+static uintptr_t stackLow;
+
+
+/* Records the frame of a PDL call for host_stack_depth() */
+static __attribute__((noinline)) void stack_mark(void)
+{
+    uintptr_t frame = (uintptr_t)__builtin_frame_address(0);
+
+    if ((0u != stackTop) && (frame < stackLow))
+    {
+        stackLow = frame;
+    }
+}
+
+
+/* Returns the modelled CSD HW block of a base address */
+static uint32_t csd_block(const CSD_Type * base)
+{
+    return ((uint32_t)(((const uint32_t *)(const void *)base - &host_csd_regs[0][0]) / HOST_CSD_REG_NUM));
+}
+
+
+void host_reset(void)
+{
+    uint32_t block;
+
+    (void)memset(host_csd_regs, 0, sizeof(host_csd_regs));
+    (void)memset(host_gpio_ports, 0, sizeof(host_gpio_ports));
+    (void)memset(host_hsiom_ports, 0, sizeof(host_hsiom_ports));
+    (void)memset(&host_access, 0, sizeof(host_access));
+    for (block = 0u; block < HOST_CSD_NUM; block++)
+    {
+        host_csd_lock[block] = CY_CSD_NONE_KEY;
+    }
+    host_csd_busy = 0;
+}
+
+
+uint32_t host_access_total(void)
+{
+    return (host_access.csdRead + host_access.csdWrite + host_access.gpioRead + host_access.gpioWrite);
+}
+
+
+__attribute__((noinline)) void host_stack_start(void)
+{
+    /* The frame of this function is at the depth of a call made by the caller */
+    stackTop = (uintptr_t)__builtin_frame_address(0);
+    stackLow = stackTop;
+}
+
+
+uint32_t host_stack_depth(void)
+{
+    return ((uint32_t)(stackTop - stackLow));
+}
+
+
+volatile uint32_t * host_gpio_reg(volatile uint32_t * reg, uint32_t reads, uint32_t writes)
+{
+    stack_mark();
+    if (NULL != host_gpio_hook)
+    {
+        host_gpio_hook(reg);
+    }
+    host_access.gpioRead += reads;
+    host_access.gpioWrite += writes;
+    return (reg);
+}
+
+
+/*******************************************************************************
+* SysLib, SysPm and flash
+*******************************************************************************/
+
+static void cs_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutex_init(&csMutex, &attr);
+}
+
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    stack_mark();
+    (void)pthread_once(&csOnce, &cs_init);
+    (void)pthread_mutex_lock(&csMutex);
+    if (0u == csDepth)
+    {
+        csStartAccess = host_access_total();
+        host_access.csCount++;
+    }
+    csDepth++;
+    return (0u);
+}
+
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    uint32_t accesses;
+
+    (void)savedIntrStatus;
+    csDepth--;
+    if (0u == csDepth)
+    {
+        accesses = host_access_total() - csStartAccess;
+        if (accesses > host_access.csAccessMax)
+        {
+            host_access.csAccessMax = accesses;
+        }
+    }
+    (void)pthread_mutex_unlock(&csMutex);
+}
+
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    (void)microseconds;
+}
+
+
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    (void)milliseconds;
+}
+
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void)
+{
+    if (NULL != host_sleep_hook)
+    {
+        host_sleep_hook();
+    }
+    return (CY_SYSPM_SUCCESS);
+}
+
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void)
+{
+    return (CY_SYSPM_SUCCESS);
+}
+
+
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t * handler)
+{
+    return (NULL != handler);
+}
+
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t * data)
+{
+    (void)rowAddr;
+    (void)data;
+    return (CY_FLASH_DRV_INV_PROT);
+}
+
+
+/*******************************************************************************
+* CSD
+*******************************************************************************/
+
+void Cy_CSD_WriteReg(CSD_Type * base, uint32_t offset, uint32_t value)
+{
+    uint32_t block = csd_block(base);
+
+    stack_mark();
+    host_access.csdWrite++;
+    host_csd_regs[block][offset >> 2u] = value;
+    if (NULL != host_csd_write_hook)
+    {
+        host_csd_write_hook(block, offset, value);
+    }
+}
+
+
+uint32_t Cy_CSD_ReadReg(const CSD_Type * base, uint32_t offset)
+{
+    stack_mark();
+    host_access.csdRead++;
+    return (host_csd_regs[csd_block(base)][offset >> 2u]);
+}
+
+
+void Cy_CSD_SetBits(CSD_Type * base, uint32_t offset, uint32_t mask)
+{
+    Cy_CSD_WriteReg(base, offset, Cy_CSD_ReadReg(base, offset) | mask);
+}
+
+
+void Cy_CSD_ClrBits(CSD_Type * base, uint32_t offset, uint32_t mask)
+{
+    Cy_CSD_WriteReg(base, offset, Cy_CSD_ReadReg(base, offset) & ~mask);
+}
+
+
+void Cy_CSD_WriteBits(CSD_Type * base, uint32_t offset, uint32_t mask, uint32_t value)
+{
+    Cy_CSD_WriteReg(base, offset, (Cy_CSD_ReadReg(base, offset) & ~mask) | (value & mask));
+}
+
+
+cy_en_csd_key_t Cy_CSD_GetLockStatus(const CSD_Type * base, const cy_stc_csd_context_t * context)
+{
+    (void)context;
+    stack_mark();
+    return (host_csd_lock[csd_block(base)]);
+}
+
+
+cy_en_csd_status_t Cy_CSD_GetConversionStatus(const CSD_Type * base, const cy_stc_csd_context_t * context)
+{
+    (void)base;
+    (void)context;
+    stack_mark();
+    return ((0 != host_csd_busy) ? CY_CSD_BUSY : CY_CSD_SUCCESS);
+}
+
+
+cy_en_csd_status_t Cy_CSD_Init(CSD_Type * base, const cy_stc_csd_config_t * config,
+                               cy_en_csd_key_t key, cy_stc_csd_context_t * context)
+{
+    cy_en_csd_status_t status = CY_CSD_LOCKED;
+    uint32_t block = csd_block(base);
+
+    if (CY_CSD_NONE_KEY == host_csd_lock[block])
+    {
+        /* The registers the middleware uses, the others are not modelled */
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_CONFIG, config->config);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_INTR_MASK, config->intrMask);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_SW_BYP_SEL, config->swBypSel);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_SW_REFGEN_SEL, config->swRefgenSel);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_SEQ_START, config->seqStart);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_IDACA, config->idacA);
+        Cy_CSD_WriteReg(base, CY_CSD_REG_OFFSET_IDACB, config->idacB);
+        host_csd_lock[block] = key;
+        context->lockKey = key;
+        status = CY_CSD_SUCCESS;
+    }
+    return (status);
+}
+
+
+cy_en_csd_status_t Cy_CSD_DeInit(const CSD_Type * base, cy_en_csd_key_t key, cy_stc_csd_context_t * context)
+{
+    cy_en_csd_status_t status = CY_CSD_LOCKED;
+    uint32_t block = csd_block(base);
+
+    stack_mark();
+    if (key == host_csd_lock[block])
+    {
+        host_csd_lock[block] = CY_CSD_NONE_KEY;
+        context->lockKey = CY_CSD_NONE_KEY;
+        status = CY_CSD_SUCCESS;
+    }
+    return (status);
+}
+
+
+/*******************************************************************************
+* GPIO, the read-modify-writes of the PDL functions
+*******************************************************************************/
+
+HSIOM_PRT_Type * Cy_GPIO_PortToHSIOM(GPIO_PRT_Type * base)
+{
+    return (&host_hsiom_ports[base - host_gpio_ports]);
+}
+
+
+void Cy_GPIO_SetDrivemode(GPIO_PRT_Type * base, uint32_t pinNum, uint32_t value)
+{
+    uint32_t pcShift = pinNum * CY_GPIO_DRIVE_MODE_OFFSET;
+
+    GPIO_PRT_PC(base) = (GPIO_PRT_PC(base) & ~(CY_GPIO_PC_DM_MASK << pcShift)) |
+                        ((value & CY_GPIO_PC_DM_MASK) << pcShift);
+    GPIO_PRT_PC2(base) = (GPIO_PRT_PC2(base) & ~(CY_GPIO_PC_DM_IBUF_MASK << pinNum)) |
+                         (((value & CY_GPIO_DM_VAL_IBUF_DISABLE_MASK) >> CY_GPIO_DRIVE_MODE_OFFSET) << pinNum);
+}
+
+
+uint32_t Cy_GPIO_GetDrivemode(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    return (((GPIO_PRT_PC(base) >> (pinNum * CY_GPIO_DRIVE_MODE_OFFSET)) & CY_GPIO_PC_DM_MASK) |
+            (((GPIO_PRT_PC2(base) >> pinNum) & CY_GPIO_PC_DM_IBUF_MASK) << CY_GPIO_DRIVE_MODE_OFFSET));
+}
+
+
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type * base, uint32_t pinNum, en_hsiom_sel_t value)
+{
+    volatile uint32_t * portSel = &HSIOM_PRT_PORT_SEL(Cy_GPIO_PortToHSIOM(base));
+    uint32_t shift = pinNum << CY_GPIO_HSIOM_OFFSET;
+
+    *portSel = (*portSel & ~(CY_GPIO_HSIOM_MASK << shift)) | ((value & CY_GPIO_HSIOM_MASK) << shift);
+}
+
+
+en_hsiom_sel_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    stack_mark();
+    host_access.gpioRead++;
+    return ((Cy_GPIO_PortToHSIOM(base)->PORT_SEL >> (pinNum << CY_GPIO_HSIOM_OFFSET)) & CY_GPIO_HSIOM_MASK);
+}
+
+
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    stack_mark();
+    host_access.gpioRead++;
+    return ((base->PS >> pinNum) & CY_GPIO_PS_MASK);
+}
+
+
+/* Clears the interrupt of the pin and reads INTR back as the PDL does */
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type * base, uint32_t pinNum)
+{
+    stack_mark();
+    host_access.gpioWrite++;
+    host_access.gpioRead++;
+    base->INTR &= ~(CY_GPIO_INTR_STATUS_MASK << pinNum);
+}
+
+
+/*******************************************************************************
+* SysInt, no interrupt controller on the host: a test calls the handler
+*******************************************************************************/
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t * config, cy_israddress userIsr)
+{
+    return (((NULL == config) || (NULL == userIsr)) ? CY_SYSINT_BAD_PARAM : CY_SYSINT_SUCCESS);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/***************************************************************************//**
+* \file csdidac_host.h
+* \version 2.10
+*
+* \brief
+* Host model of the PDL functions and registers used by the CSDIDAC
+* middleware. The header files of this directory stand in for the PDL
+* headers, so the middleware sources build unchanged for the host and the
+* tests in this directory run them against a register model. With the
+* stand-ins of cy_pdl.h and cybsp.h, main.c of the code example builds for
+* the host as well.
+*
+* The model keeps the registers of HOST_CSD_NUM CSD HW blocks in
+* host_csd_regs and HOST_PORT_NUM GPIO ports with their HSIOM registers.
+* Each CSD HW block has its own registers and owner, and the block of a PDL
+* call is found from its base address. Every register access through the PDL
+* functions or the register access macros is counted. The critical sections
+* are a recursive mutex, so the tests may call the middleware from several
+* threads.
+*
+* Build a test with:
+*   cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o <test> \
+*      tools/host/<test>.c tools/host/csdidac_host.c <middleware sources> -lpthread
+*
+* The options of the middleware, for instance CY_CSDIDAC_STATS_EN, are set
+* with -D on the same command line.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CSDIDAC_HOST_H)
+#define CSDIDAC_HOST_H
+
+#include "cy_device_headers.h"
+#include "cy_csd.h"
+#include "cy_gpio.h"
+
+/* The number of the modelled GPIO ports */
+#define HOST_PORT_NUM               (4u)
+
+/* The number of the modelled CSD HW blocks */
+#define HOST_CSD_NUM                (2u)
+
+/* The number of the modelled CSD register words per block */
+#define HOST_CSD_REG_NUM            (0x400u)
+
+/* The base address of a modelled CSD HW block */
+#define HOST_CSD_BASE_N(block)      ((CSD_Type *)(void *)host_csd_regs[(block)])
+
+/* The base address of the first CSD HW block, the block of the single-block tests */
+#define HOST_CSD_BASE               (HOST_CSD_BASE_N(0u))
+
+/* Reads a register of a modelled CSD HW block without counting the access */
+#define HOST_CSD_REG_N(block, offset)   (host_csd_regs[(block)][(offset) >> 2u])
+
+/* Reads a register of the first CSD HW block without counting the access */
+#define HOST_CSD_REG(offset)        (HOST_CSD_REG_N(0u, (offset)))
+
+/* The register access counters of the model */
+typedef struct
+{
+    uint32_t csdRead;                       /* The CSD register reads */
+    uint32_t csdWrite;                      /* The CSD register writes */
+    uint32_t gpioRead;                      /* The GPIO and HSIOM register reads */
+    uint32_t gpioWrite;                     /* The GPIO and HSIOM register writes */
+    uint32_t csCount;                       /* The outermost critical sections */
+    uint32_t csAccessMax;                   /* The most register accesses in one critical section */
+} host_access_t;
+
+/* The CSD registers per block, page aligned so a test can write-protect them */
+extern uint32_t host_csd_regs[HOST_CSD_NUM][HOST_CSD_REG_NUM];
+
+/* The GPIO and HSIOM port registers */
+extern GPIO_PRT_Type host_gpio_ports[HOST_PORT_NUM];
+extern HSIOM_PRT_Type host_hsiom_ports[HOST_PORT_NUM];
+
+/* The access counters */
+extern host_access_t host_access;
+
+/* The CSD block owners returned by Cy_CSD_GetLockStatus() */
+extern cy_en_csd_key_t host_csd_lock[HOST_CSD_NUM];
+
+/* All the CSD blocks are busy for Cy_CSD_GetConversionStatus() */
+extern int host_csd_busy;
+
+/* Called by Cy_CSD_WriteReg() after the write, NULL for no call */
+extern void (* host_csd_write_hook)(uint32_t block, uint32_t offset, uint32_t value);
+
+/*
+* Called by the GPIO and HSIOM register accesses before the access, NULL for
+* no call. A store through the register access macros is made after the call,
+* so it is seen by the next call of a hook.
+*/
+extern void (* host_gpio_hook)(volatile uint32_t * reg);
+
+/* Called by Cy_SysPm_CpuEnterSleep() instead of sleeping, NULL to return at once */
+extern void (* host_sleep_hook)(void);
+
+/* Clears the registers, the counters and the CSD block owners */
+void host_reset(void);
+
+/* Returns the register accesses counted so far */
+uint32_t host_access_total(void);
+
+/* Starts the stack depth measurement at the frame of the caller */
+void host_stack_start(void);
+
+/* Returns the deepest stack use in bytes of the PDL calls since host_stack_start() */
+uint32_t host_stack_depth(void);
+
+#endif /* CSDIDAC_HOST_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,67 @@
+/***************************************************************************//**
+* \file csdidac_rcload.c
+* \version 2.10
+*
+* \brief
+* An integer-only model of an RC load driven by a CSDIDAC channel. See
+* csdidac_rcload.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "csdidac_rcload.h"
+
+
+cy_en_csdidac_status_t rcload_init(
+                cy_en_csdidac_choice_t channel,
+                uint32_t loadKohm,
+                uint32_t tauShift,
+                const cy_stc_csdidac_context_t * idacContext,
+                rcload_t * model)
+{
+    cy_en_csdidac_status_t result = CY_CSDIDAC_BAD_PARAM;
+
+    if ((NULL != idacContext) && (NULL != model) &&
+        ((CY_CSDIDAC_A == channel) || (CY_CSDIDAC_B == channel)) &&
+        (0u != loadKohm) && (RCLOAD_MAX_KOHM >= loadKohm) && (RCLOAD_MAX_TAU_SHIFT >= tauShift))
+    {
+        model->idacContext = idacContext;
+        model->channel = channel;
+        model->loadKohm = loadKohm;
+        model->tauShift = tauShift;
+        model->voltage = 0u;
+        result = CY_CSDIDAC_SUCCESS;
+    }
+
+    return (result);
+}
+
+
+cy_en_csdidac_status_t rcload_sense(void * userData, uint32_t * senseMv)
+{
+    rcload_t * model = (rcload_t *)userData;
+    cy_en_csdidac_status_t result;
+    int32_t currentPa = 0;
+    uint32_t currentNa;
+
+    result = Cy_CSDIDAC_GetOutputCurrent(model->channel, &currentPa, model->idacContext);
+    if (CY_CSDIDAC_SUCCESS == result)
+    {
+        /* The voltage across the load follows the magnitude of the current */
+        currentNa = ((0 > currentPa) ? (0u - (uint32_t)currentPa) : (uint32_t)currentPa) / 1000u;
+
+        /* nA * kOhm = uV, the step is 1 / 2^tauShift of the difference to the steady state */
+        model->voltage += (currentNa * model->loadKohm) - (model->voltage >> model->tauShift);
+        *senseMv = ((model->voltage >> model->tauShift) + 500u) / 1000u;
+    }
+
+    return (result);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,60 @@
+/***************************************************************************//**
+* \file csdidac_rcload.h
+* \version 2.10
+*
+* \brief
+* An integer-only model of an RC load driven by a CSDIDAC channel, with a
+* sense function for the CSDIDAC closed-loop current regulator. The model
+* uses only the public CSDIDAC API, so it builds for the host model and for
+* the target, where it stands in for the sense ADC to benchmark the
+* regulator on the device.
+*
+* The load is a resistor with a capacitor in parallel. Every call of
+* rcload_sense() is one regulator update: the model reads the output current
+* of the channel with Cy_CSDIDAC_GetOutputCurrent() and moves the capacitor
+* voltage towards the steady-state voltage of that current by
+* 1 / 2^tauShift, so the time constant is 2^tauShift updates. The voltage is
+* kept in uV scaled by 2^tauShift, so the model has no dead band.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CSDIDAC_RCLOAD_H)
+#define CSDIDAC_RCLOAD_H
+
+#include "cy_csdidac.h"
+
+/* The largest load resistance in kOhm and time constant shift, the scaled voltage fits 32 bits */
+#define RCLOAD_MAX_KOHM             (6u)
+#define RCLOAD_MAX_TAU_SHIFT        (9u)
+
+/* The RC load model */
+typedef struct
+{
+    const cy_stc_csdidac_context_t * idacContext;   /* The CSDIDAC context of the driving channel */
+    cy_en_csdidac_choice_t channel;                 /* The driving channel, CY_CSDIDAC_A or CY_CSDIDAC_B */
+    uint32_t loadKohm;                              /* The load resistance in kOhm */
+    uint32_t tauShift;                              /* The time constant is 2^tauShift updates */
+    uint32_t voltage;                               /* The capacitor voltage in uV scaled by 2^tauShift */
+} rcload_t;
+
+/* Initializes the model with the discharged capacitor, returns CY_CSDIDAC_BAD_PARAM on a bad parameter */
+cy_en_csdidac_status_t rcload_init(
+                cy_en_csdidac_choice_t channel,
+                uint32_t loadKohm,
+                uint32_t tauShift,
+                const cy_stc_csdidac_context_t * idacContext,
+                rcload_t * model);
+
+/* The cy_csdidac_reg_sense_t sense function, userData is the rcload_t model */
+cy_en_csdidac_status_t rcload_sense(void * userData, uint32_t * senseMv);
+
+#endif /* CSDIDAC_RCLOAD_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+* \file csdidac_test_api.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the public CSDIDAC APIs. Every API runs across the
+* representative inputs: the GPIO, AMUX and JOIN channel configurations,
+* the A, B and AB channels, both polarities, and the six LSB ranges.
+* OutputEnable and OutputEnableExt are measured from a disabled channel,
+* which is the first enable, and from an enabled one, which is a current
+* change. Their unchecked counterparts of a handle opened by
+* Cy_CSDIDAC_ChannelOpen(), ChannelSetCurrent and ChannelEnable, are
+* measured the same way next to them, and ChannelDisable next to
+* OutputDisable. The unchecked functions return no status, so their status
+* column is that of the success.
+*
+* One CSV line is printed per call with the status and the cost:
+* - instructions: the user-space instructions of the call, counted with
+*   perf_event_open(). The column is "-" if the counter is not available or
+*   the -i option is not given, so the default output does not depend on
+*   the machine.
+* - csd_reads ... gpio_writes: the register accesses of the host model.
+* - cs_count, cs_access_max: the outermost critical sections of the call and
+*   the most register accesses in one of them.
+* - stack_bytes: the deepest stack use of the PDL calls with
+*   host_stack_start() and host_stack_depth().
+*
+* csdidac_test_api.csv is the baseline, made with gcc -O2 on x86-64 without
+* the -i option. With the baseline file as the argument, the output is
+* compared to it, the differing lines are reported to stderr, and the test
+* fails on a difference, so a change of a hot path shows up as a diff.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_api \
+*            tools/host/csdidac_test_api.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_api [-i] [<baseline.csv>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+#define LINE_SIZE                   (256u)
+
+/* The code of the representative current of every LSB range */
+#define CASE_CODE                   (100u)
+
+typedef struct
+{
+    const char * name;
+    cy_en_csdidac_channel_config_t configA;
+    cy_en_csdidac_channel_config_t configB;
+} config_case_t;
+
+static const config_case_t configCases[] =
+{
+    {"GPIO/GPIO", CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO},
+    {"AMUX/AMUX", CY_CSDIDAC_AMUX, CY_CSDIDAC_AMUX},
+    {"GPIO/JOIN", CY_CSDIDAC_GPIO, CY_CSDIDAC_JOIN},
+    {"JOIN/GPIO", CY_CSDIDAC_JOIN, CY_CSDIDAC_GPIO},
+};
+
+static const char * const channelNames[] = {"A", "B", "AB"};
+static const char * const polarityNames[] = {"source", "sink"};
+
+static cy_stc_csd_context_t csdContext;
+static cy_stc_csdidac_context_t idacContext;
+static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+static int perfFd = -1;
+static FILE * baseline;
+static unsigned long lines;
+static unsigned long diffs;
+
+
+static void perf_open(void)
+{
+    struct perf_event_attr attr;
+
+    (void)memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+
+static void measure_start(void)
+{
+    (void)memset(&host_access, 0, sizeof(host_access));
+    host_stack_start();
+    if (0 <= perfFd)
+    {
+        (void)ioctl(perfFd, PERF_EVENT_IOC_RESET, 0);
+        (void)ioctl(perfFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+
+/* Prints the line of the measured call and compares it to the baseline */
+static void measure_end(const char * api, const char * config, const char * channel,
+                        const char * polarity, int lsb, cy_en_csdidac_status_t status)
+{
+    char line[LINE_SIZE];
+    char instructions[24] = "-";
+    char expected[LINE_SIZE];
+    uint64_t count;
+    int pos;
+
+    if (0 <= perfFd)
+    {
+        (void)ioctl(perfFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (sizeof(count) == read(perfFd, &count, sizeof(count)))
+        {
+            (void)snprintf(instructions, sizeof(instructions), "%llu", (unsigned long long)count);
+        }
+    }
+    pos = snprintf(line, sizeof(line), "%s,%s,%s,%s,", api, config, channel, polarity);
+    pos += snprintf(&line[pos], sizeof(line) - (size_t)pos, (0 > lsb) ? "-," : "%d,", lsb);
+    (void)snprintf(&line[pos], sizeof(line) - (size_t)pos, "0x%08X,%s,%u,%u,%u,%u,%u,%u,%u\n",
+                   (unsigned int)status, instructions, host_access.csdRead, host_access.csdWrite,
+                   host_access.gpioRead, host_access.gpioWrite, host_access.csCount,
+                   host_access.csAccessMax, host_stack_depth());
+    (void)fputs(line, stdout);
+    lines++;
+
+    if (NULL != baseline)
+    {
+        if (NULL == fgets(expected, sizeof(expected), baseline))
+        {
+            expected[0] = '\0';
+        }
+        if (0 != strcmp(expected, line))
+        {
+            fprintf(stderr, "line %lu: expected %s", lines, ('\0' != expected[0]) ? expected : "nothing\n");
+            diffs++;
+        }
+    }
+}
+
+
+static cy_stc_csdidac_config_t make_config(const config_case_t * cfg)
+{
+    cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+
+    config.configA = cfg->configA;
+    config.configB = cfg->configB;
+    return (config);
+}
+
+
+static void bench_config(const config_case_t * cfg)
+{
+    cy_stc_csdidac_config_t config = make_config(cfg);
+    cy_stc_csdidac_channel_t channel;
+    cy_en_csdidac_status_t status;
+    uint32_t ch;
+    uint32_t pol;
+    uint32_t lsb;
+    int32_t current;
+
+    host_reset();
+    measure_start();
+    status = Cy_CSDIDAC_Init(&config, &idacContext);
+    measure_end("Init", cfg->name, "-", "-", -1, status);
+
+    measure_start();
+    status = Cy_CSDIDAC_WriteConfig(&config, &idacContext);
+    measure_end("WriteConfig", cfg->name, "-", "-", -1, status);
+
+    for (ch = 0u; ch < 3u; ch++)
+    {
+        (void)Cy_CSDIDAC_ChannelOpen((cy_en_csdidac_choice_t)ch, &idacContext, &channel);
+        for (pol = 0u; pol < 2u; pol++)
+        {
+            for (lsb = 0u; lsb < 6u; lsb++)
+            {
+                current = (int32_t)((CASE_CODE * CY_CSDIDAC_LSB_PA(lsb)) / 1000u);
+                current = (0u != pol) ? -current : current;
+
+                (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+                measure_start();
+                status = Cy_CSDIDAC_OutputEnable((cy_en_csdidac_choice_t)ch, current, &idacContext);
+                measure_end("OutputEnable", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb, status);
+                measure_start();
+                status = Cy_CSDIDAC_OutputEnable((cy_en_csdidac_choice_t)ch, current, &idacContext);
+                measure_end("OutputEnable enabled", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb, status);
+
+                (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+                measure_start();
+                status = Cy_CSDIDAC_OutputEnableExt((cy_en_csdidac_choice_t)ch, (cy_en_csdidac_polarity_t)pol,
+                                                    (cy_en_csdidac_lsb_t)lsb, CASE_CODE, &idacContext);
+                measure_end("OutputEnableExt", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb, status);
+                measure_start();
+                status = Cy_CSDIDAC_OutputEnableExt((cy_en_csdidac_choice_t)ch, (cy_en_csdidac_polarity_t)pol,
+                                                    (cy_en_csdidac_lsb_t)lsb, CASE_CODE, &idacContext);
+                measure_end("OutputEnableExt enabled", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb, status);
+
+                (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+                measure_start();
+                Cy_CSDIDAC_ChannelSetCurrent(&channel, current);
+                measure_end("ChannelSetCurrent", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb,
+                            CY_CSDIDAC_SUCCESS);
+                measure_start();
+                Cy_CSDIDAC_ChannelSetCurrent(&channel, current);
+                measure_end("ChannelSetCurrent enabled", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb,
+                            CY_CSDIDAC_SUCCESS);
+
+                (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+                measure_start();
+                Cy_CSDIDAC_ChannelEnable(&channel, (cy_en_csdidac_polarity_t)pol, (cy_en_csdidac_lsb_t)lsb, CASE_CODE);
+                measure_end("ChannelEnable", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb,
+                            CY_CSDIDAC_SUCCESS);
+                measure_start();
+                Cy_CSDIDAC_ChannelEnable(&channel, (cy_en_csdidac_polarity_t)pol, (cy_en_csdidac_lsb_t)lsb, CASE_CODE);
+                measure_end("ChannelEnable enabled", cfg->name, channelNames[ch], polarityNames[pol], (int)lsb,
+                            CY_CSDIDAC_SUCCESS);
+            }
+        }
+        measure_start();
+        status = Cy_CSDIDAC_OutputDisable((cy_en_csdidac_choice_t)ch, &idacContext);
+        measure_end("OutputDisable", cfg->name, channelNames[ch], "-", -1, status);
+        (void)Cy_CSDIDAC_ChannelEnable(&channel, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_2400_IDX, CASE_CODE);
+        measure_start();
+        Cy_CSDIDAC_ChannelDisable(&channel);
+        measure_end("ChannelDisable", cfg->name, channelNames[ch], "-", -1, CY_CSDIDAC_SUCCESS);
+    }
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 1000, &idacContext);
+    measure_start();
+    status = Cy_CSDIDAC_Save(&idacContext);
+    measure_end("Save", cfg->name, "-", "-", -1, status);
+    measure_start();
+    status = Cy_CSDIDAC_Restore(&idacContext);
+    measure_end("Restore", cfg->name, "-", "-", -1, status);
+
+    (void)Cy_CSDIDAC_DeInit(&idacContext);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t i;
+    int arg = 1;
+    char header[LINE_SIZE];
+    static const char csvHeader[] = "api,config,channel,polarity,lsb,status,instructions,csd_reads,csd_writes,"
+                                    "gpio_reads,gpio_writes,cs_count,cs_access_max,stack_bytes\n";
+
+    if ((arg < argc) && (0 == strcmp(argv[arg], "-i")))
+    {
+        perf_open();
+        if (0 > perfFd)
+        {
+            perror("perf_event_open");
+        }
+        arg++;
+    }
+    if (arg < argc)
+    {
+        baseline = fopen(argv[arg], "r");
+        if ((NULL == baseline) || (NULL == fgets(header, sizeof(header), baseline)) ||
+            (0 != strcmp(header, csvHeader)))
+        {
+            fprintf(stderr, "%s: not a baseline file\n", argv[arg]);
+            return (2);
+        }
+    }
+
+    (void)fputs(csvHeader, stdout);
+    for (i = 0u; i < (sizeof(configCases) / sizeof(configCases[0])); i++)
+    {
+        bench_config(&configCases[i]);
+    }
+    if ((NULL != baseline) && (NULL != fgets(header, sizeof(header), baseline)))
+    {
+        fprintf(stderr, "the baseline has more lines\n");
+        diffs++;
+    }
+    if (NULL != baseline)
+    {
+        fprintf(stderr, "%lu calls, %lu differ from the baseline: %s\n", lines, diffs, (0u == diffs) ? "PASS" : "FAIL");
+    }
+
+    return ((0u == diffs) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
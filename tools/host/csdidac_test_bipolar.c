@@ -0,0 +1,324 @@
+/***************************************************************************//**
+* \file csdidac_test_bipolar.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC bipolar output on a joined pin. The CSD
+* registers of the model are write-protected, so each store of the
+* middleware traps: the SIGSEGV handler lets the store execute by
+* single-stepping it with the x86-64 trap flag, and the SIGTRAP handler
+* then checks the IDAC registers. An overlap is a store after which both
+* IdacA and IdacB have a non-zero code, so both the channels drive the pin
+* at once.
+*
+* Random Cy_CSDIDAC_BipolarOutput() calls and the playback of a sine and
+* a random waveform by Cy_CSDIDAC_BipolarProcess() are checked for the
+* overlaps, for the output current after each call, and for the IDAC
+* register stores of each call: one store without a sign change and two
+* with one. A store that makes an overlap on purpose checks the trap.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_bipolar \
+*            tools/host/csdidac_test_bipolar.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_bipolar.c -lpthread -lm
+* Usage:  csdidac_test_bipolar [<calls> [<seed>]]
+*
+* The test runs on x86-64 Linux only.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_bipolar.h"
+
+#define SINE_SAMPLES                (100u)
+#define RANDOM_SAMPLES              (1000u)
+
+/* The x86-64 trap flag of EFLAGS */
+#define TRAP_FLAG                   (0x100)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_bipolar_context_t bipolarContext;
+static int8_t sineTable[SINE_SAMPLES];
+static int8_t randomTable[RANDOM_SAMPLES];
+
+/* The store trap */
+static volatile int trapOn;
+static volatile unsigned long storeCnt;
+static volatile unsigned long idacStoreCnt;
+static volatile unsigned long overlapCnt;
+static volatile uint32_t overlapA;
+static volatile uint32_t overlapB;
+
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static uint32_t code_a(void)
+{
+    return (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+}
+
+
+static uint32_t code_b(void)
+{
+    return (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB) & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+}
+
+
+static void protect(int prot)
+{
+    if (0 != mprotect(host_csd_regs, sizeof(host_csd_regs), prot))
+    {
+        perror("mprotect");
+        exit(1);
+    }
+}
+
+
+/* A store to the protected registers, the store is executed with the trap flag set */
+static void segv_handler(int sig, siginfo_t * info, void * ctx)
+{
+    ucontext_t * uc = (ucontext_t *)ctx;
+    const uint8_t * addr = (const uint8_t *)info->si_addr;
+    const uint8_t * regs = (const uint8_t *)(void *)host_csd_regs;
+
+    if ((0 == trapOn) || (addr < regs) || (addr >= (regs + sizeof(host_csd_regs))))
+    {
+        (void)signal(sig, SIG_DFL);
+        return;
+    }
+    storeCnt++;
+    if ((addr == (regs + CY_CSD_REG_OFFSET_IDACA)) || (addr == (regs + CY_CSD_REG_OFFSET_IDACB)))
+    {
+        idacStoreCnt++;
+    }
+    (void)mprotect(host_csd_regs, sizeof(host_csd_regs), PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= TRAP_FLAG;
+}
+
+
+/* The store is done, checks the registers and protects them again */
+static void trap_handler(int sig, siginfo_t * info, void * ctx)
+{
+    ucontext_t * uc = (ucontext_t *)ctx;
+
+    (void)sig;
+    (void)info;
+    if ((0u != code_a()) && (0u != code_b()))
+    {
+        overlapCnt++;
+        overlapA = code_a();
+        overlapB = code_b();
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~TRAP_FLAG;
+    (void)mprotect(host_csd_regs, sizeof(host_csd_regs), PROT_READ);
+}
+
+
+static void trap_start(void)
+{
+    trapOn = 1;
+    protect(PROT_READ);
+}
+
+
+static void trap_stop(void)
+{
+    protect(PROT_READ | PROT_WRITE);
+    trapOn = 0;
+}
+
+
+/* The output current in nA with a sign, IdacA sources and IdacB sinks */
+static int32_t output_na(void)
+{
+    uint32_t wordA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    uint32_t wordB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+
+    return (((int32_t)(code_a() * CY_CSDIDAC_LSB_PA(CY_CSDIDAC_IDAC_WORD_LSB(wordA))) -
+             (int32_t)(code_b() * CY_CSDIDAC_LSB_PA(CY_CSDIDAC_IDAC_WORD_LSB(wordB)))) / 1000);
+}
+
+
+static int32_t sign(int32_t value)
+{
+    return ((0 < value) ? 1 : ((0 > value) ? -1 : 0));
+}
+
+
+/* Checks the IDAC stores of a call that changed the output from prev to next */
+static void check_stores(unsigned long stores, int32_t prev, int32_t next, unsigned long * changes)
+{
+    unsigned long expected;
+
+    if (sign(prev) == sign(next))
+    {
+        expected = (0 == next) ? 0u : 1u;
+    }
+    else
+    {
+        expected = ((0 != prev) && (0 != next)) ? 2u : 1u;
+        (*changes)++;
+    }
+    if (stores != expected)
+    {
+        printf("failed: %ld nA to %ld nA in %lu stores, %lu expected\n", (long)prev, (long)next, stores, expected);
+        failed = 1;
+    }
+}
+
+
+static void check_output(unsigned long calls)
+{
+    unsigned long changes = 0u;
+    unsigned long maxStores = 0u;
+    unsigned long stores;
+    unsigned long i;
+    int32_t current;
+    int32_t prev = output_na();
+    int32_t next;
+
+    for (i = 0u; i < calls; i++)
+    {
+        /* Small currents often, so the zero and the sign changes are frequent */
+        current = (0u != (i & 1u)) ? ((rand() % 2001) - 1000) * 100 :
+                                     (rand() % (2 * (int32_t)CY_CSDIDAC_MAX_CURRENT_NA + 1)) -
+                                     (int32_t)CY_CSDIDAC_MAX_CURRENT_NA;
+        stores = idacStoreCnt;
+        trap_start();
+        (void)Cy_CSDIDAC_BipolarOutput(current, &bipolarContext);
+        trap_stop();
+        stores = idacStoreCnt - stores;
+        next = output_na();
+        if ((sign(current) != sign(next)) && (0 != next))
+        {
+            printf("failed: %ld nA output as %ld nA\n", (long)current, (long)next);
+            failed = 1;
+        }
+        check_stores(stores, prev, next, &changes);
+        maxStores = (stores > maxStores) ? stores : maxStores;
+        prev = next;
+    }
+    printf("output:   %lu calls, %lu sign changes, at most %lu IDAC stores per call\n", calls, changes, maxStores);
+}
+
+
+static void check_play(const char * name, const int8_t * table, uint32_t count)
+{
+    unsigned long changes = 0u;
+    unsigned long stores;
+    uint32_t i;
+    int32_t prev;
+    int32_t next;
+
+    (void)Cy_CSDIDAC_BipolarOutput(0, &bipolarContext);
+    (void)Cy_CSDIDAC_BipolarPlay(table, count, false, &bipolarContext);
+    prev = 0;
+    for (i = 0u; i < count; i++)
+    {
+        stores = idacStoreCnt;
+        trap_start();
+        Cy_CSDIDAC_BipolarProcess(&bipolarContext);
+        trap_stop();
+        stores = idacStoreCnt - stores;
+        next = ((int32_t)code_a() - (int32_t)code_b());
+        if (next != (int32_t)table[i])
+        {
+            printf("failed: %s sample %u is %ld, output %ld\n", name, i, (long)table[i], (long)next);
+            failed = 1;
+        }
+        check_stores(stores, prev, next, &changes);
+        prev = next;
+    }
+    expect(CY_CSDIDAC_DISABLE == bipolarContext.state, "playback ends");
+    printf("%-9s %u samples, %lu sign changes\n", name, count, changes);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_JOIN, &pinA, NULL, 48000000u, 10u
+    };
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : 100000u;
+    struct sigaction action;
+    uint32_t i;
+
+#if defined(__x86_64__) && defined(__linux__)
+    srand((argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 0) : 1u);
+    (void)memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO;
+    action.sa_sigaction = &segv_handler;
+    (void)sigaction(SIGSEGV, &action, NULL);
+    action.sa_sigaction = &trap_handler;
+    (void)sigaction(SIGTRAP, &action, NULL);
+
+    for (i = 0u; i < SINE_SAMPLES; i++)
+    {
+        sineTable[i] = (int8_t)lrint(127.0 * sin((2.0 * M_PI * (double)i) / (double)SINE_SAMPLES));
+    }
+    for (i = 0u; i < RANDOM_SAMPLES; i++)
+    {
+        randomTable[i] = (int8_t)((rand() % 255) - 127);
+    }
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_BipolarInit(CY_CSDIDAC_LSB_2400_IDX, &idacContext, &bipolarContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    check_output(calls);
+    check_play("sine:", sineTable, SINE_SAMPLES);
+    check_play("random:", randomTable, RANDOM_SAMPLES);
+    (void)Cy_CSDIDAC_BipolarStop(&bipolarContext);
+    printf("stores:   %lu trapped, %lu IDAC, %lu overlaps\n", storeCnt, idacStoreCnt, overlapCnt);
+    expect(0u == overlapCnt, "no overlap");
+
+    /* A store of IdacB while IdacA outputs must be caught */
+    (void)Cy_CSDIDAC_BipolarOutput(240000, &bipolarContext);
+    trap_start();
+    HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB) = bipolarContext.negBase | 5u;
+    trap_stop();
+    expect((1u == overlapCnt) && (0u != overlapA) && (5u == overlapB), "overlap detected");
+#else
+    (void)calls;
+    (void)action;
+    (void)i;
+    printf("x86-64 Linux only, skipped\n");
+#endif /* defined(__x86_64__) && defined(__linux__) */
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
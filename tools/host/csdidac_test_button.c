@@ -0,0 +1,373 @@
+/***************************************************************************//**
+* \file csdidac_test_button.c
+* \version 2.10
+*
+* \brief
+* Host test of the user button input of the code example. main.c is built
+* into the test with its main() renamed, so the test runs the application's
+* User_Switch_Interrupt_Handler() and button_process() unchanged.
+*
+* Bounce traces are replayed on the modelled button pin. A trace is in the
+* form of a logic analyser capture: the times in microseconds of the level
+* changes, the first one pressing the button. The handler is called on
+* every falling edge, as the pin interrupt is configured in design.modus,
+* and button_process() on every 1 ms tick of the main loop. The test checks:
+* - one setpoint step per press, none for the glitches shorter than the
+*   debounce time, and none for the release bounce,
+* - the first step comes no earlier than the debounce time after the first
+*   edge and at most two ticks after the debounce time past the last one,
+* - a held button repeats after BUTTON_REPEAT_DELAY_MS, then every
+*   BUTTON_REPEAT_START_MS shortened by 1/2^BUTTON_REPEAT_ACCEL_SHIFT on
+*   every repeat down to BUTTON_REPEAT_MIN_MS, with no missed or extra step,
+* - the handler and the debouncer make no CSD register access, and the
+*   handler makes one GPIO register write, the interrupt clear.
+*
+* Reports the time to cross the 127 steps of the current range with a held
+* button, and the time of the handler and of a button_process() tick. The
+* instructions are counted by single-stepping a call with the x86-64 trap
+* flag, less the call and return of an empty function, and are "-" on the
+* other hosts. The time per call is measured with a loop of the calls.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_button \
+*            tools/host/csdidac_test_button.c tools/host/csdidac_host.c cy_csdidac.c \
+*            cy_csdidac_route.c cy_csdidac_led.c cy_csdidac_persist.c cy_csdidac_idle.c -lpthread
+* Usage:  csdidac_test_button [<timed calls>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <signal.h>
+#include "csdidac_host.h"
+
+/* The application under test, its main() is not called */
+#define main                        button_app_main
+#include "main.c"
+#undef main
+
+/* The steps of the current range, CURRENT_MAX_VALUE in CURRENT_INCREMENT_VALUE steps */
+#define RANGE_STEPS                 (127u)
+
+/* The most recorded steps of a trace */
+#define STEP_LOG_SIZE               (512u)
+
+/* The ticks replayed after the last edge of a trace */
+#define TRACE_TAIL_MS               (100u)
+
+/* A recorded bounce trace */
+typedef struct
+{
+    const char * name;
+    const uint32_t * edges;                 /* The times in us of the level changes */
+    uint32_t edgeNum;                       /* An even number, the trace ends released */
+    uint32_t presses;                       /* The accepted presses, 0 for a held button */
+    uint32_t pressEdges;                    /* The edges of the press of a held button */
+} bounce_trace_t;
+
+static const uint32_t traceClean[] = {0u, 150000u};
+static const uint32_t traceBounce[] =
+{
+    0u, 40u, 95u, 180u, 260u, 470u, 620u, 1100u, 2350u,
+    150000u, 150030u, 150090u, 150400u, 150480u, 151200u, 151900u,
+};
+static const uint32_t traceSlow[] =
+{
+    0u, 700u, 1500u, 2600u, 3100u, 4800u, 5200u, 7400u, 8100u,
+    90000u, 91500u, 93000u, 96000u, 99000u,
+};
+static const uint32_t traceGlitch[] = {0u, 3000u};
+static const uint32_t traceGlitches[] = {0u, 200u, 5000u, 5300u, 12000u, 12100u, 30000u, 49000u};
+static const uint32_t traceChatter[] = {0u, 80u, 200u, 120000u, 124000u, 300000u, 300050u, 300300u};
+static const uint32_t traceDouble[] =
+{
+    0u, 50u, 300u, 60000u, 60100u, 60400u,
+    120000u, 120050u, 120200u, 180000u, 180100u, 180300u,
+};
+static const uint32_t traceHold[] =
+{
+    0u, 60u, 150u, 900u, 1000u,
+    3000000u, 3000100u, 3000250u, 3001000u, 3001300u,
+};
+
+#define TRACE(name, edges, presses, pressEdges) \
+    {(name), (edges), (uint32_t)(sizeof(edges) / sizeof((edges)[0])), (presses), (pressEdges)}
+
+static const bounce_trace_t traces[] =
+{
+    TRACE("clean tap", traceClean, 1u, 0u),
+    TRACE("tap, 2.4 ms bounce", traceBounce, 1u, 0u),
+    TRACE("tap, 8.1 ms bounce", traceSlow, 1u, 0u),
+    TRACE("3 ms glitch", traceGlitch, 0u, 0u),
+    TRACE("glitch burst", traceGlitches, 0u, 0u),
+    TRACE("tap, 4 ms dropout", traceChatter, 1u, 0u),
+    TRACE("double tap", traceDouble, 2u, 0u),
+    TRACE("hold 3 s", traceHold, 0u, 5u),
+};
+
+static uint32_t stepLog[STEP_LOG_SIZE];
+static volatile unsigned long stepCnt;
+static int failed;
+
+
+/* The CSDIDAC configuration of the BSP */
+static cy_stc_csd_context_t csdContext;
+static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+const cy_stc_csdidac_config_t CYBSP_CSD_csdidac_config =
+{
+    HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+};
+
+
+cy_rslt_t cybsp_init(void)
+{
+    return (CY_RSLT_SUCCESS);
+}
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static __attribute__((noinline)) void button_tick(void)
+{
+    (void)button_process();
+}
+
+
+static __attribute__((noinline)) void empty(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+
+#if defined(__x86_64__)
+
+static void step_handler(int sig)
+{
+    (void)sig;
+    stepCnt++;
+}
+
+
+/* Counts the instructions executed by a call of func with the trap flag set */
+static unsigned long steps(void (* func)(void))
+{
+    stepCnt = 0u;
+    __asm__ volatile ("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    func();
+    __asm__ volatile ("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    return (stepCnt);
+}
+
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)snprintf(out, size, "%lu", steps(func) - steps(&empty));
+}
+
+#else
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)func;
+    (void)snprintf(out, size, "-");
+}
+
+#endif /* defined(__x86_64__) */
+
+
+static double time_calls(void (* func)(void), unsigned long calls)
+{
+    double start = now_s();
+    unsigned long i;
+
+    for (i = 0u; i < calls; i++)
+    {
+        func();
+    }
+    return (((now_s() - start) * 1e9) / (double)calls);
+}
+
+
+/* Sets the level of the button pin, pressed is low with the pull-up */
+static void button_set(bool pressed)
+{
+    if (pressed)
+    {
+        CYBSP_USER_BTN_PORT->PS &= ~(CY_GPIO_PS_MASK << CYBSP_USER_BTN_NUM);
+    }
+    else
+    {
+        CYBSP_USER_BTN_PORT->PS |= CY_GPIO_PS_MASK << CYBSP_USER_BTN_NUM;
+    }
+}
+
+
+/* Checks the repeats of a held button against the accelerated interval schedule */
+static void check_repeats(const bounce_trace_t * trace, uint32_t stepNum)
+{
+    uint32_t firstUs = trace->edges[0];
+    uint32_t settledUs = trace->edges[trace->pressEdges - 1u];
+    uint32_t releaseUs = trace->edges[trace->pressEdges];
+    uint32_t interval = BUTTON_REPEAT_DELAY_MS;
+    uint32_t wrong = 0u;
+    uint32_t i;
+
+    expect(stepNum >= RANGE_STEPS, "current range crossed by a held button");
+    expect(((stepLog[0] * 1000u) >= (firstUs + (BUTTON_DEBOUNCE_MS * 1000u))) &&
+           ((stepLog[0] * 1000u) <= (settledUs + ((BUTTON_DEBOUNCE_MS + 2u) * MAIN_LOOP_TICK_MS * 1000u))),
+           "held press accepted after the debounce time");
+    for (i = 1u; i < stepNum; i++)
+    {
+        if ((stepLog[i] - stepLog[i - 1u]) != interval)
+        {
+            wrong++;
+        }
+        if (BUTTON_REPEAT_DELAY_MS == interval)
+        {
+            interval = BUTTON_REPEAT_START_MS;
+        }
+        else
+        {
+            interval -= interval >> BUTTON_REPEAT_ACCEL_SHIFT;
+            interval = (interval < BUTTON_REPEAT_MIN_MS) ? BUTTON_REPEAT_MIN_MS : interval;
+        }
+    }
+    expect(0u == wrong, "repeat intervals accelerate from the delay to the minimum");
+    expect(BUTTON_REPEAT_MIN_MS == (stepLog[stepNum - 1u] - stepLog[stepNum - 2u]), "minimum interval reached");
+    expect(((stepLog[stepNum - 1u] + interval) * 1000u) > releaseUs, "no repeat missed before the release");
+    expect((stepLog[stepNum - 1u] * 1000u) <= releaseUs, "no repeat after the release");
+    printf("  %u steps crossed in %u ms, %u ms to the first repeat, %u ms minimum interval\n",
+           RANGE_STEPS, stepLog[RANGE_STEPS - 1u] - stepLog[0], stepLog[1] - stepLog[0],
+           (uint32_t)BUTTON_REPEAT_MIN_MS);
+}
+
+
+/* Replays a trace on the button pin and checks the steps of the debouncer */
+static void replay(const bounce_trace_t * trace)
+{
+    const uint32_t endMs = (trace->edges[trace->edgeNum - 1u] / 1000u) + TRACE_TAIL_MS;
+    host_access_t start = host_access;
+    uint32_t isrCalls = 0u;
+    uint32_t stepNum = 0u;
+    uint32_t edgeIdx = 0u;
+    uint32_t lateSteps = 0u;
+    uint32_t tick;
+    bool pressed = false;
+    char what[96];
+
+    button_set(false);
+    for (tick = 1u; tick <= endMs; tick++)
+    {
+        /* The level changes up to the tick, the handler on every falling edge */
+        while ((edgeIdx < trace->edgeNum) && (trace->edges[edgeIdx] <= (tick * 1000u)))
+        {
+            pressed = !pressed;
+            button_set(pressed);
+            if (pressed)
+            {
+                User_Switch_Interrupt_Handler();
+                isrCalls++;
+            }
+            edgeIdx++;
+        }
+        if (button_process())
+        {
+            if (stepNum < STEP_LOG_SIZE)
+            {
+                stepLog[stepNum] = tick;
+            }
+            if ((tick * 1000u) > trace->edges[trace->edgeNum - 1u])
+            {
+                lateSteps++;
+            }
+            stepNum++;
+        }
+    }
+
+    printf("%-20s %3u edges, %3u handler calls, %3u steps\n", trace->name, trace->edgeNum, isrCalls, stepNum);
+    (void)snprintf(what, sizeof(what), "%s: no step after the release", trace->name);
+    expect(0u == lateSteps, what);
+    (void)snprintf(what, sizeof(what), "%s: no CSD access, one GPIO write per handler call", trace->name);
+    expect((start.csdRead == host_access.csdRead) && (start.csdWrite == host_access.csdWrite) &&
+           ((start.gpioWrite + isrCalls) == host_access.gpioWrite), what);
+    if (0u != trace->pressEdges)
+    {
+        check_repeats(trace, (stepNum < STEP_LOG_SIZE) ? stepNum : STEP_LOG_SIZE);
+    }
+    else
+    {
+        (void)snprintf(what, sizeof(what), "%s: one step per press", trace->name);
+        expect(trace->presses == stepNum, what);
+        (void)snprintf(what, sizeof(what), "%s: press accepted after the debounce time", trace->name);
+        expect((0u == stepNum) || ((stepLog[0] * 1000u) >= (trace->edges[0] + (BUTTON_DEBOUNCE_MS * 1000u))), what);
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000u;
+    char isrCnt[24];
+    char tickCnt[24];
+    uint32_t i;
+
+#if defined(__x86_64__)
+    (void)signal(SIGTRAP, &step_handler);
+#endif /* defined(__x86_64__) */
+    host_reset();
+    if ((CY_RSLT_SUCCESS != cybsp_init()) ||
+        (CY_SYSINT_SUCCESS != Cy_SysInt_Init(&User_Switch_intr_config, &User_Switch_Interrupt_Handler)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&CYBSP_CSD_csdidac_config, &csdidac_context)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    for (i = 0u; i < (uint32_t)(sizeof(traces) / sizeof(traces[0])); i++)
+    {
+        replay(&traces[i]);
+    }
+
+    /* The handler with the button held, and an idle tick of the debouncer */
+    button_set(true);
+    count_instructions(&User_Switch_Interrupt_Handler, isrCnt, sizeof(isrCnt));
+    printf("User_Switch_Interrupt_Handler instructions %5s, %7.2f ns\n", isrCnt,
+           time_calls(&User_Switch_Interrupt_Handler, calls));
+    button_set(false);
+    for (i = 0u; i < (2u * BUTTON_DEBOUNCE_MS); i++)
+    {
+        (void)button_process();
+    }
+    count_instructions(&button_tick, tickCnt, sizeof(tickCnt));
+    printf("button_process tick           instructions %5s, %7.2f ns\n", tickCnt, time_calls(&button_tick, calls));
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
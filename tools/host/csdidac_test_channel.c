@@ -0,0 +1,244 @@
+/***************************************************************************//**
+* \file csdidac_test_channel.c
+* \version 2.10
+*
+* \brief
+* Host measurement of the CSDIDAC channel handle APIs against the checked
+* APIs with the same effect: Cy_CSDIDAC_ChannelSetCurrent() against
+* Cy_CSDIDAC_OutputEnable(), Cy_CSDIDAC_ChannelEnable() against
+* Cy_CSDIDAC_OutputEnableExt(), and Cy_CSDIDAC_ChannelDisable() against
+* Cy_CSDIDAC_OutputDisable(). Each pair must leave the same IDAC register
+* words and the same routing of both the channels.
+*
+* The instructions of a call are counted by single-stepping it with the
+* x86-64 trap flag, less the call and return of an empty function. The
+* column is "-" on the other hosts. The time per call is measured with a
+* loop of the calls, so an enable is a current change of an enabled
+* channel as in a control loop, and a disable is that of a disabled one.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_channel \
+*            tools/host/csdidac_test_channel.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_channel [<timed calls>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+/* The current of the measured calls, code 50 of the 2.4 uA range */
+#define CASE_CURRENT                (120000)
+#define CASE_CODE                   (50u)
+
+typedef struct
+{
+    GPIO_PRT_Type gpio[HOST_PORT_NUM];
+    HSIOM_PRT_Type hsiom[HOST_PORT_NUM];
+    uint32_t idacA;
+    uint32_t idacB;
+} output_state_t;
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_channel_t channel;
+static volatile unsigned long stepCnt;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static __attribute__((noinline)) void output_enable(void)
+{
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, CASE_CURRENT, &idacContext);
+}
+
+
+static __attribute__((noinline)) void channel_set_current(void)
+{
+    Cy_CSDIDAC_ChannelSetCurrent(&channel, CASE_CURRENT);
+}
+
+
+static __attribute__((noinline)) void output_enable_ext(void)
+{
+    (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_2400_IDX, CASE_CODE,
+                                     &idacContext);
+}
+
+
+static __attribute__((noinline)) void channel_enable(void)
+{
+    Cy_CSDIDAC_ChannelEnable(&channel, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_2400_IDX, CASE_CODE);
+}
+
+
+static __attribute__((noinline)) void output_disable(void)
+{
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_A, &idacContext);
+}
+
+
+static __attribute__((noinline)) void channel_disable(void)
+{
+    Cy_CSDIDAC_ChannelDisable(&channel);
+}
+
+
+static __attribute__((noinline)) void empty(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+
+#if defined(__x86_64__)
+
+static void step_handler(int sig)
+{
+    (void)sig;
+    stepCnt++;
+}
+
+
+/* Counts the instructions executed by a call of func with the trap flag set */
+static unsigned long steps(void (* func)(void))
+{
+    stepCnt = 0u;
+    __asm__ volatile ("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    func();
+    __asm__ volatile ("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    return (stepCnt);
+}
+
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)snprintf(out, size, "%lu", steps(func) - steps(&empty));
+}
+
+#else
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)func;
+    (void)snprintf(out, size, "-");
+}
+
+#endif /* defined(__x86_64__) */
+
+
+static void state_save(output_state_t * state)
+{
+    (void)memcpy(state->gpio, host_gpio_ports, sizeof(state->gpio));
+    (void)memcpy(state->hsiom, host_hsiom_ports, sizeof(state->hsiom));
+    state->idacA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    state->idacB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+}
+
+
+static double time_calls(void (* func)(void), unsigned long calls)
+{
+    double start = now_s();
+    unsigned long i;
+
+    for (i = 0u; i < calls; i++)
+    {
+        func();
+    }
+    return (((now_s() - start) * 1e9) / (double)calls);
+}
+
+
+/* Runs the checked call and the handle call from the same state and compares the result */
+static void check_pair(const char * checkedName, void (* checked)(void), const char * handleName,
+                       void (* handle)(void), int enabled, unsigned long calls)
+{
+    output_state_t checkedState;
+    output_state_t handleState;
+    char checkedCnt[24];
+    char handleCnt[24];
+    char what[64];
+
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    if (0 != enabled)
+    {
+        output_enable();
+    }
+    checked();
+    state_save(&checkedState);
+
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    if (0 != enabled)
+    {
+        output_enable();
+    }
+    handle();
+    state_save(&handleState);
+    (void)snprintf(what, sizeof(what), "%s same as %s", handleName, checkedName);
+    expect(0 == memcmp(&checkedState, &handleState, sizeof(checkedState)), what);
+
+    count_instructions(checked, checkedCnt, sizeof(checkedCnt));
+    count_instructions(handle, handleCnt, sizeof(handleCnt));
+    printf("%-18s instructions %5s, %7.2f ns\n", checkedName, checkedCnt, time_calls(checked, calls));
+    printf("%-18s instructions %5s, %7.2f ns\n", handleName, handleCnt, time_calls(handle, calls));
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000u;
+
+#if defined(__x86_64__)
+    (void)signal(SIGTRAP, &step_handler);
+#endif /* defined(__x86_64__) */
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_ChannelOpen(CY_CSDIDAC_A, &idacContext, &channel)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    check_pair("OutputEnable", &output_enable, "ChannelSetCurrent", &channel_set_current, 1, calls);
+    check_pair("OutputEnableExt", &output_enable_ext, "ChannelEnable", &channel_enable, 1, calls);
+    check_pair("OutputDisable", &output_disable, "ChannelDisable", &channel_disable, 1, calls);
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
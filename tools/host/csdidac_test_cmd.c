@@ -0,0 +1,274 @@
+/***************************************************************************//**
+* \file csdidac_test_cmd.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC binary setpoint command interface. Runs
+* tools/csdidac_cmdsend on a pty and feeds every byte the sender writes to
+* Cy_CSDIDAC_CmdReceive(), as the UART receive interrupt does, and then
+* calls Cy_CSDIDAC_CmdProcess(). The responses go back through the pty.
+*
+* Each setpoint is checked against the sender ramp before it is applied, so
+* a lost, repeated, or reordered setpoint fails the test. With an error rate,
+* single bits of the received bytes are flipped to exercise the CRC NAK and
+* the go-back-N retransmission of the sender.
+*
+* Before the sender runs, the frames with a current outside
+* +/-CY_CSDIDAC_MAX_CURRENT_NA and a valid CRC, including 0x80000000, must
+* be rejected by Cy_CSDIDAC_CmdProcess() and keep the output.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_cmd \
+*            tools/host/csdidac_test_cmd.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_cmd.c -lpthread -lutil
+* Usage:  csdidac_test_cmd <csdidac_cmdsend> [<count> [<bit errors per million bytes>]]
+*
+* Reports the sustained setpoint rate of the parser and the sender.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <sys/wait.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_cmd.h"
+
+/* The ramp of csdidac_cmdsend */
+#define RAMP_START_NA               (0L)
+#define RAMP_STEP_NA                (4800L)
+
+static int masterFd;
+static unsigned long txErrors;
+
+
+static void tx_response(const uint8_t * data, uint32_t size)
+{
+    if ((ssize_t)size != write(masterFd, data, size))
+    {
+        txErrors++;
+    }
+}
+
+
+/* CRC-16/CCITT-FALSE of the frame bytes after the start */
+static uint16_t crc16(const uint8_t * data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFu;
+    uint32_t i;
+    uint32_t bit;
+
+    for (i = 0u; i < size; i++)
+    {
+        crc ^= ((uint32_t)data[i] << 8u);
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (0u != (crc & 0x8000u)) ? ((crc << 1u) ^ 0x1021u) : (crc << 1u);
+        }
+        crc &= 0xFFFFu;
+    }
+    return ((uint16_t)crc);
+}
+
+
+/* Feeds the sync frames of out-of-range currents, returns the rejected frames */
+static uint32_t check_range(cy_stc_csdidac_context_t * idacContext, cy_stc_csdidac_cmd_context_t * cmdContext)
+{
+    static const uint32_t values[] =
+    {
+        0x80000000uL, 0x7FFFFFFFuL, (uint32_t)CY_CSDIDAC_MAX_CURRENT_NA + 1u,
+        0u - ((uint32_t)CY_CSDIDAC_MAX_CURRENT_NA + 1u)
+    };
+    uint8_t frame[9];
+    uint32_t rejected = cmdContext->applyErrCnt;
+    uint32_t word = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    uint32_t i;
+    uint32_t j;
+    uint16_t crc;
+
+    /* No responses before the pty is open */
+    (void)Cy_CSDIDAC_CmdInit(NULL, idacContext, cmdContext);
+    for (i = 0u; i < (sizeof(values) / sizeof(values[0])); i++)
+    {
+        frame[0] = CY_CSDIDAC_CMD_SOF;
+        frame[1] = (uint8_t)(CY_CSDIDAC_CMD_FLAG_SYNC | (uint8_t)CY_CSDIDAC_A);
+        frame[2] = 0u;
+        for (j = 0u; j < 4u; j++)
+        {
+            frame[3u + j] = (uint8_t)(values[i] >> (8u * j));
+        }
+        crc = crc16(&frame[1], 6u);
+        frame[7] = (uint8_t)crc;
+        frame[8] = (uint8_t)(crc >> 8u);
+        for (j = 0u; j < sizeof(frame); j++)
+        {
+            Cy_CSDIDAC_CmdReceive(frame[j], cmdContext);
+        }
+        (void)Cy_CSDIDAC_CmdProcess(0u, cmdContext);
+    }
+    rejected = cmdContext->applyErrCnt - rejected;
+    printf("out of range:        %lu of %lu rejected\n", (unsigned long)rejected,
+           (unsigned long)(sizeof(values) / sizeof(values[0])));
+    if ((word != HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)) || (CY_CSDIDAC_DISABLE != idacContext->channelStateA))
+    {
+        rejected = 0u;
+    }
+    (void)Cy_CSDIDAC_CmdInit(&tx_response, idacContext, cmdContext);
+    return ((uint32_t)(sizeof(values) / sizeof(values[0])) == rejected);
+}
+
+
+static long ramp_next(long current)
+{
+    current += RAMP_STEP_NA;
+    if ((long)CY_CSDIDAC_MAX_CURRENT_NA < current)
+    {
+        current = -(long)CY_CSDIDAC_MAX_CURRENT_NA;
+    }
+    return (current);
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static cy_stc_csdidac_context_t idacContext;
+    static cy_stc_csdidac_cmd_context_t cmdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    const char * count = (argc > 2) ? argv[2] : "100000";
+    unsigned long errorPpm = (argc > 3) ? strtoul(argv[3], NULL, 0) : 0u;
+    unsigned long applied = 0u;
+    unsigned long mismatches = 0u;
+    unsigned long flipped = 0u;
+    long expected = RAMP_START_NA;
+    char slaveName[64];
+    char step[16];
+    char start[16];
+    struct termios tio;
+    struct pollfd pfd;
+    int slaveFd;
+    int status;
+    pid_t sender;
+    uint8_t rxByte;
+    double startTime;
+    double elapsed;
+    const cy_stc_csdidac_cmd_setpoint_t * setpoint;
+    uint32_t rangeOk;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <csdidac_cmdsend> [<count> [<bit errors per million bytes>]]\n", argv[0]);
+        return (2);
+    }
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_CmdInit(&tx_response, &idacContext, &cmdContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    rangeOk = check_range(&idacContext, &cmdContext);
+
+    (void)memset(&tio, 0, sizeof(tio));
+    cfmakeraw(&tio);
+    if (0 != openpty(&masterFd, &slaveFd, slaveName, &tio, NULL))
+    {
+        fprintf(stderr, "openpty failed\n");
+        return (1);
+    }
+
+    (void)snprintf(start, sizeof(start), "%ld", RAMP_START_NA);
+    (void)snprintf(step, sizeof(step), "%ld", RAMP_STEP_NA);
+    startTime = now_s();
+    sender = fork();
+    if (0 == sender)
+    {
+        (void)close(masterFd);
+        (void)execl(argv[1], argv[1], slaveName, "ab", count, start, step, (char *)NULL);
+        _exit(127);
+    }
+    (void)close(slaveFd);
+
+    srand(1u);
+    pfd.fd = masterFd;
+    pfd.events = POLLIN;
+    for (;;)
+    {
+        if (0 == poll(&pfd, 1u, 100))
+        {
+            if (sender == waitpid(sender, &status, WNOHANG))
+            {
+                break;
+            }
+            continue;
+        }
+        if (1 != read(masterFd, &rxByte, 1u))
+        {
+            /* The sender closed the pty */
+            (void)waitpid(sender, &status, 0);
+            break;
+        }
+        if ((0u != errorPpm) && ((unsigned long)(rand() % 1000000) < errorPpm))
+        {
+            rxByte ^= (uint8_t)(1u << (rand() % 8));
+            flipped++;
+        }
+
+        /* The receive interrupt and the main loop */
+        Cy_CSDIDAC_CmdReceive(rxByte, &cmdContext);
+        while (cmdContext.tail != cmdContext.head)
+        {
+            setpoint = &cmdContext.queue[cmdContext.tail & (CY_CSDIDAC_CMD_QUEUE_SIZE - 1u)];
+            if ((int32_t)setpoint->value != (int32_t)expected)
+            {
+                mismatches++;
+            }
+            expected = ramp_next(expected);
+            applied++;
+            (void)Cy_CSDIDAC_CmdProcess(0u, &cmdContext);
+        }
+    }
+    elapsed = now_s() - startTime;
+
+    printf("applied setpoints:   %lu\n", applied);
+    printf("out of order:        %lu\n", mismatches);
+    printf("flipped bits:        %lu\n", flipped);
+    printf("CRC NAKs:            %lu\n", (unsigned long)cmdContext.crcErrCnt);
+    printf("sequence NAKs:       %lu\n", (unsigned long)cmdContext.seqErrCnt);
+    printf("busy:                %lu\n", (unsigned long)cmdContext.busyCnt);
+    printf("rate:                %.1f setpoints/s\n", (elapsed > 0.0) ? ((double)applied / elapsed) : 0.0);
+
+    status = (WIFEXITED(status) && (0 == WEXITSTATUS(status)) && (0u == mismatches) && (0u == txErrors) &&
+              (0u != rangeOk) && (strtoul(count, NULL, 0) == applied)) ? 0 : 1;
+    printf("%s\n", (0 == status) ? "PASS" : "FAIL");
+
+    return (status);
+}
+
+
+/* [] END OF FILE */
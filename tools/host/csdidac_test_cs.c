@@ -0,0 +1,349 @@
+/***************************************************************************//**
+* \file csdidac_test_cs.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC critical section statistics, built with
+* CY_CSDIDAC_CS_STATS_EN. Cy_CSDIDAC_GetProfileTime() is replaced by the
+* register access count of the model, so the duration of a critical section
+* is the number of the register accesses made in it and the statistics are
+* the same on every host.
+*
+* The worst-case sequences are run from cleared statistics:
+* - JOIN: Cy_CSDIDAC_OutputEnable() of both the joined channels across the
+*   current range with the sign changes,
+* - AB: Cy_CSDIDAC_OutputEnable() of both the channels on pins of two ports,
+* - Reconfigure: Cy_CSDIDAC_ReconfigureChannel() of an enabled channel
+*   between the pins of two ports and the AMUX bus,
+* - Mgr: Cy_CSDIDAC_MgrUpdateGroup() of both the channels, which nests the
+*   output enables and the routing in its critical section,
+* - SeqSync: the SYNC instructions of Cy_CSDIDAC_SeqProcess(), which nest
+*   two output enables.
+* Each call makes one outermost critical section of the function, and its
+* duration is the most register accesses in one critical section counted by
+* the model. The call and profiling records of CY_CSDIDAC_STATS_EN and
+* CY_CSDIDAC_PROFILE_EN take their own critical sections without register
+* accesses, so the test also runs with these options. The
+* count, maximum, total and histogram of Cy_CSDIDAC_GetCsStats() for the
+* function of the outermost critical section must be those of these
+* durations. For the other functions of the sequence, nested or not, the
+* histogram must add up to the count, the maximum must be in the last used
+* bin, and no section may be longer than the outermost one. The mean, the maximum, and the
+* histogram are reported in register accesses.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -DCY_CSDIDAC_CS_STATS_EN=1u -Itools/host -I. \
+*            -o csdidac_test_cs tools/host/csdidac_test_cs.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_mgr.c cy_csdidac_seq.c -lpthread
+* Usage:  csdidac_test_cs [<calls>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_mgr.h"
+#include "cy_csdidac_seq.h"
+
+/* The little-endian bytes of a current operand of the sequencer */
+#define SEQ_I32(value)              (uint8_t)((uint32_t)(value) & 0xFFu), (uint8_t)(((uint32_t)(value) >> 8u) & 0xFFu), \
+                                    (uint8_t)(((uint32_t)(value) >> 16u) & 0xFFu), (uint8_t)((uint32_t)(value) >> 24u)
+
+/* The currents of the sequences, the sign changes and the LSB range changes */
+#define CURRENT_NUM                 (8u)
+
+static const int32_t currents[CURRENT_NUM] =
+{
+    (int32_t)CY_CSDIDAC_MAX_CURRENT_NA, -37, 4800, -(int32_t)CY_CSDIDAC_MAX_CURRENT_NA, 0, 600, -120000, 2400
+};
+
+static const char * const apiNames[CY_CSDIDAC_API_NUM] =
+{
+    "Init", "DeInit", "WriteConfig", "Save", "Restore", "OutputEnable", "OutputEnableExt", "OutputDisable",
+    "Reconfigure", "SyncIdacWord", "Charge", "Route", "Mgr", "Seq", "Dither", "Health", "Idle", "Pulse",
+    "Scan", "Trig", "Bipolar"
+};
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_cs_stats_t expected;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+/* The register accesses of the model as the time base */
+uint32_t Cy_CSDIDAC_GetProfileTime(void)
+{
+    return (host_access_total() & CY_CSDIDAC_PROFILE_TIME_MASK);
+}
+
+
+static void start_call(void)
+{
+    (void)memset(&host_access, 0, sizeof(host_access));
+}
+
+
+/* Adds the outermost critical section of a call to the expected statistics */
+static void end_call(void)
+{
+    uint32_t bin = host_access.csAccessMax >> CY_CSDIDAC_CS_HIST_SHIFT;
+
+    if (0u != host_access.csCount)
+    {
+        bin = (bin < CY_CSDIDAC_CS_HIST_BINS) ? bin : (CY_CSDIDAC_CS_HIST_BINS - 1u);
+        expected.hist[bin]++;
+        expected.maxTime = (host_access.csAccessMax > expected.maxTime) ? host_access.csAccessMax : expected.maxTime;
+        expected.totalTime += host_access.csAccessMax;
+        expected.count++;
+    }
+}
+
+
+static void begin_sequence(void)
+{
+    (void)memset(&expected, 0, sizeof(expected));
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_ResetCsStats(&idacContext), "reset");
+}
+
+
+/* Checks the statistics of a histogram: the sum and the bin of the maximum */
+static int hist_valid(const cy_stc_csdidac_cs_stats_t * stats)
+{
+    uint32_t sum = 0u;
+    uint32_t last = 0u;
+    uint32_t maxBin = stats->maxTime >> CY_CSDIDAC_CS_HIST_SHIFT;
+    uint32_t bin;
+
+    for (bin = 0u; bin < CY_CSDIDAC_CS_HIST_BINS; bin++)
+    {
+        sum += stats->hist[bin];
+        last = (0u != stats->hist[bin]) ? bin : last;
+    }
+    maxBin = (maxBin < CY_CSDIDAC_CS_HIST_BINS) ? maxBin : (CY_CSDIDAC_CS_HIST_BINS - 1u);
+    return ((sum == stats->count) && ((0u == stats->count) || (last == maxBin)) &&
+            ((uint64_t)stats->totalTime <= ((uint64_t)stats->count * stats->maxTime)));
+}
+
+
+static void print_stats(const char * name, const cy_stc_csdidac_cs_stats_t * stats)
+{
+    uint32_t bin;
+
+    printf("  %-16s %6lu sections, mean %6.2f, max %3lu, hist", name, (unsigned long)stats->count,
+           (0u != stats->count) ? ((double)stats->totalTime / (double)stats->count) : 0.0,
+           (unsigned long)stats->maxTime);
+    for (bin = 0u; bin < CY_CSDIDAC_CS_HIST_BINS; bin++)
+    {
+        printf(" %u", stats->hist[bin]);
+    }
+    printf("\n");
+}
+
+
+/* Compares the statistics of the outermost function and checks the other ones */
+static void end_sequence(const char * name, cy_en_csdidac_api_t outer)
+{
+    cy_stc_csdidac_cs_stats_t stats;
+    cy_stc_csdidac_cs_stats_t outerStats;
+    char what[96];
+    uint32_t api;
+
+    printf("%s:\n", name);
+    (void)Cy_CSDIDAC_GetCsStats(outer, &outerStats, &idacContext);
+    print_stats(apiNames[outer], &outerStats);
+    (void)snprintf(what, sizeof(what), "%s %s statistics", name, apiNames[outer]);
+    expect((0u != expected.count) && (0 == memcmp(&expected, &outerStats, sizeof(expected))), what);
+
+    for (api = 0u; api < (uint32_t)CY_CSDIDAC_API_NUM; api++)
+    {
+        (void)Cy_CSDIDAC_GetCsStats((cy_en_csdidac_api_t)api, &stats, &idacContext);
+        if ((api != (uint32_t)outer) && (0u != stats.count))
+        {
+            print_stats(apiNames[api], &stats);
+            (void)snprintf(what, sizeof(what), "%s %s statistics", name, apiNames[api]);
+            expect((0 != hist_valid(&stats)) && (stats.maxTime <= outerStats.maxTime), what);
+        }
+    }
+}
+
+
+static void run_join(uint32_t calls)
+{
+    uint32_t i;
+
+    begin_sequence();
+    for (i = 0u; i < calls; i++)
+    {
+        start_call();
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_AB, currents[i % CURRENT_NUM], &idacContext);
+        end_call();
+    }
+    end_sequence("JOIN", CY_CSDIDAC_API_OUTPUT_ENABLE);
+}
+
+
+static void run_ab(uint32_t calls)
+{
+    uint32_t i;
+
+    begin_sequence();
+    for (i = 0u; i < calls; i++)
+    {
+        start_call();
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_AB, currents[i % CURRENT_NUM], &idacContext);
+        end_call();
+        if (0u == (i % 3u))
+        {
+            /* The next enable connects the pins again */
+            (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+        }
+    }
+    end_sequence("AB", CY_CSDIDAC_API_OUTPUT_ENABLE);
+}
+
+
+static void run_reconfigure(uint32_t calls)
+{
+    static const cy_stc_csdidac_pin_t movePins[2] = {{&host_gpio_ports[2], 3u}, {&host_gpio_ports[0], 1u}};
+    uint32_t i;
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_AB, 4800, &idacContext);
+    begin_sequence();
+    for (i = 0u; i < calls; i++)
+    {
+        start_call();
+        if (3u == (i % 4u))
+        {
+            (void)Cy_CSDIDAC_ReconfigureChannel(CY_CSDIDAC_A, CY_CSDIDAC_AMUX, NULL, &idacContext);
+        }
+        else
+        {
+            (void)Cy_CSDIDAC_ReconfigureChannel(CY_CSDIDAC_A, CY_CSDIDAC_GPIO, &movePins[i & 1u], &idacContext);
+        }
+        end_call();
+    }
+    end_sequence("Reconfigure", CY_CSDIDAC_API_RECONFIGURE);
+    (void)Cy_CSDIDAC_ReconfigureChannel(CY_CSDIDAC_A, CY_CSDIDAC_GPIO, &movePins[1], &idacContext);
+}
+
+
+static void run_mgr(uint32_t calls)
+{
+    cy_stc_csdidac_context_t * const contexts[1] = {&idacContext};
+    cy_stc_csdidac_mgr_context_t mgrContext;
+    cy_stc_csdidac_mgr_update_t group[3];
+    uint32_t i;
+
+    (void)Cy_CSDIDAC_MgrInit(contexts, 1u, &mgrContext);
+    begin_sequence();
+    for (i = 0u; i < calls; i++)
+    {
+        /* The equal currents of the AB path, different ones, and a coalesced disable */
+        group[0].channel = 0u;
+        group[0].state = CY_CSDIDAC_ENABLE;
+        group[0].current = currents[i % CURRENT_NUM];
+        group[1].channel = 1u;
+        group[1].state = CY_CSDIDAC_ENABLE;
+        group[1].current = (0u == (i & 1u)) ? group[0].current : currents[(i + 3u) % CURRENT_NUM];
+        group[2].channel = 1u;
+        group[2].state = (0u == (i % 5u)) ? CY_CSDIDAC_DISABLE : CY_CSDIDAC_ENABLE;
+        group[2].current = group[1].current;
+        start_call();
+        (void)Cy_CSDIDAC_MgrUpdateGroup(group, 3u, &mgrContext);
+        end_call();
+    }
+    end_sequence("Mgr", CY_CSDIDAC_API_MGR);
+}
+
+
+static void run_seq_sync(uint32_t calls)
+{
+    /* LOOP 0 { SYNC MAX, -37; WAIT 1; SYNC -MAX, 120000; WAIT 1 } */
+    static const uint8_t program[] =
+    {
+        CY_CSDIDAC_SEQ_OP_LOOP, 0x00u, 0x00u,
+        CY_CSDIDAC_SEQ_OP_SYNC, SEQ_I32(CY_CSDIDAC_MAX_CURRENT_NA), SEQ_I32(-37),
+        CY_CSDIDAC_SEQ_OP_WAIT, 0x01u, 0x00u,
+        CY_CSDIDAC_SEQ_OP_SYNC, SEQ_I32(-(int32_t)CY_CSDIDAC_MAX_CURRENT_NA), SEQ_I32(120000),
+        CY_CSDIDAC_SEQ_OP_WAIT, 0x01u, 0x00u,
+        CY_CSDIDAC_SEQ_OP_ENDLOOP,
+        CY_CSDIDAC_SEQ_OP_END,
+    };
+    cy_stc_csdidac_seq_context_t seqContext;
+    uint32_t i;
+
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    expect((CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_SeqInit(program, sizeof(program), &idacContext, &seqContext)) &&
+           (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_SeqStart(&seqContext)), "sequence start");
+    begin_sequence();
+    for (i = 0u; i < calls; i++)
+    {
+        start_call();
+        (void)Cy_CSDIDAC_SeqProcess(&seqContext);
+        end_call();
+    }
+    expect(CY_CSDIDAC_SEQ_RUNNING == seqContext.state, "sequence running");
+    end_sequence("SeqSync", CY_CSDIDAC_API_SEQ);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[1], 2u};
+    const cy_stc_csdidac_config_t joinConfig =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_JOIN, &pinA, NULL, 48000000u, 10u
+    };
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    uint32_t calls = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000u;
+    cy_stc_csdidac_cs_stats_t stats;
+
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&joinConfig, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    expect((CY_CSDIDAC_BAD_PARAM == Cy_CSDIDAC_GetCsStats(CY_CSDIDAC_API_NUM, &stats, &idacContext)) &&
+           (CY_CSDIDAC_BAD_PARAM == Cy_CSDIDAC_GetCsStats(CY_CSDIDAC_API_INIT, NULL, &idacContext)) &&
+           (CY_CSDIDAC_BAD_PARAM == Cy_CSDIDAC_ResetCsStats(NULL)), "invalid parameters");
+
+    run_join(calls);
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_WriteConfig(&config, &idacContext), "write configuration");
+    run_ab(calls);
+    run_reconfigure(calls);
+    run_mgr(calls);
+    run_seq_sync(calls);
+
+    (void)Cy_CSDIDAC_ResetCsStats(&idacContext);
+    (void)Cy_CSDIDAC_GetCsStats(CY_CSDIDAC_API_SEQ, &stats, &idacContext);
+    expect((0u == stats.count) && (0u == stats.maxTime) && (0u == stats.totalTime) && (0 != hist_valid(&stats)),
+           "statistics cleared");
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
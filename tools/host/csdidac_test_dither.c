@@ -0,0 +1,329 @@
+/***************************************************************************//**
+* \file csdidac_test_dither.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the CSDIDAC sigma-delta dithered output: the tick cost
+* of Cy_CSDIDAC_DitherProcess() and the accuracy of the average current.
+*
+* The tick cost is measured for the tick without and with the carry to the
+* next code, against Cy_CSDIDAC_OutputEnableExt() writing the same code, the
+* checked path a tick would take without the fast path. The instructions
+* are counted by single-stepping a call with the x86-64 trap flag, less the
+* call and return of an empty function, and are "-" on the other hosts.
+* The time per call is measured with a loop of the calls.
+*
+* The accuracy is measured for 1 to CY_CSDIDAC_DITHER_MAX_BITS extra bits
+* and a set of currents: the edges of the ranges, both the polarities and
+* pseudo-random currents over all the ranges. The accumulator is kept from
+* one current to the next one, as in an application. The IDAC register word
+* is decoded after every tick, and the test checks:
+* - only the integer code and the next one are written,
+* - the mean of any 2^extraBits ticks is the requested current within the
+*   rounding of the code to 2^-(extraBits + 1) LSB,
+* - the output of an ideal filter model, a one-pole low-pass filter with
+*   the time constant of 2^extraBits ticks, is within 2.5 * 2^-extraBits LSB
+*   of the requested current after two time constants: the window sums of
+*   the carry error of a first-order modulator are within one code, which
+*   gives 2 * 2^-extraBits LSB with the filter start, plus the rounding.
+* The errors are reported in LSB of the range, with the error of the
+* nearest code without dithering for comparison.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_dither \
+*            tools/host/csdidac_test_dither.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_dither.c -lpthread
+* Usage:  csdidac_test_dither [<timed calls>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <signal.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_dither.h"
+
+/* The pseudo-random currents of a bit number */
+#define RANDOM_CURRENT_NUM          (64u)
+
+/* The full-scale current in pA */
+#define MAX_CURRENT_PA              ((int32_t)(CY_CSDIDAC_MAX_CURRENT_NA * 1000u))
+
+/* The current of the timed ticks, 1.3 codes of the 37.5 nA range */
+#define TICK_CURRENT_PA             (48750)
+
+/* The edges of the ranges and the polarities */
+static const int32_t edgeCurrents[] =
+{
+    0, 1, 18750, 37500, 4762500, 4762501, 9525000, 9525001, 609599999, MAX_CURRENT_PA,
+    -1, -18750, -4762501, -MAX_CURRENT_PA,
+};
+
+static const uint32_t bitList[] = {1u, 4u, 8u, 12u, CY_CSDIDAC_DITHER_MAX_BITS};
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_dither_context_t ditherContext;
+static volatile unsigned long stepCnt;
+static uint32_t randomState = 0x2545F491u;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static uint32_t random_next(void)
+{
+    randomState ^= randomState << 13u;
+    randomState ^= randomState >> 17u;
+    randomState ^= randomState << 5u;
+    return (randomState);
+}
+
+
+/* Returns the current in pA of an IDAC register word */
+static int64_t word_pa(uint32_t word)
+{
+    int64_t current = (int64_t)(word & CY_CSDIDAC_IDAC_WORD_CODE_MASK) *
+                      (int64_t)CY_CSDIDAC_LSB_PA(CY_CSDIDAC_IDAC_WORD_LSB(word));
+
+    return ((CY_CSDIDAC_SINK == CY_CSDIDAC_IDAC_WORD_POLARITY(word)) ? -current : current);
+}
+
+
+static __attribute__((noinline)) void dither_tick(void)
+{
+    Cy_CSDIDAC_DitherProcess(&ditherContext);
+}
+
+
+static __attribute__((noinline)) void output_enable_ext_tick(void)
+{
+    (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_37_IDX, 1u, &idacContext);
+}
+
+
+static __attribute__((noinline)) void empty(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+
+#if defined(__x86_64__)
+
+static void step_handler(int sig)
+{
+    (void)sig;
+    stepCnt++;
+}
+
+
+/* Counts the instructions executed by a call of func with the trap flag set */
+static unsigned long steps(void (* func)(void))
+{
+    stepCnt = 0u;
+    __asm__ volatile ("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    func();
+    __asm__ volatile ("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    return (stepCnt);
+}
+
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)snprintf(out, size, "%lu", steps(func) - steps(&empty));
+}
+
+#else
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)func;
+    (void)snprintf(out, size, "-");
+}
+
+#endif /* defined(__x86_64__) */
+
+
+static double time_calls(void (* func)(void), unsigned long calls)
+{
+    double start = now_s();
+    unsigned long i;
+
+    for (i = 0u; i < calls; i++)
+    {
+        func();
+    }
+    return (((now_s() - start) * 1e9) / (double)calls);
+}
+
+
+/* Times the dither tick with the accumulator before the carry and the checked write */
+static void tick_cost(unsigned long calls)
+{
+    char cnt[24];
+
+    expect((CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_DitherInit(CY_CSDIDAC_A, 8u, &idacContext, &ditherContext)) &&
+           (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_DitherSetCurrent(TICK_CURRENT_PA, &ditherContext)), "dither start");
+
+    ditherContext.accumulator = 0u;
+    count_instructions(&dither_tick, cnt, sizeof(cnt));
+    printf("DitherProcess, no carry  instructions %5s\n", cnt);
+    ditherContext.accumulator = (1uL << ditherContext.extraBits) - 1u;
+    count_instructions(&dither_tick, cnt, sizeof(cnt));
+    printf("DitherProcess, carry     instructions %5s\n", cnt);
+    printf("DitherProcess            %7.2f ns\n", time_calls(&dither_tick, calls));
+
+    count_instructions(&output_enable_ext_tick, cnt, sizeof(cnt));
+    printf("OutputEnableExt          instructions %5s, %7.2f ns\n", cnt, time_calls(&output_enable_ext_tick, calls));
+    (void)Cy_CSDIDAC_DitherStop(&ditherContext);
+}
+
+
+/* The errors of a bit number in LSB of the range */
+typedef struct
+{
+    double mean;                            /* The mean of 2^extraBits ticks */
+    double filter;                          /* The output of the ideal filter model */
+    double nearest;                         /* The nearest code without dithering */
+} dither_error_t;
+
+
+/* Dithers a current for four time constants and updates the worst errors */
+static void accuracy_current(int32_t currentPa, dither_error_t * worst)
+{
+    const uint32_t period = 1uL << ditherContext.extraBits;
+    const double alpha = 1.0 / (double)period;
+    int64_t sum = 0;
+    int64_t lsbPa;
+    int64_t tickPa;
+    int64_t code;
+    uint32_t word;
+    uint32_t tick;
+    uint32_t wrong = 0u;
+    double filter = (double)currentPa;
+    double error;
+
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_DitherSetCurrent(currentPa, &ditherContext), "dither current set");
+    lsbPa = (int64_t)CY_CSDIDAC_LSB_PA(CY_CSDIDAC_IDAC_WORD_LSB(ditherContext.baseWord));
+    for (tick = 0u; tick < (4u * period); tick++)
+    {
+        Cy_CSDIDAC_DitherProcess(&ditherContext);
+        word = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+        if ((word != ditherContext.baseWord) && (word != (ditherContext.baseWord + 1u)))
+        {
+            wrong++;
+        }
+        tickPa = word_pa(word);
+        if (tick < period)
+        {
+            sum += tickPa;
+        }
+        filter += ((double)tickPa - filter) * alpha;
+        if (tick >= (2u * period))
+        {
+            error = (filter - (double)currentPa) / (double)lsbPa;
+            worst->filter = (error > worst->filter) ? error : ((-error > worst->filter) ? -error : worst->filter);
+        }
+    }
+    expect(0u == wrong, "adjacent codes only");
+
+    error = ((double)sum - ((double)currentPa * (double)period)) / ((double)period * (double)lsbPa);
+    error = (0.0 > error) ? -error : error;
+    worst->mean = (error > worst->mean) ? error : worst->mean;
+
+    code = (((currentPa < 0) ? -(int64_t)currentPa : (int64_t)currentPa) + (lsbPa / 2)) / lsbPa;
+    code = (code > (int64_t)CY_CSDIDAC_MAX_CODE) ? (int64_t)CY_CSDIDAC_MAX_CODE : code;
+    error = (((double)code * (double)lsbPa) - ((currentPa < 0) ? -(double)currentPa : (double)currentPa)) /
+            (double)lsbPa;
+    error = (0.0 > error) ? -error : error;
+    worst->nearest = (error > worst->nearest) ? error : worst->nearest;
+}
+
+
+static void accuracy(uint32_t extraBits)
+{
+    const double lsbFraction = 1.0 / (double)(1uL << extraBits);
+    dither_error_t worst = {0.0, 0.0, 0.0};
+    int32_t currentPa;
+    uint32_t i;
+    char what[64];
+
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_DitherInit(CY_CSDIDAC_A, extraBits, &idacContext, &ditherContext),
+           "dither init");
+    for (i = 0u; i < (uint32_t)(sizeof(edgeCurrents) / sizeof(edgeCurrents[0])); i++)
+    {
+        accuracy_current(edgeCurrents[i], &worst);
+    }
+    for (i = 0u; i < RANDOM_CURRENT_NUM; i++)
+    {
+        /* Uniform in the full scale divided by 1 to 2^15, so every range is covered */
+        currentPa = (int32_t)((random_next() % (uint32_t)MAX_CURRENT_PA) >> (random_next() % 16u));
+        accuracy_current((0u != (random_next() & 1u)) ? -currentPa : currentPa, &worst);
+    }
+    (void)Cy_CSDIDAC_DitherStop(&ditherContext);
+
+    printf("%2u bits: mean %.7f LSB (bound %.7f), filter %.7f LSB (bound %.7f), nearest code %.4f LSB\n",
+           extraBits, worst.mean, lsbFraction / 2.0, worst.filter, 2.5 * lsbFraction, worst.nearest);
+    (void)snprintf(what, sizeof(what), "%u bits: mean within the rounding", extraBits);
+    expect(worst.mean <= ((lsbFraction / 2.0) + 1e-9), what);
+    (void)snprintf(what, sizeof(what), "%u bits: filtered current within the bound", extraBits);
+    expect(worst.filter <= (2.5 * lsbFraction), what);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000u;
+    uint32_t i;
+
+#if defined(__x86_64__)
+    (void)signal(SIGTRAP, &step_handler);
+#endif /* defined(__x86_64__) */
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    tick_cost(calls);
+    for (i = 0u; i < (uint32_t)(sizeof(bitList) / sizeof(bitList[0])); i++)
+    {
+        accuracy(bitList[i]);
+    }
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
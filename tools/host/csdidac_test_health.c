@@ -0,0 +1,285 @@
+/***************************************************************************//**
+* \file csdidac_test_health.c
+* \version 2.10
+*
+* \brief
+* Host fault injection test of the CSDIDAC health checker. Both channels are
+* enabled on GPIO pins of one port, then a fault is injected into the host
+* model and Cy_CSDIDAC_HealthCheck() is called once:
+* - the CSD HW block is taken by another owner through host_csd_lock[0],
+* - an IDAC register or the SW_BYP_SEL register is overwritten, including
+*   a reset of the whole CSD block,
+* - the HSIOM selection of a pin is changed.
+*
+* Every fault runs with each recovery policy. The test checks the detected
+* fault mask, the mask passed to the callback, the hardware after the
+* recovery, and the result of a second check: REAPPLY restores the state
+* before the fault, DISABLE disables both channels, and CALLBACK leaves the
+* hardware as it is. When the block is lost, the hardware is not touched
+* and only the context is marked disabled.
+*
+* The cost of a check without a fault is reported as the time, the
+* register accesses, and the register accesses in the critical section.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_health \
+*            tools/host/csdidac_test_health.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_health.c -lpthread
+* Usage:  csdidac_test_health
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_health.h"
+
+#define PIN_A                       (1u)
+#define PIN_B                       (2u)
+
+#define COST_CHECKS                 (1000000u)
+
+typedef struct
+{
+    uint32_t idacA;
+    uint32_t idacB;
+    uint32_t swBypSel;
+    uint32_t portSel;
+} hw_state_t;
+
+typedef struct
+{
+    const char * name;
+    void (* inject)(void);
+    bool channelB;                          /* Channel B is enabled before the fault */
+    uint32_t faults;                        /* The expected fault mask */
+} fault_case_t;
+
+static cy_stc_csd_context_t csdContext;
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_health_context_t healthContext;
+static uint32_t callbackFaults;
+static uint32_t callbackCnt;
+static int failed;
+
+
+static hw_state_t hw_read(void)
+{
+    hw_state_t state;
+
+    state.idacA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    state.idacB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    state.swBypSel = HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL);
+    state.portSel = host_hsiom_ports[0].PORT_SEL;
+    return (state);
+}
+
+
+static bool hw_equal(hw_state_t a, hw_state_t b)
+{
+    return ((a.idacA == b.idacA) && (a.idacB == b.idacB) && (a.swBypSel == b.swBypSel) && (a.portSel == b.portSel));
+}
+
+
+static void set_hsiom(uint32_t pin, uint32_t sel)
+{
+    uint32_t shift = pin << CY_GPIO_HSIOM_OFFSET;
+
+    host_hsiom_ports[0].PORT_SEL = (host_hsiom_ports[0].PORT_SEL & ~(CY_GPIO_HSIOM_MASK << shift)) | (sel << shift);
+}
+
+
+static void inject_lock(void)       { host_csd_lock[0] = CY_CSD_CAPSENSE_KEY; }
+static void inject_idaca(void)      { HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) ^= 0x05u; }
+static void inject_idacb(void)      { HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB) ^= (1uL << 8u); }
+static void inject_bypa(void)       { HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL) &= ~CY_CSDIDAC_SW_BYPA_ENABLE; }
+static void inject_bypb(void)       { HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL) |= CY_CSDIDAC_SW_BYPB_ENABLE; }
+static void inject_pina(void)       { set_hsiom(PIN_A, (uint32_t)HSIOM_SEL_GPIO); }
+static void inject_pinb(void)       { set_hsiom(PIN_B, (uint32_t)HSIOM_SEL_AMUXA); }
+
+static void inject_reset(void)
+{
+    HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) = 0u;
+    HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB) = 0u;
+    HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL) = 0u;
+}
+
+static const fault_case_t faultCases[] =
+{
+    {"lock lost",          &inject_lock,  true,  CY_CSDIDAC_HEALTH_FAULT_LOCK},
+    {"IDACA code",         &inject_idaca, true,  CY_CSDIDAC_HEALTH_FAULT_IDACA},
+    {"IDACB polarity",     &inject_idacb, true,  CY_CSDIDAC_HEALTH_FAULT_IDACB},
+    {"CSD block reset",    &inject_reset, true,  CY_CSDIDAC_HEALTH_FAULT_IDACA | CY_CSDIDAC_HEALTH_FAULT_IDACB |
+                                                 CY_CSDIDAC_HEALTH_FAULT_BYPA | CY_CSDIDAC_HEALTH_FAULT_BYPB},
+    {"bypass A open",      &inject_bypa,  true,  CY_CSDIDAC_HEALTH_FAULT_BYPA},
+    {"bypass B closed",    &inject_bypb,  false, CY_CSDIDAC_HEALTH_FAULT_BYPB},
+    {"pin A HSIOM",        &inject_pina,  true,  CY_CSDIDAC_HEALTH_FAULT_PINA},
+    {"pin B HSIOM",        &inject_pinb,  true,  CY_CSDIDAC_HEALTH_FAULT_PINB},
+};
+
+static const char * const policyNames[] = {"REAPPLY", "DISABLE", "CALLBACK"};
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static void on_fault(uint32_t faults, cy_stc_csdidac_context_t * idac)
+{
+    (void)idac;
+    callbackFaults = faults;
+    callbackCnt++;
+}
+
+
+static void expect(int condition, const char * fault, const char * policy, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s, %s: %s\n", fault, policy, what);
+        failed = 1;
+    }
+}
+
+
+static void setup(cy_en_csdidac_health_policy_t policy, bool channelB)
+{
+    const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], PIN_A};
+    const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], PIN_B};
+    static cy_stc_csdidac_pin_t pins[2];
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pins[0], &pins[1], 48000000u, 10u
+    };
+
+    pins[0] = pinA;
+    pins[1] = pinB;
+    host_reset();
+    (void)Cy_CSDIDAC_Init(&config, &idacContext);
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 10000, &idacContext);
+    if (true == channelB)
+    {
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, -20000, &idacContext);
+    }
+    (void)Cy_CSDIDAC_HealthInit(policy, &on_fault, &idacContext, &healthContext);
+    callbackFaults = 0u;
+    callbackCnt = 0u;
+}
+
+
+static void run_case(const fault_case_t * fc, cy_en_csdidac_health_policy_t policy)
+{
+    const char * name = policyNames[policy];
+    bool lock = (0u != (fc->faults & CY_CSDIDAC_HEALTH_FAULT_LOCK));
+    hw_state_t before;
+    hw_state_t injected;
+    hw_state_t after;
+    uint32_t faults;
+    uint32_t again;
+
+    setup(policy, fc->channelB);
+    expect(0u == Cy_CSDIDAC_HealthCheck(&healthContext), fc->name, name, "fault before the injection");
+    before = hw_read();
+    fc->inject();
+    injected = hw_read();
+
+    faults = Cy_CSDIDAC_HealthCheck(&healthContext);
+    after = hw_read();
+    again = Cy_CSDIDAC_HealthCheck(&healthContext);
+    printf("%-18s %-8s faults 0x%02X, callback 0x%02X, second check 0x%02X\n",
+           fc->name, name, faults, callbackFaults, again);
+
+    expect(fc->faults == faults, fc->name, name, "fault mask");
+    expect(fc->faults == callbackFaults, fc->name, name, "callback mask");
+    if ((true == lock) || (CY_CSDIDAC_HEALTH_CALLBACK == policy))
+    {
+        /* The hardware is not touched */
+        expect(hw_equal(injected, after), fc->name, name, "hardware changed");
+        expect((true == lock) ? (CY_CSDIDAC_HEALTH_FAULT_LOCK == again) : (fc->faults == again),
+               fc->name, name, "second check");
+    }
+    else
+    {
+        expect(0u == again, fc->name, name, "second check");
+    }
+    if (true == lock)
+    {
+        expect(((CY_CSDIDAC_DISABLE == idacContext.channelStateA) && (CY_CSDIDAC_DISABLE == idacContext.channelStateB)) ==
+               (CY_CSDIDAC_HEALTH_CALLBACK != policy), fc->name, name, "context state");
+    }
+    else if (CY_CSDIDAC_HEALTH_REAPPLY == policy)
+    {
+        expect(hw_equal(before, after), fc->name, name, "state before the fault not restored");
+    }
+    else if (CY_CSDIDAC_HEALTH_DISABLE == policy)
+    {
+        expect((0u == after.idacA) && (0u == after.idacB) &&
+               (0u == (after.swBypSel & (CY_CSDIDAC_SW_BYPA_ENABLE | CY_CSDIDAC_SW_BYPB_ENABLE))) &&
+               (CY_CSDIDAC_DISABLE == idacContext.channelStateA) && (CY_CSDIDAC_DISABLE == idacContext.channelStateB),
+               fc->name, name, "channels not disabled");
+    }
+    else
+    {
+        /* CALLBACK is checked above */
+    }
+}
+
+
+static void cost(void)
+{
+    uint32_t i;
+    double start;
+    double elapsed;
+
+    setup(CY_CSDIDAC_HEALTH_REAPPLY, true);
+    host_access = (host_access_t){0};
+    (void)Cy_CSDIDAC_HealthCheck(&healthContext);
+    printf("check without a fault: %u register accesses, %u in the critical section\n",
+           host_access_total(), host_access.csAccessMax);
+
+    start = now_s();
+    for (i = 0u; i < COST_CHECKS; i++)
+    {
+        (void)Cy_CSDIDAC_HealthCheck(&healthContext);
+    }
+    elapsed = now_s() - start;
+    printf("check without a fault: %.1f ns, %lu checks, %lu faults\n", (elapsed * 1e9) / COST_CHECKS,
+           (unsigned long)healthContext.checkCnt, (unsigned long)healthContext.faultCnt);
+    if (0u != healthContext.faultCnt)
+    {
+        failed = 1;
+    }
+}
+
+
+int main(void)
+{
+    uint32_t i;
+    uint32_t policy;
+
+    for (i = 0u; i < (sizeof(faultCases) / sizeof(faultCases[0])); i++)
+    {
+        for (policy = 0u; policy < 3u; policy++)
+        {
+            run_case(&faultCases[i], (cy_en_csdidac_health_policy_t)policy);
+        }
+    }
+    cost();
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
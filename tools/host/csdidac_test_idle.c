@@ -0,0 +1,203 @@
+/***************************************************************************//**
+* \file csdidac_test_idle.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC zero-current idle gating. A scripted sequence
+* of setpoints checks the parking after the hold time, the registers of
+* a parked channel, the re-arming, and the residency and the parking and
+* re-arming counters of the idle gating context. An enable at 0 nA of a
+* parked channel is not a re-arm.
+*
+* A stress run then calls Cy_CSDIDAC_IdleProcess() with the zero hold time
+* from a thread, while the main thread alternates the 0 nA and non-zero
+* setpoints. A non-zero setpoint found disabled right after it is written
+* was parked from a stale read and counts as lost.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_idle \
+*            tools/host/csdidac_test_idle.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_idle.c -lpthread
+* Usage:  csdidac_test_idle [<stress seconds>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_idle.h"
+
+#define HOLD_TICKS                  (3u)
+#define PIN_A                       (1u)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_idle_context_t idleContext;
+static volatile int stop;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static uint32_t hsiom_a(void)
+{
+    return ((host_hsiom_ports[0].PORT_SEL >> (PIN_A << CY_GPIO_HSIOM_OFFSET)) & CY_GPIO_HSIOM_MASK);
+}
+
+
+static int is_parked(void)
+{
+    return ((0u == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)) &&
+            (0u == (HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL) & CY_CSDIDAC_SW_BYPA_ENABLE)) &&
+            ((uint32_t)HSIOM_SEL_GPIO == hsiom_a()));
+}
+
+
+static int is_armed(void)
+{
+    return ((0u != (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) & CY_CSDIDAC_IDAC_WORD_CODE_MASK)) &&
+            (0u != (HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL) & CY_CSDIDAC_SW_BYPA_ENABLE)) &&
+            ((uint32_t)HSIOM_SEL_AMUXA == hsiom_a()));
+}
+
+
+static void ticks(uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0u; i < num; i++)
+    {
+        (void)Cy_CSDIDAC_IdleProcess(&idleContext);
+    }
+}
+
+
+static void script(void)
+{
+    (void)Cy_CSDIDAC_IdleInit(CY_CSDIDAC_A, HOLD_TICKS, &idacContext, &idleContext);
+
+    ticks(2u);
+    expect(CY_CSDIDAC_IDLE_OFF == idleContext.state[0], "disabled channel is off");
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 1000, &idacContext);
+    ticks(5u);
+    expect(CY_CSDIDAC_IDLE_ACTIVE == idleContext.state[0], "1000 nA is active");
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 0, &idacContext);
+    ticks(HOLD_TICKS);
+    expect(CY_CSDIDAC_IDLE_ZERO == idleContext.state[0], "held at zero for the hold time");
+    ticks(1u);
+    expect(CY_CSDIDAC_IDLE_PARKED == idleContext.state[0], "parked after the hold time");
+    expect(is_parked(), "parked registers");
+    expect(1u == idleContext.parkCnt[0], "one parking");
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 0, &idacContext);
+    ticks(1u);
+    expect(0u == idleContext.rearmCnt[0], "0 nA enable is not a re-arm");
+    ticks(HOLD_TICKS);
+    expect(CY_CSDIDAC_IDLE_PARKED == idleContext.state[0], "0 nA enable parked again");
+    expect(2u == idleContext.parkCnt[0], "two parkings");
+
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 1000, &idacContext);
+    expect(is_armed(), "re-armed registers");
+    ticks(1u);
+    expect(CY_CSDIDAC_IDLE_ACTIVE == idleContext.state[0], "re-armed channel is active");
+    expect(1u == idleContext.rearmCnt[0], "one re-arm");
+
+    expect((2u == idleContext.residency[0][CY_CSDIDAC_IDLE_OFF]) &&
+           (6u == idleContext.residency[0][CY_CSDIDAC_IDLE_ACTIVE]) &&
+           ((2u * HOLD_TICKS) == idleContext.residency[0][CY_CSDIDAC_IDLE_ZERO]) &&
+           (2u == idleContext.residency[0][CY_CSDIDAC_IDLE_PARKED]), "residency");
+    printf("residency off/active/zero/parked: %lu/%lu/%lu/%lu, parked %lu, re-armed %lu\n",
+           (unsigned long)idleContext.residency[0][CY_CSDIDAC_IDLE_OFF],
+           (unsigned long)idleContext.residency[0][CY_CSDIDAC_IDLE_ACTIVE],
+           (unsigned long)idleContext.residency[0][CY_CSDIDAC_IDLE_ZERO],
+           (unsigned long)idleContext.residency[0][CY_CSDIDAC_IDLE_PARKED],
+           (unsigned long)idleContext.parkCnt[0], (unsigned long)idleContext.rearmCnt[0]);
+}
+
+
+static void * idle_tick(void * arg)
+{
+    (void)arg;
+    while (0 == stop)
+    {
+        (void)Cy_CSDIDAC_IdleProcess(&idleContext);
+        (void)sched_yield();
+    }
+    return (NULL);
+}
+
+
+static void stress(unsigned int seconds)
+{
+    cy_stc_csdidac_channel_state_t state;
+    pthread_t tickThread;
+    time_t end = time(NULL) + (time_t)seconds;
+    unsigned long setpoints = 0u;
+    unsigned long lost = 0u;
+
+    (void)Cy_CSDIDAC_IdleInit(CY_CSDIDAC_A, 0u, &idacContext, &idleContext);
+    (void)pthread_create(&tickThread, NULL, &idle_tick, NULL);
+    while (time(NULL) < end)
+    {
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 0, &idacContext);
+        (void)sched_yield();
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 2400, &idacContext);
+        if ((CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_ReadChannelState(&state, &idacContext)) &&
+            (CY_CSDIDAC_ENABLE != state.channelStateA))
+        {
+            lost++;
+        }
+        setpoints++;
+        (void)sched_yield();
+    }
+    stop = 1;
+    (void)pthread_join(tickThread, NULL);
+
+    printf("stress: %lu setpoints, %lu parkings, %lu re-arms, %lu lost\n", setpoints,
+           (unsigned long)idleContext.parkCnt[0], (unsigned long)idleContext.rearmCnt[0], lost);
+    expect(0u == lost, "no non-zero setpoint parked");
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], PIN_A};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    script();
+    stress((argc > 1) ? (unsigned int)atoi(argv[1]) : 2u);
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
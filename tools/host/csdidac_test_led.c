@@ -0,0 +1,200 @@
+/***************************************************************************//**
+* \file csdidac_test_led.c
+* \version 2.10
+*
+* \brief
+* Host test of the perceived linearity of the CSDIDAC LED fades. The fade of
+* the original main.c steps the sink current linearly from -609600 nA to 0
+* by 4800 nA, 127 steps. The gamma-corrected fade of the LED driver runs
+* over the same 127 ticks with Cy_CSDIDAC_LedFade() and
+* Cy_CSDIDAC_LedProcess(). Both fades are run out and in, and the IDAC
+* register word is read back after every step.
+*
+* The light output is taken as proportional to the LED current, and the
+* perceived lightness is the CIE 1976 L* of the relative luminance. A
+* perceptually linear fade moves L* linearly in time between the end
+* points, so the test reports the maximum and RMS deviation of L* from
+* that line. It also reports the largest L* step between ticks, a visible
+* jump, and the number of the LSB range switches.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. [-DCY_CSDIDAC_LED_BITS=10u] \
+*            -o csdidac_test_led tools/host/csdidac_test_led.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_led.c -lpthread -lm
+* Usage:  csdidac_test_led
+*
+* The test fails if the gamma fade does not reduce the maximum deviation.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_led.h"
+
+/* The fade of the original main.c */
+#define OLD_MAX_NA                  (609600L)
+#define OLD_STEP_NA                 (4800L)
+#define FADE_TICKS                  ((uint32_t)(OLD_MAX_NA / OLD_STEP_NA))
+
+typedef struct
+{
+    double lightness[FADE_TICKS + 1u];      /* L* after every step, the first is the start point */
+    uint32_t num;
+    uint32_t lsbSwitches;
+    uint32_t lastLsb;
+} fade_t;
+
+typedef struct
+{
+    double maxError;
+    double rmsError;
+    double maxStep;
+} linearity_t;
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_led_context_t ledContext;
+
+
+/* The CIE 1976 lightness of the relative luminance */
+static double cie_lightness(double y)
+{
+    return ((y > 0.008856) ? ((116.0 * cbrt(y)) - 16.0) : (903.3 * y));
+}
+
+
+/* Records the lightness of the LED current set by the IDAC B register word */
+static void record(fade_t * fade)
+{
+    uint32_t word = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    uint32_t lsb = CY_CSDIDAC_IDAC_WORD_LSB(word);
+    double currentPa = (double)(word & CY_CSDIDAC_IDAC_WORD_CODE_MASK) * (double)CY_CSDIDAC_LSB_PA(lsb);
+
+    if ((0u != fade->num) && (lsb != fade->lastLsb))
+    {
+        fade->lsbSwitches++;
+    }
+    fade->lastLsb = lsb;
+    fade->lightness[fade->num] = cie_lightness(currentPa / ((double)OLD_MAX_NA * 1000.0));
+    fade->num++;
+}
+
+
+static linearity_t linearity(const fade_t * fade)
+{
+    linearity_t result = {0.0, 0.0, 0.0};
+    double first = fade->lightness[0];
+    double last = fade->lightness[fade->num - 1u];
+    double ideal;
+    double error;
+    double sum = 0.0;
+    uint32_t i;
+
+    for (i = 0u; i < fade->num; i++)
+    {
+        ideal = first + (((last - first) * (double)i) / (double)(fade->num - 1u));
+        error = fabs(fade->lightness[i] - ideal);
+        sum += error * error;
+        result.maxError = (error > result.maxError) ? error : result.maxError;
+        if ((0u != i) && (fabs(fade->lightness[i] - fade->lightness[i - 1u]) > result.maxStep))
+        {
+            result.maxStep = fabs(fade->lightness[i] - fade->lightness[i - 1u]);
+        }
+    }
+    result.rmsError = sqrt(sum / (double)fade->num);
+    return (result);
+}
+
+
+static void old_fade(fade_t * fade, int out)
+{
+    uint32_t i;
+    long current;
+
+    fade->num = 0u;
+    fade->lsbSwitches = 0u;
+    for (i = 0u; i <= FADE_TICKS; i++)
+    {
+        current = (0 != out) ? (-OLD_MAX_NA + ((long)i * OLD_STEP_NA)) : -((long)i * OLD_STEP_NA);
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, (int32_t)current, &idacContext);
+        record(fade);
+    }
+}
+
+
+static void gamma_fade(fade_t * fade, int out)
+{
+    uint32_t i;
+
+    fade->num = 0u;
+    fade->lsbSwitches = 0u;
+    (void)Cy_CSDIDAC_LedFade((0 != out) ? CY_CSDIDAC_LED_MAX_BRIGHTNESS : 0u, 0u, &ledContext);
+    record(fade);
+    (void)Cy_CSDIDAC_LedFade((0 != out) ? 0u : CY_CSDIDAC_LED_MAX_BRIGHTNESS, FADE_TICKS, &ledContext);
+    for (i = 0u; i < FADE_TICKS; i++)
+    {
+        (void)Cy_CSDIDAC_LedProcess(&ledContext);
+        record(fade);
+    }
+}
+
+
+static void report(const char * name, const fade_t * fade, linearity_t lin)
+{
+    printf("%-16s L* %5.1f -> %5.1f, deviation max %5.2f rms %5.2f, largest step %5.2f, %u LSB switches\n",
+           name, fade->lightness[0], fade->lightness[fade->num - 1u], lin.maxError, lin.rmsError,
+           lin.maxStep, fade->lsbSwitches);
+}
+
+
+int main(void)
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    static fade_t oldFade;
+    static fade_t gammaFade;
+    linearity_t oldLin;
+    linearity_t gammaLin;
+    int failed = 0;
+    int out;
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_LedInit(CY_CSDIDAC_B, &idacContext, &ledContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    printf("%u ticks, %u-bit brightness\n", FADE_TICKS, (unsigned int)CY_CSDIDAC_LED_BITS);
+
+    for (out = 1; out >= 0; out--)
+    {
+        old_fade(&oldFade, out);
+        gamma_fade(&gammaFade, out);
+        oldLin = linearity(&oldFade);
+        gammaLin = linearity(&gammaFade);
+        report((0 != out) ? "old fade out" : "old fade in", &oldFade, oldLin);
+        report((0 != out) ? "gamma fade out" : "gamma fade in", &gammaFade, gammaLin);
+        if (gammaLin.maxError >= oldLin.maxError)
+        {
+            failed = 1;
+        }
+    }
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
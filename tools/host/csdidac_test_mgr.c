@@ -0,0 +1,335 @@
+/***************************************************************************//**
+* \file csdidac_test_mgr.c
+* \version 2.10
+*
+* \brief
+* Host test of Cy_CSDIDAC_MgrUpdateGroup() on two modelled CSD HW blocks,
+* block 0 with both the channels on GPIO pins and block 1 with IdacB
+* joined to IdacA. The CSD register writes are recorded with the block,
+* the register and the outermost critical section of the model they are
+* made in. The test checks:
+* - the validation: a NULL pointer, an empty group, a channel out of the
+*   managed range, a current out of range, an invalid state, a disabled
+*   channel, and a joined channel enabled while its pin is disabled by the
+*   same group fail, and a failed group writes no register, also when its
+*   other updates are valid,
+* - the coalescing: of several updates of a channel only the last one is
+*   applied, with one IDAC register write,
+* - the per-block grouping: the updates of both the blocks in an interleaved
+*   order are written block by block, each block in one critical section,
+* - the AB path: equal enabled currents of both the channels of a block are
+*   applied by one Cy_CSDIDAC_OutputEnable() call, and different currents by
+*   two. The calls are counted by the CY_CSDIDAC_STATS_EN statistics.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -DCY_CSDIDAC_STATS_EN=1u -Itools/host -I. \
+*            -o csdidac_test_mgr tools/host/csdidac_test_mgr.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_mgr.c -lpthread
+* Usage:  csdidac_test_mgr
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_mgr.h"
+
+/* The most recorded CSD register writes of a group */
+#define WRITE_LOG_SIZE              (256u)
+
+/* The recorded CSD register write */
+typedef struct
+{
+    uint32_t block;
+    uint32_t offset;
+    uint32_t csCount;
+} csd_write_t;
+
+static cy_stc_csdidac_context_t idacContext[HOST_CSD_NUM];
+static cy_stc_csdidac_mgr_context_t mgrContext;
+static csd_write_t writeLog[WRITE_LOG_SIZE];
+static uint32_t writeNum;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static void write_hook(uint32_t block, uint32_t offset, uint32_t value)
+{
+    (void)value;
+    if (writeNum < WRITE_LOG_SIZE)
+    {
+        writeLog[writeNum].block = block;
+        writeLog[writeNum].offset = offset;
+        writeLog[writeNum].csCount = host_access.csCount;
+    }
+    writeNum++;
+}
+
+
+/* Counts the recorded writes of a register of a block */
+static uint32_t writes_of(uint32_t block, uint32_t offset)
+{
+    uint32_t num = 0u;
+    uint32_t i;
+
+    for (i = 0u; (i < writeNum) && (i < WRITE_LOG_SIZE); i++)
+    {
+        if ((block == writeLog[i].block) && (offset == writeLog[i].offset))
+        {
+            num++;
+        }
+    }
+    return (num);
+}
+
+
+/* Applies a group with the write log cleared */
+static cy_en_csdidac_status_t update(const cy_stc_csdidac_mgr_update_t * updates, uint32_t numUpdates)
+{
+    writeNum = 0u;
+    return (Cy_CSDIDAC_MgrUpdateGroup(updates, numUpdates, &mgrContext));
+}
+
+
+/* Returns the IDAC register word of a flat channel */
+static uint32_t idac_word(uint32_t channel)
+{
+    return (HOST_CSD_REG_N(channel / CY_CSDIDAC_MGR_CH_PER_BLOCK,
+                           (0u == (channel % CY_CSDIDAC_MGR_CH_PER_BLOCK)) ? CY_CSD_REG_OFFSET_IDACA :
+                                                                             CY_CSD_REG_OFFSET_IDACB));
+}
+
+
+/*
+* Returns the IDAC register word a single Cy_CSDIDAC_MgrOutputEnable() call
+* makes. The call is made on the channel the group has set to the same
+* current, and it is not recorded.
+*/
+static uint32_t reference_word(uint32_t channel, int32_t current)
+{
+    uint32_t saved[HOST_CSD_NUM][HOST_CSD_REG_NUM];
+    uint32_t word;
+
+    (void)memcpy(saved, host_csd_regs, sizeof(saved));
+    host_csd_write_hook = NULL;
+    (void)Cy_CSDIDAC_MgrOutputEnable(channel, current, &mgrContext);
+    host_csd_write_hook = &write_hook;
+    word = idac_word(channel);
+    (void)memcpy(host_csd_regs, saved, sizeof(saved));
+    return (word);
+}
+
+
+static void disable_all(void)
+{
+    static const cy_stc_csdidac_mgr_update_t offAll[] =
+    {
+        {0u, CY_CSDIDAC_DISABLE, 0}, {1u, CY_CSDIDAC_DISABLE, 0},
+        {2u, CY_CSDIDAC_DISABLE, 0}, {3u, CY_CSDIDAC_DISABLE, 0},
+    };
+
+    expect(CY_CSDIDAC_SUCCESS == update(offAll, 4u), "disable all");
+}
+
+
+/* Checks that a group fails and leaves the registers unchanged */
+static void check_invalid(const char * name, const cy_stc_csdidac_mgr_update_t * updates, uint32_t numUpdates)
+{
+    uint32_t saved[HOST_CSD_NUM][HOST_CSD_REG_NUM];
+    char what[96];
+
+    (void)memcpy(saved, host_csd_regs, sizeof(saved));
+    (void)snprintf(what, sizeof(what), "invalid %s", name);
+    expect((CY_CSDIDAC_BAD_PARAM == update(updates, numUpdates)) && (0u == writeNum) &&
+           (0 == memcmp(saved, host_csd_regs, sizeof(saved))), what);
+}
+
+
+static void check_validation(const cy_stc_csdidac_config_t * config1)
+{
+    static const cy_stc_csdidac_mgr_update_t outOfRange[] = {{4u, CY_CSDIDAC_ENABLE, 1200}};
+    static const cy_stc_csdidac_mgr_update_t overMax[] =
+    {
+        {0u, CY_CSDIDAC_ENABLE, (int32_t)CY_CSDIDAC_MAX_CURRENT_NA + 1}
+    };
+    static const cy_stc_csdidac_mgr_update_t underMax[] =
+    {
+        {1u, CY_CSDIDAC_ENABLE, -(int32_t)CY_CSDIDAC_MAX_CURRENT_NA - 1}
+    };
+    static const cy_stc_csdidac_mgr_update_t badState[] = {{0u, (cy_en_csdidac_state_t)2u, 1200}};
+    static const cy_stc_csdidac_mgr_update_t lastBad[] =
+    {
+        {0u, CY_CSDIDAC_ENABLE, 1200}, {2u, CY_CSDIDAC_ENABLE, 2400}, {5u, CY_CSDIDAC_DISABLE, 0}
+    };
+    static const cy_stc_csdidac_mgr_update_t joinOff[] =
+    {
+        {3u, CY_CSDIDAC_ENABLE, 1200}, {2u, CY_CSDIDAC_DISABLE, 0}
+    };
+    static const cy_stc_csdidac_mgr_update_t joinOn[] =
+    {
+        {3u, CY_CSDIDAC_ENABLE, 1200}, {2u, CY_CSDIDAC_ENABLE, 600}
+    };
+    static const cy_stc_csdidac_mgr_update_t disabledCh[] = {{3u, CY_CSDIDAC_ENABLE, 1200}};
+    cy_stc_csdidac_config_t configOff = *config1;
+
+    (void)Cy_CSDIDAC_MgrOutputEnable(0u, 4800, &mgrContext);
+    check_invalid("NULL updates", NULL, 1u);
+    check_invalid("empty group", outOfRange, 0u);
+    writeNum = 0u;
+    expect((CY_CSDIDAC_BAD_PARAM == Cy_CSDIDAC_MgrUpdateGroup(outOfRange, 1u, NULL)) && (0u == writeNum),
+           "invalid NULL context");
+    check_invalid("channel out of range", outOfRange, 1u);
+    check_invalid("current over the maximum", overMax, 1u);
+    check_invalid("current under the minimum", underMax, 1u);
+    check_invalid("state", badState, 1u);
+    check_invalid("last update of a valid group", lastBad, 3u);
+    check_invalid("joined channel with its pin disabled", joinOff, 2u);
+    expect(CY_CSDIDAC_SUCCESS == update(joinOn, 2u), "joined channel with its pin enabled");
+
+    /* The configuration is written with both the channels of the block disabled */
+    disable_all();
+    configOff.configB = CY_CSDIDAC_DISABLED;
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_WriteConfig(&configOff, &idacContext[1]), "disable a channel");
+    check_invalid("disabled channel", disabledCh, 1u);
+    (void)Cy_CSDIDAC_WriteConfig(config1, &idacContext[1]);
+}
+
+
+static void check_coalescing(void)
+{
+    static const cy_stc_csdidac_mgr_update_t group[] =
+    {
+        {0u, CY_CSDIDAC_ENABLE, 1200}, {1u, CY_CSDIDAC_ENABLE, -2400}, {0u, CY_CSDIDAC_DISABLE, 0},
+        {2u, CY_CSDIDAC_ENABLE, 600}, {0u, CY_CSDIDAC_ENABLE, 48000}, {1u, CY_CSDIDAC_DISABLE, 0},
+    };
+
+    expect(CY_CSDIDAC_SUCCESS == update(group, sizeof(group) / sizeof(group[0])), "coalesced group");
+    expect((reference_word(0u, 48000) == idac_word(0u)) &&
+           (1u == writes_of(0u, CY_CSD_REG_OFFSET_IDACA)), "last enable of a channel applied once");
+    expect((0u == (idac_word(1u) & CY_CSDIDAC_IDAC_WORD_CODE_MASK)) &&
+           (1u == writes_of(0u, CY_CSD_REG_OFFSET_IDACB)), "last disable of a channel applied once");
+    expect(reference_word(2u, 600) == idac_word(2u), "other block applied");
+    printf("coalescing:  %u updates, %u CSD register writes\n",
+           (unsigned int)(sizeof(group) / sizeof(group[0])), writeNum);
+    disable_all();
+}
+
+
+static void check_grouping(void)
+{
+    static const cy_stc_csdidac_mgr_update_t group[] =
+    {
+        {3u, CY_CSDIDAC_ENABLE, -2400}, {0u, CY_CSDIDAC_ENABLE, 1200},
+        {2u, CY_CSDIDAC_ENABLE, 600}, {1u, CY_CSDIDAC_ENABLE, -1200},
+    };
+    uint32_t csCount = host_access.csCount;
+    uint32_t blockChanges = 0u;
+    uint32_t mixedCs = 0u;
+    uint32_t i;
+
+    expect(CY_CSDIDAC_SUCCESS == update(group, sizeof(group) / sizeof(group[0])), "interleaved group");
+    csCount = host_access.csCount - csCount;
+    for (i = 0u; i < sizeof(group) / sizeof(group[0]); i++)
+    {
+        expect(reference_word(group[i].channel, group[i].current) == idac_word(group[i].channel), "channel applied");
+    }
+    for (i = 1u; (i < writeNum) && (i < WRITE_LOG_SIZE); i++)
+    {
+        if (writeLog[i].block != writeLog[i - 1u].block)
+        {
+            blockChanges++;
+        }
+        if ((writeLog[i].block == writeLog[i - 1u].block) != (writeLog[i].csCount == writeLog[i - 1u].csCount))
+        {
+            mixedCs++;
+        }
+    }
+    expect((0u < writeNum) && (0u == writeLog[0].block) && (1u == blockChanges), "written block by block");
+    expect(0u == mixedCs, "one critical section per block");
+    expect(HOST_CSD_NUM == csCount, "critical sections");
+    printf("grouping:    %u CSD register writes, %u critical sections\n", writeNum, csCount);
+    disable_all();
+}
+
+
+/* Returns the Cy_CSDIDAC_OutputEnable() calls of block 0 made by a group of both its channels */
+static uint32_t enable_calls(int32_t currentA, int32_t currentB)
+{
+    const cy_stc_csdidac_mgr_update_t group[] =
+    {
+        {0u, CY_CSDIDAC_ENABLE, currentA}, {1u, CY_CSDIDAC_ENABLE, currentB},
+    };
+    cy_stc_csdidac_stats_t stats;
+
+    (void)Cy_CSDIDAC_SnapshotStats(NULL, &idacContext[0]);
+    expect(CY_CSDIDAC_SUCCESS == update(group, 2u), "group of both the channels");
+    (void)Cy_CSDIDAC_SnapshotStats(&stats, &idacContext[0]);
+    expect((reference_word(0u, currentA) == idac_word(0u)) &&
+           (reference_word(1u, currentB) == idac_word(1u)), "both the channels applied");
+    disable_all();
+    return (stats.calls[CY_CSDIDAC_API_OUTPUT_ENABLE]);
+}
+
+
+static void check_ab(void)
+{
+    uint32_t equalCalls = enable_calls(-3600, -3600);
+    uint32_t differentCalls = enable_calls(-3600, 3600);
+
+    expect(1u == equalCalls, "equal currents in one AB call");
+    expect(2u == differentCalls, "different currents in two calls");
+    printf("AB path:     %u OutputEnable calls for equal currents, %u for different\n", equalCalls, differentCalls);
+}
+
+
+int main(void)
+{
+    static cy_stc_csd_context_t csdContext[HOST_CSD_NUM];
+    static const cy_stc_csdidac_pin_t pinA0 = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB0 = {&host_gpio_ports[0], 2u};
+    static const cy_stc_csdidac_pin_t pinA1 = {&host_gpio_ports[1], 1u};
+    const cy_stc_csdidac_config_t config0 =
+    {
+        HOST_CSD_BASE_N(0u), &csdContext[0], CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA0, &pinB0, 48000000u, 10u
+    };
+    const cy_stc_csdidac_config_t config1 =
+    {
+        HOST_CSD_BASE_N(1u), &csdContext[1], CY_CSDIDAC_GPIO, CY_CSDIDAC_JOIN, &pinA1, NULL, 48000000u, 10u
+    };
+    cy_stc_csdidac_context_t * const contexts[HOST_CSD_NUM] = {&idacContext[0], &idacContext[1]};
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config0, &idacContext[0])) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config1, &idacContext[1])) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_MgrInit(contexts, HOST_CSD_NUM, &mgrContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    host_csd_write_hook = &write_hook;
+
+    check_validation(&config1);
+    check_coalescing();
+    check_grouping();
+    check_ab();
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
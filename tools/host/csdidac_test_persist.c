@@ -0,0 +1,228 @@
+/***************************************************************************//**
+* \file csdidac_test_persist.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC operating point persistence on a RAM stand-in of
+* the flash. The storage area is a RAM array aligned to
+* CY_CSDIDAC_PERSIST_ROW_SIZE. The row write function of the stand-in gets
+* the 32-bit row address, as Cy_Flash_WriteRow() does, and rebuilds the host
+* pointer from its offset to the low 32 bits of the area pointer, so the
+* test runs on a 64-bit host.
+*
+* The test checks:
+* - the coalescing of a burst of setpoint changes into one record after
+*   the hold-off, and no write of an unchanged operating point,
+* - the restore after a simulated reset, with its register accesses,
+* - the wear levelling over the rows, also across the sequence number
+*   wraparound,
+* - a row write cut by a reset, the previous record is restored,
+* - a failed row write, retried after the next hold-off.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_persist \
+*            tools/host/csdidac_test_persist.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_persist.c -lpthread
+* Usage:  csdidac_test_persist
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_persist.h"
+
+#define ROW_NUM                     (8u)
+#define AREA_SIZE                   (ROW_NUM * CY_CSDIDAC_PERSIST_ROW_SIZE)
+
+/* The changes of the setpoint burst */
+#define BURST_CHANGES               (1000u)
+
+/* The bytes of a cut row write, the magic, the sequence number and the channel A word */
+#define TORN_BYTES                  (12u)
+
+/* The records of the wear levelling run */
+#define WEAR_RECORDS                (1001u)
+
+typedef enum
+{
+    WRITE_OK,                               /* The row is written */
+    WRITE_TORN,                             /* A reset cuts the write after the first TORN_BYTES bytes */
+    WRITE_FAIL,                             /* The write fails with CY_FLASH_DRV_INV_PROT */
+} write_mode_t;
+
+static uint8_t flashArea[AREA_SIZE] __attribute__((aligned(CY_CSDIDAC_PERSIST_ROW_SIZE)));
+static uint32_t rowWrites[ROW_NUM];
+static write_mode_t writeMode;
+static cy_stc_csd_context_t csdContext;
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_persist_context_t persistContext;
+static int failed;
+
+
+static cy_en_flashdrv_status_t ram_flash_write(uint32_t rowAddr, const uint32_t * data)
+{
+    /* The 32-bit address is rebuilt as an offset to the low 32 bits of the area pointer */
+    uint32_t offset = rowAddr - (uint32_t)(uintptr_t)flashArea;
+    cy_en_flashdrv_status_t status = CY_FLASH_DRV_INVALID_INPUT_PARAMETERS;
+
+    if ((AREA_SIZE > offset) && (0u == (offset % CY_CSDIDAC_PERSIST_ROW_SIZE)))
+    {
+        status = CY_FLASH_DRV_SUCCESS;
+        if (WRITE_FAIL == writeMode)
+        {
+            status = CY_FLASH_DRV_INV_PROT;
+        }
+        else
+        {
+            (void)memset(&flashArea[offset], 0xFF, CY_CSDIDAC_PERSIST_ROW_SIZE);
+            (void)memcpy(&flashArea[offset], data,
+                         (WRITE_TORN == writeMode) ? TORN_BYTES : CY_CSDIDAC_PERSIST_ROW_SIZE);
+            rowWrites[offset / CY_CSDIDAC_PERSIST_ROW_SIZE]++;
+        }
+    }
+    return (status);
+}
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+/* A reset: the registers and the contexts are lost, the flash area is kept */
+static void reset(void)
+{
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+
+    host_reset();
+    (void)memset(&idacContext, 0, sizeof(idacContext));
+    (void)memset(&persistContext, 0, sizeof(persistContext));
+    (void)Cy_CSDIDAC_Init(&config, &idacContext);
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_PersistInit(CY_CSDIDAC_AB, flashArea, ROW_NUM, &ram_flash_write,
+                                                        &idacContext, &persistContext), "PersistInit");
+}
+
+
+static void hold(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i <= CY_CSDIDAC_PERSIST_HOLDOFF; i++)
+    {
+        (void)Cy_CSDIDAC_PersistProcess(&persistContext);
+    }
+}
+
+
+static void check_restore(const char * name, uint32_t wordA, uint32_t wordB)
+{
+    uint32_t writes;
+
+    reset();
+    host_access = (host_access_t){0};
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_PersistRestore(&persistContext), name);
+    writes = host_access.csdWrite;
+    printf("%-22s IDACA 0x%08X, IDACB 0x%08X, %u CSD writes, %u register accesses\n", name,
+           HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA), HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB), writes,
+           host_access_total());
+    expect((wordA == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)) && (wordB == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB)), name);
+}
+
+
+int main(void)
+{
+    uint32_t wordA;
+    uint32_t wordB;
+    uint32_t rowMin;
+    uint32_t rowMax;
+    uint32_t i;
+
+    (void)memset(flashArea, 0xFF, sizeof(flashArea));
+    reset();
+    expect((0u == persistContext.storedWord[0]) && (0u == persistContext.storedWord[1]), "empty area has a record");
+
+    /* A burst of changes is one record after the hold-off */
+    for (i = 0u; i < BURST_CHANGES; i++)
+    {
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, (int32_t)(1000u + (i * 300u)), &idacContext);
+        (void)Cy_CSDIDAC_PersistProcess(&persistContext);
+    }
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, -48000, &idacContext);
+    expect(0u == persistContext.writeCnt, "write during the burst");
+    hold();
+    hold();
+    printf("burst:                 %u changes, %u row writes\n", BURST_CHANGES + 1u, persistContext.writeCnt);
+    expect(1u == persistContext.writeCnt, "burst not coalesced into one record");
+    wordA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    wordB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    check_restore("restore after reset", wordA, wordB);
+
+    /* An unchanged operating point is not written again */
+    hold();
+    expect(0u == persistContext.writeCnt, "unchanged operating point written");
+
+    /* The wear levelling across the sequence number wraparound */
+    persistContext.sequence = 0xFFFFFF00u;
+    (void)memset(rowWrites, 0, sizeof(rowWrites));
+    for (i = 0u; i < WEAR_RECORDS; i++)
+    {
+        (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_600_IDX,
+                                         1u + (i % CY_CSDIDAC_MAX_CODE), &idacContext);
+        hold();
+    }
+    rowMin = rowWrites[0];
+    rowMax = rowWrites[0];
+    for (i = 1u; i < ROW_NUM; i++)
+    {
+        rowMin = (rowWrites[i] < rowMin) ? rowWrites[i] : rowMin;
+        rowMax = (rowWrites[i] > rowMax) ? rowWrites[i] : rowMax;
+    }
+    printf("wear levelling:        %u records, %u..%u writes per row of %u, sequence 0x%08X\n",
+           persistContext.writeCnt, rowMin, rowMax, ROW_NUM, persistContext.sequence);
+    expect((WEAR_RECORDS == persistContext.writeCnt) && (1u >= (rowMax - rowMin)), "wear levelling");
+    wordA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    wordB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    check_restore("restore after wrap", wordA, wordB);
+
+    /* A row write cut by a reset, the previous record is restored */
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 333000, &idacContext);
+    writeMode = WRITE_TORN;
+    (void)Cy_CSDIDAC_PersistFlush(&persistContext);
+    writeMode = WRITE_OK;
+    check_restore("restore after torn", wordA, wordB);
+
+    /* A failed write is retried after the next hold-off */
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, -96000, &idacContext);
+    wordB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    writeMode = WRITE_FAIL;
+    hold();
+    expect(0u == persistContext.writeCnt, "failed write counted");
+    writeMode = WRITE_OK;
+    hold();
+    expect(1u == persistContext.writeCnt, "failed write not retried");
+    check_restore("restore after retry", wordA, wordB);
+
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
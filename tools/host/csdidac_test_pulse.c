@@ -0,0 +1,299 @@
+/***************************************************************************//**
+* \file csdidac_test_pulse.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC pulsed-current mode on a simulated timer. The
+* timer counter is a 64-bit tick count masked to
+* CY_CSDIDAC_PULSE_TIME_MASK, and the compare interrupt calls
+* Cy_CSDIDAC_PulseProcess() after a fixed latency. The main loop does
+* random work and calls Cy_CSDIDAC_PulseSleep(), whose sleep the
+* host_sleep_hook stand-in of Cy_SysPm_CpuEnterSleep() ends at the
+* scheduled compare.
+*
+* The test checks the pulse edges and counters of each train and the
+* residency statistics: sleepTicks is the simulated sleep time, runTicks
+* is the time from the start of the trains to the edge interrupt after they
+* end, and the active time runTicks - sleepTicks is the simulated time
+* the CPU was awake in between.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_pulse \
+*            tools/host/csdidac_test_pulse.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_pulse.c -lpthread
+* Usage:  csdidac_test_pulse [<seed>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_pulse.h"
+
+/* The compare interrupt latency and the execution time of the edge interrupt in the timer ticks */
+#define ISR_LATENCY_TICKS           (2u)
+#define ISR_COST_TICKS              (5u)
+
+/* The longest main loop work between the sleeps in the timer ticks */
+#define WORK_TICKS_MAX              (300u)
+
+/* The most recorded edges of a train */
+#define EDGE_MAX                    (4096u)
+
+typedef struct
+{
+    uint64_t time[EDGE_MAX];                /* The simulated time of the edge store */
+    uint32_t word[EDGE_MAX];                /* The stored IDAC register word */
+    uint32_t num;
+    uint32_t last;
+} edge_log_t;
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_pulse_context_t pulseContext;
+static uint64_t simTime;
+static uint64_t fireAt;
+static int armed;
+static uint64_t sleepTotal;
+static uint64_t lastProcess;
+static edge_log_t edges[CY_CSDIDAC_PULSE_CH_NUM];
+
+
+static uint32_t timer_read(void)
+{
+    return ((uint32_t)simTime & CY_CSDIDAC_PULSE_TIME_MASK);
+}
+
+
+static void timer_schedule(uint32_t edgeTime)
+{
+    fireAt = simTime + ((edgeTime - timer_read()) & CY_CSDIDAC_PULSE_TIME_MASK);
+    armed = 1;
+}
+
+
+/* The stand-in of Cy_SysPm_CpuEnterSleep(), the CPU wakes at the compare interrupt */
+static void sleep_until_compare(void)
+{
+    if ((0 != armed) && (fireAt > simTime))
+    {
+        sleepTotal += fireAt - simTime;
+        simTime = fireAt;
+    }
+}
+
+
+static void log_edge(uint32_t idx, uint32_t offset)
+{
+    edge_log_t * log = &edges[idx];
+    uint32_t word = HOST_CSD_REG(offset);
+
+    if ((word != log->last) && (log->num < EDGE_MAX))
+    {
+        log->time[log->num] = simTime;
+        log->word[log->num] = word;
+        log->num++;
+    }
+    log->last = word;
+}
+
+
+static void compare_isr(void)
+{
+    armed = 0;
+    simTime = fireAt + ISR_LATENCY_TICKS;
+    lastProcess = simTime;
+    Cy_CSDIDAC_PulseProcess(&pulseContext);
+    log_edge(0u, CY_CSD_REG_OFFSET_IDACA);
+    log_edge(1u, CY_CSD_REG_OFFSET_IDACB);
+    simTime += ISR_COST_TICKS;
+}
+
+
+/* The main loop work, preempted by the compare interrupts */
+static void work(uint32_t ticks)
+{
+    uint64_t end = simTime + ticks;
+
+    while ((0 != armed) && (fireAt <= end))
+    {
+        simTime = fireAt;
+        compare_isr();
+        end += ISR_LATENCY_TICKS + ISR_COST_TICKS;
+    }
+    simTime = end;
+}
+
+
+static void main_loop_until(int (* done)(void))
+{
+    while (0 == done())
+    {
+        work(1u + ((uint32_t)rand() % WORK_TICKS_MAX));
+        Cy_CSDIDAC_PulseSleep(&pulseContext);
+        if ((0 != armed) && (fireAt <= simTime))
+        {
+            compare_isr();
+        }
+    }
+}
+
+
+static int trains_done(void)
+{
+    return (false == pulseContext.scheduled);
+}
+
+
+static uint64_t stopAt;
+
+static int stop_time(void)
+{
+    return (simTime >= stopAt);
+}
+
+
+/* Checks the edges of a train of count pulses from the first edge on */
+static int check_edges(uint32_t idx, uint32_t width, uint32_t period, uint32_t count)
+{
+    const edge_log_t * log = &edges[idx];
+    int failed = 0;
+    uint32_t i;
+
+    if ((2u * count) != log->num)
+    {
+        printf("train %u: %u edges, %u expected\n", idx, log->num, 2u * count);
+        failed = 1;
+    }
+    for (i = 0u; (i < log->num) && (0 == failed); i++)
+    {
+        if ((log->time[i] - log->time[0]) !=
+            (((uint64_t)(i / 2u) * period) + ((0u != (i & 1u)) ? width : 0u)))
+        {
+            printf("train %u: edge %u at %llu\n", idx, i, (unsigned long long)(log->time[i] - log->time[0]));
+            failed = 1;
+        }
+    }
+    return (failed);
+}
+
+
+/* Checks the residency statistics of a run started at startTime */
+static int check_residency(const char * name, uint64_t startTime, uint64_t sleepStart)
+{
+    uint64_t run = lastProcess - startTime;
+    uint64_t sleep = sleepTotal - sleepStart;
+    uint32_t active = pulseContext.runTicks - pulseContext.sleepTicks;
+    int failed = 0;
+
+    printf("%s: run %lu ticks, sleep %lu ticks in %lu sleeps, active %lu ticks (%.1f%%)\n", name,
+           (unsigned long)pulseContext.runTicks, (unsigned long)pulseContext.sleepTicks,
+           (unsigned long)pulseContext.sleepCnt, (unsigned long)active,
+           (0u != pulseContext.runTicks) ? ((100.0 * active) / pulseContext.runTicks) : 0.0);
+    if ((run != pulseContext.runTicks) || (sleep != pulseContext.sleepTicks) ||
+        (pulseContext.sleepTicks > pulseContext.runTicks))
+    {
+        printf("%s: expected run %llu, sleep %llu\n", name, (unsigned long long)run, (unsigned long long)sleep);
+        failed = 1;
+    }
+    return (failed);
+}
+
+
+static void reset_run(void)
+{
+    uint32_t i;
+
+    (void)Cy_CSDIDAC_PulseInit(&timer_schedule, &timer_read, &idacContext, &pulseContext);
+    for (i = 0u; i < CY_CSDIDAC_PULSE_CH_NUM; i++)
+    {
+        edges[i].num = 0u;
+        edges[i].last = 0u;
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    uint64_t startTime;
+    uint64_t sleepStart;
+    int failed = 0;
+
+    srand((argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 0) : 1u);
+    host_reset();
+    host_sleep_hook = &sleep_until_compare;
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    simTime = 0xFFF0u;
+
+    /* A train of 500 pulses across many timer counter wraps */
+    reset_run();
+    startTime = simTime;
+    sleepStart = sleepTotal;
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_PulseStart(CY_CSDIDAC_A, 500000, 400u, 3000u, 500u, &pulseContext))
+    {
+        fprintf(stderr, "start failed\n");
+        return (1);
+    }
+    main_loop_until(&trains_done);
+    failed |= check_edges(0u, 400u, 3000u, 500u);
+    if ((500u != pulseContext.train[0].pulseCnt) || ((500u * 400u) != pulseContext.train[0].onTicks))
+    {
+        printf("train 0: %lu pulses, %lu on ticks\n", (unsigned long)pulseContext.train[0].pulseCnt,
+               (unsigned long)pulseContext.train[0].onTicks);
+        failed = 1;
+    }
+    failed |= check_residency("finite train", startTime, sleepStart);
+
+    /* Two trains, the endless one is stopped in the middle of a pulse */
+    reset_run();
+    startTime = simTime;
+    sleepStart = sleepTotal;
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_PulseStart(CY_CSDIDAC_A, -300000, 100u, 1000u, 0u, &pulseContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_PulseStart(CY_CSDIDAC_B, 60000, 700u, 2500u, 40u, &pulseContext)))
+    {
+        fprintf(stderr, "start failed\n");
+        return (1);
+    }
+    stopAt = startTime + 50000u;
+    main_loop_until(&stop_time);
+    while (false == pulseContext.train[0].on)
+    {
+        work(1u);
+    }
+    (void)Cy_CSDIDAC_PulseStop(CY_CSDIDAC_A, &pulseContext);
+    main_loop_until(&trains_done);
+    failed |= check_edges(1u, 700u, 2500u, 40u);
+    failed |= check_residency("stopped train", startTime, sleepStart);
+
+    /* A train stopped right after the start, the run is the sleep until the first edge */
+    reset_run();
+    startTime = simTime;
+    sleepStart = sleepTotal;
+    (void)Cy_CSDIDAC_PulseStart(CY_CSDIDAC_A, 500000, 400u, 3000u, 0u, &pulseContext);
+    (void)Cy_CSDIDAC_PulseStop(CY_CSDIDAC_A, &pulseContext);
+    Cy_CSDIDAC_PulseSleep(&pulseContext);
+    compare_isr();
+    failed |= check_residency("immediate stop", startTime, sleepStart);
+
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
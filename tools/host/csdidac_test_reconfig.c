@@ -0,0 +1,273 @@
+/***************************************************************************//**
+* \file csdidac_test_reconfig.c
+* \version 2.10
+*
+* \brief
+* Host test of the make-before-break migration of Cy_CSDIDAC_ReconfigureChannel().
+* The IDAC, bypass switch and HSIOM register state is sampled by the hooks
+* of the model after every CSD register write and before every GPIO and
+* HSIOM register access, and once after the call, so every store is in the
+* recorded timeline of the distinct states. With both the channels enabled,
+* one channel is moved between the pins of one port, the pins of two ports,
+* the AMUX bus and back, and the test checks for every state:
+* - make-before-break: the moved channel always has a path, its IDAC word
+*   and bypass switch are kept and, between two pins, the new pin is
+*   connected before the old pin is disconnected,
+* - the other channel keeps its IDAC word, bypass switch and pin,
+* - the overlap window of two GPIO pins, where both carry the current, is
+*   within one state: the store that connects the new pin is followed by
+*   the store that disconnects the old one.
+* A disabled channel is also moved, which must store nothing.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_reconfig \
+*            tools/host/csdidac_test_reconfig.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_reconfig
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+/* The watched pins */
+#define PIN_NUM                     (5u)
+
+/* The most recorded states of a call */
+#define STATE_LOG_SIZE              (64u)
+
+/* The sampled register state */
+typedef struct
+{
+    uint32_t idacA;
+    uint32_t idacB;
+    uint32_t bypass;
+    uint32_t hsiomSel[PIN_NUM];
+} route_state_t;
+
+static const cy_stc_csdidac_pin_t pins[PIN_NUM] =
+{
+    {&host_gpio_ports[0], 1u}, {&host_gpio_ports[0], 2u}, {&host_gpio_ports[0], 3u},
+    {&host_gpio_ports[1], 4u}, {&host_gpio_ports[2], 6u},
+};
+
+static cy_stc_csdidac_context_t idacContext;
+static route_state_t stateLog[STATE_LOG_SIZE];
+static uint32_t stateNum;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static void sample(route_state_t * state)
+{
+    uint32_t i;
+
+    state->idacA = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+    state->idacB = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB);
+    state->bypass = HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL);
+    for (i = 0u; i < PIN_NUM; i++)
+    {
+        state->hsiomSel[i] = (host_hsiom_ports[pins[i].ioPcPtr - host_gpio_ports].PORT_SEL >>
+                              ((uint32_t)pins[i].pin << CY_GPIO_HSIOM_OFFSET)) & CY_GPIO_HSIOM_MASK;
+    }
+}
+
+
+/* Records the state if it differs from the last recorded one */
+static void record(void)
+{
+    route_state_t state;
+
+    sample(&state);
+    if ((0u == stateNum) || (0 != memcmp(&state, &stateLog[stateNum - 1u], sizeof(state))))
+    {
+        if (stateNum < STATE_LOG_SIZE)
+        {
+            stateLog[stateNum] = state;
+        }
+        stateNum++;
+    }
+}
+
+
+static void csd_write_hook(uint32_t block, uint32_t offset, uint32_t value)
+{
+    (void)block;
+    (void)offset;
+    (void)value;
+    record();
+}
+
+
+static void gpio_hook(volatile uint32_t * reg)
+{
+    (void)reg;
+    record();
+}
+
+
+/* The routing of a channel: the configuration and the index of its pin */
+typedef struct
+{
+    cy_en_csdidac_channel_config_t config;
+    uint32_t pin;
+} channel_route_t;
+
+
+static int pin_connected(const route_state_t * state, const channel_route_t * route, uint32_t hsiomSel)
+{
+    return ((CY_CSDIDAC_GPIO == route->config) && (hsiomSel == state->hsiomSel[route->pin]));
+}
+
+
+/* Moves an enabled or disabled channel and checks the recorded states */
+static void check_move(const char * name, cy_en_csdidac_choice_t ch, channel_route_t * own,
+                       const channel_route_t * next, const channel_route_t * other)
+{
+    const uint32_t ownBypass = (CY_CSDIDAC_A == ch) ? CY_CSDIDAC_SW_BYPA_ENABLE : CY_CSDIDAC_SW_BYPB_ENABLE;
+    const uint32_t otherBypass = (CY_CSDIDAC_A == ch) ? CY_CSDIDAC_SW_BYPB_ENABLE : CY_CSDIDAC_SW_BYPA_ENABLE;
+    const uint32_t ownSel = (CY_CSDIDAC_A == ch) ? HSIOM_SEL_AMUXA : HSIOM_SEL_AMUXB;
+    const uint32_t otherSel = (CY_CSDIDAC_A == ch) ? HSIOM_SEL_AMUXB : HSIOM_SEL_AMUXA;
+    const int enabled = (0u != (ownBypass & HOST_CSD_REG(CY_CSD_REG_OFFSET_SW_BYP_SEL)));
+    cy_en_csdidac_status_t status;
+    route_state_t start;
+    const route_state_t * state;
+    uint32_t offStates = 0u;
+    uint32_t overlapStates = 0u;
+    uint32_t otherChanged = 0u;
+    uint32_t ownChanged = 0u;
+    uint32_t firstMake = STATE_LOG_SIZE;
+    uint32_t firstBreak = STATE_LOG_SIZE;
+    uint32_t i;
+    int oldOn;
+    int newOn;
+
+    sample(&start);
+    stateNum = 0u;
+    record();
+    host_csd_write_hook = &csd_write_hook;
+    host_gpio_hook = &gpio_hook;
+    status = Cy_CSDIDAC_ReconfigureChannel(ch, next->config, (CY_CSDIDAC_GPIO == next->config) ? &pins[next->pin] : NULL,
+                                           &idacContext);
+    host_csd_write_hook = NULL;
+    host_gpio_hook = NULL;
+    record();
+    expect((CY_CSDIDAC_SUCCESS == status) && (stateNum <= STATE_LOG_SIZE), name);
+
+    for (i = 0u; (i < stateNum) && (i < STATE_LOG_SIZE); i++)
+    {
+        state = &stateLog[i];
+        oldOn = pin_connected(state, own, ownSel);
+        newOn = pin_connected(state, next, ownSel);
+        if ((CY_CSDIDAC_A == ch) ? (state->idacA != start.idacA) : (state->idacB != start.idacB))
+        {
+            ownChanged++;
+        }
+        if (((CY_CSDIDAC_A == ch) ? (state->idacB != start.idacB) : (state->idacA != start.idacA)) ||
+            ((state->bypass & otherBypass) != (start.bypass & otherBypass)) ||
+            ((CY_CSDIDAC_GPIO == other->config) && (state->hsiomSel[other->pin] != otherSel)))
+        {
+            otherChanged++;
+        }
+        if ((0 != enabled) &&
+            ((0u == (state->bypass & ownBypass)) ||
+             ((CY_CSDIDAC_AMUX != own->config) && (CY_CSDIDAC_AMUX != next->config) && (0 == oldOn) && (0 == newOn))))
+        {
+            offStates++;
+        }
+        if ((0 != oldOn) && (0 != newOn) && (own->pin != next->pin))
+        {
+            overlapStates++;
+        }
+        if ((0 != newOn) && (STATE_LOG_SIZE == firstMake))
+        {
+            firstMake = i;
+        }
+        if ((0 == oldOn) && (STATE_LOG_SIZE == firstBreak))
+        {
+            firstBreak = i;
+        }
+    }
+
+    expect(0u == ownChanged, "IDAC word of the moved channel kept");
+    expect(0u == otherChanged, "other channel kept");
+    if (0 != enabled)
+    {
+        expect(0u == offStates, "moved channel always has a path");
+        expect(1u >= overlapStates, "overlap window within one state");
+        expect((CY_CSDIDAC_GPIO != own->config) || (CY_CSDIDAC_GPIO != next->config) ||
+               (firstMake < firstBreak), "new pin connected before the old one is disconnected");
+        expect((CY_CSDIDAC_GPIO != next->config) || (0 != pin_connected(&stateLog[stateNum - 1u], next, ownSel)),
+               "new pin connected");
+        expect((CY_CSDIDAC_GPIO != own->config) || (own->pin == next->pin) ||
+               (0 == pin_connected(&stateLog[stateNum - 1u], own, ownSel)), "old pin disconnected");
+    }
+    else
+    {
+        expect(1u == stateNum, "disabled channel moved without a store");
+    }
+    printf("%-30s %2u stores, %u overlap, %u off\n", name, stateNum - 1u, overlapStates, offStates);
+    *own = *next;
+}
+
+
+int main(void)
+{
+    static cy_stc_csd_context_t csdContext;
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pins[0], &pins[1], 48000000u, 10u
+    };
+    static const channel_route_t pinA0 = {CY_CSDIDAC_GPIO, 0u};
+    static const channel_route_t pinA1 = {CY_CSDIDAC_GPIO, 2u};
+    static const channel_route_t pinA2 = {CY_CSDIDAC_GPIO, 3u};
+    static const channel_route_t busA = {CY_CSDIDAC_AMUX, 0u};
+    static const channel_route_t pinB0 = {CY_CSDIDAC_GPIO, 1u};
+    static const channel_route_t pinB1 = {CY_CSDIDAC_GPIO, 4u};
+    channel_route_t routeA = pinA0;
+    channel_route_t routeB = pinB0;
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 2400, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, -4800, &idacContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    check_move("A: pin to pin of the port", CY_CSDIDAC_A, &routeA, &pinA1, &routeB);
+    check_move("A: pin to pin of a port", CY_CSDIDAC_A, &routeA, &pinA2, &routeB);
+    check_move("A: pin to AMUX", CY_CSDIDAC_A, &routeA, &busA, &routeB);
+    check_move("A: AMUX to pin", CY_CSDIDAC_A, &routeA, &pinA0, &routeB);
+    check_move("B: pin to pin of a port", CY_CSDIDAC_B, &routeB, &pinB1, &routeA);
+    check_move("B: same pin", CY_CSDIDAC_B, &routeB, &pinB1, &routeA);
+
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_B, &idacContext);
+    check_move("B: disabled, pin to pin", CY_CSDIDAC_B, &routeB, &pinB0, &routeA);
+    expect((CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_B, -4800, &idacContext)) &&
+           (HSIOM_SEL_AMUXB == ((host_hsiom_ports[0].PORT_SEL >> (2u << CY_GPIO_HSIOM_OFFSET)) & CY_GPIO_HSIOM_MASK)),
+           "moved disabled channel enabled on its new pin");
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,243 @@
+/***************************************************************************//**
+* \file csdidac_test_reg.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the CSDIDAC closed-loop current regulator on the RC
+* load model of csdidac_rcload.c. The regulator runs with the loop divider
+* of 1, so every Cy_CSDIDAC_RegProcess() call is a control update.
+*
+* For a start from the discharged load and for two target steps, the
+* benchmark reports the convergence time, the number of updates until the
+* error stays within the tolerance, and the overshoot in the direction of
+* the step. It then reports the
+* update cost: the time and the register accesses per update, with and
+* without an output change, and the time of the model sense call alone.
+*
+* Target and sense voltages that do not fit int32_t are then checked: the
+* regulator must drive the output to the full scale for a target above the
+* sense voltage and to zero for a sense voltage above the target.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_reg \
+*            tools/host/csdidac_test_reg.c tools/host/csdidac_rcload.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_reg.c -lpthread
+* Usage:  csdidac_test_reg [<load kOhm> [<tau shift> [<kp> [<ki>]]]]
+*
+* The gains are in nA/mV in the Q8 format of cy_stc_csdidac_reg_config_t.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "csdidac_host.h"
+#include "csdidac_rcload.h"
+#include "cy_csdidac_reg.h"
+
+/* The updates of a convergence run */
+#define RUN_UPDATES                 (4000u)
+
+/* The settled error band in mV */
+#define TOLERANCE_MV                (2)
+
+/* The updates of the cost measurement */
+#define COST_UPDATES                (1000000u)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_reg_context_t regContext;
+static rcload_t load;
+static uint32_t fakeSenseMv;
+static int failed;
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static cy_en_csdidac_status_t fake_sense(void * userData, uint32_t * senseMv)
+{
+    (void)userData;
+    *senseMv = fakeSenseMv;
+    return (CY_CSDIDAC_SUCCESS);
+}
+
+
+/* Runs the regulator to the target and reports the convergence */
+static void converge(const char * name, uint32_t targetMv)
+{
+    uint32_t startMv = ((load.voltage >> load.tauShift) + 500u) / 1000u;
+    uint32_t settled = 0u;
+    int32_t overshoot = 0;
+    int32_t beyond;
+    uint32_t i;
+    int32_t error;
+
+    (void)Cy_CSDIDAC_RegSetTarget(targetMv, &regContext);
+    for (i = 0u; i < RUN_UPDATES; i++)
+    {
+        if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_RegProcess(&regContext))
+        {
+            printf("%s: update %u failed\n", name, i);
+            failed = 1;
+        }
+        error = regContext.errorMv;
+        if ((TOLERANCE_MV < error) || (-TOLERANCE_MV > error))
+        {
+            settled = i + 1u;
+        }
+        /* The sense voltage beyond the target in the direction of the step */
+        beyond = (startMv < targetMv) ? -error : error;
+        if (beyond > overshoot)
+        {
+            overshoot = beyond;
+        }
+    }
+    printf("%-20s target %4u mV, settled within %d mV after %4u updates (%.1f time constants), "
+           "overshoot %d mV, output %u nA\n", name, targetMv, TOLERANCE_MV, settled,
+           (double)settled / (double)(1u << load.tauShift), overshoot, regContext.outputNa);
+    if (RUN_UPDATES <= settled)
+    {
+        printf("%s: not settled\n", name);
+        failed = 1;
+    }
+}
+
+
+/* Reports the time and the register accesses per update */
+static void cost(void)
+{
+    cy_stc_csdidac_reg_config_t config = regContext.cfgCopy;
+    uint32_t senseMv;
+    uint32_t changes = 0u;
+    uint32_t accesses;
+    uint32_t i;
+    double start;
+    double regTime;
+    double senseTime;
+
+    /* The steady state, the output current is mostly unchanged */
+    host_access = (host_access_t){0};
+    start = now_s();
+    for (i = 0u; i < COST_UPDATES; i++)
+    {
+        (void)Cy_CSDIDAC_RegProcess(&regContext);
+    }
+    regTime = now_s() - start;
+    accesses = host_access_total();
+
+    start = now_s();
+    for (i = 0u; i < COST_UPDATES; i++)
+    {
+        (void)rcload_sense(&load, &senseMv);
+    }
+    senseTime = now_s() - start;
+    printf("steady update:       %.1f ns, %.2f register accesses, model sense %.1f ns\n",
+           (regTime * 1e9) / COST_UPDATES, (double)accesses / COST_UPDATES,
+           (senseTime * 1e9) / COST_UPDATES);
+
+    /* Every update changes the output, the sense voltage alternates around the target */
+    config.senseFunc = &fake_sense;
+    (void)Cy_CSDIDAC_RegInit(&config, &idacContext, &regContext);
+    host_access = (host_access_t){0};
+    start = now_s();
+    for (i = 0u; i < COST_UPDATES; i++)
+    {
+        fakeSenseMv = config.targetMv + (((i & 1u) != 0u) ? 50u : 0u) - 25u;
+        accesses = regContext.outputNa;
+        (void)Cy_CSDIDAC_RegProcess(&regContext);
+        changes += (accesses != regContext.outputNa) ? 1u : 0u;
+    }
+    regTime = now_s() - start;
+    accesses = host_access_total();
+    printf("changing update:     %.1f ns, %.2f register accesses, %u of %u updates changed the output\n",
+           (regTime * 1e9) / COST_UPDATES, (double)accesses / COST_UPDATES, changes, COST_UPDATES);
+}
+
+
+/* Checks the target and sense voltages that do not fit int32_t */
+static void check_range(void)
+{
+    cy_stc_csdidac_reg_config_t config = regContext.cfgCopy;
+    uint32_t i;
+
+    config.senseFunc = &fake_sense;
+    (void)Cy_CSDIDAC_RegInit(&config, &idacContext, &regContext);
+    (void)Cy_CSDIDAC_RegSetTarget(0xFFFFFFFFu, &regContext);
+    fakeSenseMv = 100u;
+    for (i = 0u; i < 2000u; i++)
+    {
+        (void)Cy_CSDIDAC_RegProcess(&regContext);
+    }
+    printf("target 0xFFFFFFFF:   error %d mV, output %u nA\n", regContext.errorMv, regContext.outputNa);
+    if ((CY_CSDIDAC_REG_MAX_ERROR_MV != regContext.errorMv) || (CY_CSDIDAC_MAX_CURRENT_NA != regContext.outputNa))
+    {
+        failed = 1;
+    }
+
+    (void)Cy_CSDIDAC_RegSetTarget(100u, &regContext);
+    fakeSenseMv = 0x80000010u;
+    for (i = 0u; i < 2000u; i++)
+    {
+        (void)Cy_CSDIDAC_RegProcess(&regContext);
+    }
+    printf("sense 0x80000010:    error %d mV, output %u nA\n", regContext.errorMv, regContext.outputNa);
+    if ((-CY_CSDIDAC_REG_MAX_ERROR_MV != regContext.errorMv) || (0u != regContext.outputNa))
+    {
+        failed = 1;
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    cy_stc_csdidac_reg_config_t regConfig =
+    {
+        CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, 0u, 64u << CY_CSDIDAC_REG_GAIN_SHIFT, 4u << CY_CSDIDAC_REG_GAIN_SHIFT,
+        1u, &rcload_sense, &load
+    };
+    uint32_t loadKohm = (argc > 1) ? (uint32_t)atoi(argv[1]) : 2u;
+    uint32_t tauShift = (argc > 2) ? (uint32_t)atoi(argv[2]) : 6u;
+
+    regConfig.kp = (argc > 3) ? (uint32_t)atoi(argv[3]) : regConfig.kp;
+    regConfig.ki = (argc > 4) ? (uint32_t)atoi(argv[4]) : regConfig.ki;
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != rcload_init(CY_CSDIDAC_A, loadKohm, tauShift, &idacContext, &load)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_RegInit(&regConfig, &idacContext, &regContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    printf("load %u kOhm, time constant %u updates, kp %u/256, ki %u/256 nA/mV\n",
+           loadKohm, 1u << tauShift, regConfig.kp, regConfig.ki);
+
+    converge("start", 100u);
+    converge("step up", 300u);
+    converge("step down", 50u);
+    cost();
+    check_range();
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,271 @@
+/***************************************************************************//**
+* \file csdidac_test_route.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC port-batched pin routing. Random batches of
+* pin changes on two ports are applied with Cy_CSDIDAC_RouteBatchApply()
+* and with the per-pin reference, Cy_GPIO_SetDrivemode() and
+* Cy_GPIO_SetHSIOM() for each pin in the order of the batch, from the same
+* random port registers. The PC, PC2, and HSIOM PORT_SEL registers of
+* all the ports must be the same, and the GPIO register accesses of both
+* are reported per pin count.
+*
+* The connect and disconnect of both the channels with the pins on one
+* port through Cy_CSDIDAC_OutputEnable() and Cy_CSDIDAC_OutputDisable()
+* are then measured against the accesses of the per-pin reference.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_route \
+*            tools/host/csdidac_test_route.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_route [<batches> [<seed>]]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_route.h"
+
+/* The most pin changes of a random batch, all the pins of both the ports */
+#define PIN_CHANGE_MAX              (2u * CY_GPIO_PINS_MAX)
+
+typedef struct
+{
+    GPIO_PRT_Type gpio[HOST_PORT_NUM];
+    HSIOM_PRT_Type hsiom[HOST_PORT_NUM];
+} port_regs_t;
+
+typedef struct
+{
+    cy_stc_csdidac_pin_t pin;
+    uint32_t driveMode;
+    en_hsiom_sel_t hsiomSel;
+} pin_change_t;
+
+/* The accesses of the batched and reference updates per pin count */
+typedef struct
+{
+    unsigned long batches;
+    unsigned long batchAccess;
+    unsigned long refAccess;
+} access_row_t;
+
+static cy_stc_csdidac_context_t idacContext;
+static access_row_t rows[PIN_CHANGE_MAX + 1u];
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static void regs_save(port_regs_t * regs)
+{
+    (void)memcpy(regs->gpio, host_gpio_ports, sizeof(regs->gpio));
+    (void)memcpy(regs->hsiom, host_hsiom_ports, sizeof(regs->hsiom));
+}
+
+
+static void regs_load(const port_regs_t * regs)
+{
+    (void)memcpy(host_gpio_ports, regs->gpio, sizeof(regs->gpio));
+    (void)memcpy(host_hsiom_ports, regs->hsiom, sizeof(regs->hsiom));
+}
+
+
+static int regs_equal(const port_regs_t * a, const port_regs_t * b)
+{
+    int equal = 1;
+    uint32_t i;
+
+    for (i = 0u; i < HOST_PORT_NUM; i++)
+    {
+        if ((a->gpio[i].PC != b->gpio[i].PC) || (a->gpio[i].PC2 != b->gpio[i].PC2) ||
+            (a->hsiom[i].PORT_SEL != b->hsiom[i].PORT_SEL))
+        {
+            equal = 0;
+        }
+    }
+    return (equal);
+}
+
+
+static uint32_t gpio_access(void)
+{
+    return (host_access.gpioRead + host_access.gpioWrite);
+}
+
+
+/* Fills the pin changes of a random batch, the same pin can change twice */
+static uint32_t random_changes(pin_change_t * change)
+{
+    static const en_hsiom_sel_t hsiomSel[] = {HSIOM_SEL_GPIO, HSIOM_SEL_AMUXA, HSIOM_SEL_AMUXB};
+    static const uint32_t driveMode[] =
+    {
+        CY_CSDIDAC_ROUTE_DM_KEEP, CY_GPIO_DM_ANALOG, CY_GPIO_DM_PULLUP, CY_GPIO_DM_STRONG_IN_OFF
+    };
+    uint32_t num = 1u + ((uint32_t)rand() % PIN_CHANGE_MAX);
+    uint32_t i;
+
+    for (i = 0u; i < num; i++)
+    {
+        change[i].pin.ioPcPtr = &host_gpio_ports[(uint32_t)rand() & 1u];
+        change[i].pin.pin = (uint8_t)((uint32_t)rand() % CY_GPIO_PINS_MAX);
+        change[i].driveMode = driveMode[(uint32_t)rand() % (sizeof(driveMode) / sizeof(driveMode[0]))];
+        change[i].hsiomSel = hsiomSel[(uint32_t)rand() % (sizeof(hsiomSel) / sizeof(hsiomSel[0]))];
+    }
+    return (num);
+}
+
+
+static void random_regs(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < HOST_PORT_NUM; i++)
+    {
+        host_gpio_ports[i].PC = (uint32_t)rand() & 0x00FFFFFFuL;
+        host_gpio_ports[i].PC2 = (uint32_t)rand() & 0xFFuL;
+        host_hsiom_ports[i].PORT_SEL = ((uint32_t)rand() << 1u) ^ (uint32_t)rand();
+    }
+}
+
+
+/* Applies a random batch both ways and compares the registers */
+static void check_batch(void)
+{
+    pin_change_t change[PIN_CHANGE_MAX];
+    cy_stc_csdidac_route_batch_t batch;
+    port_regs_t start;
+    port_regs_t ref;
+    port_regs_t batched;
+    uint32_t num = random_changes(change);
+    uint32_t access;
+    uint32_t i;
+
+    random_regs();
+    regs_save(&start);
+    access = gpio_access();
+    for (i = 0u; i < num; i++)
+    {
+        if (CY_CSDIDAC_ROUTE_DM_KEEP != change[i].driveMode)
+        {
+            Cy_GPIO_SetDrivemode(change[i].pin.ioPcPtr, (uint32_t)change[i].pin.pin, change[i].driveMode);
+        }
+        Cy_GPIO_SetHSIOM(change[i].pin.ioPcPtr, (uint32_t)change[i].pin.pin, change[i].hsiomSel);
+    }
+    rows[num].refAccess += gpio_access() - access;
+    regs_save(&ref);
+
+    regs_load(&start);
+    (void)Cy_CSDIDAC_RouteBatchInit(&batch);
+    for (i = 0u; i < num; i++)
+    {
+        expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_RouteBatchAdd(&change[i].pin, change[i].driveMode,
+                                                               change[i].hsiomSel, &batch), "batch add");
+    }
+    access = gpio_access();
+    (void)Cy_CSDIDAC_RouteBatchApply(&batch, &idacContext);
+    rows[num].batchAccess += gpio_access() - access;
+    rows[num].batches++;
+    regs_save(&batched);
+
+    if (0 == regs_equal(&ref, &batched))
+    {
+        printf("failed: batch of %u pin changes differs from the per-pin reference\n", num);
+        failed = 1;
+    }
+}
+
+
+/* Measures an output change of both the channels, refAccess is the per-pin reference */
+static void check_output(const char * name, int enable, uint32_t refAccess)
+{
+    uint32_t access = gpio_access();
+
+    if (0 != enable)
+    {
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_AB, 2400, &idacContext);
+    }
+    else
+    {
+        (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    }
+    access = gpio_access() - access;
+    printf("%-24s %2u GPIO accesses, per-pin %2u\n", name, access, refAccess);
+    expect(access < refAccess, name);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long batches = (argc > 1) ? strtoul(argv[1], NULL, 0) : 100000u;
+    unsigned long i;
+    uint32_t refConnect;
+    uint32_t refDisconnect;
+    uint32_t access;
+
+    srand((argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 0) : 1u);
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    /* The per-pin reference of the connect and disconnect of both the channels */
+    access = gpio_access();
+    Cy_GPIO_SetDrivemode(pinA.ioPcPtr, (uint32_t)pinA.pin, CY_GPIO_DM_ANALOG);
+    Cy_GPIO_SetHSIOM(pinA.ioPcPtr, (uint32_t)pinA.pin, HSIOM_SEL_AMUXA);
+    Cy_GPIO_SetDrivemode(pinB.ioPcPtr, (uint32_t)pinB.pin, CY_GPIO_DM_ANALOG);
+    Cy_GPIO_SetHSIOM(pinB.ioPcPtr, (uint32_t)pinB.pin, HSIOM_SEL_AMUXB);
+    refConnect = gpio_access() - access;
+    access = gpio_access();
+    Cy_GPIO_SetHSIOM(pinA.ioPcPtr, (uint32_t)pinA.pin, HSIOM_SEL_GPIO);
+    Cy_GPIO_SetHSIOM(pinB.ioPcPtr, (uint32_t)pinB.pin, HSIOM_SEL_GPIO);
+    refDisconnect = gpio_access() - access;
+    check_output("connect A and B", 1, refConnect);
+    check_output("disconnect A and B", 0, refDisconnect);
+
+    for (i = 0u; i < batches; i++)
+    {
+        check_batch();
+    }
+    printf("pin changes  batches  batched accesses  per-pin accesses\n");
+    for (i = 1u; i <= PIN_CHANGE_MAX; i++)
+    {
+        if (0u != rows[i].batches)
+        {
+            printf("%11lu  %7lu  %16.2f  %16.2f\n", i, rows[i].batches,
+                   (double)rows[i].batchAccess / (double)rows[i].batches,
+                   (double)rows[i].refAccess / (double)rows[i].batches);
+        }
+    }
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
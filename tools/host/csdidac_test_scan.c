@@ -0,0 +1,192 @@
+/***************************************************************************//**
+* \file csdidac_test_scan.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the CSDIDAC time-multiplexed pin scanning. Eight pins
+* are scanned on one port and alternately on two ports. After every
+* Cy_CSDIDAC_ScanProcess() call the test checks that only the current pin
+* is connected to the analog bus and that the IDAC register holds its
+* word, and after Cy_CSDIDAC_ScanStop() that no pin is connected and the
+* code is zero.
+*
+* The test is built with CY_CSDIDAC_PROFILE_EN, and
+* Cy_CSDIDAC_GetProfileTime() is replaced by a nanosecond clock, so the
+* execution time of Cy_CSDIDAC_ScanProcess() and the maximum dead time of
+* the context are in ns. They include the clock reads of the profiling.
+* The maximum times are those of the checked switches, as the long loop
+* is preempted by the host. Reports the switches with a single HSIOM
+* write, the mean execution time and the scan rate of the long loop.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -DCY_CSDIDAC_PROFILE_EN=1u -Itools/host -I. \
+*            -o csdidac_test_scan tools/host/csdidac_test_scan.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_scan.c -lpthread
+* Usage:  csdidac_test_scan [<switches>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_scan.h"
+
+#define SCAN_PIN_NUM                (8u)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_scan_context_t scanContext;
+static cy_stc_csdidac_pin_t pinList[SCAN_PIN_NUM];
+static cy_stc_csdidac_scan_pin_t scanPins[SCAN_PIN_NUM];
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+/* The nanosecond time base of the profiling instead of SysTick */
+uint32_t Cy_CSDIDAC_GetProfileTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint32_t)(((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec) & CY_CSDIDAC_PROFILE_TIME_MASK);
+}
+
+
+static uint32_t hsiom_sel(const cy_stc_csdidac_pin_t * ptrPin)
+{
+    const HSIOM_PRT_Type * hsiom = &host_hsiom_ports[ptrPin->ioPcPtr - host_gpio_ports];
+
+    return ((hsiom->PORT_SEL >> ((uint32_t)ptrPin->pin << CY_GPIO_HSIOM_OFFSET)) & CY_GPIO_HSIOM_MASK);
+}
+
+
+/* Returns the number of the scanned pins connected to the analog bus, connIdx is the last one */
+static uint32_t connected(uint32_t * connIdx)
+{
+    uint32_t num = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < SCAN_PIN_NUM; i++)
+    {
+        if ((uint32_t)HSIOM_SEL_AMUXA == hsiom_sel(&pinList[i]))
+        {
+            *connIdx = i;
+            num++;
+        }
+    }
+    return (num);
+}
+
+
+static void scan(const char * name, uint32_t portNum, unsigned long switches)
+{
+    uint32_t connIdx = 0u;
+    uint32_t processMax;
+    uint32_t deadMax;
+    unsigned long i;
+    unsigned long wrong = 0u;
+    double start;
+    double elapsed;
+
+    for (i = 0u; i < SCAN_PIN_NUM; i++)
+    {
+        pinList[i].ioPcPtr = &host_gpio_ports[1u + (i % portNum)];
+        pinList[i].pin = (uint8_t)(i / portNum);
+        scanPins[i].ptrPin = &pinList[i];
+        scanPins[i].idacWord = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_300_IDX, 10u + (8u * i));
+    }
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_ScanInit(CY_CSDIDAC_A, scanPins, SCAN_PIN_NUM, &idacContext, &scanContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_ScanStart(&scanContext)))
+    {
+        printf("failed: %s start\n", name);
+        failed = 1;
+        return;
+    }
+    expect((1u == connected(&connIdx)) && (0u == connIdx) &&
+           (scanPins[0].idacWord == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)), "first pin connected");
+
+    /* The checked switches */
+    for (i = 0u; i < (4u * SCAN_PIN_NUM); i++)
+    {
+        Cy_CSDIDAC_ScanProcess(&scanContext);
+        if ((1u != connected(&connIdx)) || (connIdx != scanContext.pinIdx) ||
+            (scanPins[connIdx].idacWord != HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)))
+        {
+            wrong++;
+        }
+    }
+    processMax = scanContext.profile.maxTime;
+    deadMax = scanContext.deadTimeMax;
+    expect(0u == wrong, "one pin connected with its word");
+
+    start = now_s();
+    for (i = 0u; i < switches; i++)
+    {
+        Cy_CSDIDAC_ScanProcess(&scanContext);
+    }
+    elapsed = now_s() - start;
+
+    expect(CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_ScanStop(&scanContext), "stop");
+    expect((0u == connected(&connIdx)) &&
+           (0u == (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) & CY_CSDIDAC_IDAC_WORD_CODE_MASK)), "no pin after stop");
+
+    printf("%s:\n", name);
+    printf("  single HSIOM write:   %lu of %lu switches\n", (unsigned long)scanContext.batchedCnt,
+           (unsigned long)scanContext.switchCnt);
+    printf("  ScanProcess:          %.1f ns mean, %lu ns max\n",
+           (double)scanContext.profile.totalTime / (double)scanContext.profile.calls, (unsigned long)processMax);
+    printf("  dead time:            %lu ns max\n", (unsigned long)deadMax);
+    printf("  scan rate:            %.0f switches/s\n", (double)switches / elapsed);
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_A, &idacContext);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_AMUX, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long switches = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000u;
+
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    scan("one port", 1u, switches);
+    scan("two ports", 2u, switches);
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,265 @@
+/***************************************************************************//**
+* \file csdidac_test_seq.c
+* \version 2.10
+*
+* \brief
+* Host runner of the CSDIDAC sequencer profiles. Reads the C array written
+* by csdidac_seqasm, loads it with Cy_CSDIDAC_SeqInit() and calls
+* Cy_CSDIDAC_SeqProcess() once per tick on the register model. After every
+* tick it prints a CSV line: the tick, the sequencer state, the IDACA and
+* IDACB register words and the output currents in nA decoded by
+* Cy_CSDIDAC_GetOutputCurrent(). The run ends at the END instruction, on an
+* error, or after the given number of ticks, for the profiles that loop
+* forever. Channel A and channel B are GPIO channels.
+*
+* Without a file the runner checks itself: a profile in the seqasm output
+* form, with a SET, a SYNC, a WAIT, a RAMP and a LOOP of two iterations, is
+* run and its currents are compared tick by tick with the expected ones.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_seq \
+*            tools/host/csdidac_test_seq.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_seq.c -lpthread
+* Usage:  csdidac_test_seq [<seqasm output.c> [<ticks>]]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_seq.h"
+
+/* The longest profile, as for csdidac_seqasm */
+#define SEQ_MAX_LENGTH              (65536u)
+
+/* The longest seqasm output file, "0xXXu, " and the line indents */
+#define SEQ_MAX_TEXT                (8u * SEQ_MAX_LENGTH)
+
+/* The ticks of a run when not given */
+#define SEQ_DEFAULT_TICKS           (1000u)
+
+/* A tick of the run */
+typedef struct
+{
+    cy_en_csdidac_seq_state_t state;
+    int32_t currentA;                       /* The output current of channel A in nA */
+    int32_t currentB;                       /* The output current of channel B in nA */
+} seq_tick_t;
+
+/*
+* The profile of the self-check, csdidac_seqasm output of:
+*   set a 2400
+*   sync 4800 -4800
+*   wait 2
+*   ramp a 12000 4
+*   loop 2
+*     set b -2400
+*     wait 1
+*     off b
+*     wait 1
+*   endloop
+*   end
+*/
+static const char selfProfile[] =
+    "/* Generated by csdidac_seqasm from profile.txt, 45 bytes */\n"
+    "const uint8_t profile[] =\n"
+    "{\n"
+    "    0x01u, 0x00u, 0x60u, 0x09u, 0x00u, 0x00u, 0x07u, 0xC0u, 0x12u, 0x00u, 0x00u, 0x40u,\n"
+    "    0xEDu, 0xFFu, 0xFFu, 0x04u, 0x02u, 0x00u, 0x03u, 0x00u, 0xE0u, 0x2Eu, 0x00u, 0x00u,\n"
+    "    0x04u, 0x00u, 0x05u, 0x02u, 0x00u, 0x01u, 0x01u, 0xA0u, 0xF6u, 0xFFu, 0xFFu, 0x04u,\n"
+    "    0x01u, 0x00u, 0x02u, 0x01u, 0x04u, 0x01u, 0x00u, 0x06u, 0x00u\n"
+    "};\n";
+
+/* The expected ticks of the self-check profile, a WAIT or a RAMP of n ticks lasts n ticks */
+static const seq_tick_t selfTicks[] =
+{
+    {CY_CSDIDAC_SEQ_RUNNING, 4800, -4800},  /* set a, sync, wait 2 */
+    {CY_CSDIDAC_SEQ_RUNNING, 4800, -4800},
+    {CY_CSDIDAC_SEQ_RUNNING, 6600, -4800},  /* ramp a in 4 steps */
+    {CY_CSDIDAC_SEQ_RUNNING, 8400, -4800},
+    {CY_CSDIDAC_SEQ_RUNNING, 10200, -4800},
+    {CY_CSDIDAC_SEQ_RUNNING, 12000, -4800},
+    {CY_CSDIDAC_SEQ_RUNNING, 12000, -2400}, /* loop, set b, wait 1 */
+    {CY_CSDIDAC_SEQ_RUNNING, 12000, 0},     /* off b, wait 1 */
+    {CY_CSDIDAC_SEQ_RUNNING, 12000, -2400}, /* endloop, set b, wait 1 */
+    {CY_CSDIDAC_SEQ_RUNNING, 12000, 0},     /* off b, wait 1 */
+    {CY_CSDIDAC_SEQ_DONE, 12000, 0},        /* endloop, end */
+};
+
+static uint8_t program[SEQ_MAX_LENGTH];
+static seq_tick_t ticks[SEQ_DEFAULT_TICKS];
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_seq_context_t seqContext;
+
+
+/* Reads the bytes of the C array of seqasm, returns the length or 0 on an error */
+static uint32_t parse_array(const char * text, uint8_t * bytes)
+{
+    const char * pos = strchr(text, '{');
+    uint32_t length = 0u;
+    unsigned long value;
+    char * end;
+
+    while ((NULL != pos) && ('}' != *pos))
+    {
+        pos++;
+        pos += strspn(pos, " \t\r\n");
+        if ('}' != *pos)
+        {
+            value = strtoul(pos, &end, 0);
+            if ((end == pos) || (0xFFu < value) || (SEQ_MAX_LENGTH <= length))
+            {
+                pos = NULL;
+            }
+            else
+            {
+                bytes[length++] = (uint8_t)value;
+                pos = end + strspn(end, "uU \t\r\n");
+                pos = ((',' == *pos) || ('}' == *pos)) ? pos : NULL;
+            }
+        }
+    }
+
+    return ((NULL == pos) ? 0u : length);
+}
+
+
+static int32_t output_current_na(cy_en_csdidac_choice_t ch)
+{
+    int32_t currentPa = 0;
+
+    (void)Cy_CSDIDAC_GetOutputCurrent(ch, &currentPa, &idacContext);
+    return (currentPa / 1000);
+}
+
+
+/* Runs a profile, prints the ticks when out is not NULL, returns the number of the run ticks */
+static uint32_t run(const uint8_t * bytes, uint32_t length, uint32_t tickNum, FILE * out)
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    cy_en_csdidac_status_t status;
+    seq_tick_t tick;
+    uint32_t i;
+
+    host_reset();
+    status = Cy_CSDIDAC_Init(&config, &idacContext);
+    if (CY_CSDIDAC_SUCCESS == status)
+    {
+        status = Cy_CSDIDAC_SeqInit(bytes, length, &idacContext, &seqContext);
+    }
+    if (CY_CSDIDAC_SUCCESS == status)
+    {
+        status = Cy_CSDIDAC_SeqStart(&seqContext);
+    }
+    if (CY_CSDIDAC_SUCCESS != status)
+    {
+        fprintf(stderr, "profile not loaded: status 0x%08lX\n", (unsigned long)status);
+        return (0u);
+    }
+
+    if (NULL != out)
+    {
+        fprintf(out, "tick,state,IDACA,IDACB,currentA_nA,currentB_nA\n");
+    }
+    for (i = 0u; (i < tickNum) && (CY_CSDIDAC_SEQ_RUNNING == Cy_CSDIDAC_SeqGetState(&seqContext)); i++)
+    {
+        (void)Cy_CSDIDAC_SeqProcess(&seqContext);
+        tick.state = Cy_CSDIDAC_SeqGetState(&seqContext);
+        tick.currentA = output_current_na(CY_CSDIDAC_A);
+        tick.currentB = output_current_na(CY_CSDIDAC_B);
+        if (i < SEQ_DEFAULT_TICKS)
+        {
+            ticks[i] = tick;
+        }
+        if (NULL != out)
+        {
+            fprintf(out, "%lu,%u,0x%08lX,0x%08lX,%ld,%ld\n", (unsigned long)(i + 1u), (unsigned)tick.state,
+                    (unsigned long)HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA),
+                    (unsigned long)HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB), (long)tick.currentA, (long)tick.currentB);
+        }
+    }
+
+    return (i);
+}
+
+
+static int self_check(void)
+{
+    const uint32_t tickNum = (uint32_t)(sizeof(selfTicks) / sizeof(selfTicks[0]));
+    uint32_t length = parse_array(selfProfile, program);
+    uint32_t wrong = 0u;
+    uint32_t ran;
+    uint32_t i;
+
+    if (45u != length)
+    {
+        printf("failed: profile parsed\n");
+        return (1);
+    }
+    ran = run(program, length, SEQ_DEFAULT_TICKS, stdout);
+    for (i = 0u; (i < ran) && (i < tickNum); i++)
+    {
+        if (0 != memcmp(&ticks[i], &selfTicks[i], sizeof(ticks[i])))
+        {
+            printf("failed: tick %lu\n", (unsigned long)(i + 1u));
+            wrong++;
+        }
+    }
+    if (ran != tickNum)
+    {
+        printf("failed: %lu ticks run, %lu expected\n", (unsigned long)ran, (unsigned long)tickNum);
+        wrong++;
+    }
+    printf("%s\n", (0u == wrong) ? "PASS" : "FAIL");
+
+    return ((0u == wrong) ? 0 : 1);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static char text[SEQ_MAX_TEXT];
+    uint32_t tickNum = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : SEQ_DEFAULT_TICKS;
+    uint32_t length;
+    size_t size;
+    FILE * in;
+
+    if (argc < 2)
+    {
+        return (self_check());
+    }
+
+    in = fopen(argv[1], "r");
+    if (NULL == in)
+    {
+        fprintf(stderr, "%s: cannot open\n", argv[1]);
+        return (1);
+    }
+    size = fread(text, 1u, sizeof(text) - 1u, in);
+    (void)fclose(in);
+    text[size] = '\0';
+
+    length = parse_array(text, program);
+    if (0u == length)
+    {
+        fprintf(stderr, "%s: no csdidac_seqasm array\n", argv[1]);
+        return (1);
+    }
+
+    return ((0u == run(program, length, tickNum, stdout)) ? 1 : 0);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,177 @@
+/***************************************************************************//**
+* \file csdidac_test_seqlock.c
+* \version 2.10
+*
+* \brief
+* Host stress test of Cy_CSDIDAC_ReadChannelState(). A writer thread
+* enables and disables both the channels with Cy_CSDIDAC_OutputEnableExt()
+* and Cy_CSDIDAC_OutputDisable() on CY_CSDIDAC_AB, so every committed state
+* has equal A and B fields. Reader threads take snapshots and count the
+* copies with different A and B fields as torn. The same copy taken without
+* the sequence counter is counted for comparison.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_seqlock \
+*            tools/host/csdidac_test_seqlock.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_seqlock [<seconds> [<readers>]]
+*
+* The test fails if a snapshot returned with CY_CSDIDAC_SUCCESS is torn.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+#define READERS_MAX                 (16u)
+
+typedef struct
+{
+    pthread_t thread;
+    unsigned long reads;
+    unsigned long torn;
+    unsigned long busy;
+    unsigned long unprotectedTorn;
+} reader_t;
+
+static cy_stc_csdidac_context_t idacContext;
+static volatile int stop;
+
+
+static int is_consistent(const cy_stc_csdidac_channel_state_t * state)
+{
+    return ((state->polarityA == state->polarityB) && (state->lsbA == state->lsbB) &&
+            (state->codeA == state->codeB) && (state->channelStateA == state->channelStateB));
+}
+
+
+static void * writer(void * arg)
+{
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0u; 0 == stop; i++)
+    {
+        if (0u == (i % 97u))
+        {
+            (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+        }
+        else
+        {
+            (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_AB, (cy_en_csdidac_polarity_t)(i & 1u),
+                                             (cy_en_csdidac_lsb_t)((i >> 1u) % 6u), (i * 7u) & 0x7Fu,
+                                             &idacContext);
+        }
+    }
+    return (NULL);
+}
+
+
+static void * reader(void * arg)
+{
+    reader_t * rd = (reader_t *)arg;
+    volatile const cy_stc_csdidac_context_t * ctx = &idacContext;
+    cy_stc_csdidac_channel_state_t state;
+
+    while (0 == stop)
+    {
+        if (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_ReadChannelState(&state, &idacContext))
+        {
+            rd->reads++;
+            if (0 == is_consistent(&state))
+            {
+                rd->torn++;
+            }
+        }
+        else
+        {
+            rd->busy++;
+        }
+
+        /* The same copy without the sequence counter */
+        state.polarityA = ctx->polarityA;
+        state.lsbA = ctx->lsbA;
+        state.codeA = ctx->codeA;
+        state.channelStateA = ctx->channelStateA;
+        state.polarityB = ctx->polarityB;
+        state.lsbB = ctx->lsbB;
+        state.codeB = ctx->codeB;
+        state.channelStateB = ctx->channelStateB;
+        if (0 == is_consistent(&state))
+        {
+            rd->unprotectedTorn++;
+        }
+    }
+    return (NULL);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    static reader_t readers[READERS_MAX];
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long reads = 0u;
+    unsigned long torn = 0u;
+    unsigned long busy = 0u;
+    unsigned long unprotectedTorn = 0u;
+    unsigned int seconds = (argc > 1) ? (unsigned int)atoi(argv[1]) : 5u;
+    uint32_t readerNum = (argc > 2) ? (uint32_t)atoi(argv[2]) : 4u;
+    pthread_t writerThread;
+    uint32_t i;
+
+    if ((0u == readerNum) || (READERS_MAX < readerNum))
+    {
+        fprintf(stderr, "readers: 1..%u\n", READERS_MAX);
+        return (2);
+    }
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "Cy_CSDIDAC_Init failed\n");
+        return (1);
+    }
+
+    (void)pthread_create(&writerThread, NULL, &writer, NULL);
+    for (i = 0u; i < readerNum; i++)
+    {
+        (void)pthread_create(&readers[i].thread, NULL, &reader, &readers[i]);
+    }
+    (void)sleep(seconds);
+    stop = 1;
+    (void)pthread_join(writerThread, NULL);
+    for (i = 0u; i < readerNum; i++)
+    {
+        (void)pthread_join(readers[i].thread, NULL);
+        reads += readers[i].reads;
+        torn += readers[i].torn;
+        busy += readers[i].busy;
+        unprotectedTorn += readers[i].unprotectedTorn;
+    }
+
+    printf("updates:             %lu\n", (unsigned long)(idacContext.seq / 2u));
+    printf("snapshots:           %lu\n", reads);
+    printf("snapshots torn:      %lu\n", torn);
+    printf("snapshots busy:      %lu\n", busy);
+    printf("unprotected torn:    %lu\n", unprotectedTorn);
+    printf("%s\n", (0u == torn) ? "PASS" : "FAIL");
+
+    return ((0u == torn) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
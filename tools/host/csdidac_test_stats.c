@@ -0,0 +1,174 @@
+/***************************************************************************//**
+* \file csdidac_test_stats.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the CSDIDAC call and error statistics. The same loop of
+* Cy_CSDIDAC_OutputEnable(), Cy_CSDIDAC_OutputEnableExt(),
+* Cy_CSDIDAC_OutputDisable() and a failing Cy_CSDIDAC_OutputEnable() call
+* is timed in a build with CY_CSDIDAC_STATS_EN and in one without it, the
+* difference is the overhead of the counters. The register accesses and
+* the critical sections per call are reported too. The register accesses
+* must be the same in both builds. A critical section of the host model is
+* a mutex, so the time of the critical section the counters take is much
+* longer than on the target.
+*
+* With CY_CSDIDAC_STATS_EN, the counters of Cy_CSDIDAC_SnapshotStats() are
+* checked against the calls of the loop and the cost of the snapshot is
+* reported.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. [-DCY_CSDIDAC_STATS_EN=1u] \
+*            -o csdidac_test_stats tools/host/csdidac_test_stats.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c -lpthread
+* Usage:  csdidac_test_stats [<iterations>]
+*
+* The time per call is the best of several repetitions of the loop.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+#define REPEATS                     (7u)
+
+/* The calls of one loop iteration */
+#define CALLS_PER_ITERATION         (4u)
+
+/* An invalid channel, the call fails with CY_CSDIDAC_BAD_PARAM */
+#define BAD_CHANNEL                 ((cy_en_csdidac_choice_t)7u)
+
+static cy_stc_csdidac_context_t idacContext;
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static void run(uint32_t iterations)
+{
+    uint32_t i;
+
+    for (i = 0u; i < iterations; i++)
+    {
+        (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, (int32_t)(i & 0xFFFFu), &idacContext);
+        (void)Cy_CSDIDAC_OutputEnableExt(CY_CSDIDAC_B, CY_CSDIDAC_SINK, CY_CSDIDAC_LSB_600_IDX,
+                                         i & CY_CSDIDAC_IDAC_WORD_CODE_MASK, &idacContext);
+        (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_A, &idacContext);
+        (void)Cy_CSDIDAC_OutputEnable(BAD_CHANNEL, 1000, &idacContext);
+    }
+}
+
+
+#if (0u != CY_CSDIDAC_STATS_EN)
+static int check_stats(uint32_t iterations)
+{
+    static cy_stc_csdidac_stats_t stats;
+    uint32_t badParam = CY_CSDIDAC_STATUS_ERR_IDX(CY_CSDIDAC_BAD_PARAM);
+    uint32_t i;
+    double start;
+    double elapsed;
+    int failed = 0;
+
+    (void)Cy_CSDIDAC_SnapshotStats(NULL, &idacContext);
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_B, &idacContext);
+    (void)Cy_CSDIDAC_SnapshotStats(NULL, &idacContext);
+    run(iterations);
+    (void)Cy_CSDIDAC_SnapshotStats(&stats, &idacContext);
+    if (((2u * iterations) != stats.calls[CY_CSDIDAC_API_OUTPUT_ENABLE]) ||
+        (iterations != stats.calls[CY_CSDIDAC_API_OUTPUT_ENABLE_EXT]) ||
+        (iterations != stats.calls[CY_CSDIDAC_API_OUTPUT_DISABLE]) ||
+        (((iterations < 0xFFFFu) ? iterations : 0xFFFFu) !=
+            stats.failures[CY_CSDIDAC_API_OUTPUT_ENABLE][badParam]) ||
+        (iterations != stats.enableCntA) || (iterations != stats.disableCntA) ||
+        (1u != stats.enableCntB) || (0u != stats.disableCntB))
+    {
+        printf("statistics do not match the calls\n");
+        failed = 1;
+    }
+    printf("counted:             %lu OutputEnable, %lu failed with BAD_PARAM, %lu/%lu A enables/disables\n",
+           (unsigned long)stats.calls[CY_CSDIDAC_API_OUTPUT_ENABLE],
+           (unsigned long)stats.failures[CY_CSDIDAC_API_OUTPUT_ENABLE][badParam],
+           (unsigned long)stats.enableCntA, (unsigned long)stats.disableCntA);
+
+    start = now_s();
+    for (i = 0u; i < iterations; i++)
+    {
+        (void)Cy_CSDIDAC_SnapshotStats(&stats, &idacContext);
+    }
+    elapsed = now_s() - start;
+    printf("snapshot and reset:  %.1f ns, %lu bytes\n", (elapsed * 1e9) / iterations,
+           (unsigned long)sizeof(stats));
+
+    return (failed);
+}
+#endif /* (0u != CY_CSDIDAC_STATS_EN) */
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    uint32_t iterations = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1000000u;
+    double best = 0.0;
+    double elapsed;
+    uint32_t i;
+    int failed = 0;
+
+    if (0u == iterations)
+    {
+        fprintf(stderr, "iterations: 1 or more\n");
+        return (2);
+    }
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    for (i = 0u; i < REPEATS; i++)
+    {
+        elapsed = now_s();
+        run(iterations);
+        elapsed = now_s() - elapsed;
+        if ((0u == i) || (elapsed < best))
+        {
+            best = elapsed;
+        }
+    }
+    host_access = (host_access_t){0};
+    run(1u);
+
+    printf("CY_CSDIDAC_STATS_EN: %u\n", (unsigned int)CY_CSDIDAC_STATS_EN);
+    printf("time per call:       %.2f ns\n", (best * 1e9) / ((double)iterations * CALLS_PER_ITERATION));
+    printf("register accesses:   %u per iteration of %u calls\n", host_access_total(), CALLS_PER_ITERATION);
+    printf("critical sections:   %u per iteration of %u calls\n", host_access.csCount, CALLS_PER_ITERATION);
+    #if (0u != CY_CSDIDAC_STATS_EN)
+        failed = check_stats(iterations);
+    #endif /* (0u != CY_CSDIDAC_STATS_EN) */
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
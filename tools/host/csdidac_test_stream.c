@@ -0,0 +1,277 @@
+/***************************************************************************//**
+* \file csdidac_test_stream.c
+* \version 2.10
+*
+* \brief
+* Host test of the CSDIDAC double-buffered streaming playback. A producer
+* thread fills and commits the halves of the buffer with a sequence of
+* distinct IDAC register words, while a tick thread calls
+* Cy_CSDIDAC_StreamProcess() and checks each word written to the IDAC
+* register. A word is either the next word of the sequence or, on an
+* underrun, the last word again, so a lost, repeated, or reordered sample
+* fails the test.
+*
+* Before the threads start, the start of the playback and the overrun
+* counter are checked: Cy_CSDIDAC_StreamStart() outputs the first word and
+* the first tick the second one, and only a rejected commit is an overrun.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_stream \
+*            tools/host/csdidac_test_stream.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_stream.c -lpthread
+* Usage:  csdidac_test_stream [<seconds> [<half size> [<tick period us>]]]
+*
+* With the tick period of 0 the tick runs as fast as it can and yields on an
+* underrun, so the rate is the sustained rate of the producer and the
+* playback together. Reports the played samples per second and the
+* underruns.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_stream.h"
+
+#define HALF_SIZE_MAX               (4096u)
+
+/* The number of the distinct words of the sequence */
+#define SEQ_WORD_NUM                (2u * 6u * 128u)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_stream_context_t streamContext;
+static uint32_t streamBuffer[CY_CSDIDAC_STREAM_HALF_NUM * HALF_SIZE_MAX];
+static uint32_t halfSize;
+static uint32_t produced;
+static unsigned long tickPeriodUs;
+static volatile unsigned long notifyCnt;
+static volatile int stop;
+
+static unsigned long played;
+static unsigned long mismatches;
+static unsigned long repeats;
+
+
+/* The n-th word of the sequence */
+static uint32_t seq_word(uint32_t n)
+{
+    n %= SEQ_WORD_NUM;
+    return (CY_CSDIDAC_IDAC_WORD((n >> 7u) & 1u, (n >> 8u), n & CY_CSDIDAC_IDAC_WORD_CODE_MASK));
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static void notify(uint32_t * half, uint32_t size)
+{
+    (void)half;
+    (void)size;
+    notifyCnt++;
+}
+
+
+/* Fills and commits the next half, returns 0 if no half is free */
+static int produce(void)
+{
+    uint32_t * half = Cy_CSDIDAC_StreamGetFree(&streamContext);
+    uint32_t i;
+    int filled = 0;
+
+    if (NULL != half)
+    {
+        for (i = 0u; i < halfSize; i++)
+        {
+            half[i] = seq_word(produced + i);
+        }
+        if (CY_CSDIDAC_SUCCESS == Cy_CSDIDAC_StreamCommit(&streamContext))
+        {
+            produced += halfSize;
+            filled = 1;
+        }
+    }
+    return (filled);
+}
+
+
+static void * producer(void * arg)
+{
+    (void)arg;
+    while (0 == stop)
+    {
+        if (0 == produce())
+        {
+            (void)sched_yield();
+        }
+    }
+    return (NULL);
+}
+
+
+static void * ticker(void * arg)
+{
+    struct timespec period = {0, 0};
+    uint32_t expected = (uint32_t)played;
+    uint32_t last = seq_word(expected - 1u);
+    uint32_t word;
+
+    (void)arg;
+    period.tv_nsec = (long)tickPeriodUs * 1000L;
+    while (0 == stop)
+    {
+        Cy_CSDIDAC_StreamProcess(&streamContext);
+        word = HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA);
+        if (word == seq_word(expected))
+        {
+            expected++;
+            played++;
+        }
+        else if (word == last)
+        {
+            /* An underrun, the producer runs next on a single core */
+            repeats++;
+            (void)sched_yield();
+        }
+        else
+        {
+            mismatches++;
+        }
+        last = word;
+        if (0u != tickPeriodUs)
+        {
+            (void)nanosleep(&period, NULL);
+        }
+    }
+    return (NULL);
+}
+
+
+/* Checks the start of the playback and the overrun counter */
+static int check_start(void)
+{
+    int failed = 0;
+    uint32_t i;
+
+    (void)produce();
+    (void)produce();
+    for (i = 0u; i < 10u; i++)
+    {
+        if (NULL != Cy_CSDIDAC_StreamGetFree(&streamContext))
+        {
+            failed = 1;
+        }
+    }
+    if (0u != streamContext.overrunCnt)
+    {
+        printf("overrun counted on a poll\n");
+        failed = 1;
+    }
+    if ((CY_CSDIDAC_BAD_PARAM != Cy_CSDIDAC_StreamCommit(&streamContext)) || (1u != streamContext.overrunCnt))
+    {
+        printf("rejected commit not counted as one overrun\n");
+        failed = 1;
+    }
+
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_StreamStart(&streamContext)) ||
+        ((HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) & seq_word(0u)) != seq_word(0u)))
+    {
+        printf("start does not output the first word\n");
+        failed = 1;
+    }
+    Cy_CSDIDAC_StreamProcess(&streamContext);
+    if (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) != seq_word(1u))
+    {
+        printf("first tick does not output the second word\n");
+        failed = 1;
+    }
+    played = 2u;
+    return (failed);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned int seconds = (argc > 1) ? (unsigned int)atoi(argv[1]) : 5u;
+    pthread_t producerThread;
+    pthread_t tickThread;
+    struct timespec runTime = {0, 0};
+    double startTime;
+    double elapsed;
+    unsigned long startSamples;
+    int failed;
+
+    halfSize = (argc > 2) ? (uint32_t)atoi(argv[2]) : 64u;
+    tickPeriodUs = (argc > 3) ? strtoul(argv[3], NULL, 0) : 0u;
+    if ((0u == halfSize) || (HALF_SIZE_MAX < halfSize))
+    {
+        fprintf(stderr, "half size: 1..%u\n", HALF_SIZE_MAX);
+        return (2);
+    }
+
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_StreamInit(CY_CSDIDAC_A, streamBuffer, halfSize,
+                                                     CY_CSDIDAC_STREAM_HOLD_LAST, &notify,
+                                                     &idacContext, &streamContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+    failed = check_start();
+
+    startSamples = streamContext.sampleCnt;
+    startTime = now_s();
+    (void)pthread_create(&producerThread, NULL, &producer, NULL);
+    (void)pthread_create(&tickThread, NULL, &ticker, NULL);
+    runTime.tv_sec = (time_t)seconds;
+    (void)nanosleep(&runTime, NULL);
+    stop = 1;
+    (void)pthread_join(tickThread, NULL);
+    (void)pthread_join(producerThread, NULL);
+    elapsed = now_s() - startTime;
+    (void)Cy_CSDIDAC_StreamStop(&streamContext);
+
+    if ((played != streamContext.sampleCnt) || (repeats != streamContext.underrunCnt) ||
+        (notifyCnt != streamContext.swapCnt) || (0u != mismatches))
+    {
+        failed = 1;
+    }
+
+    printf("half size:           %lu\n", (unsigned long)halfSize);
+    printf("played samples:      %lu\n", played);
+    printf("sample counter:      %lu\n", (unsigned long)streamContext.sampleCnt);
+    printf("swaps:               %lu\n", (unsigned long)streamContext.swapCnt);
+    printf("underruns:           %lu\n", (unsigned long)streamContext.underrunCnt);
+    printf("repeated words:      %lu\n", repeats);
+    printf("overruns:            %lu\n", (unsigned long)streamContext.overrunCnt);
+    printf("wrong words:         %lu\n", mismatches);
+    printf("rate:                %.1f samples/s\n",
+           (elapsed > 0.0) ? ((double)(streamContext.sampleCnt - startSamples) / elapsed) : 0.0);
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,227 @@
+/***************************************************************************//**
+* \file csdidac_test_trig.c
+* \version 2.10
+*
+* \brief
+* Host measurement of the CSDIDAC pre-armed trigger fire path. Each
+* configuration (IdacA, IdacB, both, with and without the marker pin) is
+* armed and fired, and the test checks the IDAC register words, the marker
+* DR_INV store, and that the fire path makes no PDL call and enters no
+* critical section.
+*
+* The instructions of a fire are counted by single-stepping the call with
+* the x86-64 trap flag, less the call and return of an empty function, so
+* the count is that of Cy_CSDIDAC_TrigFire() inlined in an interrupt. The
+* column is "-" on the other hosts. The same count of
+* Cy_CSDIDAC_OutputEnable(), the path of an interrupt without the trigger,
+* and the time of both paths are reported for the comparison.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_trig \
+*            tools/host/csdidac_test_trig.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_trig.c -lpthread
+* Usage:  csdidac_test_trig [<timed calls>]
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_trig.h"
+
+#define MARKER_PORT                 (&host_gpio_ports[3])
+#define MARKER_PIN                  (5u)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_trig_context_t trigContext;
+static volatile unsigned long stepCnt;
+static int failed;
+
+
+static void expect(int condition, const char * what)
+{
+    if (0 == condition)
+    {
+        printf("failed: %s\n", what);
+        failed = 1;
+    }
+}
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+/* The fire of an interrupt handler */
+static __attribute__((noinline)) void fire(void)
+{
+    Cy_CSDIDAC_TrigFire(&trigContext);
+}
+
+
+/* The full path of an interrupt handler without the trigger */
+static __attribute__((noinline)) void enable(void)
+{
+    (void)Cy_CSDIDAC_OutputEnable(CY_CSDIDAC_A, 120000, &idacContext);
+}
+
+
+static __attribute__((noinline)) void empty(void)
+{
+    __asm__ volatile ("" ::: "memory");
+}
+
+
+#if defined(__x86_64__)
+
+static void step_handler(int sig)
+{
+    (void)sig;
+    stepCnt++;
+}
+
+
+/* Counts the instructions executed by a call of func with the trap flag set */
+static unsigned long steps(void (* func)(void))
+{
+    stepCnt = 0u;
+    __asm__ volatile ("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    func();
+    __asm__ volatile ("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+    return (stepCnt);
+}
+
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)snprintf(out, size, "%lu", steps(func) - steps(&empty));
+}
+
+#else
+
+static void count_instructions(void (* func)(void), char * out, size_t size)
+{
+    (void)func;
+    (void)snprintf(out, size, "-");
+}
+
+#endif /* defined(__x86_64__) */
+
+
+/* Arms the configuration, fires it, and checks the stores */
+static void check_fire(const char * name, uint32_t armA, uint32_t armB, GPIO_PRT_Type * markerPort)
+{
+    const uint32_t wordA = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_2400_IDX, 50u);
+    const uint32_t wordB = CY_CSDIDAC_IDAC_WORD(CY_CSDIDAC_SINK, CY_CSDIDAC_LSB_300_IDX, 77u);
+    uint32_t accesses;
+    char instructions[24];
+
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    (void)Cy_CSDIDAC_TrigInit(markerPort, MARKER_PIN, &idacContext, &trigContext);
+    if (0u != armA)
+    {
+        (void)Cy_CSDIDAC_TrigArmExt(CY_CSDIDAC_A, CY_CSDIDAC_SOURCE, CY_CSDIDAC_LSB_2400_IDX, 50u, &trigContext);
+    }
+    if (0u != armB)
+    {
+        (void)Cy_CSDIDAC_TrigArmExt(CY_CSDIDAC_B, CY_CSDIDAC_SINK, CY_CSDIDAC_LSB_300_IDX, 77u, &trigContext);
+    }
+    expect((0u == (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) & CY_CSDIDAC_IDAC_WORD_CODE_MASK)) &&
+           (0u == (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB) & CY_CSDIDAC_IDAC_WORD_CODE_MASK)), "armed output at zero");
+    MARKER_PORT->DR_INV = 0u;
+
+    accesses = host_access_total();
+    fire();
+    expect(accesses == host_access_total(), "fire makes no PDL call");
+    expect((0u == armA) || (wordA == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA)), "IdacA word stored");
+    expect((0u == armB) || (wordB == HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACB)), "IdacB word stored");
+    expect(((NULL == markerPort) ? 0u : (CY_GPIO_DR_MASK << MARKER_PIN)) == MARKER_PORT->DR_INV, "marker store");
+
+    count_instructions(&fire, instructions, sizeof(instructions));
+    printf("%-22s instructions %s\n", name, instructions);
+    (void)Cy_CSDIDAC_TrigDisarm(&trigContext);
+}
+
+
+static double time_calls(void (* func)(void), unsigned long calls)
+{
+    double start = now_s();
+    unsigned long i;
+
+    for (i = 0u; i < calls; i++)
+    {
+        func();
+    }
+    return (((now_s() - start) * 1e9) / (double)calls);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000000u;
+    host_access_t access;
+    char instructions[24];
+    double fireNs;
+    double enableNs;
+
+#if defined(__x86_64__)
+    (void)signal(SIGTRAP, &step_handler);
+#endif /* defined(__x86_64__) */
+    host_reset();
+    if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    check_fire("none armed", 0u, 0u, NULL);
+    check_fire("IdacA", 1u, 0u, NULL);
+    check_fire("IdacB", 0u, 1u, NULL);
+    check_fire("IdacA, IdacB", 1u, 1u, NULL);
+    check_fire("IdacA, marker", 1u, 0u, MARKER_PORT);
+    check_fire("IdacA, IdacB, marker", 1u, 1u, MARKER_PORT);
+
+    /* The same interrupt with the full conversion, validation and routing path */
+    (void)Cy_CSDIDAC_OutputDisable(CY_CSDIDAC_AB, &idacContext);
+    (void)memset(&host_access, 0, sizeof(host_access));
+    enable();
+    access = host_access;
+    count_instructions(&enable, instructions, sizeof(instructions));
+    printf("%-22s instructions %s, accesses %lu, critical sections %lu\n", "OutputEnable", instructions,
+           (unsigned long)host_access_total(), (unsigned long)access.csCount);
+
+    (void)Cy_CSDIDAC_TrigInit(MARKER_PORT, MARKER_PIN, &idacContext, &trigContext);
+    (void)Cy_CSDIDAC_TrigArm(CY_CSDIDAC_A, 120000, &trigContext);
+    (void)Cy_CSDIDAC_TrigArm(CY_CSDIDAC_B, -4800, &trigContext);
+    fireNs = time_calls(&fire, calls);
+    enableNs = time_calls(&enable, calls / 10u);
+    printf("fire:                  %.2f ns\n", fireNs);
+    printf("OutputEnable:          %.2f ns\n", enableNs);
+    (void)Cy_CSDIDAC_TrigDisarm(&trigContext);
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
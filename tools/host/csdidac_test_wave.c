@@ -0,0 +1,257 @@
+/***************************************************************************//**
+* \file csdidac_test_wave.c
+* \version 2.10
+*
+* \brief
+* Host benchmark of the CSDIDAC compressed waveform playback. Each test
+* waveform is built as a table of the IDAC register words chosen by
+* Cy_CSDIDAC_CurrentToCode() and compressed by a stream encoder of the
+* format of cy_csdidac_wave.h: a range token where the polarity or LSB
+* changes or the code delta does not fit 7 bits, a code delta otherwise,
+* and hold tokens for repeated samples.
+*
+* Both the raw table and the stream are played in a loop with
+* Cy_CSDIDAC_WaveProcess(). The IDAC register is compared with the table
+* after every sample for two passes, and the stream bytes read per sample
+* are counted to check the decode bound of two bytes. Then the decode time
+* per sample is measured for both formats.
+*
+* Build:  cc -std=c99 -O2 -D_DEFAULT_SOURCE -Itools/host -I. -o csdidac_test_wave \
+*            tools/host/csdidac_test_wave.c tools/host/csdidac_host.c \
+*            cy_csdidac.c cy_csdidac_route.c cy_csdidac_wave.c -lpthread -lm
+* Usage:  csdidac_test_wave [<timed samples>]
+*
+* Reports the compression ratio, the stream bytes per sample, and the
+* decode time per sample of the compressed and raw playback.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "csdidac_host.h"
+#include "cy_csdidac_wave.h"
+
+#define SAMPLE_NUM                  (4096u)
+
+/* The worst case stream size, a range token with the code per sample and the end token */
+#define STREAM_SIZE_MAX             ((2u * SAMPLE_NUM) + 1u)
+
+#define WORD_RANGE(word)            ((word) & ~CY_CSDIDAC_IDAC_WORD_CODE_MASK)
+
+static cy_stc_csdidac_context_t idacContext;
+static cy_stc_csdidac_wave_context_t waveContext;
+static uint32_t words[SAMPLE_NUM];
+static uint8_t stream[STREAM_SIZE_MAX];
+static int failed;
+
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+
+static uint32_t current_word(double currentNa)
+{
+    cy_en_csdidac_polarity_t polarity;
+    cy_en_csdidac_lsb_t lsb;
+    uint32_t code;
+
+    (void)Cy_CSDIDAC_CurrentToCode((int32_t)lrint(currentNa), &polarity, &lsb, &code);
+    return (CY_CSDIDAC_IDAC_WORD(polarity, lsb, code));
+}
+
+
+static void make_wave(uint32_t shape)
+{
+    uint32_t i;
+    double t;
+
+    for (i = 0u; i < SAMPLE_NUM; i++)
+    {
+        t = (double)i;
+        switch (shape)
+        {
+            case 0u:
+                words[i] = current_word(600000.0 * sin((2.0 * M_PI * t) / 512.0));
+                break;
+            case 1u:
+                words[i] = current_word(15000.0 + (15000.0 * sin((2.0 * M_PI * t) / 512.0)));
+                break;
+            case 2u:
+                words[i] = current_word(40000.0 * (double)((i / 100u) % 5u));
+                break;
+            case 3u:
+                words[i] = current_word(((i % 50u) < 10u) ? 200000.0 : 0.0);
+                break;
+            default:
+                words[i] = current_word((double)((rand() % 1200001) - 600000));
+                break;
+        }
+    }
+}
+
+
+/* Encodes the table into the stream, returns the stream size */
+static uint32_t encode(void)
+{
+    uint32_t size = 0u;
+    uint32_t prev = words[0];
+    uint32_t run;
+    int32_t delta;
+    uint32_t i = 1u;
+
+    stream[size++] = (uint8_t)CY_CSDIDAC_WAVE_RANGE_TOKEN(CY_CSDIDAC_IDAC_WORD_POLARITY(prev),
+                                                          CY_CSDIDAC_IDAC_WORD_LSB(prev));
+    stream[size++] = (uint8_t)(prev & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+    while (i < SAMPLE_NUM)
+    {
+        if (words[i] == prev)
+        {
+            for (run = 1u; ((i + run) < SAMPLE_NUM) && (words[i + run] == prev) &&
+                           (run < CY_CSDIDAC_WAVE_HOLD_MAX); run++)
+            {
+            }
+            stream[size++] = (uint8_t)(CY_CSDIDAC_WAVE_HOLD | (run - 1u));
+            i += run;
+        }
+        else
+        {
+            delta = (int32_t)(words[i] & CY_CSDIDAC_IDAC_WORD_CODE_MASK) - (int32_t)(prev & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+            if ((WORD_RANGE(words[i]) == WORD_RANGE(prev)) && (-64 <= delta) && (63 >= delta))
+            {
+                stream[size++] = (uint8_t)((uint32_t)delta & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+            }
+            else
+            {
+                stream[size++] = (uint8_t)CY_CSDIDAC_WAVE_RANGE_TOKEN(CY_CSDIDAC_IDAC_WORD_POLARITY(words[i]),
+                                                                      CY_CSDIDAC_IDAC_WORD_LSB(words[i]));
+                stream[size++] = (uint8_t)(words[i] & CY_CSDIDAC_IDAC_WORD_CODE_MASK);
+            }
+            prev = words[i];
+            i++;
+        }
+    }
+    stream[size++] = CY_CSDIDAC_WAVE_END;
+    return (size);
+}
+
+
+/* Plays two passes, checks every sample, and returns the most stream bytes read by a sample */
+static uint32_t check_playback(const char * name, bool compressed)
+{
+    uint32_t mismatches = 0u;
+    uint32_t maxBytes = 0u;
+    const uint8_t * token;
+    uint32_t i;
+
+    for (i = 0u; i < (2u * SAMPLE_NUM); i++)
+    {
+        token = waveContext.token;
+        Cy_CSDIDAC_WaveProcess(&waveContext);
+        if ((true == compressed) && (waveContext.token > token) && ((uint32_t)(waveContext.token - token) > maxBytes))
+        {
+            maxBytes = (uint32_t)(waveContext.token - token);
+        }
+        if (HOST_CSD_REG(CY_CSD_REG_OFFSET_IDACA) != words[i % SAMPLE_NUM])
+        {
+            mismatches++;
+        }
+    }
+    if (0u != mismatches)
+    {
+        printf("%s: %u wrong samples\n", name, mismatches);
+        failed = 1;
+    }
+    return (maxBytes);
+}
+
+
+static double time_playback(uint32_t samples)
+{
+    uint32_t i;
+    double start = now_s();
+
+    for (i = 0u; i < samples; i++)
+    {
+        Cy_CSDIDAC_WaveProcess(&waveContext);
+    }
+    return (((now_s() - start) * 1e9) / samples);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static cy_stc_csd_context_t csdContext;
+    static const cy_stc_csdidac_pin_t pinA = {&host_gpio_ports[0], 1u};
+    static const cy_stc_csdidac_pin_t pinB = {&host_gpio_ports[0], 2u};
+    static const char * const shapeNames[] =
+    {
+        "sine +/-600 uA", "sine 0..30 uA", "staircase", "pulse train", "random"
+    };
+    const cy_stc_csdidac_config_t config =
+    {
+        HOST_CSD_BASE, &csdContext, CY_CSDIDAC_GPIO, CY_CSDIDAC_GPIO, &pinA, &pinB, 48000000u, 10u
+    };
+    uint32_t samples = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000000u;
+    uint32_t size;
+    uint32_t maxBytes;
+    uint32_t shape;
+    double rawNs;
+    double decodeNs;
+
+    srand(1u);
+    host_reset();
+    if ((CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_Init(&config, &idacContext)) ||
+        (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_WaveInit(CY_CSDIDAC_A, &idacContext, &waveContext)))
+    {
+        fprintf(stderr, "init failed\n");
+        return (1);
+    }
+
+    printf("%u samples per waveform, %u timed samples\n", SAMPLE_NUM, samples);
+    for (shape = 0u; shape < (sizeof(shapeNames) / sizeof(shapeNames[0])); shape++)
+    {
+        make_wave(shape);
+        size = encode();
+
+        (void)Cy_CSDIDAC_WavePlayRaw(words, SAMPLE_NUM, true, &waveContext);
+        (void)check_playback(shapeNames[shape], false);
+        rawNs = time_playback(samples);
+
+        if (CY_CSDIDAC_SUCCESS != Cy_CSDIDAC_WavePlay(stream, size, true, &waveContext))
+        {
+            printf("%s: stream rejected\n", shapeNames[shape]);
+            failed = 1;
+            continue;
+        }
+        maxBytes = check_playback(shapeNames[shape], true);
+        decodeNs = time_playback(samples);
+        (void)Cy_CSDIDAC_WaveStop(&waveContext);
+
+        printf("%-15s %5u bytes, ratio %6.2f, at most %u bytes per sample, decode %.2f ns/sample, raw %.2f ns/sample\n",
+               shapeNames[shape], size, (double)(SAMPLE_NUM * sizeof(uint32_t)) / (double)size, maxBytes,
+               decodeNs, rawNs);
+        if (2u < maxBytes)
+        {
+            failed = 1;
+        }
+    }
+    printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+
+    return (failed);
+}
+
+
+/* [] END OF FILE */
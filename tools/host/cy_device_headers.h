@@ -0,0 +1,92 @@
+/***************************************************************************//**
+* \file cy_device_headers.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the device header: the CSD IP define, the CMSIS core
+* intrinsics and the peripheral register types used by the CSDIDAC
+* middleware. See csdidac_host.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_DEVICE_HEADERS_H)
+#define CY_DEVICE_HEADERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CY_IP_M0S8CSDV2             1
+
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        static inline
+#define __WEAK                      __attribute__((weak))
+
+#define CY_ASSERT(x)                do { if (!(x)) { __builtin_trap(); } } while (0)
+#define CY_ASSERT_L1(x)             CY_ASSERT(x)
+#define CY_ASSERT_L2(x)             CY_ASSERT(x)
+#define CY_ASSERT_L3(x)             CY_ASSERT(x)
+#define CY_UNUSED_PARAMETER(x)      ((void)(x))
+
+#define CY_PDL_DRV_ID(x)            ((uint32_t)(x) << 16u)
+#define CY_PDL_STATUS_ERROR         (2uL << 16u)
+#define CY_ALIGN(align)             __attribute__((aligned(align)))
+
+typedef uint32_t cy_rslt_t;
+#define CY_RSLT_SUCCESS             (0u)
+
+typedef struct
+{
+    volatile uint32_t CONFIG;
+} CSD_Type;
+
+typedef struct
+{
+    volatile uint32_t DR;
+    volatile uint32_t PS;
+    volatile uint32_t PC;
+    volatile uint32_t INTR_CFG;
+    volatile uint32_t INTR;
+    volatile uint32_t PC2;
+    volatile uint32_t DR_SET;
+    volatile uint32_t DR_CLR;
+    volatile uint32_t DR_INV;
+} GPIO_PRT_Type;
+
+typedef struct
+{
+    volatile uint32_t PORT_SEL;
+} HSIOM_PRT_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type host_systick;
+#define SysTick                     (&host_systick)
+
+typedef int32_t IRQn_Type;
+
+static inline void __DMB(void) { __sync_synchronize(); }
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __ISB(void) { __sync_synchronize(); }
+static inline void __WFI(void) { }
+static inline void __disable_irq(void) { }
+static inline void __enable_irq(void) { }
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) { (void)irq; }
+
+#endif /* CY_DEVICE_HEADERS_H */
+
+
+/* [] END OF FILE */
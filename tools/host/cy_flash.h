@@ -0,0 +1,35 @@
+/***************************************************************************//**
+* \file cy_flash.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the flash driver definitions used by the CSDIDAC middleware. The flash row write fails on the host, the tests pass a RAM stand-in to the persistence module.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_FLASH_H)
+#define CY_FLASH_H
+
+#include "cy_device_headers.h"
+
+typedef enum
+{
+    CY_FLASH_DRV_SUCCESS        = 0x00u,
+    CY_FLASH_DRV_INV_PROT       = 0x01u,
+    CY_FLASH_DRV_INVALID_INPUT_PARAMETERS = 0x02u,
+} cy_en_flashdrv_status_t;
+
+#define CY_FLASH_SIZEOF_ROW                 (128u)
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t * data);
+
+#endif /* CY_FLASH_H */
+
+
+/* [] END OF FILE */
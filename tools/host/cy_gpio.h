@@ -0,0 +1,63 @@
+/***************************************************************************//**
+* \file cy_gpio.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the GPIO definitions used by the CSDIDAC middleware. The register access macros count the accesses, see csdidac_host.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_GPIO_H)
+#define CY_GPIO_H
+
+#include "cy_device_headers.h"
+
+typedef uint32_t en_hsiom_sel_t;
+
+#define HSIOM_SEL_GPIO                      (0u)
+#define HSIOM_SEL_AMUXA                     (6u)
+#define HSIOM_SEL_AMUXB                     (7u)
+
+#define CY_GPIO_DM_ANALOG                   (0x00u)
+#define CY_GPIO_DM_PULLUP                   (0x02u)
+#define CY_GPIO_DM_STRONG_IN_OFF            (0x0Eu)
+
+#define CY_GPIO_PINS_MAX                    (8u)
+#define CY_GPIO_PC_DM_MASK                  (0x7u)
+#define CY_GPIO_PC_DM_IBUF_MASK             (0x1u)
+#define CY_GPIO_DM_VAL_IBUF_DISABLE_MASK    (0x8u)
+#define CY_GPIO_DRIVE_MODE_OFFSET           (3u)
+#define CY_GPIO_HSIOM_MASK                  (0xFu)
+#define CY_GPIO_HSIOM_OFFSET                (2u)
+#define CY_GPIO_DR_MASK                     (0x1u)
+#define CY_GPIO_PS_MASK                     (0x1u)
+#define CY_GPIO_INTR_STATUS_MASK            (0x1u)
+
+/* Counted register accesses: one per use of a macro, two for PORT_SEL,
+* which the middleware takes the address of for one read-modify-write.
+*/
+volatile uint32_t * host_gpio_reg(volatile uint32_t * reg, uint32_t reads, uint32_t writes);
+
+#define GPIO_PRT_PC(base)                   (*host_gpio_reg(&(base)->PC, 1u, 0u))
+#define GPIO_PRT_PC2(base)                  (*host_gpio_reg(&(base)->PC2, 1u, 0u))
+#define GPIO_PRT_DR_INV(base)               (*host_gpio_reg(&(base)->DR_INV, 0u, 1u))
+#define HSIOM_PRT_PORT_SEL(base)            (*host_gpio_reg(&(base)->PORT_SEL, 1u, 1u))
+
+HSIOM_PRT_Type * Cy_GPIO_PortToHSIOM(GPIO_PRT_Type * base);
+void Cy_GPIO_SetDrivemode(GPIO_PRT_Type * base, uint32_t pinNum, uint32_t value);
+uint32_t Cy_GPIO_GetDrivemode(GPIO_PRT_Type * base, uint32_t pinNum);
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type * base, uint32_t pinNum, en_hsiom_sel_t value);
+en_hsiom_sel_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type * base, uint32_t pinNum);
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type * base, uint32_t pinNum);
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type * base, uint32_t pinNum);
+
+#endif /* CY_GPIO_H */
+
+
+/* [] END OF FILE */
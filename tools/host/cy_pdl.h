@@ -0,0 +1,31 @@
+/***************************************************************************//**
+* \file cy_pdl.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the PDL header included by the code example: the host
+* stand-ins of the drivers it uses, see csdidac_host.h.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PDL_H)
+#define CY_PDL_H
+
+#include "cy_device_headers.h"
+#include "cy_csd.h"
+#include "cy_gpio.h"
+#include "cy_syslib.h"
+#include "cy_sysint.h"
+#include "cy_syspm.h"
+#include "cy_flash.h"
+
+#endif /* CY_PDL_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,40 @@
+/***************************************************************************//**
+* \file cy_sysint.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the SysInt types and functions used by the code example. There is no interrupt controller on the host, a test calls the handler itself.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_SYSINT_H)
+#define CY_SYSINT_H
+
+#include "cy_device_headers.h"
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS           = 0x00u,
+    CY_SYSINT_BAD_PARAM         = 0x01u,
+} cy_en_sysint_status_t;
+
+typedef void (* cy_israddress)(void);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t * config, cy_israddress userIsr);
+
+#endif /* CY_SYSINT_H */
+
+
+/* [] END OF FILE */
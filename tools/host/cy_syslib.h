@@ -0,0 +1,29 @@
+/***************************************************************************//**
+* \file cy_syslib.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the SysLib functions used by the CSDIDAC middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_SYSLIB_H)
+#define CY_SYSLIB_H
+
+#include "cy_device_headers.h"
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+void Cy_SysLib_Delay(uint32_t milliseconds);
+
+#endif /* CY_SYSLIB_H */
+
+
+/* [] END OF FILE */
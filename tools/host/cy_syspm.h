@@ -0,0 +1,71 @@
+/***************************************************************************//**
+* \file cy_syspm.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the SysPm types and functions used by the CSDIDAC middleware.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_SYSPM_H)
+#define CY_SYSPM_H
+
+#include "cy_device_headers.h"
+
+typedef enum
+{
+    CY_SYSPM_SUCCESS            = 0x0u,
+    CY_SYSPM_BAD_PARAM          = 0x1u,
+    CY_SYSPM_TIMEOUT            = 0x2u,
+    CY_SYSPM_INVALID_STATE      = 0x3u,
+    CY_SYSPM_FAIL               = 0x4u,
+} cy_en_syspm_status_t;
+
+typedef enum
+{
+    CY_SYSPM_CHECK_READY        = 0x01u,
+    CY_SYSPM_CHECK_FAIL         = 0x02u,
+    CY_SYSPM_BEFORE_TRANSITION  = 0x04u,
+    CY_SYSPM_AFTER_TRANSITION   = 0x08u,
+} cy_en_syspm_callback_mode_t;
+
+typedef enum
+{
+    CY_SYSPM_SLEEP              = 0u,
+    CY_SYSPM_DEEPSLEEP          = 1u,
+} cy_en_syspm_callback_type_t;
+
+typedef struct
+{
+    void * base;
+    void * context;
+} cy_stc_syspm_callback_params_t;
+
+typedef cy_en_syspm_status_t (* Cy_SysPmCallback)(cy_stc_syspm_callback_params_t * callbackParams,
+                                                  cy_en_syspm_callback_mode_t mode);
+
+typedef struct cy_stc_syspm_callback
+{
+    Cy_SysPmCallback callback;
+    cy_en_syspm_callback_type_t type;
+    uint32_t skipMode;
+    cy_stc_syspm_callback_params_t * callbackParams;
+    struct cy_stc_syspm_callback * prevItm;
+    struct cy_stc_syspm_callback * nextItm;
+    uint8_t order;
+} cy_stc_syspm_callback_t;
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void);
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(void);
+bool Cy_SysPm_RegisterCallback(cy_stc_syspm_callback_t * handler);
+
+#endif /* CY_SYSPM_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,36 @@
+/***************************************************************************//**
+* \file cybsp.h
+* \version 2.10
+*
+* \brief
+* Host stand-in of the BSP header included by the code example. The user
+* button is pin 3 of the modelled port 3 as on the PMG1-CY7113 kit. The
+* CSDIDAC configuration and cybsp_init() are defined by the test that
+* builds main.c.
+*
+********************************************************************************
+* \copyright
+* Copyright 2019-2024, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CYBSP_H)
+#define CYBSP_H
+
+#include "csdidac_host.h"
+#include "cy_csdidac.h"
+
+#define CYBSP_USER_BTN_PORT         (&host_gpio_ports[3])
+#define CYBSP_USER_BTN_NUM          (3u)
+#define CYBSP_USER_BTN_IRQ          ((IRQn_Type)3)
+
+extern const cy_stc_csdidac_config_t CYBSP_CSD_csdidac_config;
+
+cy_rslt_t cybsp_init(void);
+
+#endif /* CYBSP_H */
+
+
+/* [] END OF FILE */